@@ -745,6 +745,13 @@ function(hpx_check_for_cxx17_std_in_place_type_t)
     FILE ${ARGN})
 endfunction()
 
+###############################################################################
+function(hpx_check_for_cxx17_std_experimental_simd)
+  add_hpx_config_test(HPX_WITH_CXX17_STD_EXPERIMENTAL_SIMD
+    SOURCE cmake/tests/cxx17_std_experimental_simd.cpp
+    FILE ${ARGN})
+endfunction()
+
 ###############################################################################
 function(hpx_check_for_cxx17_structured_bindings)
   add_hpx_config_test(HPX_WITH_CXX17_STRUCTURED_BINDINGS
@@ -228,6 +228,14 @@ function(hpx_perform_cxx_feature_tests)
     hpx_check_for_cxx17_std_in_place_type_t(
       DEFINITIONS HPX_HAVE_CXX17_STD_IN_PLACE_TYPE_T)
 
+    if(HPX_WITH_DATAPAR AND HPX_WITH_DATAPAR_STD_EXPERIMENTAL_SIMD)
+      hpx_check_for_cxx17_std_experimental_simd(
+        DEFINITIONS HPX_HAVE_DATAPAR HPX_HAVE_DATAPAR_STD_EXPERIMENTAL_SIMD
+        REQUIRED "HPX_WITH_DATAPAR_STD_EXPERIMENTAL_SIMD needs a standard library providing <experimental/simd> (e.g. libstdc++ V11 or newer)")
+    endif()
+
+  elseif(HPX_WITH_DATAPAR AND HPX_WITH_DATAPAR_STD_EXPERIMENTAL_SIMD)
+    hpx_error("HPX_WITH_DATAPAR_STD_EXPERIMENTAL_SIMD requires C++17 (set HPX_WITH_CXX17=On)")
   endif()
 
   # we deliberately check for this functionality even for non-C++17
@@ -0,0 +1,20 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <experimental/simd>
+
+namespace stdx = std::experimental;
+
+int main()
+{
+    float data[stdx::native_simd<float>::size()] = {};
+
+    stdx::native_simd<float> v(data, stdx::element_aligned);
+    v += 1.0f;
+    v.copy_to(data, stdx::element_aligned);
+
+    return stdx::popcount(v == 1.0f) == int(v.size()) ? 0 : 1;
+}
@@ -20,6 +20,7 @@
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
 #include <hpx/collectives.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/preprocessor/cat.hpp>
 #include <hpx/preprocessor/expand.hpp>
 #include <hpx/preprocessor/nargs.hpp>
@@ -28,15 +29,19 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/errors.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -49,27 +54,75 @@ namespace hpx { namespace server
     ///
     /// This contain the implementation of the partition_unordered_map's
     /// component functionality.
+    ///
+    /// The elements of a partition are distributed over a fixed number of
+    /// shards, each of which is a separate stl unordered_map protected by its
+    /// own spinlock. Actions accessing different shards of the same partition
+    /// run concurrently, only actions touching the same shard are serialized.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
         typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
 
         typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
+        // number of shards every partition is split into, this has to be a
+        // power of two
+        static constexpr std::size_t num_shards = 32;
+        static constexpr std::size_t num_shards_log2 = 5;
+
     private:
-        data_type partition_unordered_map_;
+        typedef lcos::local::spinlock mutex_type;
+
+        struct shard
+        {
+            mutable mutex_type mtx_;
+            data_type data_;
+        };
+
+        typedef std::array<util::cache_line_data<shard>, num_shards>
+            shards_type;
+
+        // The client selects the partition from the hash value modulo the
+        // number of partitions, all keys of a partition share the low bits
+        // of their hash values. The shard is therefore selected from the
+        // high bits of the (multiplicatively mixed) hash value.
+        std::size_t get_shard(Key const& key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(hash_(key));
+            return static_cast<std::size_t>(
+                (h * 0x9e3779b97f4a7c15ull) >> (64 - num_shards_log2));
+        }
+
+        shard& get_shard_data(Key const& key)
+        {
+            return shards_[get_shard(key)].data_;
+        }
+
+        shard const& get_shard_data(Key const& key) const
+        {
+            return shards_[get_shard(key)].data_;
+        }
+
+        void init(size_type bucket_count, KeyEqual const& equal)
+        {
+            size_type shard_bucket_count = bucket_count / num_shards;
+            for (auto& s : shards_)
+            {
+                s.data_.data_ = data_type(shard_bucket_count, hash_, equal);
+            }
+        }
+
+        Hash hash_;
+        shards_type shards_;
 
     public:
         ///////////////////////////////////////////////////////////////////////
@@ -83,41 +136,75 @@ namespace hpx { namespace server
         }
 
         explicit partition_unordered_map(size_type bucket_count)
-          : partition_unordered_map_(bucket_count)
-        {}
+        {
+            init(bucket_count, KeyEqual());
+        }
 
         partition_unordered_map(size_type bucket_count, Hash const& hash,
                 KeyEqual const& equal)
-          : partition_unordered_map_(bucket_count, hash, equal)
-        {}
+          : hash_(hash)
+        {
+            init(bucket_count, equal);
+        }
 
         // support components::copy
         partition_unordered_map(partition_unordered_map const& rhs)
           : base_type(rhs),
-            partition_unordered_map_(rhs.partition_unordered_map_)
-        {}
+            hash_(rhs.hash_)
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shard const& s = rhs.shards_[i].data_;
+                std::lock_guard<mutex_type> l(s.mtx_);
+                shards_[i].data_.data_ = s.data_;
+            }
+        }
 
         partition_unordered_map& operator=(partition_unordered_map const& rhs)
         {
             if (this != &rhs)
             {
                 this->base_type::operator=(rhs);
-                partition_unordered_map_ = rhs.partition_unordered_map_;
+                hash_ = rhs.hash_;
+                for (std::size_t i = 0; i != num_shards; ++i)
+                {
+                    data_type d;
+                    {
+                        shard const& s = rhs.shards_[i].data_;
+                        std::lock_guard<mutex_type> l(s.mtx_);
+                        d = s.data_;
+                    }
+
+                    shard& s = shards_[i].data_;
+                    std::lock_guard<mutex_type> l(s.mtx_);
+                    s.data_ = std::move(d);
+                }
             }
             return *this;
         }
 
         partition_unordered_map(partition_unordered_map && rhs)
           : base_type(std::move(rhs)),
-            partition_unordered_map_(std::move(rhs.partition_unordered_map_))
-        {}
+            hash_(std::move(rhs.hash_))
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shards_[i].data_.data_ =
+                    std::move(rhs.shards_[i].data_.data_);
+            }
+        }
 
         partition_unordered_map& operator=(partition_unordered_map && rhs)
         {
             if (this != &rhs)
             {
                 this->base_type::operator=(std::move(rhs));
-                partition_unordered_map_ = std::move(rhs.partition_unordered_map_);
+                hash_ = std::move(rhs.hash_);
+                for (std::size_t i = 0; i != num_shards; ++i)
+                {
+                    shards_[i].data_.data_ =
+                        std::move(rhs.shards_[i].data_.data_);
+                }
             }
             return *this;
         }
@@ -125,38 +212,32 @@ namespace hpx { namespace server
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            data_type result(0, hash_,
+                shards_[0].data_.data_.key_eq());
+            for (auto const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.data_.mtx_);
+                result.insert(s.data_.data_.begin(), s.data_.data_.end());
+            }
+            return result;
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
-        }
-
-        ///////////////////////////////////////////////////////////////////////
-        iterator_type begin()
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type begin() const
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type cbegin() const
-        {
-            return partition_unordered_map_.cbegin();
-        }
+            std::array<data_type, num_shards> data;
+            for (auto& v : d)
+            {
+                std::size_t i = get_shard(v.first);
+                data[i].insert(std::move(v));
+            }
 
-        iterator_type end()
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type end() const
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type cend() const
-        {
-            return partition_unordered_map_.cend();
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shard& s = shards_[i].data_;
+                std::lock_guard<mutex_type> l(s.mtx_);
+                s.data_.clear();
+                s.data_.insert(std::make_move_iterator(data[i].begin()),
+                    std::make_move_iterator(data[i].end()));
+            }
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -166,27 +247,32 @@ namespace hpx { namespace server
         /// Returns the number of elements
         size_type size() const
         {
-            return partition_unordered_map_.size();
+            size_type result = 0;
+            for (auto const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.data_.mtx_);
+                result += s.data_.data_.size();
+            }
+            return result;
         }
 
         /// Returns the maximum possible number of elements
         size_type max_size() const
         {
-            return partition_unordered_map_.max_size();
-        }
-
-        /// Returns the number of elements that the container has currently
-        /// allocated space for.
-        size_type capacity() const
-        {
-            return partition_unordered_map_.capacity();
+            return shards_[0].data_.data_.max_size();
         }
 
         /// Checks if the container has no elements, i.e. whether
         /// begin() == end().
         bool empty() const
         {
-            return partition_unordered_map_.empty();
+            for (auto const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.data_.mtx_);
+                if (!s.data_.data_.empty())
+                    return false;
+            }
+            return true;
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -201,24 +287,13 @@ namespace hpx { namespace server
         /// \return Return the value of the element at position represented
         ///         by \a pos.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            shard& s = get_shard_data(key);
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            typename data_type::iterator it = s.data_.find(key);
+            if (it == s.data_.end())
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
@@ -229,8 +304,9 @@ namespace hpx { namespace server
             if (!erase)
                 return it->second;
 
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            T result = std::move(it->second);
+            s.data_.erase(it);
+            return result;
         }
 
         /// Return the element at the position \a pos in the partition_unordered_map
@@ -248,9 +324,11 @@ namespace hpx { namespace server
 
             for (std::size_t i = 0; i != keys.size(); ++i)
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
+                shard& s = get_shard_data(keys[i]);
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                typename data_type::iterator it = s.data_.find(keys[i]);
+                if (it == s.data_.end())
                 {
                     HPX_THROW_EXCEPTION(bad_parameter,
                         "partition_unordered_map::get_values",
@@ -276,7 +354,9 @@ namespace hpx { namespace server
         ///
         void set_value(Key const& pos, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            shard& s = get_shard_data(pos);
+            std::lock_guard<mutex_type> l(s.mtx_);
+            s.data_[pos] = val;
         }
 
         /// Copy the value of \a val for the elements at positions \a pos in
@@ -290,10 +370,13 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
 
             for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            {
+                shard& s = get_shard_data(keys[i]);
+                std::lock_guard<mutex_type> l(s.mtx_);
+                s.data_[keys[i]] = val[i];
+            }
         }
 
         /// Remove all elements from the vector leaving the
@@ -301,13 +384,19 @@ namespace hpx { namespace server
         ///
         void clear()
         {
-            partition_unordered_map_.clear();
+            for (auto& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.data_.mtx_);
+                s.data_.data_.clear();
+            }
         }
 
         /// Erase the given element
         std::size_t erase(Key const& key)
         {
-            return partition_unordered_map_.erase(key);
+            shard& s = get_shard_data(key);
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return s.data_.erase(key);
         }
 
         /// Macros to define HPX component actions for all exported functions.
@@ -12,6 +12,7 @@
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
@@ -360,6 +361,34 @@ namespace hpx
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // Reassembles the values returned from the partitions in the order of
+        // the requested keys. positions_[i] holds the indices of the keys
+        // which were sent to the i-th partition queried.
+        struct get_values_helper
+        {
+            std::vector<std::vector<std::size_t> > positions_;
+            std::size_t count_;
+
+            std::vector<T> operator()(
+                future<std::vector<future<std::vector<T> > > > && f) const
+            {
+                std::vector<future<std::vector<T> > > part_values = f.get();
+
+                std::vector<T> result(count_);
+                for (std::size_t i = 0; i != part_values.size(); ++i)
+                {
+                    std::vector<T> values = part_values[i].get();
+                    std::vector<std::size_t> const& pos = positions_[i];
+
+                    HPX_ASSERT(values.size() == pos.size());
+                    for (std::size_t j = 0; j != pos.size(); ++j)
+                        result[pos[j]] = std::move(values[j]);
+                }
+                return result;
+            }
+        };
+
         /// \cond NOINTERNAL
         typedef std::pair<hpx::id_type, std::vector<hpx::id_type> >
             bulk_locality_result;
@@ -682,6 +711,96 @@ namespace hpx
                 .get_value(pos, erase);
         }
 
+        /// Returns the elements with the given keys from the given partition
+        /// of the unordered_map container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        ///
+        /// \return Returns the values of the elements with the given keys.
+        ///
+        std::vector<T> get_values(launch::sync_policy, size_type part,
+            std::vector<Key> const& keys) const
+        {
+            return get_values(part, keys).get();
+        }
+
+        /// Asynchronously returns the elements with the given keys from the
+        /// given partition of the unordered_map container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        ///
+        /// \return Returns the hpx::future to the values of the elements
+        ///         with the given keys.
+        ///
+        future<std::vector<T> > get_values(size_type part,
+            std::vector<Key> const& keys) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+                return make_ready_future(part_data.local_data_->get_values(keys));
+
+            return partition_unordered_map_client(part_data.partition_)
+                .get_values(keys);
+        }
+
+        /// Returns the elements with the given keys from the unordered_map
+        /// container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the values of the elements with the given keys.
+        ///
+        std::vector<T> get_values(launch::sync_policy,
+            std::vector<Key> const& keys) const
+        {
+            return get_values(keys).get();
+        }
+
+        /// Asynchronously returns the elements with the given keys from the
+        /// unordered_map container. The keys are grouped by the partition
+        /// they belong to, every partition is queried only once.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the hpx::future to the values of the elements
+        ///         with the given keys, in the order of the keys.
+        ///
+        future<std::vector<T> > get_values(std::vector<Key> const& keys) const
+        {
+            if (keys.empty())
+                return make_ready_future(std::vector<T>());
+
+            // group the keys by the partition they belong to
+            std::vector<std::vector<Key> > part_keys(partitions_.size());
+            std::vector<std::vector<std::size_t> > part_positions(
+                partitions_.size());
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                std::size_t part = get_partition(keys[i]);
+                part_keys[part].push_back(keys[i]);
+                part_positions[part].push_back(i);
+            }
+
+            get_values_helper helper;
+            helper.count_ = keys.size();
+
+            std::vector<future<std::vector<T> > > part_values;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                part_values.push_back(get_values(part, part_keys[part]));
+                helper.positions_.push_back(std::move(part_positions[part]));
+            }
+
+            return when_all(part_values).then(std::move(helper));
+        }
+
         /// Copy the value of \a val in the element at position \a pos in
         /// the unordered_map container.
         ///
@@ -761,6 +880,101 @@ namespace hpx
                 .set_value(pos, std::forward<T_>(val));
         }
 
+        /// Copy the values \a vals to the elements with the given keys in
+        /// the partition \a part of the unordered_map container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        /// \param vals  The values to be copied
+        ///
+        void set_values(launch::sync_policy, size_type part,
+            std::vector<Key> const& keys, std::vector<T> const& vals)
+        {
+            set_values(part, keys, vals).get();
+        }
+
+        /// Asynchronously copy the values \a vals to the elements with the
+        /// given keys in the partition \a part of the unordered_map
+        /// container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_values(size_type part, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(part < partitions_.size());
+            HPX_ASSERT(keys.size() == vals.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+            {
+                part_data.local_data_->set_values(keys, vals);
+                return make_ready_future();
+            }
+
+            return partition_unordered_map_client(part_data.partition_)
+                .set_values(keys, vals);
+        }
+
+        /// Copy the values \a vals to the elements with the given keys in
+        /// the unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        void set_values(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            set_values(keys, vals).get();
+        }
+
+        /// Asynchronously copy the values \a vals to the elements with the
+        /// given keys in the unordered_map container. The keys are grouped
+        /// by the partition they belong to, every partition is sent a single
+        /// request.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_values(std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(keys.size() == vals.size());
+
+            if (keys.empty())
+                return make_ready_future();
+
+            // group the keys and values by the partition they belong to
+            std::vector<std::vector<Key> > part_keys(partitions_.size());
+            std::vector<std::vector<T> > part_vals(partitions_.size());
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                std::size_t part = get_partition(keys[i]);
+                part_keys[part].push_back(keys[i]);
+                part_vals[part].push_back(vals[i]);
+            }
+
+            std::vector<future<void> > part_futures;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                part_futures.push_back(
+                    set_values(part, part_keys[part], part_vals[part]));
+            }
+
+            return when_all(part_futures);
+        }
+
         /// Asynchronously compute the size of the unordered_map.
         ///
         /// \return Return the number of elements in the unordered_map
@@ -5,6 +5,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/include/traits.hpp>
 #include <hpx/include/unordered_map.hpp>
 #include <hpx/testing.hpp>
@@ -76,6 +77,50 @@ void fill_unordered_map(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
     HPX_TEST(m.size() == count);
 }
 
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void bulk_tests(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m)
+{
+    std::size_t const count = 1007;
+
+    std::vector<Key> keys;
+    std::vector<Value> vals;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        keys.push_back(std::to_string(i));
+        vals.push_back(Value(i));
+    }
+
+    // set all values concurrently
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        futures.push_back(m.set_value(keys[i], vals[i]));
+    }
+    hpx::wait_all(futures);
+    HPX_TEST_EQ(m.size(), count);
+
+    // the values are returned in the order of the requested keys
+    std::reverse(keys.begin(), keys.end());
+    std::vector<Value> result = m.get_values(hpx::launch::sync, keys);
+    HPX_TEST_EQ(result.size(), count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(result[i], Value(count - i - 1));
+    }
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        vals[i] = Value(2 * (count - i - 1));
+    }
+    m.set_values(hpx::launch::sync, keys, vals);
+    HPX_TEST_EQ(m.size(), count);
+
+    result = m.get_values(hpx::launch::sync, keys);
+    HPX_TEST(result == vals);
+
+    HPX_TEST(m.get_values(hpx::launch::sync, std::vector<Key>()).empty());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Key, typename Value, typename DistPolicy>
 void trivial_tests(DistPolicy const& policy)
@@ -107,6 +152,12 @@ void trivial_tests(DistPolicy const& policy)
         fill_unordered_map(m, 107, Value(42));
         test_global_iteration(m, Value(42));
     }
+
+    // bulk access
+    {
+        hpx::unordered_map<Key, Value> m(policy);
+        bulk_tests(m);
+    }
 }
 
 template <typename Key, typename Value>
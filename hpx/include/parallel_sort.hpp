@@ -7,9 +7,16 @@
 #if !defined(HPX_PARALLEL_SORT_NOV_01_2015_1003AM)
 #define HPX_PARALLEL_SORT_NOV_01_2015_1003AM
 
+#include <hpx/parallel/algorithms/nth_element.hpp>
+#include <hpx/parallel/algorithms/partial_sort.hpp>
 #include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/segmented_algorithms/sort.hpp>
 #include <hpx/parallel/algorithms/sort_by_key.hpp>
+#include <hpx/parallel/algorithms/stable_sort.hpp>
+#include <hpx/parallel/container_algorithms/nth_element.hpp>
+#include <hpx/parallel/container_algorithms/partial_sort.hpp>
 #include <hpx/parallel/container_algorithms/sort.hpp>
+#include <hpx/parallel/container_algorithms/stable_sort.hpp>
 
 #endif
 
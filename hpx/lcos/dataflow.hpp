@@ -22,7 +22,7 @@
 #ifndef HPX_LCOS_DATAFLOW_HPP
 #define HPX_LCOS_DATAFLOW_HPP
 
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/coroutines/detail/get_stack_pointer.hpp>
 #include <hpx/datastructures/tuple.hpp>
 #include <hpx/functional/deferred_call.hpp>
@@ -533,12 +533,12 @@ namespace hpx
     auto dataflow(F && f, Ts &&... ts)
     ->  decltype(
             lcos::detail::dataflow_dispatch<typename std::decay<F>::type>::call(
-                hpx::util::internal_allocator<>{}, std::forward<F>(f),
+                hpx::util::thread_local_caching_allocator<>{}, std::forward<F>(f),
                 std::forward<Ts>(ts)...
         ))
     {
         return lcos::detail::dataflow_dispatch<typename std::decay<F>::type>::
-            call(hpx::util::internal_allocator<>{}, std::forward<F>(f),
+            call(hpx::util::thread_local_caching_allocator<>{}, std::forward<F>(f),
                 std::forward<Ts>(ts)...);
     }
 
@@ -561,11 +561,11 @@ namespace hpx
     HPX_FORCEINLINE
     auto dataflow(T0 && t0, Ts &&... ts)
     ->  decltype(lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::thread_local_caching_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...))
     {
         return lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::thread_local_caching_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...);
     }
 
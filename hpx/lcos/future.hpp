@@ -10,7 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/allocator_support/allocator_deleter.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assertion.hpp>
 #include <hpx/concepts/concepts.hpp>
 #include <hpx/errors.hpp>
@@ -442,7 +442,7 @@ namespace hpx { namespace lcos { namespace detail
 
             typename hpx::traits::detail::shared_state_ptr<result_type>::type p =
                 detail::make_continuation_alloc<continuation_result_type>(
-                    hpx::util::internal_allocator<>{},
+                    hpx::util::thread_local_caching_allocator<>{},
                     std::move(fut), std::forward<Policy_>(policy),
                     std::forward<F>(f));
             return hpx::traits::future_access<future<result_type> >::create(
@@ -1541,7 +1541,7 @@ namespace hpx { namespace lcos
     make_ready_future(Ts&&... ts)
     {
         return make_ready_future_alloc<T>(
-            hpx::util::internal_allocator<>{},
+            hpx::util::thread_local_caching_allocator<>{},
             std::forward<Ts>(ts)...);
     }
     ///////////////////////////////////////////////////////////////////////////
@@ -1561,7 +1561,7 @@ namespace hpx { namespace lcos
     {
         using result_type = typename hpx::util::decay_unwrap<T>::type;
         return make_ready_future_alloc<result_type>(
-            hpx::util::internal_allocator<>{},
+            hpx::util::thread_local_caching_allocator<>{},
             std::forward<T>(init));
     }
 
@@ -1633,7 +1633,7 @@ namespace hpx { namespace lcos
     HPX_FORCEINLINE future<void> make_ready_future()
     {
         return make_ready_future_alloc<void>(
-            hpx::util::internal_allocator<>{}, util::unused);
+            hpx::util::thread_local_caching_allocator<>{}, util::unused);
     }
 
     // Extension (see wg21.link/P0319)
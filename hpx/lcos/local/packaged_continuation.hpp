@@ -10,7 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/allocator_support/allocator_deleter.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/errors.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/lcos/future.hpp>
@@ -1054,7 +1054,7 @@ namespace hpx { namespace lcos { namespace detail
     unwrap_impl(Future && future, error_code& ec)
     {
         return unwrap_impl_alloc(
-            util::internal_allocator<>{}, std::forward<Future>(future), ec);
+            util::thread_local_caching_allocator<>{}, std::forward<Future>(future), ec);
     }
 
     template <typename Allocator, typename Future>
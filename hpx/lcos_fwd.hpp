@@ -76,6 +76,9 @@ namespace hpx
 
             template <typename R>
             class promise;
+
+            template <typename Sig>
+            class packaged_task;
         }
 
         // forward declare wait_all()
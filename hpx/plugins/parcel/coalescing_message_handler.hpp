@@ -32,6 +32,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace plugins { namespace parcel
 {
+    namespace detail
+    {
+        struct round_trip_time;
+    }
+
     struct HPX_LIBRARY_EXPORT coalescing_message_handler
       : parcelset::policies::message_handler
     {
@@ -79,6 +84,14 @@ namespace hpx { namespace plugins { namespace parcel
 
         void update_num_messages();
         void update_interval();
+        void update_adaptive();
+
+        // recalculate the coalescing parameters from the observed parcel
+        // arrival rate and round trip time
+        void adapt_parameters();
+
+        std::size_t get_num_coalesced_parcels() const;
+        std::int64_t get_interval() const;
 
     private:
         mutable mutex_type mtx_;
@@ -91,6 +104,15 @@ namespace hpx { namespace plugins { namespace parcel
         bool allow_background_flush_;
         std::string action_name_;
 
+        // adaptive coalescing, num_coalesced_parcels_ and interval_ are the
+        // upper limits for the adapted values
+        bool adaptive_;
+        std::size_t adaptive_num_coalesced_parcels_;
+        std::int64_t adaptive_interval_;            // [ns]
+        double average_arrival_time_;               // [ns]
+        std::shared_ptr<detail::round_trip_time> round_trip_time_;
+        std::int64_t buffer_started_at_;
+
         // performance counter data
         std::int64_t num_parcels_;
         std::int64_t reset_num_parcels_;
@@ -155,6 +155,13 @@ namespace hpx { namespace plugins { namespace parcel { namespace detail
 
         std::size_t capacity() const { return max_messages_; }
 
+        // access the write handler of the parcel appended last
+        parcelset::write_handler_type& back_handler()
+        {
+            HPX_ASSERT(!handlers_.empty());
+            return handlers_.back();
+        }
+
     private:
         parcelset::locality dest_;
         std::vector<parcelset::parcel> messages_;
@@ -0,0 +1,146 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHM_CONNECTION_HANDLER_HPP
+#define HPX_PARCELSET_POLICIES_SHM_CONNECTION_HANDLER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHM)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shm/locality.hpp>
+#include <hpx/plugins/parcelport/shm/receiver.hpp>
+#include <hpx/plugins/parcelport/shm/segment.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shm
+    {
+        class sender;
+        class HPX_EXPORT connection_handler;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shm::connection_handler>
+    {
+        typedef policies::shm::sender connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+
+        static const char * type()
+        {
+            return "shm";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-shm";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shm";
+        }
+    };
+
+    namespace policies { namespace shm
+    {
+        // The shared memory parcelport connects localities running on the
+        // same node. It is never used for bootstrapping, parcels are routed
+        // through it only once alternative parcelports have been enabled.
+        class HPX_EXPORT connection_handler
+          : public parcelport_impl<connection_handler>
+        {
+            typedef parcelport_impl<connection_handler> base_type;
+        public:
+
+            static std::vector<std::string> runtime_configuration()
+            {
+                std::vector<std::string> lines;
+
+                return lines;
+            }
+
+            connection_handler(util::runtime_configuration const& ini,
+                threads::policies::callback_notifier const& notifier);
+
+            ~connection_handler();
+
+            /// Start the handling of connections.
+            bool do_run();
+
+            /// Stop the handling of connectons.
+            void do_stop();
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return boost::asio::ip::host_name();
+            }
+
+            /// Only localities running on the same node can be reached
+            bool can_connect(parcelset::locality const& l,
+                bool use_alternative_parcelport) override;
+
+            std::shared_ptr<sender> create_connection(
+                parcelset::locality const& l, error_code& ec);
+
+            parcelset::locality agas_locality(util::runtime_configuration const& ini)
+                const;
+
+            parcelset::locality create_locality() const;
+
+            bool background_work(
+                std::size_t num_thread, parcelport_background_mode mode);
+
+            /// Park a connection whose ring is full, its write is resumed
+            /// from the background work once the receiver has made room.
+            void park_connection(std::shared_ptr<sender> const& s);
+
+        private:
+            bool resume_parked_connections();
+
+            std::shared_ptr<segment> get_segment(
+                locality const& l, error_code& ec);
+
+            std::size_t num_channels_;
+            std::size_t channel_size_;
+
+            /// The segment this locality receives parcels through
+            receiver receiver_;
+
+            /// The segments of the localities parcels have been sent to
+            lcos::local::spinlock segments_mtx_;
+            std::map<locality, std::shared_ptr<segment> > segments_;
+
+            /// The connections waiting for room in their ring
+            lcos::local::spinlock parked_mtx_;
+            std::vector<std::shared_ptr<sender> > parked_;
+            bool stopped_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHM_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_SHM_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHM)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/string.hpp>
+
+#include <boost/io/ios_state.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shm
+    {
+        // A shared memory endpoint is identified by the node it runs on and
+        // the id of the process owning the receiving segment.
+        class locality
+        {
+        public:
+            locality()
+              : pid_(0)
+            {}
+
+            locality(std::string const& host, std::uint32_t pid)
+              : host_(host), pid_(pid)
+            {}
+
+            std::string const& host() const
+            {
+                return host_;
+            }
+
+            std::uint32_t pid() const
+            {
+                return pid_;
+            }
+
+            // name of the shared memory segment the receiving locality
+            // listens on
+            std::string segment_name() const
+            {
+                return "/hpx.shm." + std::to_string(pid_);
+            }
+
+            static const char *type()
+            {
+                return "shm";
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return pid_ != 0;
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << host_;
+                ar << pid_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> host_;
+                ar >> pid_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.pid_ == rhs.pid_ && lhs.host_ == rhs.host_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.host_ < rhs.host_ ||
+                    (lhs.host_ == rhs.host_ && lhs.pid_ < rhs.pid_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                boost::io::ios_flags_saver ifs(os);
+                os << loc.host_ << ":" << loc.pid_;
+
+                return os;
+            }
+
+            std::string host_;
+            std::uint32_t pid_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
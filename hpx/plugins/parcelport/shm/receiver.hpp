@@ -0,0 +1,277 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHM_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHM)
+
+#include <hpx/assertion.hpp>
+#include <hpx/errors.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shm/segment.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shm
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Non-owning view of received data, this allows to decode messages in
+    // place without copying them out of the shared memory segment first.
+    class data_view
+    {
+    public:
+        using allocator_type = std::allocator<char>;
+
+        data_view()
+          : data_(nullptr), size_(0)
+        {}
+
+        explicit data_view(allocator_type const&)
+          : data_(nullptr), size_(0)
+        {}
+
+        data_view(char const* data, std::size_t size)
+          : data_(data), size_(size)
+        {}
+
+        char const* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        char const& operator[](std::size_t i) const
+        {
+            HPX_ASSERT(i < size_);
+            return data_[i];
+        }
+
+        void clear()
+        {
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+    private:
+        char const* data_;
+        std::size_t size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    class receiver
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef parcel_buffer<data_view, data_view> parcel_buffer_type;
+
+        // process local state of a channel
+        struct channel_state
+        {
+            mutex_type mtx_;
+
+            // collects the fragments of a message larger than the ring
+            std::vector<char> staging_;
+        };
+
+    public:
+        explicit receiver(parcelset::parcelport& pp)
+          : pp_(pp)
+          , stopped_(true)
+        {}
+
+        void open(std::string const& name, std::size_t num_channels,
+            std::size_t channel_size, error_code& ec = throws)
+        {
+            segment_.create(name, num_channels, channel_size, ec);
+            if (ec)
+                return;
+
+            channels_.reset(new channel_state[segment_.num_channels()]);
+            stopped_.store(false, std::memory_order_release);
+        }
+
+        void close()
+        {
+            if (stopped_.exchange(true))
+                return;
+
+            segment_.mark_closed();
+
+            // wait for concurrent readers to leave the segment
+            for (std::size_t i = 0; i != segment_.num_channels(); ++i)
+            {
+                std::lock_guard<mutex_type> l(channels_[i].mtx_);
+            }
+            segment_.close();
+        }
+
+        bool background_work()
+        {
+            if (stopped_.load(std::memory_order_acquire))
+                return false;
+
+            bool did_some_work = false;
+            std::size_t active = segment_.active_channels();
+            for (std::size_t i = 0; i != active; ++i)
+            {
+                channel_control& ctrl = segment_.control(i);
+                if (ctrl.head.load(std::memory_order_relaxed) ==
+                    ctrl.tail.load(std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                // only one thread consumes a channel at any time
+                std::unique_lock<mutex_type> l(
+                    channels_[i].mtx_, std::try_to_lock);
+                if (!l.owns_lock() || stopped_.load(std::memory_order_relaxed))
+                    continue;
+
+                did_some_work = receive(i, channels_[i]) || did_some_work;
+            }
+            return did_some_work;
+        }
+
+    private:
+        bool receive(std::size_t channel, channel_state& state)
+        {
+            channel_control& ctrl = segment_.control(channel);
+            std::size_t capacity = segment_.channel_size();
+            char const* ring = segment_.ring(channel);
+
+            std::uint64_t tail = ctrl.tail.load(std::memory_order_relaxed);
+            std::uint64_t head = ctrl.head.load(std::memory_order_acquire);
+            if (tail == head)
+                return false;
+
+            while (tail != head)
+            {
+                frame_header hdr;
+                char const* frame = ring + tail % capacity;
+                std::memcpy(&hdr, frame, sizeof(hdr));
+                HPX_ASSERT(hdr.size != 0 && hdr.size <= head - tail);
+
+                char const* payload = frame + sizeof(frame_header);
+                switch (hdr.kind)
+                {
+                case frame_message:
+                    // decode straight out of the ring
+                    decode(payload, static_cast<std::size_t>(hdr.length));
+                    break;
+
+                case frame_fragment:
+                    {
+                        std::vector<char>& staging = state.staging_;
+                        if (staging.empty())
+                            staging.reserve(static_cast<std::size_t>(hdr.total));
+                        staging.insert(
+                            staging.end(), payload, payload + hdr.length);
+
+                        if (staging.size() == hdr.total)
+                        {
+                            decode(staging.data(), staging.size());
+                            std::vector<char>().swap(staging);
+                        }
+                    }
+                    break;
+
+                case frame_wrap:
+                    break;
+
+                default:
+                    HPX_ASSERT(false);
+                    break;
+                }
+
+                // hand the space back to the sender
+                tail += hdr.size;
+                ctrl.tail.store(tail, std::memory_order_release);
+            }
+            return true;
+        }
+
+        void decode(char const* data, std::size_t size)
+        {
+            message_header hdr;
+            std::memcpy(&hdr, data, sizeof(hdr));
+            std::size_t offset = sizeof(hdr);
+
+            parcel_buffer_type buffer;
+            buffer.size_ = hdr.size;
+            buffer.data_size_ = hdr.data_size;
+            buffer.num_chunks_.first = hdr.num_zero_copy_chunks;
+            buffer.num_chunks_.second = hdr.num_non_zero_copy_chunks;
+
+            if (hdr.num_transmission_chunks != 0)
+            {
+                typedef parcel_buffer_type::transmission_chunk_type
+                    transmission_chunk_type;
+
+                std::vector<transmission_chunk_type>& chunks =
+                    buffer.transmission_chunks_;
+                chunks.resize(hdr.num_transmission_chunks);
+
+                std::size_t chunks_size =
+                    chunks.size() * sizeof(transmission_chunk_type);
+                std::memcpy(chunks.data(), data + offset, chunks_size);
+                offset += chunks_size;
+            }
+
+            // main buffer holding data which was serialized normally
+            std::size_t data_size = static_cast<std::size_t>(hdr.size);
+            buffer.data_ = data_view(data + offset, data_size);
+            offset += align_payload(data_size);
+
+            // zero-copy chunks
+            buffer.chunks_.reserve(hdr.num_zero_copy_chunks);
+            for (std::size_t i = 0; i != hdr.num_zero_copy_chunks; ++i)
+            {
+                std::size_t chunk_size = static_cast<std::size_t>(
+                    buffer.transmission_chunks_[i].second);
+                buffer.chunks_.emplace_back(data + offset, chunk_size);
+                offset += align_payload(chunk_size);
+            }
+            HPX_ASSERT(offset <= size);
+
+            buffer.data_point_.bytes_ = data_size;
+
+            // the parcels are de-serialized synchronously, the data is not
+            // referenced anymore once this returns
+            decode_parcels(pp_, std::move(buffer), -1);
+        }
+
+        parcelset::parcelport& pp_;
+        segment segment_;
+        std::unique_ptr<channel_state[]> channels_;
+        std::atomic<bool> stopped_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHM_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_SHM_SEGMENT_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHM)
+#include <hpx/assertion.hpp>
+#include <hpx/errors.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shm
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Every locality owns one shared memory segment which is opened by all
+    // other localities on the same node sending parcels to it. The segment
+    // is split into channels, each channel is a single-producer,
+    // single-consumer byte ring claimed by one sending connection at a time.
+    //
+    // Messages are written into the ring as frames, a frame never wraps
+    // around the end of the ring. Frames are padded to full cache lines,
+    // which guarantees that there is always enough room left for a wrap
+    // frame marking the unused remainder at the end of the ring.
+    constexpr std::size_t frame_alignment = 64;
+
+    enum frame_kind : std::uint32_t
+    {
+        frame_wrap = 1,         // skip to the beginning of the ring
+        frame_message = 2,      // a complete message
+        frame_fragment = 3      // part of a message larger than the ring
+    };
+
+    struct frame_header
+    {
+        std::uint64_t size;         // bytes occupied in the ring
+        std::uint32_t kind;
+        std::uint32_t reserved;
+        std::uint64_t length;       // payload bytes carried by this frame
+        std::uint64_t total;        // payload bytes of the whole message
+    };
+
+    // Layout of a message: the message_header is followed by the
+    // transmission chunks, the main buffer holding the data which was
+    // serialized normally and the zero-copy chunks. The main buffer and each
+    // zero-copy chunk are padded to 8 bytes.
+    struct message_header
+    {
+        std::uint64_t size;
+        std::uint64_t data_size;
+        std::uint32_t num_zero_copy_chunks;
+        std::uint32_t num_non_zero_copy_chunks;
+        std::uint32_t num_transmission_chunks;
+        std::uint32_t reserved;
+    };
+
+    inline std::size_t align_payload(std::size_t size)
+    {
+        return (size + 7) & ~std::size_t(7);
+    }
+
+    struct alignas(64) channel_control
+    {
+        // pid of the sending process, zero if the channel is free
+        alignas(64) std::atomic<std::uint32_t> owner;
+
+        // monotonic positions, head is advanced by the sender only, tail by
+        // the receiver only
+        alignas(64) std::atomic<std::uint64_t> head;
+        alignas(64) std::atomic<std::uint64_t> tail;
+    };
+
+    struct alignas(64) segment_header
+    {
+        std::atomic<std::uint64_t> magic;
+        std::atomic<std::uint32_t> closed;
+        // one past the highest channel ever claimed, bounds the receiver's
+        // scan
+        std::atomic<std::uint32_t> active_channels;
+        std::uint32_t num_channels;
+        std::uint64_t channel_size;
+    };
+
+    inline std::size_t align_frame(std::size_t size)
+    {
+        return (size + frame_alignment - 1) & ~(frame_alignment - 1);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    class HPX_EXPORT segment
+    {
+    public:
+        HPX_NON_COPYABLE(segment);
+
+    public:
+        segment();
+        ~segment();
+
+        // create the segment owned by this locality, it is removed from the
+        // system once it is closed
+        void create(std::string const& name, std::size_t num_channels,
+            std::size_t channel_size, error_code& ec = throws);
+
+        // attach to a segment owned by another locality
+        void open(std::string const& name, error_code& ec = throws);
+
+        // unmap the segment, unlink it if owned by this locality
+        void close();
+
+        // tell all senders that this segment will not be read anymore
+        void mark_closed();
+
+        bool is_open() const
+        {
+            return header_ != nullptr;
+        }
+
+        bool is_closed() const
+        {
+            return header_->closed.load(std::memory_order_acquire) != 0;
+        }
+
+        std::size_t num_channels() const
+        {
+            return header_->num_channels;
+        }
+
+        std::size_t active_channels() const
+        {
+            return header_->active_channels.load(std::memory_order_acquire);
+        }
+
+        std::size_t channel_size() const
+        {
+            return static_cast<std::size_t>(header_->channel_size);
+        }
+
+        channel_control& control(std::size_t channel) const
+        {
+            HPX_ASSERT(channel < num_channels());
+            return controls_[channel];
+        }
+
+        char* ring(std::size_t channel) const
+        {
+            HPX_ASSERT(channel < num_channels());
+            return rings_ + channel * channel_size();
+        }
+
+        // claim a free channel for exclusive use by the calling process,
+        // returns std::size_t(-1) if all channels are in use
+        std::size_t claim_channel(std::uint32_t owner);
+        void release_channel(std::size_t channel);
+
+    private:
+        void map(int fd, std::size_t size, error_code& ec);
+
+        std::string name_;
+        bool owner_;
+        void* base_;
+        std::size_t size_;
+
+        segment_header* header_;
+        channel_control* controls_;
+        char* rings_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,430 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHM_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHM)
+
+#include <hpx/assertion.hpp>
+#include <hpx/config/asio.hpp>
+#include <hpx/functional/bind.hpp>
+#include <hpx/functional/deferred_call.hpp>
+#include <hpx/functional/unique_function.hpp>
+#include <hpx/plugins/parcelport/shm/connection_handler.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/plugins/parcelport/shm/locality.hpp>
+#include <hpx/plugins/parcelport/shm/segment.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/serialization/serialization_chunk.hpp>
+#include <hpx/state.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shm
+{
+    // A sending connection copies the serialized parcels (including their
+    // zero-copy chunks) into a ring of the receiving locality's segment. The
+    // data is copied once, the receiver decodes the messages in place.
+    //
+    // The sender never waits for the receiver on the io_service thread. If
+    // the ring is full, the connection is parked with the connection handler
+    // which resumes the write once the receiver has made room.
+    class sender
+      : public parcelset::parcelport_connection<sender, std::vector<char> >
+    {
+        using postprocess_handler_type = util::unique_function_nonser<void(
+            boost::system::error_code const&)>;
+
+        // a contiguous piece of the message, pieces without data are padding
+        struct piece
+        {
+            char const* data;
+            std::size_t size;
+        };
+
+        enum write_status
+        {
+            write_done,
+            write_blocked,      // the ring is full
+            write_failed        // the receiver went away
+        };
+
+    public:
+        /// Construct a sending connection writing into the given channel of
+        /// the receiving locality's segment.
+        sender(boost::asio::io_service& io_service,
+                parcelset::locality const& locality_id,
+                std::shared_ptr<segment> seg, std::size_t channel,
+                connection_handler* pp)
+          : io_service_(io_service)
+          , segment_(std::move(seg))
+          , channel_(channel)
+          , there_(locality_id)
+          , timer_()
+          , pp_(pp)
+          , current_piece_(0)
+          , piece_offset_(0)
+          , total_(0)
+          , written_(0)
+          , blocked_size_(0)
+        {
+        }
+
+        ~sender()
+        {
+            segment_->release_channel(channel_);
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify_(parcelset::locality const & parcel_locality_id) const
+        {
+            HPX_ASSERT(parcel_locality_id == there_);
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler,
+            ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+            HPX_ASSERT(!handler_);
+            HPX_ASSERT(!postprocess_handler_);
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
+            HPX_ASSERT(handler_);
+            HPX_ASSERT(postprocess_handler_);
+
+            /// Increment sends and begin timer.
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            gather_pieces();
+
+            // The data is copied into the ring on the io_service, this keeps
+            // the recursion caused by sending pending parcels from the
+            // post-processing handler bounded.
+            void (sender::*f)() = &sender::handle_write;
+            io_service_.post(util::bind(f, shared_from_this()));
+        }
+
+        /// Return whether the write of a parked connection can be resumed,
+        /// either because the receiver has made room or because it went
+        /// away.
+        bool can_resume() const
+        {
+            channel_control& ctrl = segment_->control(channel_);
+            std::uint64_t head = ctrl.head.load(std::memory_order_relaxed);
+            std::uint64_t tail = ctrl.tail.load(std::memory_order_acquire);
+            return segment_->channel_size() - (head - tail) >= blocked_size_ ||
+                segment_->is_closed();
+        }
+
+        /// Continue the write of a parked connection, the write fails if
+        /// abort is set.
+        void resume(bool abort)
+        {
+            if (abort)
+            {
+                void (sender::*f)(boost::system::error_code) =
+                    &sender::complete_write;
+                io_service_.post(util::bind(f, shared_from_this(),
+                    boost::asio::error::make_error_code(
+                        boost::asio::error::connection_aborted)));
+                return;
+            }
+
+            void (sender::*f)() = &sender::handle_write;
+            io_service_.post(util::bind(f, shared_from_this()));
+        }
+
+    private:
+        static void reset_handler(postprocess_handler_type handler)
+        {
+            handler.reset();
+        }
+
+        void gather_pieces()
+        {
+            pieces_.clear();
+            current_piece_ = 0;
+            piece_offset_ = 0;
+            written_ = 0;
+
+            header_.size = buffer_.size_;
+            header_.data_size = buffer_.data_size_;
+            header_.num_zero_copy_chunks = buffer_.num_chunks_.first;
+            header_.num_non_zero_copy_chunks = buffer_.num_chunks_.second;
+            header_.num_transmission_chunks =
+                static_cast<std::uint32_t>(buffer_.transmission_chunks_.size());
+            header_.reserved = 0;
+
+            pieces_.push_back(piece{
+                reinterpret_cast<char const*>(&header_), sizeof(header_)});
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty())
+            {
+                pieces_.push_back(
+                    piece{reinterpret_cast<char const*>(chunks.data()),
+                        chunks.size() *
+                            sizeof(parcel_buffer_type::transmission_chunk_type)});
+            }
+
+            // add main buffer holding data which was serialized normally
+            add_piece(buffer_.data_.data(), buffer_.data_.size());
+
+            // now add chunks themselves, those hold zero-copy serialized
+            // chunks which are copied straight from the user's memory
+            for (serialization::serialization_chunk& c : buffer_.chunks_)
+            {
+                if (c.type_ == serialization::chunk_type_pointer)
+                {
+                    add_piece(
+                        static_cast<char const*>(c.data_.cpos_), c.size_);
+                }
+            }
+
+            total_ = payload_size();
+        }
+
+        void add_piece(char const* data, std::size_t size)
+        {
+            pieces_.push_back(piece{data, size});
+            std::size_t padding = align_payload(size) - size;
+            if (padding != 0)
+                pieces_.push_back(piece{nullptr, padding});
+        }
+
+        std::size_t payload_size() const
+        {
+            std::size_t size = 0;
+            for (piece const& p : pieces_)
+                size += p.size;
+            return size;
+        }
+
+        // copy the next count bytes of the message to dest
+        void copy_pieces(char* dest, std::size_t count)
+        {
+            while (count != 0)
+            {
+                piece const& p = pieces_[current_piece_];
+                std::size_t n = (std::min)(p.size - piece_offset_, count);
+                if (p.data != nullptr)
+                    std::memcpy(dest, p.data + piece_offset_, n);
+
+                dest += n;
+                count -= n;
+                piece_offset_ += n;
+                if (piece_offset_ == p.size)
+                {
+                    ++current_piece_;
+                    piece_offset_ = 0;
+                }
+            }
+        }
+
+        // place one frame of the given kind carrying length payload bytes
+        // into the ring, the frame is published only once it is complete
+        write_status write_frame(
+            frame_kind kind, std::size_t length, std::size_t total)
+        {
+            if (segment_->is_closed())
+                return write_failed;
+
+            channel_control& ctrl = segment_->control(channel_);
+            std::size_t capacity = segment_->channel_size();
+            char* ring = segment_->ring(channel_);
+
+            std::uint64_t head = ctrl.head.load(std::memory_order_relaxed);
+            std::size_t size = align_frame(sizeof(frame_header) + length);
+            HPX_ASSERT(size <= capacity);
+
+            // frames never wrap around the end of the ring
+            std::size_t offset = static_cast<std::size_t>(head % capacity);
+            std::size_t remaining = capacity - offset;
+            std::size_t skip = remaining < size ? remaining : 0;
+
+            std::uint64_t tail = ctrl.tail.load(std::memory_order_acquire);
+            if (capacity - (head - tail) < skip + size)
+            {
+                blocked_size_ = skip + size;
+                return write_blocked;
+            }
+
+            if (skip != 0)
+            {
+                frame_header wrap = {skip, frame_wrap, 0, 0, 0};
+                std::memcpy(ring + offset, &wrap, sizeof(wrap));
+                offset = 0;
+            }
+
+            frame_header hdr = {size, kind, 0, length, total};
+            std::memcpy(ring + offset, &hdr, sizeof(hdr));
+            copy_pieces(ring + offset + sizeof(frame_header), length);
+
+            ctrl.head.store(head + skip + size, std::memory_order_release);
+            return write_done;
+        }
+
+        // write the (remainder of the) message, stops at the first frame
+        // which doesn't fit into the ring
+        write_status write_message()
+        {
+            std::size_t capacity = segment_->channel_size();
+            if (align_frame(sizeof(frame_header) + total_) <= capacity / 2)
+            {
+                write_status status =
+                    write_frame(frame_message, total_, total_);
+                if (status == write_done)
+                    written_ = total_;
+                return status;
+            }
+
+            // messages which do not comfortably fit into the ring are
+            // streamed through it in fragments
+            std::size_t max_length = capacity / 2 - sizeof(frame_header);
+            while (written_ != total_)
+            {
+                std::size_t length = (std::min)(max_length, total_ - written_);
+                write_status status =
+                    write_frame(frame_fragment, length, total_);
+                if (status != write_done)
+                    return status;
+                written_ += length;
+            }
+            return write_done;
+        }
+
+        /// write the message and complete the operation, the connection is
+        /// parked if the ring is full
+        void handle_write()
+        {
+            boost::system::error_code e;
+            switch (write_message())
+            {
+            case write_blocked:
+                pp_->park_connection(shared_from_this());
+                return;
+
+            case write_failed:
+                e = boost::asio::error::make_error_code(
+                    boost::asio::error::connection_aborted);
+                break;
+
+            default:
+                break;
+            }
+
+            complete_write(e);
+        }
+
+        void complete_write(boost::system::error_code e)
+        {
+            // just call initial handler
+            handler_(e);
+
+            postprocess_handler_type handler;
+            std::swap(handler, handler_);
+
+            if (threads::threadmanager_is(state_running))
+            {
+                // the handler needs to be reset on an HPX thread (it destroys
+                // the parcel, which in turn might invoke HPX functions)
+                threads::register_thread_nullary(util::deferred_call(
+                    &sender::reset_handler, std::move(handler)));
+            }
+            else
+            {
+                reset_handler(std::move(handler));
+            }
+
+            if (!e)
+            {
+                // complete data point and push back onto gatherer
+                buffer_.data_point_.time_ =
+                    timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+                pp_->add_sent_data(buffer_.data_point_);
+            }
+            pp_->release_send_buffer(buffer_.data_);
+            buffer_.clear();
+
+            // Call post-processing handler, which will send remaining pending
+            // parcels. Pass along the connection so it can be reused if more
+            // parcels have to be sent.
+            util::unique_function_nonser<
+                void(
+                    boost::system::error_code const&
+                  , parcelset::locality const&
+                  , std::shared_ptr<sender>
+                )
+            > postprocess_handler;
+            std::swap(postprocess_handler, postprocess_handler_);
+            postprocess_handler(e, there_, shared_from_this());
+        }
+
+        boost::asio::io_service& io_service_;
+
+        /// the segment of the receiving locality and the channel owned by
+        /// this connection
+        std::shared_ptr<segment> segment_;
+        std::size_t channel_;
+
+        /// the other (receiving) end of this connection
+        parcelset::locality there_;
+
+        /// Counters and their data containers.
+        util::high_resolution_timer timer_;
+        connection_handler* pp_;
+
+        /// the message currently being written
+        message_header header_;
+        std::vector<piece> pieces_;
+        std::size_t current_piece_;
+        std::size_t piece_offset_;
+
+        /// payload bytes of the message, and the ones already written
+        std::size_t total_;
+        std::size_t written_;
+
+        /// the room needed in the ring to write the next frame
+        std::size_t blocked_size_;
+
+        postprocess_handler_type handler_;
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+                , parcelset::locality const&
+                , std::shared_ptr<sender>
+                )
+        > postprocess_handler_;
+    };
+}}}}
+
+#endif
+
+#endif
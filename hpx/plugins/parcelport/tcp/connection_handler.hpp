@@ -17,6 +17,7 @@
 #include <hpx/config/asio.hpp>
 
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
+#include <hpx/runtime/parcelset/detail/receive_buffer_pool.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport_impl.hpp>
 #include <hpx/util_fwd.hpp>
@@ -25,6 +26,7 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -108,12 +110,19 @@ namespace hpx { namespace parcelset
 
             parcelset::locality create_locality() const;
 
+            /// Return the given receive buffer pool statistic
+            std::int64_t get_receive_buffer_pool_statistics(
+                receive_buffer_pool_statistics_type t, bool reset) override;
+
         private:
             void handle_accept(boost::system::error_code const & e,
                 std::shared_ptr<receiver> receiver_conn);
             void handle_read_completion(boost::system::error_code const& e,
                 std::shared_ptr<receiver> receiver_conn);
 
+            /// Pool of receive buffers shared by all incoming connections
+            std::shared_ptr<detail::receive_buffer_pool> receive_buffer_pool_;
+
             /// Acceptor used to listen for incoming connections.
             boost::asio::ip::tcp::acceptor* acceptor_;
 
@@ -24,6 +24,7 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/detail/receive_buffer_pool.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>
 #include <hpx/util/yield_while.hpp>
@@ -47,14 +48,25 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
     class connection_handler;
 
+    // Received data is stored in buffers drawn from a pool, their contents
+    // are not initialized before the data is read from the socket.
+    typedef std::vector<char, parcelset::detail::receive_buffer_allocator<char> >
+        receive_buffer_type;
+
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<receiver, receive_buffer_type,
+            receive_buffer_type>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
         receiver(boost::asio::io_service& io_service, std::uint64_t max_inbound_size,
+            std::shared_ptr<parcelset::detail::receive_buffer_pool> const& pool,
             connection_handler& parcelport)
-          : socket_(io_service)
+          : parcelport_connection<receiver, receive_buffer_type,
+                receive_buffer_type>(receive_buffer_type::allocator_type(
+                    std::make_shared<parcelset::detail::receive_buffer_cache>(
+                        pool)))
+          , socket_(io_service)
           , max_inbound_size_(max_inbound_size)
           , ack_(0)
           , parcelport_(parcelport)
@@ -254,12 +266,14 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                     static_cast<std::size_t>(
                         static_cast<std::uint32_t>(buffer_.num_chunks_.first));
 
-                buffer_.chunks_.resize(num_zero_copy_chunks);
+                buffer_.chunks_.clear();
+                buffer_.chunks_.reserve(num_zero_copy_chunks);
                 for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
                 {
                     std::size_t chunk_size = static_cast<std::size_t>(
                         buffer_.transmission_chunks_[i].second);
-                    buffer_.chunks_[i].resize(chunk_size);
+                    buffer_.chunks_.emplace_back(
+                        chunk_size, buffer_.data_.get_allocator());
                     buffers.push_back(
                         boost::asio::buffer(buffer_.chunks_[i].data(), chunk_size));
                 }
@@ -314,9 +328,12 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                         Handler)
                     = &receiver::handle_write_ack<Handler>;
 
-                // decode the received parcels.
+                // decode the received parcels, the buffers are given back to
+                // the pool once the parcels have been decoded
+                receive_buffer_type::allocator_type alloc =
+                    buffer_.data_.get_allocator();
                 decode_parcels(parcelport_, std::move(buffer_), -1);
-                buffer_ = parcel_buffer_type();
+                buffer_ = parcel_buffer_type(alloc);
 
                 ack_ = true;
                 {
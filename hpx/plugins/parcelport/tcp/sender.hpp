@@ -241,6 +241,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
+            pp_->release_send_buffer(buffer_.data_);
             buffer_.clear();
             // Call post-processing handler, which will send remaining pending
             // parcels. Pass along the connection so it can be reused if more
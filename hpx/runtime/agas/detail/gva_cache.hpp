@@ -0,0 +1,283 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_GVA_CACHE_HPP)
+#define HPX_AGAS_DETAIL_GVA_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/functional/function.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Key of the GVA cache, a range of (stripped) global ids. Two keys compare
+    // equivalent if their ranges overlap.
+    struct gva_cache_key
+    {
+    private:
+        typedef std::pair<naming::gid_type, naming::gid_type> key_type;
+
+        key_type key_;
+
+    public:
+        gva_cache_key()
+          : key_()
+        {
+        }
+
+        explicit gva_cache_key(
+                naming::gid_type const& id, std::uint64_t count = 1)
+          : key_(naming::detail::get_stripped_gid(id),
+                naming::detail::get_stripped_gid(id) + (count - 1))
+        {
+            HPX_ASSERT(count);
+        }
+
+        naming::gid_type get_gid() const
+        {
+            return key_.first;
+        }
+
+        naming::gid_type const& get_last_gid() const
+        {
+            return key_.second;
+        }
+
+        std::uint64_t get_count() const
+        {
+            naming::gid_type const size = key_.second - key_.first;
+            HPX_ASSERT(size.get_msb() == 0);
+            return size.get_lsb();
+        }
+
+        friend bool operator<(
+            gva_cache_key const& lhs, gva_cache_key const& rhs)
+        {
+            return lhs.key_.second < rhs.key_.first;
+        }
+
+        friend bool operator==(
+            gva_cache_key const& lhs, gva_cache_key const& rhs)
+        {
+            // Direct hit
+            if (lhs.key_ == rhs.key_)
+            {
+                return true;
+            }
+
+            // Is lhs in rhs?
+            if (1 == lhs.get_count() && 1 != rhs.get_count())
+            {
+                return rhs.key_.first <= lhs.key_.first &&
+                    lhs.key_.second <= rhs.key_.second;
+            }
+
+            // Is rhs in lhs?
+            else if (1 != lhs.get_count() && 1 == rhs.get_count())
+            {
+                return lhs.key_.first <= rhs.key_.first &&
+                    rhs.key_.second <= lhs.key_.second;
+            }
+
+            return false;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Concurrent cache mapping global id ranges to their GVAs.
+    //
+    // The cache is split into a power-of-two number of shards. Global ids are
+    // assigned to shards in blocks of 2^shard_block_bits consecutive ids. A
+    // key covering ids of more than one block is stored in one of the same
+    // number of range shards instead, which are assigned to blocks of
+    // 2^range_block_bits ids the same way. The few keys covering more than
+    // one of those larger blocks are stored in a single spanning shard. A
+    // lookup missing in the regular shard of an id consults the range shard
+    // of the id and, if it holds any entries, the spanning shard. Every entry
+    // is therefore stored exactly once.
+    //
+    // Each shard is protected by its own readers/writer spinlock, so lookups
+    // of different objects run in parallel and never contend on a global
+    // lock. Writers take precedence over readers arriving after them.
+    //
+    // Instead of a strict LRU order, which would require every lookup to
+    // modify a shared list, each shard implements the CLOCK algorithm: a hit
+    // sets the reference bit of the entry and eviction sweeps over the slots
+    // of the shard, giving entries referenced since the last sweep a second
+    // chance.
+    class HPX_EXPORT gva_cache
+    {
+    public:
+        typedef gva_cache_key key_type;
+        typedef gva entry_type;
+        typedef std::pair<key_type, entry_type> entry_pair;
+
+        // returns true if the new key (first argument) collides with the key
+        // already stored in the cache (second argument)
+        typedef util::function_nonser<bool(key_type const&, key_type const&)>
+            collision_function_type;
+
+        typedef util::function_nonser<bool(entry_pair const&)>
+            erase_function_type;
+
+        static constexpr std::size_t shard_block_bits = 4;
+        static constexpr std::size_t range_block_bits = 16;
+        static constexpr std::size_t max_num_shards = 64;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Thread-safe counterpart of local_full_statistics
+        class statistics
+        {
+        public:
+            enum method
+            {
+                method_get_entry = 0,
+                method_insert_entry = 1,
+                method_update_entry = 2,
+                method_erase_entry = 3,
+                num_methods = 4
+            };
+
+            // Helper class to update timings and counts on function exit
+            struct update_on_exit
+            {
+                update_on_exit(statistics& stat, method m);
+                ~update_on_exit();
+
+                std::uint64_t started_at_;
+                statistics& stat_;
+                method m_;
+            };
+
+            statistics();
+
+            void got_hit() { ++hits_; }
+            void got_miss() { ++misses_; }
+            void got_insertion() { ++insertions_; }
+            void got_eviction() { ++evictions_; }
+
+            std::size_t hits(bool reset);
+            std::size_t misses(bool reset);
+            std::size_t insertions(bool reset);
+            std::size_t evictions(bool reset);
+
+            std::int64_t get_get_entry_count(bool reset);
+            std::int64_t get_insert_entry_count(bool reset);
+            std::int64_t get_update_entry_count(bool reset);
+            std::int64_t get_erase_entry_count(bool reset);
+
+            std::int64_t get_get_entry_time(bool reset);
+            std::int64_t get_insert_entry_time(bool reset);
+            std::int64_t get_update_entry_time(bool reset);
+            std::int64_t get_erase_entry_time(bool reset);
+
+        private:
+            std::atomic<std::size_t> hits_;
+            std::atomic<std::size_t> misses_;
+            std::atomic<std::size_t> insertions_;
+            std::atomic<std::size_t> evictions_;
+
+            std::atomic<std::int64_t> counts_[num_methods];
+            std::atomic<std::int64_t> times_[num_methods];
+        };
+
+        // num_shards == 0 selects the number of shards based on the number
+        // of cores of this machine
+        explicit gva_cache(std::size_t num_shards = 0);
+        ~gva_cache();
+
+        gva_cache(gva_cache const&) = delete;
+        gva_cache& operator=(gva_cache const&) = delete;
+
+        // set the overall capacity, distributed evenly over all shards
+        // (including the range shards and the spanning shard)
+        void reserve(std::size_t max_size);
+
+        std::size_t capacity() const;
+        std::size_t size() const;
+
+        std::size_t num_shards() const
+        {
+            return num_shards_;
+        }
+
+        // Look up the entry covering the given key, marks it as recently
+        // used.
+        bool get_entry(
+            key_type const& key, key_type& realkey, entry_type& entry);
+
+        bool get_entry(key_type const& key, entry_type& entry)
+        {
+            key_type tmp;
+            return get_entry(key, tmp, entry);
+        }
+
+        // Insert a new entry, returns false if an overlapping key is already
+        // stored.
+        bool insert(key_type const& key, entry_type const& entry);
+
+        // Update the entry for the given key or insert it if it's not in the
+        // cache yet. Returns false (and does not modify the cache) if f
+        // reports a collision with an existing key, in which case that key
+        // is returned in collision.
+        bool update_if(key_type const& key, entry_type const& entry,
+            collision_function_type const& f, key_type& collision);
+
+        // Remove all entries for which f returns true, returns the number of
+        // removed entries.
+        std::size_t erase(erase_function_type const& f);
+
+        // Remove all entries, returns the number of removed entries.
+        std::size_t clear();
+
+        statistics& get_statistics()
+        {
+            return statistics_;
+        }
+
+    private:
+        struct shard;
+
+        std::size_t get_shard(naming::gid_type const& id) const;
+        std::size_t get_range_shard(naming::gid_type const& id) const;
+
+        std::size_t total_shards() const
+        {
+            return 2 * num_shards_ + 1;
+        }
+
+        // fill shards with the (sorted, unique) indices of the shards which
+        // may hold entries overlapping with the given key (the spanning
+        // shard always being the last one), returns their number. target is
+        // set to the index of the shard the key itself has to be stored in.
+        std::size_t get_shards(key_type const& key, std::size_t* shards,
+            std::size_t& target) const;
+
+        std::size_t num_shards_;
+        std::size_t num_shards_log2_;
+
+        // num_shards_ regular shards followed by num_shards_ range shards and
+        // the spanning shard
+        std::unique_ptr<shard[]> shards_;
+
+        statistics statistics_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
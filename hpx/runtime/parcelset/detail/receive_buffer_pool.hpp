@@ -0,0 +1,432 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_DETAIL_RECEIVE_BUFFER_POOL_HPP
+#define HPX_PARCELSET_DETAIL_RECEIVE_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/spinlock.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#if defined(HPX_MSVC)
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A pool of page aligned memory blocks to be used as receive buffers by
+    // the parcelports. Blocks are handed out in power-of-two size classes and
+    // are kept on per size class free lists once they are released. This
+    // avoids going back to the system allocator (and touching fresh pages)
+    // for every received message. The number of bytes kept by the pool is
+    // bounded, large blocks are given back to the system right away.
+    class receive_buffer_pool
+    {
+        typedef hpx::util::spinlock mutex_type;
+
+    public:
+        static constexpr std::size_t page_size = 4096;
+
+        // blocks between 4kB and 16MB are cached, larger blocks are always
+        // allocated from (and returned to) the system
+        static constexpr std::size_t min_size_class_log2 = 12;
+        static constexpr std::size_t num_size_classes = 13;
+
+        // maximum number of free blocks kept per size class
+        static constexpr std::size_t max_free_blocks = 16;
+
+        // maximum number of bytes kept by the pool overall, including the
+        // blocks held by the per-connection caches
+        static constexpr std::size_t max_cached_bytes =
+            std::size_t(256) * 1024 * 1024;
+
+        receive_buffer_pool()
+          : hits_(0)
+          , misses_(0)
+          , cached_bytes_(0)
+        {}
+
+        ~receive_buffer_pool()
+        {
+            for (std::size_t i = 0; i != num_size_classes; ++i)
+            {
+                for (void* p : buckets_[i].free_)
+                    free_block(p);
+            }
+        }
+
+        receive_buffer_pool(receive_buffer_pool const&) = delete;
+        receive_buffer_pool& operator=(receive_buffer_pool const&) = delete;
+
+        // return the size class for a block of the given size, returns
+        // num_size_classes if blocks of this size are not cached
+        static std::size_t size_class(std::size_t size) noexcept
+        {
+            std::size_t cls = 0;
+            std::size_t block = std::size_t(1) << min_size_class_log2;
+            while (block < size && cls != num_size_classes)
+            {
+                block <<= 1;
+                ++cls;
+            }
+            return cls;
+        }
+
+        static std::size_t block_size(std::size_t size) noexcept
+        {
+            std::size_t cls = size_class(size);
+            if (cls == num_size_classes)
+                return (size + page_size - 1) & ~(page_size - 1);
+            return std::size_t(1) << (cls + min_size_class_log2);
+        }
+
+        // retrieve a (non-initialized) block of at least the given size
+        void* allocate(std::size_t size)
+        {
+            std::size_t cls = size_class(size);
+            if (cls != num_size_classes)
+            {
+                void* p = nullptr;
+                if (buckets_[cls].pop(p))
+                {
+                    release_bytes(block_size(size));
+                    ++hits_;
+                    return p;
+                }
+            }
+
+            ++misses_;
+            return allocate_block(block_size(size));
+        }
+
+        // give a block back to the pool
+        void deallocate(void* p, std::size_t size) noexcept
+        {
+            std::size_t cls = size_class(size);
+            if (cls == num_size_classes)
+            {
+                free_block(p);
+                return;
+            }
+
+            std::size_t const bytes = block_size(size);
+            if (!reserve_bytes(bytes))
+            {
+                free_block(p);
+                return;
+            }
+
+            if (!buckets_[cls].push(p))
+            {
+                release_bytes(bytes);
+                free_block(p);
+            }
+        }
+
+        // account for the given number of bytes to be cached, fails if this
+        // would exceed the overall limit
+        bool reserve_bytes(std::size_t bytes) noexcept
+        {
+            std::size_t cached = cached_bytes_.load(std::memory_order_relaxed);
+            do
+            {
+                if (cached + bytes > max_cached_bytes)
+                    return false;
+            } while (!cached_bytes_.compare_exchange_weak(
+                cached, cached + bytes, std::memory_order_relaxed));
+            return true;
+        }
+
+        void release_bytes(std::size_t bytes) noexcept
+        {
+            cached_bytes_ -= bytes;
+        }
+
+        // account for an allocation which was served by a per-connection
+        // cache sitting in front of this pool
+        void count_hit() noexcept
+        {
+            ++hits_;
+        }
+
+        std::int64_t get_hits(bool reset)
+        {
+            return static_cast<std::int64_t>(
+                util::get_and_reset_value(hits_, reset));
+        }
+
+        std::int64_t get_misses(bool reset)
+        {
+            return static_cast<std::int64_t>(
+                util::get_and_reset_value(misses_, reset));
+        }
+
+        // number of bytes currently held by the pool and the caches in front
+        // of it
+        std::int64_t get_occupancy() const
+        {
+            return static_cast<std::int64_t>(cached_bytes_.load());
+        }
+
+    private:
+        static void* allocate_block(std::size_t size)
+        {
+#if defined(HPX_MSVC)
+            void* p = _aligned_malloc(size, page_size);
+            if (p == nullptr)
+                throw std::bad_alloc();
+#else
+            void* p = nullptr;
+            if (posix_memalign(&p, page_size, size) != 0)
+                throw std::bad_alloc();
+#endif
+            return p;
+        }
+
+        static void free_block(void* p) noexcept
+        {
+#if defined(HPX_MSVC)
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+
+        struct bucket
+        {
+            bucket()
+            {
+                free_.reserve(max_free_blocks);
+            }
+
+            bool pop(void*& p)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (free_.empty())
+                    return false;
+                p = free_.back();
+                free_.pop_back();
+                return true;
+            }
+
+            bool push(void* p) noexcept
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (free_.size() == max_free_blocks)
+                    return false;
+                free_.push_back(p);
+                return true;
+            }
+
+            mutex_type mtx_;
+            std::vector<void*> free_;
+        };
+
+        std::array<bucket, num_size_classes> buckets_;
+
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::size_t> cached_bytes_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A small per-connection cache of receive buffers in front of the shared
+    // pool. A connection receives one message after the other, so most of the
+    // time the blocks used for the previous message can be reused directly.
+    // Only small blocks are kept, they are accounted for by the shared pool.
+    class receive_buffer_cache
+    {
+        typedef hpx::util::spinlock mutex_type;
+
+        static constexpr std::size_t num_slots = 4;
+
+        // larger blocks are handed to the shared pool right away
+        static constexpr std::size_t max_block_size = 1024 * 1024;
+
+        struct slot
+        {
+            void* data_;
+            std::size_t size_class_;
+        };
+
+    public:
+        explicit receive_buffer_cache(
+                std::shared_ptr<receive_buffer_pool> pool)
+          : pool_(std::move(pool))
+        {
+            for (slot& s : slots_)
+                s = slot{nullptr, 0};
+        }
+
+        ~receive_buffer_cache()
+        {
+            for (slot& s : slots_)
+            {
+                if (s.data_ != nullptr)
+                {
+                    std::size_t const bytes = std::size_t(1)
+                        << (s.size_class_ +
+                               receive_buffer_pool::min_size_class_log2);
+                    pool_->release_bytes(bytes);
+                    pool_->deallocate(s.data_, bytes);
+                }
+            }
+        }
+
+        receive_buffer_cache(receive_buffer_cache const&) = delete;
+        receive_buffer_cache& operator=(receive_buffer_cache const&) = delete;
+
+        void* allocate(std::size_t size)
+        {
+            if (receive_buffer_pool::block_size(size) <= max_block_size)
+            {
+                std::size_t cls = receive_buffer_pool::size_class(size);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                for (slot& s : slots_)
+                {
+                    if (s.data_ != nullptr && s.size_class_ == cls)
+                    {
+                        void* p = s.data_;
+                        s.data_ = nullptr;
+                        pool_->release_bytes(
+                            receive_buffer_pool::block_size(size));
+                        pool_->count_hit();
+                        return p;
+                    }
+                }
+            }
+            return pool_->allocate(size);
+        }
+
+        void deallocate(void* p, std::size_t size) noexcept
+        {
+            std::size_t const bytes = receive_buffer_pool::block_size(size);
+            if (bytes <= max_block_size)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (slot& s : slots_)
+                {
+                    if (s.data_ == nullptr)
+                    {
+                        if (!pool_->reserve_bytes(bytes))
+                            break;
+
+                        s = slot{p, receive_buffer_pool::size_class(size)};
+                        return;
+                    }
+                }
+            }
+            pool_->deallocate(p, size);
+        }
+
+    private:
+        std::shared_ptr<receive_buffer_pool> pool_;
+
+        mutex_type mtx_;
+        std::array<slot, num_slots> slots_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Allocator drawing its memory from a receive_buffer_cache. Elements are
+    // default-initialized instead of value-initialized, resizing a buffer
+    // before receiving data into it does not touch the memory.
+    template <typename T>
+    class receive_buffer_allocator
+    {
+    public:
+        typedef T value_type;
+
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef receive_buffer_allocator<U> other;
+        };
+
+        receive_buffer_allocator() noexcept = default;
+
+        explicit receive_buffer_allocator(
+                std::shared_ptr<receive_buffer_cache> cache) noexcept
+          : cache_(std::move(cache))
+        {}
+
+        template <typename U>
+        receive_buffer_allocator(
+                receive_buffer_allocator<U> const& rhs) noexcept
+          : cache_(rhs.cache())
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            if (!cache_)
+                return std::allocator<T>().allocate(n);
+            return static_cast<T*>(cache_->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (!cache_)
+                std::allocator<T>().deallocate(p, n);
+            else
+                cache_->deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        void construct(U* p) noexcept(
+            std::is_nothrow_default_constructible<U>::value)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template <typename U, typename... Ts>
+        void construct(U* p, Ts&&... ts)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<Ts>(ts)...);
+        }
+
+        std::shared_ptr<receive_buffer_cache> const& cache() const noexcept
+        {
+            return cache_;
+        }
+
+        template <typename U>
+        friend bool operator==(receive_buffer_allocator const& lhs,
+            receive_buffer_allocator<U> const& rhs) noexcept
+        {
+            return lhs.cache_ == rhs.cache();
+        }
+
+        template <typename U>
+        friend bool operator!=(receive_buffer_allocator const& lhs,
+            receive_buffer_allocator<U> const& rhs) noexcept
+        {
+            return lhs.cache_ != rhs.cache();
+        }
+
+    private:
+        std::shared_ptr<receive_buffer_cache> cache_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,211 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_DETAIL_SEND_BUFFER_POOL_HPP
+#define HPX_PARCELSET_DETAIL_SEND_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concurrency/spinlock.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A pool of buffers used by the parcelports to serialize outgoing
+    // messages into. Buffers are handed out in power-of-two size classes and
+    // are put back once the write operation using them has completed. The
+    // buffers are never given back to the system allocator while they are
+    // cached, their pages stay mapped (and faulted in) from one message to
+    // the next.
+    class send_buffer_pool
+    {
+        typedef hpx::util::spinlock mutex_type;
+
+    public:
+        typedef std::vector<char> buffer_type;
+
+        // buffers between 4kB and 256MB are cached, larger buffers are
+        // always allocated from (and returned to) the system
+        static constexpr std::size_t min_size_class_log2 = 12;
+        static constexpr std::size_t num_size_classes = 17;
+
+        // maximum number of free buffers kept per size class
+        static constexpr std::size_t max_free_buffers = 16;
+
+        // maximum number of bytes kept by the pool overall
+        static constexpr std::size_t max_cached_bytes =
+            std::size_t(256) * 1024 * 1024;
+
+        send_buffer_pool()
+          : hits_(0)
+          , misses_(0)
+          , cached_bytes_(0)
+        {}
+
+        send_buffer_pool(send_buffer_pool const&) = delete;
+        send_buffer_pool& operator=(send_buffer_pool const&) = delete;
+
+        // return the smallest size class holding buffers of at least the
+        // given size, returns num_size_classes if buffers of this size are
+        // not cached
+        static std::size_t size_class(std::size_t size) noexcept
+        {
+            std::size_t cls = 0;
+            std::size_t block = std::size_t(1) << min_size_class_log2;
+            while (block < size && cls != num_size_classes)
+            {
+                block <<= 1;
+                ++cls;
+            }
+            return cls;
+        }
+
+        static std::size_t block_size(std::size_t cls) noexcept
+        {
+            return std::size_t(1) << (cls + min_size_class_log2);
+        }
+
+        // Make sure the given (empty) buffer is able to hold at least size
+        // bytes without reallocating. The memory currently held by the
+        // buffer is given back to the pool if it is too small.
+        void acquire(buffer_type& buffer, std::size_t size)
+        {
+            HPX_ASSERT(buffer.empty());
+            if (buffer.capacity() >= size)
+            {
+                ++hits_;
+                return;
+            }
+
+            release(buffer);
+
+            std::size_t cls = size_class(size);
+            if (cls == num_size_classes)
+            {
+                ++misses_;
+                buffer.reserve(size);
+                return;
+            }
+
+            if (buckets_[cls].pop(buffer))
+            {
+                cached_bytes_ -= buffer.capacity();
+                ++hits_;
+                return;
+            }
+
+            ++misses_;
+            buffer.reserve(block_size(cls));
+        }
+
+        // give the memory held by the given buffer back to the pool, the
+        // buffer is left empty (without any memory attached)
+        void release(buffer_type& buffer) noexcept
+        {
+            std::size_t capacity = buffer.capacity();
+            if (capacity < block_size(0))
+            {
+                buffer_type().swap(buffer);
+                return;
+            }
+
+            // buffers are stored in the largest size class they can satisfy
+            std::size_t cls = size_class(capacity);
+            if (cls == num_size_classes || block_size(cls) > capacity)
+                --cls;
+
+            buffer.clear();
+            if (reserve_bytes(capacity))
+            {
+                if (!buckets_[cls].push(buffer))
+                    cached_bytes_ -= capacity;
+            }
+            buffer_type().swap(buffer);
+        }
+
+        std::int64_t get_hits(bool reset)
+        {
+            return static_cast<std::int64_t>(
+                util::get_and_reset_value(hits_, reset));
+        }
+
+        std::int64_t get_misses(bool reset)
+        {
+            return static_cast<std::int64_t>(
+                util::get_and_reset_value(misses_, reset));
+        }
+
+        // number of bytes currently held by the pool
+        std::int64_t get_occupancy() const
+        {
+            return static_cast<std::int64_t>(cached_bytes_.load());
+        }
+
+    private:
+        // account for the given number of bytes to be cached by the pool,
+        // fails if this would exceed the overall limit
+        bool reserve_bytes(std::size_t bytes) noexcept
+        {
+            std::size_t cached = cached_bytes_.load(std::memory_order_relaxed);
+            do
+            {
+                if (cached + bytes > max_cached_bytes)
+                    return false;
+            } while (!cached_bytes_.compare_exchange_weak(
+                cached, cached + bytes, std::memory_order_relaxed));
+            return true;
+        }
+
+        struct bucket
+        {
+            bucket()
+            {
+                free_.reserve(max_free_buffers);
+            }
+
+            bool pop(buffer_type& buffer)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (free_.empty())
+                    return false;
+                free_.back().swap(buffer);
+                free_.pop_back();
+                return true;
+            }
+
+            // moves the memory of the given buffer into the bucket, leaves
+            // the buffer untouched if the bucket is full
+            bool push(buffer_type& buffer) noexcept
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (free_.size() == max_free_buffers)
+                    return false;
+                free_.emplace_back(std::move(buffer));
+                return true;
+            }
+
+            mutex_type mtx_;
+            std::vector<buffer_type> free_;
+        };
+
+        std::array<bucket, num_size_classes> buckets_;
+
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::size_t> cached_bytes_;
+    };
+}}}
+
+#endif
@@ -81,6 +81,22 @@ namespace hpx
                 return result;
             }
 
+            // preallocate the buffer the parcels are serialized into, plain
+            // std::vector<char> buffers are taken from the pool of send
+            // buffers of the parcelport
+            template <typename BufferType>
+            void reserve_send_buffer(
+                parcelport&, BufferType& data, std::size_t size)
+            {
+                data.reserve(size);
+            }
+
+            inline void reserve_send_buffer(
+                parcelport& pp, std::vector<char>& data, std::size_t size)
+            {
+                pp.acquire_send_buffer(data, size);
+            }
+
             template <typename Buffer>
             void encode_finalize(Buffer & buffer, std::size_t arg_size)
             {
@@ -169,7 +185,7 @@ namespace hpx
                         num_chunks += ps[parcels_sent].num_chunks();
                     }
 
-                    buffer.data_.reserve(arg_size);
+                    detail::reserve_send_buffer(pp, buffer.data_, arg_size);
 
                     buffer.chunks_.reserve(num_chunks);
 
@@ -183,7 +199,8 @@ namespace hpx
 
                         serialization::output_archive archive(
                             buffer.data_, archive_flags, &buffer.chunks_,
-                            filter.get());
+                            filter.get(),
+                            pp.get_zero_copy_serialization_threshold());
 
                         if (num_parcels != std::size_t(-1))
                             archive << parcels_sent; //-V128
@@ -21,10 +21,12 @@
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/applier_fwd.hpp>
 #include <hpx/runtime/parcelset/detail/per_action_data_counter.hpp>
+#include <hpx/runtime/parcelset/detail/send_buffer_pool.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -182,6 +184,48 @@ namespace hpx { namespace parcelset
         virtual std::int64_t get_connection_cache_statistics(
             connection_cache_statistics_type, bool reset) = 0;
 
+        /// Return the given receive buffer pool statistic
+        enum receive_buffer_pool_statistics_type
+        {
+            receive_buffer_pool_hits = 0,
+            receive_buffer_pool_misses = 1
+        };
+
+        // retrieve performance counter value for given statistics type,
+        // parcelports which don't pool their receive buffers report zero
+        virtual std::int64_t get_receive_buffer_pool_statistics(
+            receive_buffer_pool_statistics_type, bool /*reset*/)
+        {
+            return 0;
+        }
+
+        /// Return the given send buffer pool statistic
+        enum send_buffer_pool_statistics_type
+        {
+            send_buffer_pool_hits = 0,
+            send_buffer_pool_misses = 1,
+            send_buffer_pool_occupancy = 2
+        };
+
+        // retrieve performance counter value for given statistics type
+        std::int64_t get_send_buffer_pool_statistics(
+            send_buffer_pool_statistics_type, bool reset);
+
+        /// Make sure the given send buffer can hold at least size bytes,
+        /// the memory is taken from the pool of send buffers
+        void acquire_send_buffer(std::vector<char>& buffer, std::size_t size)
+        {
+            send_buffer_pool_.acquire(buffer, size);
+        }
+
+        /// Give the memory held by the given send buffer back to the pool of
+        /// send buffers, this should be called once the write operation
+        /// using the buffer has completed
+        void release_send_buffer(std::vector<char>& buffer) noexcept
+        {
+            send_buffer_pool_.release(buffer);
+        }
+
         /// Return the name of this locality
         virtual std::string get_locality_name() const = 0;
 
@@ -320,6 +364,20 @@ namespace hpx { namespace parcelset
             return allow_zero_copy_optimizations_;
         }
 
+        /// Return whether integers should be serialized using a variable
+        /// length encoding
+        bool allow_integer_compression() const
+        {
+            return allow_integer_compression_;
+        }
+
+        /// Return the minimal size of data to be sent as a separate
+        /// (zero-copy) chunk
+        std::size_t get_zero_copy_serialization_threshold() const
+        {
+            return zero_copy_serialization_threshold_;
+        }
+
         bool async_serialization() const
         {
             return async_serialization_;
@@ -335,11 +393,25 @@ namespace hpx { namespace parcelset
 
         hpx::applier::applier *applier_;
 
+        /// Pending parcels are kept in separate lanes for each destination,
+        /// parcels in the high priority lane are sent before the others
+        enum parcel_lane
+        {
+            parcel_lane_high_priority = 0,
+            parcel_lane_normal_priority = 1,
+            num_parcel_lanes = 2
+        };
+
+        /// Return the lane the given parcel should be queued in
+        parcel_lane get_parcel_lane(parcel const& p) const;
+
         /// The cache for pending parcels
         typedef util::tuple<
             std::vector<parcel>
           , std::vector<write_handler_type>
-        > map_second_type;
+        > pending_parcels_lane;
+        typedef std::array<pending_parcels_lane, num_parcel_lanes>
+            map_second_type;
         typedef std::map<locality, map_second_type> pending_parcels_map;
         pending_parcels_map pending_parcels_;
 
@@ -354,6 +426,12 @@ namespace hpx { namespace parcelset
         std::int64_t const max_inbound_message_size_;
         std::int64_t const max_outbound_message_size_;
 
+        /// Parcels up to this size are sent through the high priority lane
+        std::size_t const priority_message_size_;
+
+        /// Buffers outgoing messages are serialized into
+        detail::send_buffer_pool send_buffer_pool_;
+
         /// Overall parcel statistics
         performance_counters::parcels::gatherer parcels_sent_;
         performance_counters::parcels::gatherer parcels_received_;
@@ -367,6 +445,8 @@ namespace hpx { namespace parcelset
         /// serialization is allowed to use array optimization
         bool allow_array_optimizations_;
         bool allow_zero_copy_optimizations_;
+        bool allow_integer_compression_;
+        std::size_t zero_copy_serialization_threshold_;
 
         /// async serialization of parcels
         bool async_serialization_;
@@ -143,6 +143,9 @@ namespace hpx { namespace parcelset
                 if (!this->allow_zero_copy_optimizations())
                     archive_flags_ |= serialization::disable_data_chunking;
             }
+
+            if (this->allow_integer_compression())
+                archive_flags_ |= serialization::enable_integer_compression;
         }
 
         ~parcelport_impl() override
@@ -616,8 +619,6 @@ namespace hpx { namespace parcelset
         void enqueue_parcel(locality const& locality_id,
             parcel&& p, write_handler_type&& f)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
             std::unique_lock<lcos::local::spinlock> l(mtx_);
             // We ignore the lock here. It might happen that while enqueuing,
             // we need to acquire a lock. This should not cause any problems
@@ -626,20 +627,19 @@ namespace hpx { namespace parcelset
                 std::unique_lock<lcos::local::spinlock>
             > il(&l);
 
-            mapped_type& e = pending_parcels_[locality_id];
+            pending_parcels_lane& e =
+                pending_parcels_[locality_id][get_parcel_lane(p)];
             util::get<0>(e).push_back(std::move(p));
             util::get<1>(e).push_back(std::move(f));
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            if (parcel_destinations_.insert(locality_id).second)
+                ++num_parcel_destinations_;
         }
 
         void enqueue_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
             std::unique_lock<lcos::local::spinlock> l(mtx_);
             // We ignore the lock here. It might happen that while enqueuing,
             // we need to acquire a lock. This should not cause any problems
@@ -650,33 +650,79 @@ namespace hpx { namespace parcelset
 
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-            if (util::get<0>(e).empty())
+            pending_parcels_map::mapped_type& lanes =
+                pending_parcels_[locality_id];
+
+            // all parcels usually go into the same lane
+            bool same_lane = true;
+            parcel_lane lane = parcel_lane_normal_priority;
+            if (!parcels.empty())
+            {
+                lane = get_parcel_lane(parcels[0]);
+                for (std::size_t i = 1; i != parcels.size(); ++i)
+                {
+                    if (get_parcel_lane(parcels[i]) != lane)
+                    {
+                        same_lane = false;
+                        break;
+                    }
+                }
+            }
+
+            if (same_lane)
             {
-                HPX_ASSERT(util::get<1>(e).empty());
-                std::swap(util::get<0>(e), parcels);
-                std::swap(util::get<1>(e), handlers);
+                pending_parcels_lane& e = lanes[lane];
+                if (util::get<0>(e).empty())
+                {
+                    HPX_ASSERT(util::get<1>(e).empty());
+                    std::swap(util::get<0>(e), parcels);
+                    std::swap(util::get<1>(e), handlers);
+                }
+                else
+                {
+                    HPX_ASSERT(
+                        util::get<0>(e).size() == util::get<1>(e).size());
+                    std::size_t new_size =
+                        util::get<0>(e).size() + parcels.size();
+                    util::get<0>(e).reserve(new_size);
+
+                    std::move(parcels.begin(), parcels.end(),
+                        std::back_inserter(util::get<0>(e)));
+                    util::get<1>(e).reserve(new_size);
+                    std::move(handlers.begin(), handlers.end(),
+                        std::back_inserter(util::get<1>(e)));
+                }
             }
             else
             {
-                HPX_ASSERT(util::get<0>(e).size() == util::get<1>(e).size());
-                std::size_t new_size = util::get<0>(e).size() + parcels.size();
-                util::get<0>(e).reserve(new_size);
-
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(util::get<0>(e)));
-                util::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(util::get<1>(e)));
+                for (std::size_t i = 0; i != parcels.size(); ++i)
+                {
+                    pending_parcels_lane& e =
+                        lanes[get_parcel_lane(parcels[i])];
+                    util::get<0>(e).push_back(std::move(parcels[i]));
+                    util::get<1>(e).push_back(std::move(handlers[i]));
+                }
             }
 
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            if (parcel_destinations_.insert(locality_id).second)
+                ++num_parcel_destinations_;
+        }
+
+        static bool has_pending_parcels(
+            pending_parcels_map::mapped_type const& lanes)
+        {
+            for (pending_parcels_lane const& e : lanes)
+            {
+                if (!util::get<0>(e).empty())
+                    return true;
+            }
+            return false;
         }
 
         bool dequeue_parcels(locality const& locality_id,
             std::vector<parcel>& parcels,
-            std::vector<write_handler_type>& handlers)
+            std::vector<write_handler_type>& handlers,
+            bool* more_pending = nullptr)
         {
             using iterator = pending_parcels_map::iterator;
 
@@ -689,28 +735,49 @@ namespace hpx { namespace parcelset
 
                 // do nothing if parcels have already been picked up by
                 // another thread
-                if (it != pending_parcels_.end() && !util::get<0>(it->second).empty())
+                if (it == pending_parcels_.end())
+                    return false;
+
+                // pick up the parcels from the first non-empty lane, the
+                // remaining lanes are handled by subsequent sends
+                bool found = false;
+                for (pending_parcels_lane& e : it->second)
                 {
+                    if (util::get<0>(e).empty())
+                    {
+                        HPX_ASSERT(util::get<1>(e).empty());
+                        continue;
+                    }
+
                     HPX_ASSERT(it->first == locality_id);
                     HPX_ASSERT(handlers.size() == 0);
                     HPX_ASSERT(handlers.size() == parcels.size());
-                    std::swap(parcels, util::get<0>(it->second));
-                    HPX_ASSERT(util::get<0>(it->second).size() == 0);
-                    std::swap(handlers, util::get<1>(it->second));
+                    std::swap(parcels, util::get<0>(e));
+                    HPX_ASSERT(util::get<0>(e).size() == 0);
+                    std::swap(handlers, util::get<1>(e));
                     HPX_ASSERT(handlers.size() == parcels.size());
 
                     HPX_ASSERT(!handlers.empty());
+                    found = true;
+                    break;
                 }
-                else
-                {
-                    HPX_ASSERT(util::get<1>(it->second).empty());
+
+                if (!found)
                     return false;
-                }
 
-                parcel_destinations_.erase(locality_id);
+                // the destination is accounted for only once, even if its
+                // parcels were spread over several lanes (or enqueued
+                // several times)
+                bool pending = has_pending_parcels(it->second);
+                if (!pending)
+                {
+                    parcel_destinations_.erase(locality_id);
 
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
+                    HPX_ASSERT(0 != num_parcel_destinations_.load());
+                    --num_parcel_destinations_;
+                }
+                if (more_pending != nullptr)
+                    *more_pending = pending;
 
                 return true;
             }
@@ -726,21 +793,24 @@ namespace hpx { namespace parcelset
 
                 for (auto &pending: pending_parcels_)
                 {
-                    auto &parcels = util::get<0>(pending.second);
-                    if (!parcels.empty())
+                    for (auto& lane : pending.second)
                     {
-                        auto& handlers = util::get<1>(pending.second);
-                        dest = pending.first;
-                        p = std::move(parcels.back());
-                        parcels.pop_back();
-                        handler = std::move(handlers.back());
-                        handlers.pop_back();
-
-                        if (parcels.empty())
+                        auto &parcels = util::get<0>(lane);
+                        if (!parcels.empty())
                         {
-                            pending_parcels_.erase(dest);
+                            auto& handlers = util::get<1>(lane);
+                            dest = pending.first;
+                            p = std::move(parcels.back());
+                            parcels.pop_back();
+                            handler = std::move(handlers.back());
+                            handlers.pop_back();
+
+                            if (!has_pending_parcels(pending.second))
+                            {
+                                pending_parcels_.erase(dest);
+                            }
+                            return true;
                         }
-                        return true;
                     }
                 }
             }
@@ -814,7 +884,8 @@ namespace hpx { namespace parcelset
             std::vector<parcel> parcels;
             std::vector<write_handler_type> handlers;
 
-            if(!dequeue_parcels(locality_id, parcels, handlers))
+            bool more_pending = false;
+            if(!dequeue_parcels(locality_id, parcels, handlers, &more_pending))
             {
                 // Give this connection back to the cache as we couldn't dequeue
                 // parcels.
@@ -829,6 +900,11 @@ namespace hpx { namespace parcelset
                 sender_connection, std::move(parcels),
                 std::move(handlers));
 
+            // parcels of a lower priority lane are still waiting, try to send
+            // those through another connection
+            if (more_pending)
+                get_connection_and_send_parcels(locality_id, background);
+
             // We yield here for a short amount of time to give another
             // HPX thread the chance to put a subsequent parcel which
             // leads to a more effective parcel buffering
@@ -863,8 +939,11 @@ namespace hpx { namespace parcelset
 
 //                HPX_ASSERT(locality_id == sender_connection->destination());
                 pending_parcels_map::iterator it = pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() || util::get<0>(it->second).empty())
+                if (it == pending_parcels_.end() ||
+                    !has_pending_parcels(it->second))
+                {
                     return;
+                }
             }
 
             // Create a new HPX thread which sends parcels that are still
@@ -101,6 +101,102 @@ namespace hpx { namespace threads { namespace detail
         // thread.
         scheduler->do_some_work(data.schedulehint.hint);
     }
+
+    // Create a batch of threads with a single call into the scheduler. All
+    // threads are created with the same initial state. The thread ids are not
+    // returned, which allows the scheduler to stage the whole batch at once.
+    inline void create_threads(
+        policies::scheduler_base* scheduler, thread_init_data* data,
+        std::size_t count, thread_state_enum initial_state = pending,
+        bool run_now = false, error_code& ec = throws)
+    {
+        // verify parameters
+        switch (initial_state) {
+        case pending:
+        case pending_do_not_schedule:
+        case pending_boost:
+        case suspended:
+            break;
+
+        default:
+            {
+                std::ostringstream strm;
+                strm << "invalid initial state: "
+                     << get_thread_state_name(initial_state);
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "threads::detail::create_threads",
+                    strm.str());
+                return;
+            }
+        }
+
+        if (count == 0)
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+        thread_self* self = get_self_ptr();
+        thread_priority parent_priority = thread_priority_default;
+        if (self)
+        {
+            parent_priority =
+                get_thread_id_data(threads::get_self_id())->get_priority();
+        }
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            thread_init_data& d = data[i];
+
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+            if (!d.description)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "threads::detail::create_threads",
+                    "description is nullptr");
+                return;
+            }
+#endif
+
+#ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
+            if (nullptr == d.parent_id) {
+                if (self)
+                {
+                    d.parent_id = threads::get_self_id();
+                    d.parent_phase = self->get_thread_phase();
+                }
+            }
+            if (0 == d.parent_locality_id)
+                d.parent_locality_id = get_locality_id();
+#endif
+
+            if (nullptr == d.scheduler_base)
+                d.scheduler_base = scheduler;
+
+            // Pass critical priority from parent to child (but only if there
+            // is none is explicitly specified).
+            if (d.priority == thread_priority_default &&
+                parent_priority == thread_priority_high_recursive)
+            {
+                d.priority = thread_priority_high_recursive;
+            }
+
+            if (d.priority == thread_priority_default)
+                d.priority = thread_priority_normal;
+        }
+
+        // create the new threads
+        scheduler->create_threads(data, count, initial_state, run_now, ec);
+
+        LTM_(info) << "register_threads(" << count << "): initial_state("
+                   << get_thread_state_name(initial_state) << "), "
+                   << "run_now(" << (run_now ? "true" : "false") << ")";
+
+        // the batch is spread over several queues, wake up one parked
+        // thread for each of the new threads
+        scheduler->wake_up_parked(count);
+    }
 }}}
 
 #endif
@@ -191,7 +191,7 @@ namespace hpx { namespace threads { namespace detail {
             sched_->Scheduler::set_all_states_at_least(state_stopping);
 
             // make sure we're not waiting
-            sched_->Scheduler::do_some_work(std::size_t(-1));
+            sched_->Scheduler::wake_up_parked(std::size_t(-1));
 
             if (blocking)
             {
@@ -204,7 +204,7 @@ namespace hpx { namespace threads { namespace detail {
                     // make sure no OS thread is waiting
                     LTM_(info) << "stop: " << id_.name() << " notify_all";
 
-                    sched_->Scheduler::do_some_work(std::size_t(-1));
+                    sched_->Scheduler::wake_up_parked(std::size_t(-1));
 
                     LTM_(info) << "stop: " << id_.name() << " join:" << i;
 
@@ -362,6 +362,9 @@ namespace hpx { namespace threads { namespace detail {
                 expected, state_pre_sleep);
         }
 
+        // parked threads have to notice the state change
+        sched_->Scheduler::wake_up_parked(std::size_t(-1));
+
         for (std::size_t i = 0; i != threads_.size(); ++i)
         {
             suspend_processing_unit_direct(i, ec);
@@ -610,6 +613,28 @@ namespace hpx { namespace threads { namespace detail {
         ++tasks_scheduled_;
     }
 
+    template <typename Scheduler>
+    void scheduled_thread_pool<Scheduler>::create_threads(
+        thread_init_data* data, std::size_t count,
+        thread_state_enum initial_state, bool run_now, error_code& ec)
+    {
+        // verify state
+        if (thread_count_ == 0 && !sched_->Scheduler::is_state(state_running))
+        {
+            // thread-manager is not currently running
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool<Scheduler>::create_threads",
+                "invalid state: thread pool is not running");
+            return;
+        }
+
+        detail::create_threads(
+            sched_.get(), data, count, initial_state, run_now, ec);
+
+        // update statistics
+        tasks_scheduled_ += static_cast<std::int64_t>(count);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Scheduler>
     thread_state scheduled_thread_pool<Scheduler>::set_state(
@@ -1984,6 +2009,9 @@ namespace hpx { namespace threads { namespace detail {
 
         l.unlock();
 
+        // a parked thread has to notice the state change
+        sched_->Scheduler::wake_up_parked(std::size_t(-1));
+
         HPX_ASSERT(expected == state_running || expected == state_pre_sleep ||
             expected == state_sleeping);
 
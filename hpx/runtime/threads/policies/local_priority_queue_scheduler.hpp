@@ -23,6 +23,7 @@
 #include <hpx/topology/topology.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cstddef>
@@ -567,6 +568,52 @@ namespace hpx { namespace threads { namespace policies {
                 data, id, initial_state, run_now, ec);
         }
 
+        // create a batch of new threads, batches of normal priority threads
+        // without placement hints are split into contiguous blocks which are
+        // handed to the queues round-robin
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, bool run_now,
+            error_code& ec) override
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                if (data[i].priority != thread_priority_normal ||
+                    data[i].schedulehint.mode ==
+                        thread_schedule_hint_mode_thread)
+                {
+                    scheduler_base::create_threads(
+                        data, count, initial_state, run_now, ec);
+                    return;
+                }
+            }
+
+            std::size_t const block_size =
+                (count + num_queues_ - 1) / num_queues_;
+
+            for (std::size_t first = 0; first < count; first += block_size)
+            {
+                std::size_t num_thread = curr_queue_++ % num_queues_;
+
+                std::unique_lock<pu_mutex_type> l;
+                num_thread = select_active_pu(l, num_thread);
+
+                std::size_t size = (std::min)(block_size, count - first);
+                for (std::size_t i = first; i != first + size; ++i)
+                {
+                    data[i].schedulehint.mode =
+                        thread_schedule_hint_mode_thread;
+                    data[i].schedulehint.hint =
+                        static_cast<std::int16_t>(num_thread);
+                }
+
+                HPX_ASSERT(num_thread < num_queues_);
+                queues_[num_thread].data_->create_threads(
+                    data + first, size, initial_state, run_now, ec);
+                if (ec)
+                    return;
+            }
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         bool get_next_thread(std::size_t num_thread, bool running,
@@ -23,6 +23,7 @@
 #include <hpx/topology/topology.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -325,6 +326,44 @@ namespace hpx { namespace threads { namespace policies {
                 data, id, initial_state, run_now, ec);
         }
 
+        // create a batch of new threads, batches without placement hints are
+        // split into contiguous blocks which are handed to the queues
+        // round-robin
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, bool run_now,
+            error_code& ec) override
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                if (data[i].schedulehint.mode ==
+                    thread_schedule_hint_mode_thread)
+                {
+                    scheduler_base::create_threads(
+                        data, count, initial_state, run_now, ec);
+                    return;
+                }
+            }
+
+            std::size_t queue_size = queues_.size();
+            std::size_t const block_size =
+                (count + queue_size - 1) / queue_size;
+
+            for (std::size_t first = 0; first < count; first += block_size)
+            {
+                std::size_t num_thread = curr_queue_++ % queue_size;
+
+                std::unique_lock<pu_mutex_type> l;
+                num_thread = select_active_pu(l, num_thread);
+
+                HPX_ASSERT(num_thread < queue_size);
+                queues_[num_thread]->create_threads(data + first,
+                    (std::min)(block_size, count - first), initial_state,
+                    run_now, ec);
+                if (ec)
+                    return;
+            }
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread, bool running,
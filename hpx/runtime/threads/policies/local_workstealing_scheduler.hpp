@@ -0,0 +1,194 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SCHEDULING_LOCAL_WORKSTEALING_HPP)
+#define HPX_THREADMANAGER_SCHEDULING_LOCAL_WORKSTEALING_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+#include <hpx/assertion.hpp>
+#include <hpx/affinity/affinity_data.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/runtime/threads/policies/local_queue_scheduler.hpp>
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/thread_queue.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The local_workstealing_scheduler maintains exactly one Chase-Lev
+    /// work-stealing deque per OS thread. The owning OS thread pushes and
+    /// pops its own work items at the bottom of the deque without atomic
+    /// read-modify-write operations, idle OS threads steal from the top of
+    /// the deques of randomly selected victims. Victims in the same NUMA
+    /// domain are always tried before victims in other NUMA domains.
+    template <typename Mutex = std::mutex,
+        typename PendingQueuing = lockfree_chase_lev,
+        typename StagedQueuing = lockfree_fifo,
+        typename TerminatedQueuing =
+            default_local_queue_scheduler_terminated_queue>
+    class HPX_EXPORT local_workstealing_scheduler
+      : public local_queue_scheduler<Mutex, PendingQueuing, StagedQueuing,
+            TerminatedQueuing>
+    {
+    public:
+        using base_type = local_queue_scheduler<Mutex, PendingQueuing,
+            StagedQueuing, TerminatedQueuing>;
+
+        using thread_queue_type = typename base_type::thread_queue_type;
+        using init_parameter_type = typename base_type::init_parameter_type;
+
+        local_workstealing_scheduler(init_parameter_type const& init,
+            bool deferred_initialization = true)
+          : base_type(init, deferred_initialization)
+          , victims_in_numa_domain_(init.num_queues_)
+          , victims_outside_numa_domain_(init.num_queues_)
+          , random_state_(init.num_queues_)
+        {
+        }
+
+        static std::string get_scheduler_name()
+        {
+            return "local_workstealing_scheduler";
+        }
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        bool get_next_thread(std::size_t num_thread, bool running,
+            threads::thread_data*& thrd, bool enable_stealing) override
+        {
+            HPX_ASSERT(num_thread < this->queues_.size());
+
+            {
+                thread_queue_type* q = this->queues_[num_thread];
+
+                // only the owner pops from the bottom of its deque
+                bool result = q->get_next_thread(thrd, false, false);
+
+                q->increment_num_pending_accesses();
+                if (result)
+                    return true;
+                q->increment_num_pending_misses();
+
+                // Give up, we should have work to convert.
+                if (q->get_staged_queue_length(std::memory_order_relaxed) != 0)
+                    return false;
+            }
+
+            if (!running || !enable_stealing)
+                return false;
+
+            if (steal_from(num_thread, victims_in_numa_domain_[num_thread],
+                    running, thrd))
+            {
+                return true;
+            }
+
+            return this->has_work_stealing_numa() &&
+                steal_from(num_thread,
+                    victims_outside_numa_domain_[num_thread], running, thrd);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void on_start_thread(std::size_t num_thread) override
+        {
+            base_type::on_start_thread(num_thread);
+
+            auto const& topo = create_topology();
+
+            std::size_t num_pu = this->affinity_data_.get_pu_num(num_thread);
+            mask_cref_type node_mask = topo.get_numa_node_affinity_mask(num_pu);
+
+            // pre-calculate the lists of possible victims for this thread
+            std::vector<std::size_t>& in_numa =
+                victims_in_numa_domain_[num_thread];
+            std::vector<std::size_t>& outside_numa =
+                victims_outside_numa_domain_[num_thread];
+
+            in_numa.clear();
+            outside_numa.clear();
+
+            std::size_t queues_size = this->queues_.size();
+            for (std::size_t i = 1; i != queues_size; ++i)
+            {
+                std::size_t const idx = (i + num_thread) % queues_size;
+                if (!any(node_mask) ||
+                    test(node_mask, this->affinity_data_.get_pu_num(idx)))
+                {
+                    in_numa.push_back(idx);
+                }
+                else
+                {
+                    outside_numa.push_back(idx);
+                }
+            }
+
+            // seed the victim selection, the state must never be zero
+            random_state_[num_thread].data_ =
+                0x9e3779b97f4a7c15ULL * (num_thread + 1);
+        }
+
+    protected:
+        // xorshift64* generator, used to pick the first victim
+        std::size_t next_random(std::size_t num_thread)
+        {
+            std::uint64_t& x = random_state_[num_thread].data_;
+            x ^= x >> 12;
+            x ^= x << 25;
+            x ^= x >> 27;
+            return std::size_t((x * 0x2545f4914f6cdd1dULL) >> 32);
+        }
+
+        // Try each of the given victims once, starting at a random position.
+        bool steal_from(std::size_t num_thread,
+            std::vector<std::size_t> const& victims, bool running,
+            threads::thread_data*& thrd)
+        {
+            std::size_t num_victims = victims.size();
+            if (num_victims == 0)
+                return false;
+
+            std::size_t start = next_random(num_thread) % num_victims;
+            for (std::size_t i = 0; i != num_victims; ++i)
+            {
+                std::size_t idx = victims[(start + i) % num_victims];
+                HPX_ASSERT(idx != num_thread);
+
+                thread_queue_type* q = this->queues_[idx];
+                if (q->get_next_thread(thrd, running, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    this->queues_[num_thread]
+                        ->increment_num_stolen_to_pending();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::vector<std::vector<std::size_t>> victims_in_numa_domain_;
+        std::vector<std::vector<std::size_t>> victims_outside_numa_domain_;
+        std::vector<util::cache_line_data<std::uint64_t>> random_state_;
+    };
+}}}    // namespace hpx::threads::policies
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
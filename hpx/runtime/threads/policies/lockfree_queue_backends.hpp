@@ -19,10 +19,13 @@
 #endif
 
 // Does not rely on CXX11_STD_ATOMIC_128BIT
+#include <hpx/concurrency/chase_lev_deque.hpp>
 #include <hpx/concurrency/concurrentqueue.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 #include <utility>
 
 namespace hpx { namespace threads { namespace policies {
@@ -139,6 +142,123 @@ namespace hpx { namespace threads { namespace policies {
         };
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Chase-Lev work-stealing deque. The OS thread owning the queue pushes and
+    // pops at the bottom end without any atomic read-modify-write operations,
+    // all other threads steal from the top end. Items pushed by threads other
+    // than the owner (or pushed to the other end) are routed through a
+    // multi-producer FIFO inbox which is drained once the deque runs empty.
+    //
+    // The owner is the OS thread which called on_start_thread() last, until
+    // no owner is registered all operations go through the inbox.
+    template <typename T>
+    struct lockfree_chase_lev_backend
+    {
+        using container_type = util::chase_lev_deque<T>;
+
+        using value_type = T;
+        using reference = T&;
+        using const_reference = T const&;
+        using size_type = std::uint64_t;
+
+        lockfree_chase_lev_backend(
+            size_type initial_size = 0, size_type num_thread = size_type(-1))
+          : deque_(std::size_t(initial_size))
+          , inbox_(initial_size, num_thread)
+          , owner_(std::thread::id())
+        {
+        }
+
+        bool push(const_reference val, bool other_end = false)
+        {
+            if (!other_end && is_owner())
+            {
+                deque_.push_bottom(val);
+                return true;
+            }
+            return inbox_.push(val);
+        }
+
+        bool pop(reference val, bool steal = true)
+        {
+            if (!steal && is_owner())
+            {
+                if (deque_.pop_bottom(val))
+                    return true;
+            }
+            else if (deque_.steal(val))
+            {
+                return true;
+            }
+            return inbox_.pop(val, steal);
+        }
+
+        bool empty()
+        {
+            return deque_.empty() && inbox_.empty();
+        }
+
+        void on_start_thread()
+        {
+            owner_.store(
+                std::this_thread::get_id(), std::memory_order_release);
+        }
+
+        void on_stop_thread()
+        {
+            owner_.store(std::thread::id(), std::memory_order_release);
+        }
+
+    private:
+        bool is_owner() const
+        {
+            return owner_.load(std::memory_order_relaxed) ==
+                std::this_thread::get_id();
+        }
+
+        container_type deque_;
+        lockfree_fifo_backend<T> inbox_;
+        std::atomic<std::thread::id> owner_;
+    };
+
+    struct lockfree_chase_lev
+    {
+        template <typename T>
+        struct apply
+        {
+            using type = lockfree_chase_lev_backend<T>;
+        };
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    namespace detail {
+        // Some backends need to know the OS thread they are associated with,
+        // forward the notifications to those which support it.
+        template <typename Backend>
+        auto on_start_thread(Backend& backend, int)
+            -> decltype(backend.on_start_thread())
+        {
+            return backend.on_start_thread();
+        }
+
+        template <typename Backend>
+        void on_start_thread(Backend&, long)
+        {
+        }
+
+        template <typename Backend>
+        auto on_stop_thread(Backend& backend, int)
+            -> decltype(backend.on_stop_thread())
+        {
+            return backend.on_stop_thread();
+        }
+
+        template <typename Backend>
+        void on_stop_thread(Backend&, long)
+        {
+        }
+    }    // namespace detail
+
 // LIFO
 #if defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
     struct lockfree_lifo;
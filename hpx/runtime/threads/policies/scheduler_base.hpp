@@ -87,6 +87,14 @@ namespace hpx { namespace threads { namespace policies {
         /// possibly idling OS threads
         void do_some_work(std::size_t);
 
+        /// Wake up at most the given number of parked OS threads, all of
+        /// them if count is std::size_t(-1) (used when the pool is stopped
+        /// or suspended)
+        void wake_up_parked(std::size_t count);
+
+        /// Return the number of currently parked OS threads
+        std::size_t get_num_parked() const;
+
         virtual void suspend(std::size_t num_thread);
         virtual void resume(std::size_t num_thread);
 
@@ -208,6 +216,11 @@ namespace hpx { namespace threads { namespace policies {
         virtual void create_thread(thread_init_data& data, thread_id_type* id,
             thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
 
+        // create a batch of threads, schedulers may override this to
+        // distribute the whole batch with fewer synchronization operations
+        virtual void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, bool run_now, error_code& ec);
+
         virtual bool get_next_thread(std::size_t num_thread, bool running,
             threads::thread_data*& thrd, bool enable_stealing) = 0;
 
@@ -285,10 +298,29 @@ namespace hpx { namespace threads { namespace policies {
         std::condition_variable cond_;
         struct idle_backoff_data
         {
-            std::uint32_t wait_count_;
-            double max_idle_backoff_time_;
+            std::uint32_t wait_count_ = 0;
+            double max_idle_backoff_time_ = 0;
+            std::int64_t max_idle_yield_count_ = 0;
+
+            // non-zero while the OS thread is parked, this is the word the
+            // OS thread waits on
+            std::atomic<std::uint32_t> parked_{0};
+
+            // NUMA domain of the OS thread, initialized on first use
+            std::atomic<std::size_t> domain_{std::size_t(-1)};
         };
         std::vector<util::cache_line_data<idle_backoff_data>> wait_counts_;
+
+        // number of currently parked OS threads
+        util::cache_line_data<std::atomic<std::size_t>> num_parked_;
+
+        // rotating start index for the search of a parked OS thread, this
+        // spreads the wake ups over all parked threads
+        util::cache_line_data<std::atomic<std::size_t>> next_parked_;
+
+        std::size_t next_parked_index();
+        bool wake_parked(std::size_t num_thread);
+        bool wake_parked_in_domain(std::size_t domain, std::size_t skip);
 #endif
 
         // support for suspension of pus
@@ -35,7 +35,6 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -83,6 +82,10 @@ namespace hpx { namespace threads { namespace policies {
     //     bool pop(reference val, bool steal = true);
     //
     //     bool empty();
+    //
+    //     // optional, called on the OS thread associated with the queue
+    //     void on_start_thread();
+    //     void on_stop_thread();
     // };
     //
     // struct queue_policy
@@ -106,8 +109,11 @@ namespace hpx { namespace threads { namespace policies {
             std::hash<thread_id_type>, std::equal_to<thread_id_type>,
             util::internal_allocator<thread_id_type>>;
 
-        using thread_heap_type =
-            std::list<thread_id_type, util::internal_allocator<thread_id_type>>;
+        // recycled thread objects are reused in LIFO order, the most recently
+        // terminated thread is the one most likely to still have its stack in
+        // the cache
+        using thread_heap_type = std::vector<thread_id_type,
+            util::internal_allocator<thread_id_type>>;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         using task_description =
@@ -175,8 +181,8 @@ namespace hpx { namespace threads { namespace policies {
             if (!heap->empty())
             {
                 // Take ownership of the thread object and rebind it.
-                thrd = heap->front();
-                heap->pop_front();
+                thrd = heap->back();
+                heap->pop_back();
                 get_thread_id_data(thrd)->rebind(data, state);
             }
             else
@@ -337,23 +343,23 @@ namespace hpx { namespace threads { namespace policies {
 
             if (stacksize == parameters_.small_stacksize_)
             {
-                thread_heap_small_.push_front(thrd);
+                thread_heap_small_.push_back(thrd);
             }
             else if (stacksize == parameters_.medium_stacksize_)
             {
-                thread_heap_medium_.push_front(thrd);
+                thread_heap_medium_.push_back(thrd);
             }
             else if (stacksize == parameters_.large_stacksize_)
             {
-                thread_heap_large_.push_front(thrd);
+                thread_heap_large_.push_back(thrd);
             }
             else if (stacksize == parameters_.huge_stacksize_)
             {
-                thread_heap_huge_.push_front(thrd);
+                thread_heap_huge_.push_back(thrd);
             }
             else if (stacksize == parameters_.nostack_stacksize_)
             {
-                thread_heap_nostack_.push_front(thrd);
+                thread_heap_nostack_.push_back(thrd);
             }
             else
             {
@@ -728,6 +734,79 @@ namespace hpx { namespace threads { namespace policies {
                 ec = make_success_code();
         }
 
+        // create a batch of new threads, the queue lock is acquired (and the
+        // staged task counter is updated) once for the whole batch
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, bool run_now, error_code& ec)
+        {
+            if (count == 0)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            if (run_now)
+            {
+                std::unique_lock<mutex_type> lk(mtx_);
+
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    threads::thread_id_type thrd;
+                    create_thread_object(thrd, data[i], initial_state, lk);
+
+                    // add a new entry in the map for this thread
+                    std::pair<thread_map_type::iterator, bool> p =
+                        thread_map_.insert(thrd);
+
+                    if (HPX_UNLIKELY(!p.second))
+                    {
+                        lk.unlock();
+                        HPX_THROWS_IF(ec, hpx::out_of_memory,
+                            "thread_queue::create_threads",
+                            "Couldn't add new thread to the map of threads");
+                        return;
+                    }
+                    ++thread_map_count_;
+
+                    HPX_ASSERT(
+                        &get_thread_id_data(thrd)->get_queue<thread_queue>() ==
+                        this);
+
+                    // push the new thread in the pending queue thread
+                    if (initial_state == pending)
+                        schedule_thread(get_thread_id_data(thrd));
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            // do not execute the work, but register the task descriptions for
+            // later thread creation
+            new_tasks_count_.data_ += static_cast<std::int64_t>(count);
+
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+            std::uint64_t now = util::high_resolution_clock::now();
+#endif
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                task_description* td = task_description_alloc_.allocate(1);
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                new (td)
+                    task_description(std::move(data[i]), initial_state, now);
+#else
+                new (td) task_description(
+                    std::move(data[i]), initial_state);    //-V106
+#endif
+                new_tasks_.push(td);
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
         void move_work_items_from(thread_queue* src, std::int64_t count)
         {
             thread_description* trd;
@@ -1064,8 +1143,14 @@ namespace hpx { namespace threads { namespace policies {
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
-        void on_stop_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            detail::on_start_thread(work_items_, 0);
+        }
+        void on_stop_thread(std::size_t num_thread)
+        {
+            detail::on_stop_thread(work_items_, 0);
+        }
         void on_error(std::size_t num_thread, std::exception_ptr const& e) {}
 
     private:
@@ -35,6 +35,8 @@ namespace hpx { namespace threads { namespace policies {
             std::int64_t max_terminated_threads = std::int64_t(
                 HPX_THREAD_QUEUE_MAX_TERMINATED_THREADS),
             double max_idle_backoff_time = double(HPX_IDLE_BACKOFF_TIME_MAX),
+            std::int64_t max_idle_yield_count = std::int64_t(
+                HPX_IDLE_YIELD_COUNT_MAX),
             std::ptrdiff_t small_stacksize = HPX_SMALL_STACK_SIZE,
             std::ptrdiff_t medium_stacksize = HPX_MEDIUM_STACK_SIZE,
             std::ptrdiff_t large_stacksize = HPX_LARGE_STACK_SIZE,
@@ -48,6 +50,7 @@ namespace hpx { namespace threads { namespace policies {
           , max_delete_count_(max_delete_count)
           , max_terminated_threads_(max_terminated_threads)
           , max_idle_backoff_time_(max_idle_backoff_time)
+          , max_idle_yield_count_(max_idle_yield_count)
           , small_stacksize_(small_stacksize)
           , medium_stacksize_(medium_stacksize)
           , large_stacksize_(large_stacksize)
@@ -65,6 +68,7 @@ namespace hpx { namespace threads { namespace policies {
         std::int64_t max_delete_count_;
         std::int64_t max_terminated_threads_;
         double max_idle_backoff_time_;
+        std::int64_t max_idle_yield_count_;
         std::ptrdiff_t const small_stacksize_;
         std::ptrdiff_t const medium_stacksize_;
         std::ptrdiff_t const large_stacksize_;
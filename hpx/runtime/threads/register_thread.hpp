@@ -683,6 +683,44 @@ namespace hpx { namespace threads {
         register_non_suspendable_work_plain(pool, std::move(thread_func),
             description, initial_state, priority, os_thread, ec);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create a batch of new threads using the given
+    ///        threads#thread_init_data objects.
+    ///
+    /// \param pool       [in] The thread pool the threads are created on.
+    /// \param data       [in] Pointer to the first of \a count
+    ///                   threads#thread_init_data objects. The objects are
+    ///                   left in a moved-from state.
+    /// \param count      [in] The number of threads to create.
+    /// \param initial_state [in] The thread state all newly created threads
+    ///                   will be initialized with.
+    /// \param run_now    [in] If this is set to `true` the thread objects
+    ///                   are created immediately, otherwise the whole batch
+    ///                   is staged and the thread objects are created by the
+    ///                   worker threads once they run out of work.
+    ///
+    /// In contrast to registering the threads one by one the scheduler is
+    /// entered only once and the queues are locked only once for each block
+    /// of threads placed on them.
+    ///
+    inline void register_threads_plain(threads::thread_pool_base* pool,
+        threads::thread_init_data* data, std::size_t count,
+        threads::thread_state_enum initial_state = threads::pending,
+        bool run_now = false, error_code& ec = throws)
+    {
+        HPX_ASSERT(pool);
+        pool->create_threads(data, count, initial_state, run_now, ec);
+    }
+
+    inline void register_threads_plain(threads::thread_init_data* data,
+        std::size_t count,
+        threads::thread_state_enum initial_state = threads::pending,
+        bool run_now = false, error_code& ec = throws)
+    {
+        register_threads_plain(detail::get_self_or_default_pool(), data, count,
+            initial_state, run_now, ec);
+    }
 }}    // namespace hpx::threads
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -691,6 +729,7 @@ namespace hpx { namespace applier {
     using threads::register_thread;
     using threads::register_thread_nullary;
     using threads::register_thread_plain;
+    using threads::register_threads_plain;
 
     using threads::register_work;
     using threads::register_work_nullary;
@@ -10,7 +10,7 @@
 #define HPX_RUNTIME_THREADS_THREAD_DATA_STACKLESS_HPP
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_slab_allocator.hpp>
 #include <hpx/assertion.hpp>
 #include <hpx/coroutines/stackless_coroutine.hpp>
 #include <hpx/coroutines/thread_enums.hpp>
@@ -54,7 +54,8 @@ namespace hpx { namespace threads {
             return this;
         }
 
-        static util::internal_allocator<thread_data_stackless> thread_alloc_;
+        static util::thread_local_slab_allocator<thread_data_stackless>
+            thread_alloc_;
 
     public:
         stackless_coroutine_type::result_type call()
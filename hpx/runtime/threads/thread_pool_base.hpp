@@ -177,6 +177,8 @@ namespace hpx { namespace threads
             thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
         virtual void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec) = 0;
+        virtual void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
 
         virtual thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
@@ -0,0 +1,425 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_JAN_2020)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/type_support/always_void.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/util/detail/chunk_size.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail {
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Maps keys onto unsigned integers of the same size such that comparing
+    // the integers gives the same order as comparing the keys with
+    // operator<(). Only keys for which this is specialized are radix sorted.
+    template <typename T, typename Enable = void>
+    struct radix_sort_key_traits
+    {
+    };
+
+    template <typename T>
+    struct radix_sort_key_traits<T,
+        typename std::enable_if<std::is_integral<T>::value &&
+            !std::is_same<T, bool>::value>::type>
+    {
+        typedef typename std::make_unsigned<T>::type type;
+
+        static type get(T key) noexcept
+        {
+            // flipping the sign bit moves negative values in front of the
+            // positive ones, this is a no-op for unsigned keys
+            type const sign_bit = std::is_signed<T>::value ?
+                type(type(1) << (sizeof(T) * CHAR_BIT - 1)) :
+                type(0);
+            return type(type(key) ^ sign_bit);
+        }
+    };
+
+    template <typename T>
+    struct radix_sort_key_traits<T,
+        typename std::enable_if<std::is_floating_point<T>::value &&
+            std::numeric_limits<T>::is_iec559 &&
+            (sizeof(T) == sizeof(std::uint32_t) ||
+                sizeof(T) == sizeof(std::uint64_t))>::type>
+    {
+        typedef typename std::conditional<sizeof(T) == sizeof(std::uint32_t),
+            std::uint32_t, std::uint64_t>::type type;
+
+        static type get(T key) noexcept
+        {
+            type bits;
+            std::memcpy(&bits, &key, sizeof(T));
+
+            // negative values are stored as sign and magnitude, their
+            // order has to be reversed
+            type const sign_bit = type(1) << (sizeof(T) * CHAR_BIT - 1);
+            return (bits & sign_bit) ? type(~bits) : type(bits | sign_bit);
+        }
+    };
+
+    // comparison function objects which are known to order the keys the
+    // same way operator<() does
+    template <typename T, typename Compare>
+    struct is_radix_sort_compare : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_radix_sort_compare<T, detail::less> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_radix_sort_compare<T, std::less<T>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct is_radix_sort_compare<T, std::less<>> : std::true_type
+    {
+    };
+
+    template <typename T, typename Compare, typename Enable = void>
+    struct is_radix_sortable : std::false_type
+    {
+    };
+
+    template <typename T, typename Compare>
+    struct is_radix_sortable<T, Compare,
+        typename hpx::util::always_void<
+            typename radix_sort_key_traits<T>::type>::type>
+      : is_radix_sort_compare<T, typename std::decay<Compare>::type>
+    {
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // used in place of the value iterator if only keys are sorted
+    struct radix_sort_no_values
+    {
+        struct value_type
+        {
+        };
+
+        value_type& operator[](std::size_t) const noexcept
+        {
+            static value_type value;
+            return value;
+        }
+    };
+
+    // the values are moved through uninitialized buffers, this is fine for
+    // trivially copyable types only
+    template <typename ValueIter>
+    struct is_radix_sortable_values
+      : std::is_trivially_copyable<
+            typename std::iterator_traits<ValueIter>::value_type>
+    {
+    };
+
+    template <>
+    struct is_radix_sortable_values<radix_sort_no_values> : std::true_type
+    {
+    };
+
+    template <typename ValueIter>
+    class radix_sort_values_buffer
+    {
+        typedef typename std::iterator_traits<ValueIter>::value_type
+            value_type;
+
+    public:
+        explicit radix_sort_values_buffer(std::size_t count)
+          : buffer_(count)
+        {
+        }
+
+        value_type* data() const noexcept
+        {
+            return buffer_.data();
+        }
+
+    private:
+        sort_buffer<value_type> buffer_;
+    };
+
+    template <>
+    class radix_sort_values_buffer<radix_sort_no_values>
+    {
+    public:
+        explicit radix_sort_values_buffer(std::size_t) {}
+
+        radix_sort_no_values data() const noexcept
+        {
+            return radix_sort_no_values();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    static const std::size_t radix_sort_limit_per_task = 65536ul;
+
+    // the keys are sorted one byte per pass
+    static const std::size_t radix_sort_digit_bits = 8;
+    static const std::size_t radix_sort_num_digits =
+        std::size_t(1) << radix_sort_digit_bits;
+
+    // number of elements staged per digit before they are written to their
+    // destination, the staged keys fill one cache line
+    template <typename Key>
+    struct radix_sort_staging_size
+      : std::integral_constant<std::size_t,
+            (sizeof(Key) < 64 ? 64 / sizeof(Key) : 1)>
+    {
+    };
+
+    template <typename Key>
+    inline std::size_t radix_sort_digit(Key key, std::size_t shift) noexcept
+    {
+        return std::size_t(radix_sort_key_traits<Key>::get(key) >> shift) &
+            (radix_sort_num_digits - 1);
+    }
+
+    template <typename ExPolicy>
+    std::size_t radix_sort_chunk_size(ExPolicy& policy, std::size_t count)
+    {
+        std::size_t const cores = execution::processing_units_count(
+            policy.executor(), policy.parameters());
+
+        std::size_t max_chunks = execution::maximal_number_of_chunks(
+            policy.parameters(), policy.executor(), cores, count);
+
+        std::size_t chunk_size = execution::get_chunk_size(policy.parameters(),
+            policy.executor(), [] { return 0; }, cores, count);
+
+        util::detail::adjust_chunk_size_and_max_chunks(
+            cores, count, max_chunks, chunk_size);
+
+        return (std::max)(chunk_size, radix_sort_limit_per_task);
+    }
+
+    //------------------------------------------------------------------------
+    //  function : radix_sort_pass
+    /// \brief stable distribution of the elements by the digit selected by
+    ///        shift, every chunk counts its digits, an exclusive scan over
+    ///        all digits and chunks gives the positions every chunk writes
+    ///        its elements to
+    /// \remarks elements are written through small per-digit staging
+    ///          buffers, this turns the scattered single element writes
+    ///          into writes of whole cache lines
+    //------------------------------------------------------------------------
+    template <typename Key, typename ExPolicy, typename KeyIn,
+        typename ValueIn, typename KeyOut, typename ValueOut>
+    void radix_sort_pass(ExPolicy& policy, KeyIn keys_in, ValueIn values_in,
+        KeyOut keys_out, ValueOut values_out, std::size_t count,
+        std::size_t chunk_size, std::size_t shift)
+    {
+        std::size_t const num_chunks = (count + chunk_size - 1) / chunk_size;
+        std::vector<std::size_t> offsets(num_chunks * radix_sort_num_digits, 0);
+
+        sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+            std::size_t const begin = chunk * chunk_size;
+            std::size_t const end = (std::min)(begin + chunk_size, count);
+            std::size_t* counts = offsets.data() + chunk * radix_sort_num_digits;
+
+            for (std::size_t i = begin; i != end; ++i)
+                ++counts[radix_sort_digit<Key>(keys_in[i], shift)];
+        });
+
+        std::size_t sum = 0;
+        for (std::size_t digit = 0; digit != radix_sort_num_digits; ++digit)
+        {
+            for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+            {
+                std::size_t& offset =
+                    offsets[chunk * radix_sort_num_digits + digit];
+                std::size_t const n = offset;
+                offset = sum;
+                sum += n;
+            }
+        }
+
+        sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+            std::size_t const begin = chunk * chunk_size;
+            std::size_t const end = (std::min)(begin + chunk_size, count);
+            std::size_t* positions =
+                offsets.data() + chunk * radix_sort_num_digits;
+
+            std::size_t const staging_size =
+                radix_sort_staging_size<Key>::value;
+
+            sort_buffer<Key> staged_keys_buffer(
+                radix_sort_num_digits * staging_size);
+            radix_sort_values_buffer<ValueIn> staged_values_buffer(
+                radix_sort_num_digits * staging_size);
+
+            Key* staged_keys = staged_keys_buffer.data();
+            auto staged_values = staged_values_buffer.data();
+
+            std::size_t staged[radix_sort_num_digits] = {0};
+
+            auto flush = [&](std::size_t digit, std::size_t n) {
+                std::size_t const pos = positions[digit];
+                std::size_t const first = digit * staging_size;
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    keys_out[pos + j] = staged_keys[first + j];
+                    values_out[pos + j] = staged_values[first + j];
+                }
+                positions[digit] = pos + n;
+            };
+
+            for (std::size_t i = begin; i != end; ++i)
+            {
+                Key const key = keys_in[i];
+                std::size_t const digit = radix_sort_digit<Key>(key, shift);
+                std::size_t const slot = digit * staging_size + staged[digit];
+
+                staged_keys[slot] = key;
+                staged_values[slot] = values_in[i];
+
+                if (++staged[digit] == staging_size)
+                {
+                    flush(digit, staging_size);
+                    staged[digit] = 0;
+                }
+            }
+
+            for (std::size_t digit = 0; digit != radix_sort_num_digits;
+                 ++digit)
+            {
+                if (staged[digit] != 0)
+                    flush(digit, staged[digit]);
+            }
+        });
+    }
+
+    //------------------------------------------------------------------------
+    //  function : parallel_radix_sort
+    /// \brief least significant digit first radix sort of count keys,
+    ///        the values (if any) are permuted alongside the keys
+    /// \remarks the number of keys per digit does not depend on the order
+    ///          of the keys, they are counted once upfront for all digits,
+    ///          passes over digits all keys have in common are skipped
+    //------------------------------------------------------------------------
+    template <typename ExPolicy, typename KeyIter, typename ValueIter>
+    void parallel_radix_sort(ExPolicy& policy, KeyIter keys, ValueIter values,
+        std::size_t count)
+    {
+        typedef typename std::iterator_traits<KeyIter>::value_type key_type;
+
+        std::size_t const num_passes = sizeof(key_type);
+        std::size_t const chunk_size = radix_sort_chunk_size(policy, count);
+        std::size_t const num_chunks = (count + chunk_size - 1) / chunk_size;
+
+        std::size_t const histogram_size = num_passes * radix_sort_num_digits;
+        std::vector<std::size_t> histograms(num_chunks * histogram_size, 0);
+
+        sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+            std::size_t const begin = chunk * chunk_size;
+            std::size_t const end = (std::min)(begin + chunk_size, count);
+            std::size_t* counts = histograms.data() + chunk * histogram_size;
+
+            for (std::size_t i = begin; i != end; ++i)
+            {
+                key_type const key = keys[i];
+                for (std::size_t pass = 0; pass != num_passes; ++pass)
+                {
+                    ++counts[pass * radix_sort_num_digits +
+                        radix_sort_digit<key_type>(
+                            key, pass * radix_sort_digit_bits)];
+                }
+            }
+        });
+
+        std::vector<std::size_t> passes;
+        for (std::size_t pass = 0; pass != num_passes; ++pass)
+        {
+            bool all_keys_equal = false;
+            for (std::size_t digit = 0; digit != radix_sort_num_digits;
+                 ++digit)
+            {
+                std::size_t total = 0;
+                for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+                {
+                    total += histograms[chunk * histogram_size +
+                        pass * radix_sort_num_digits + digit];
+                }
+
+                if (total != 0)
+                {
+                    all_keys_equal = (total == count);
+                    break;
+                }
+            }
+
+            if (!all_keys_equal)
+                passes.push_back(pass);
+        }
+
+        if (passes.empty())
+            return;
+
+        sort_buffer<key_type> keys_buffer(count);
+        radix_sort_values_buffer<ValueIter> values_buffer(count);
+
+        bool in_buffer = false;
+        for (std::size_t pass : passes)
+        {
+            std::size_t const shift = pass * radix_sort_digit_bits;
+            if (!in_buffer)
+            {
+                radix_sort_pass<key_type>(policy, keys, values,
+                    keys_buffer.data(), values_buffer.data(), count,
+                    chunk_size, shift);
+            }
+            else
+            {
+                radix_sort_pass<key_type>(policy, keys_buffer.data(),
+                    values_buffer.data(), keys, values, count, chunk_size,
+                    shift);
+            }
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            auto keys_in = keys_buffer.data();
+            auto values_in = values_buffer.data();
+
+            sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                std::size_t const begin = chunk * chunk_size;
+                std::size_t const end = (std::min)(begin + chunk_size, count);
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    keys[i] = keys_in[i];
+                    values[i] = values_in[i];
+                }
+            });
+        }
+    }
+
+    /// \endcond
+}}}}    // namespace hpx::parallel::v1::detail
+
+#endif
@@ -0,0 +1,109 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_BUFFER_JAN_2020)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_BUFFER_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail {
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Uninitialized memory for a given number of elements of type T. The
+    // buffer manages the memory only, the elements are constructed and
+    // destroyed by the algorithms using it.
+    template <typename T>
+    class sort_buffer
+    {
+    public:
+        explicit sort_buffer(std::size_t count)
+          : data_(std::allocator<T>().allocate(count))
+          , count_(count)
+        {
+        }
+
+        ~sort_buffer()
+        {
+            std::allocator<T>().deallocate(data_, count_);
+        }
+
+        sort_buffer(sort_buffer const&) = delete;
+        sort_buffer& operator=(sort_buffer const&) = delete;
+
+        T* data() const noexcept
+        {
+            return data_;
+        }
+
+    private:
+        T* data_;
+        std::size_t count_;
+    };
+
+    // Destroys the elements held by a sort_buffer, the algorithms create it
+    // once all elements have been constructed in the buffer.
+    template <typename T>
+    struct sort_buffer_elements
+    {
+        ~sort_buffer_elements()
+        {
+            for (std::size_t i = 0; i != count_; ++i)
+                data_[i].~T();
+        }
+
+        T* data_;
+        std::size_t count_;
+    };
+
+    // Elements are moved through a sort_buffer only if this can't throw,
+    // otherwise the input sequence could be left partially destroyed.
+    template <typename T>
+    struct is_sort_buffer_compatible
+      : std::integral_constant<bool,
+            std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_assignable<T>::value &&
+                std::is_nothrow_destructible<T>::value>
+    {
+    };
+
+    // Run f(0), ..., f(count - 1) concurrently and wait for all of them
+    // to finish. Rethrows the exceptions reported by the tasks.
+    template <typename ExPolicy, typename F>
+    void sort_run_tasks(ExPolicy& policy, std::size_t count, F const& f)
+    {
+        std::vector<hpx::future<void>> workitems;
+        workitems.reserve(count);
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            workitems.push_back(execution::async_execute(
+                policy.executor(), [&f, i]() { f(i); }));
+        }
+
+        hpx::wait_all(workitems);
+
+        std::list<std::exception_ptr> errors;
+        util::detail::handle_local_exceptions<ExPolicy>::call(
+            workitems, errors);
+    }
+
+    /// \endcond
+}}}}    // namespace hpx::parallel::v1::detail
+
+#endif
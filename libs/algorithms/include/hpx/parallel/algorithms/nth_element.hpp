@@ -0,0 +1,275 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_JAN_2020)
+#define HPX_PARALLEL_ALGORITHM_NTH_ELEMENT_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concepts/concepts.hpp>
+#include <hpx/iterator_support/traits/is_iterator.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/partition.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1 {
+    ///////////////////////////////////////////////////////////////////////////
+    // nth_element
+    namespace detail {
+        /// \cond NOINTERNAL
+
+        //------------------------------------------------------------------------
+        //  function : parallel_nth_element
+        /// \brief quick select, the ranges are split by parallel partitioning
+        ///        until they are small enough to be handled sequentially
+        /// \remarks every step separates the elements less than the pivot
+        ///          and the elements equal to the pivot, this guarantees
+        ///          progress for inputs with many equal elements
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_nth_element(ExPolicy& policy, RandomIt first,
+            RandomIt nth, RandomIt last, Compare const& comp, std::true_type)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            RandomIt const end = last;
+            if (nth == last)
+                return end;
+
+            while (std::size_t(last - first) > sort_limit_per_task)
+            {
+                // median of three
+                RandomIt a = first;
+                RandomIt b = first + (last - first) / 2;
+                RandomIt c = last - 1;
+
+                if (comp(*b, *a))
+                    std::swap(a, b);
+                if (comp(*c, *b))
+                    b = comp(*c, *a) ? a : c;
+
+                value_type const pivot = *b;
+
+                RandomIt middle1 = partition_helper::call(policy, first, last,
+                    [&pivot, &comp](value_type const& x) -> bool {
+                        return comp(x, pivot);
+                    },
+                    util::projection_identity());
+
+                if (nth < middle1)
+                {
+                    last = middle1;
+                    continue;
+                }
+
+                RandomIt middle2 = partition_helper::call(policy, middle1,
+                    last,
+                    [&pivot, &comp](value_type const& x) -> bool {
+                        return !comp(pivot, x);
+                    },
+                    util::projection_identity());
+
+                HPX_ASSERT(middle1 != middle2);
+                if (nth < middle2)
+                    return end;
+
+                first = middle2;
+            }
+
+            std::nth_element(first, nth, last, comp);
+            return end;
+        }
+
+        // the pivot can't be kept aside for types which are not copyable
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_nth_element(ExPolicy&, RandomIt first, RandomIt nth,
+            RandomIt last, Compare const& comp, std::false_type)
+        {
+            std::nth_element(first, nth, last, comp);
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_nth_element(ExPolicy& policy, RandomIt first,
+            RandomIt nth, RandomIt last, Compare const& comp)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            return parallel_nth_element(policy, first, nth, last, comp,
+                std::is_copy_constructible<value_type>());
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // nth_element
+        template <typename RandomIt>
+        struct nth_element
+          : public detail::algorithm<nth_element<RandomIt>, RandomIt>
+        {
+            nth_element()
+              : nth_element::algorithm("nth_element")
+            {
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt sequential(ExPolicy, RandomIt first, RandomIt nth,
+                RandomIt last, Compare&& comp, Proj&& proj)
+            {
+                std::nth_element(first, nth, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                RandomIt>::type
+            parallel(ExPolicy&& policy, RandomIt first, RandomIt nth,
+                RandomIt last, Compare&& comp, Proj&& proj)
+            {
+                typedef util::detail::algorithm_result<ExPolicy, RandomIt>
+                    algorithm_result;
+
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                try
+                {
+                    return algorithm_result::get(execution::async_execute(
+                        policy.executor(), [=]() mutable -> RandomIt {
+                            try
+                            {
+                                return parallel_nth_element(
+                                    policy, first, nth, last, pred);
+                            }
+                            catch (...)
+                            {
+                                util::detail::handle_local_exceptions<
+                                    ExPolicy>::call(std::current_exception());
+                            }
+
+                            // Not reachable.
+                            HPX_ASSERT(false);
+                            return last;
+                        }));
+                }
+                catch (...)
+                {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }    // namespace detail
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges the elements in the range [first, last) such that the
+    /// element pointed at by \a nth is changed to whatever element would
+    /// occur in that position if [first, last) was sorted and all of the
+    /// elements before this new \a nth element are less than or equal to the
+    /// elements after the new \a nth element.
+    ///
+    /// \note   Complexity: O(N) applications of the predicate on average,
+    ///                     where N = std::distance(first, last).
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param nth          Refers to the element the partitioning is done
+    ///                     around.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a nth_element algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+        HPX_CONCEPT_REQUIRES_(execution::is_execution_policy<ExPolicy>::value&&
+                hpx::traits::is_iterator<RandomIt>::value&&
+                    traits::is_projected<Proj, RandomIt>::value&&
+                        traits::is_indirect_callable<ExPolicy, Compare,
+                            traits::projected<Proj, RandomIt>,
+                            traits::projected<Proj, RandomIt>>::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    nth_element(ExPolicy&& policy, RandomIt first, RandomIt nth, RandomIt last,
+        Compare&& comp = Compare(), Proj&& proj = Proj())
+    {
+        static_assert((hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::nth_element<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, nth, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}    // namespace hpx::parallel::v1
+
+#endif
@@ -0,0 +1,205 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_JAN_2020)
+#define HPX_PARALLEL_ALGORITHM_PARTIAL_SORT_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concepts/concepts.hpp>
+#include <hpx/iterator_support/traits/is_iterator.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/nth_element.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1 {
+    ///////////////////////////////////////////////////////////////////////////
+    // partial_sort
+    namespace detail {
+        /// \cond NOINTERNAL
+
+        // select the smallest elements in parallel, sort them afterwards
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_partial_sort(ExPolicy& policy, RandomIt first,
+            RandomIt middle, RandomIt last, Compare const& comp)
+        {
+            if (first == middle)
+                return last;
+
+            parallel_nth_element(policy, first, middle, last, comp);
+            parallel_sort_async(policy, first, middle, comp).get();
+            return last;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // partial_sort
+        template <typename RandomIt>
+        struct partial_sort
+          : public detail::algorithm<partial_sort<RandomIt>, RandomIt>
+        {
+            partial_sort()
+              : partial_sort::algorithm("partial_sort")
+            {
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt sequential(ExPolicy, RandomIt first,
+                RandomIt middle, RandomIt last, Compare&& comp, Proj&& proj)
+            {
+                std::partial_sort(first, middle, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                RandomIt>::type
+            parallel(ExPolicy&& policy, RandomIt first, RandomIt middle,
+                RandomIt last, Compare&& comp, Proj&& proj)
+            {
+                typedef util::detail::algorithm_result<ExPolicy, RandomIt>
+                    algorithm_result;
+
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                try
+                {
+                    return algorithm_result::get(execution::async_execute(
+                        policy.executor(), [=]() mutable -> RandomIt {
+                            try
+                            {
+                                return parallel_partial_sort(
+                                    policy, first, middle, last, pred);
+                            }
+                            catch (...)
+                            {
+                                util::detail::handle_local_exceptions<
+                                    ExPolicy>::call(std::current_exception());
+                            }
+
+                            // Not reachable.
+                            HPX_ASSERT(false);
+                            return last;
+                        }));
+                }
+                catch (...)
+                {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }    // namespace detail
+
+    //-----------------------------------------------------------------------------
+    /// Rearranges the elements in the range [first, last) such that the range
+    /// [first, middle) contains the sorted middle - first smallest elements
+    /// of the range [first, last). The order of equal elements is not
+    /// guaranteed to be preserved. The order of the remaining elements in the
+    /// range [middle, last) is unspecified.
+    ///
+    /// \note   Complexity: Approximately (last - first) * log(middle - first)
+    ///                     applications of the predicate.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param middle       Refers to the end of the range of elements which
+    ///                     will be sorted.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a partial_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+        HPX_CONCEPT_REQUIRES_(execution::is_execution_policy<ExPolicy>::value&&
+                hpx::traits::is_iterator<RandomIt>::value&&
+                    traits::is_projected<Proj, RandomIt>::value&&
+                        traits::is_indirect_callable<ExPolicy, Compare,
+                            traits::projected<Proj, RandomIt>,
+                            traits::projected<Proj, RandomIt>>::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    partial_sort(ExPolicy&& policy, RandomIt first, RandomIt middle,
+        RandomIt last, Compare&& comp = Compare(), Proj&& proj = Proj())
+    {
+        static_assert((hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::partial_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, middle, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}    // namespace hpx::parallel::v1
+
+#endif
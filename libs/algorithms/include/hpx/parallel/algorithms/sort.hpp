@@ -16,10 +16,14 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/functional/invoke.hpp>
 #include <hpx/iterator_support/traits/is_iterator.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/type_support/decay.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/executors/execution.hpp>
@@ -29,16 +33,21 @@
 #include <hpx/parallel/util/compare_projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/detail/chunk_size.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace parallel { inline namespace v1 {
     ///////////////////////////////////////////////////////////////////////////
@@ -163,6 +172,196 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 std::move(left), std::move(right));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // number of samples drawn per bucket while selecting the splitters
+        static const std::size_t sample_sort_oversampling = 32ul;
+
+        // the bucket of each element is stored as a 16 bit integer, each
+        // splitter defines two buckets
+        static const std::size_t sample_sort_max_buckets = 4096ul;
+
+        //------------------------------------------------------------------------
+        //  function : sample_sort
+        /// \brief sorts [first, last) by distributing the elements into
+        ///        buckets delimited by splitters taken from a sorted sample
+        ///        of the input, the buckets are then sorted independently
+        /// \remarks the classification of the elements and their
+        ///          distribution into the buckets is done in parallel by
+        ///          num_chunks tasks operating on chunk_size elements each
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt sample_sort(ExPolicy policy, RandomIt first, RandomIt last,
+            Compare comp, std::size_t num_buckets, std::size_t chunk_size)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            std::size_t const count = last - first;
+            std::size_t const num_chunks =
+                (count + chunk_size - 1) / chunk_size;
+
+            //----------------------------------------------------------------
+            //                  select splitters
+            //----------------------------------------------------------------
+            std::size_t const num_samples =
+                num_buckets * sample_sort_oversampling;
+            std::size_t const stride = count / num_samples;
+            HPX_ASSERT(stride != 0);
+
+            std::vector<value_type> splitters;
+            {
+                std::vector<value_type> samples;
+                samples.reserve(num_samples);
+
+                // draw one pseudo-random element from each stride, this
+                // avoids picking bad splitters for periodic inputs
+                std::uint64_t seed = count;
+                for (std::size_t i = 0; i != num_samples; ++i)
+                {
+                    seed = seed * 6364136223846793005ull +
+                        1442695040888963407ull;
+                    samples.push_back(
+                        first[i * stride + std::size_t(seed >> 33) % stride]);
+                }
+
+                std::sort(samples.begin(), samples.end(), comp);
+
+                // duplicate splitters are dropped, elements equal to a
+                // splitter go into a bucket of their own
+                splitters.reserve(num_buckets - 1);
+                for (std::size_t i = 1; i != num_buckets; ++i)
+                {
+                    value_type const& s = samples[i * sample_sort_oversampling];
+                    if (splitters.empty() || comp(splitters.back(), s))
+                        splitters.push_back(s);
+                }
+            }
+
+            // bucket 2*i holds the elements between splitter i-1 and
+            // splitter i, bucket 2*i+1 holds the elements equal to splitter i
+            std::size_t const num_classes = 2 * splitters.size() + 1;
+
+            //----------------------------------------------------------------
+            //                  classify
+            //----------------------------------------------------------------
+            std::vector<std::uint16_t> classes(count);
+            std::vector<std::size_t> offsets(num_chunks * num_classes, 0);
+
+            sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                std::size_t const begin = chunk * chunk_size;
+                std::size_t const end = (std::min)(begin + chunk_size, count);
+                std::size_t* counts = offsets.data() + chunk * num_classes;
+
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    auto&& x = first[i];
+                    auto it = std::lower_bound(
+                        splitters.begin(), splitters.end(), x, comp);
+
+                    std::size_t cls = 2 * std::size_t(it - splitters.begin());
+                    if (it != splitters.end() && !comp(x, *it))
+                        ++cls;
+
+                    classes[i] = static_cast<std::uint16_t>(cls);
+                    ++counts[cls];
+                }
+            });
+
+            // turn the per-chunk histograms into the positions each chunk
+            // starts writing its elements of a bucket at
+            std::vector<std::size_t> bucket_begin(num_classes + 1);
+            std::size_t sum = 0;
+            for (std::size_t cls = 0; cls != num_classes; ++cls)
+            {
+                bucket_begin[cls] = sum;
+                for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+                {
+                    std::size_t& offset = offsets[chunk * num_classes + cls];
+                    std::size_t const n = offset;
+                    offset = sum;
+                    sum += n;
+                }
+            }
+            bucket_begin[num_classes] = sum;
+            HPX_ASSERT(sum == count);
+
+            //----------------------------------------------------------------
+            //                  distribute
+            //----------------------------------------------------------------
+            sort_buffer<value_type> buffer(count);
+            value_type* buf = buffer.data();
+
+            sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                std::size_t const begin = chunk * chunk_size;
+                std::size_t const end = (std::min)(begin + chunk_size, count);
+                std::size_t* positions = offsets.data() + chunk * num_classes;
+
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    ::new (static_cast<void*>(buf + positions[classes[i]]++))
+                        value_type(std::move(first[i]));
+                }
+            });
+
+            // the (moved from) elements of the buffer are destroyed even if
+            // comp throws while the buckets are sorted
+            sort_buffer_elements<value_type> elements = {buf, count};
+
+            //----------------------------------------------------------------
+            //                  sort buckets
+            //----------------------------------------------------------------
+            std::size_t const large_bucket = 2 * (count / num_buckets);
+
+            sort_run_tasks(policy, num_classes, [&](std::size_t cls) {
+                std::size_t const begin = bucket_begin[cls];
+                std::size_t const end = bucket_begin[cls + 1];
+
+                std::move(buf + begin, buf + end, first + begin);
+
+                // buckets of elements equal to a splitter are sorted already
+                if (cls % 2 != 0 || end - begin < 2)
+                    return;
+
+                if (end - begin > large_bucket)
+                {
+                    sort_thread(policy, first + begin, first + end, comp,
+                        sort_limit_per_task)
+                        .get();
+                }
+                else
+                {
+                    std::sort(first + begin, first + end, comp);
+                }
+            });
+
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt> sample_sort_async(ExPolicy&& policy,
+            RandomIt first, RandomIt last, Compare comp,
+            std::size_t num_buckets, std::size_t chunk_size, std::true_type)
+        {
+            return execution::async_execute(policy.executor(),
+                &sample_sort<typename std::decay<ExPolicy>::type, RandomIt,
+                    Compare>,
+                std::forward<ExPolicy>(policy), first, last, comp, num_buckets,
+                chunk_size);
+        }
+
+        // types which can't be copied or moved without throwing are sorted
+        // by the recursive quick sort instead
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt> sample_sort_async(ExPolicy&& policy,
+            RandomIt first, RandomIt last, Compare comp, std::size_t,
+            std::size_t chunk_size, std::false_type)
+        {
+            return execution::async_execute(policy.executor(),
+                &sort_thread<typename std::decay<ExPolicy>::type, RandomIt,
+                    Compare>,
+                std::forward<ExPolicy>(policy), first, last, comp, chunk_size);
+        }
+
         //------------------------------------------------------------------------
         //  function : parallel_sort_async
         //------------------------------------------------------------------------
@@ -209,12 +408,79 @@ namespace hpx { namespace parallel { inline namespace v1 {
             if (detail::is_sorted_sequential(first, last, comp))
                 return hpx::make_ready_future(last);
 
+            // The recursive quick sort partitions the whole sequence
+            // sequentially before any parallelism kicks in, which limits
+            // its scalability. Large inputs are sorted by a sample sort
+            // distributing the elements in parallel instead.
+            std::size_t const num_buckets = (std::min)(
+                (std::min)(4 * cores, count / sort_limit_per_task),
+                sample_sort_max_buckets);
+
+            if (cores > 1 && num_buckets > 1)
+            {
+                typedef typename std::iterator_traits<RandomIt>::value_type
+                    value_type;
+
+                typedef std::integral_constant<bool,
+                    std::is_copy_constructible<value_type>::value &&
+                        is_sort_buffer_compatible<value_type>::value>
+                    use_sample_sort;
+
+                return sample_sort_async(std::forward<ExPolicy>(policy),
+                    first, last, comp, num_buckets, chunk_size,
+                    use_sample_sort());
+            }
+
             return execution::async_execute(policy.executor(),
                 &sort_thread<typename std::decay<ExPolicy>::type, RandomIt,
                     Compare>,
                 std::forward<ExPolicy>(policy), first, last, comp, chunk_size);
         }
 
+        //------------------------------------------------------------------------
+        //  function : parallel_radix_sort_async
+        //------------------------------------------------------------------------
+        /// arithmetic keys compared with operator<() are radix sorted
+        template <typename ExPolicy, typename RandomIt>
+        hpx::future<RandomIt> parallel_radix_sort_async(
+            ExPolicy&& policy, RandomIt first, RandomIt last)
+        {
+            std::size_t const count = last - first;
+            if (count < radix_sort_limit_per_task)
+            {
+                std::sort(first, last);
+                return hpx::make_ready_future(last);
+            }
+
+            return execution::async_execute(
+                policy.executor(), [=]() mutable -> RandomIt {
+                    parallel_radix_sort(
+                        policy, first, radix_sort_no_values(), count);
+                    return last;
+                });
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        hpx::future<RandomIt> parallel_sort_dispatch(ExPolicy&& policy,
+            RandomIt first, RandomIt last, Compare&& comp, Proj&& proj,
+            std::false_type)
+        {
+            return parallel_sort_async(std::forward<ExPolicy>(policy), first,
+                last,
+                util::compare_projected<Compare, Proj>(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj)));
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        hpx::future<RandomIt> parallel_sort_dispatch(ExPolicy&& policy,
+            RandomIt first, RandomIt last, Compare&&, Proj&&, std::true_type)
+        {
+            return parallel_radix_sort_async(
+                std::forward<ExPolicy>(policy), first, last);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // sort
         template <typename RandomIt>
@@ -244,15 +510,23 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 typedef util::detail::algorithm_result<ExPolicy, RandomIt>
                     algorithm_result;
 
+                typedef typename std::iterator_traits<RandomIt>::value_type
+                    value_type;
+
+                typedef std::integral_constant<bool,
+                    std::is_same<typename hpx::util::decay<Proj>::type,
+                        util::projection_identity>::value &&
+                        is_radix_sortable<value_type, Compare>::value>
+                    use_radix_sort;
+
                 try
                 {
                     // call the sort routine and return the right type,
                     // depending on execution policy
-                    return algorithm_result::get(parallel_sort_async(
+                    return algorithm_result::get(parallel_sort_dispatch(
                         std::forward<ExPolicy>(policy), first, last,
-                        util::compare_projected<Compare, Proj>(
-                            std::forward<Compare>(comp),
-                            std::forward<Proj>(proj))));
+                        std::forward<Compare>(comp), std::forward<Proj>(proj),
+                        use_radix_sort()));
                 }
                 catch (...)
                 {
@@ -262,6 +536,34 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 }
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented sort
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename std::enable_if<
+            execution::is_execution_policy<ExPolicy>::value,
+            typename util::detail::algorithm_result<ExPolicy,
+                RandomIt>::type>::type
+        sort_(ExPolicy&& policy, RandomIt first, RandomIt last, Compare&& comp,
+            Proj&& proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(std::forward<ExPolicy>(policy),
+                is_seq(), first, last, std::forward<Compare>(comp),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        inline typename std::enable_if<
+            execution::is_execution_policy<ExPolicy>::value,
+            typename util::detail::algorithm_result<ExPolicy,
+                SegIter>::type>::type
+        sort_(ExPolicy&& policy, SegIter first, SegIter last, Compare&& comp,
+            Proj&& proj, std::true_type);
         /// \endcond
     }    // namespace detail
 
@@ -348,11 +650,11 @@ namespace hpx { namespace parallel { inline namespace v1 {
         static_assert((hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(std::forward<ExPolicy>(policy),
-            is_seq(), first, last, std::forward<Compare>(comp),
-            std::forward<Proj>(proj));
+        return detail::sort_(std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}    // namespace hpx::parallel::v1
 
@@ -12,11 +12,16 @@
 #include <hpx/datastructures/tuple.hpp>
 #include <hpx/util/tagged_pair.hpp>
 
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
 #include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
 #include <hpx/parallel/tagspec.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -35,6 +40,62 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 return hpx::util::get<0>(std::forward<Tuple>(t));
             }
         };
+
+#if defined(HPX_HAVE_TUPLE_RVALUE_SWAP)
+        template <typename ExPolicy, typename KeyIter, typename ValueIter,
+            typename Compare>
+        typename util::detail::algorithm_result<ExPolicy,
+            hpx::util::tagged_pair<tag::in1(KeyIter),
+                tag::in2(ValueIter)>>::type
+        sort_by_key(ExPolicy&& policy, KeyIter key_first, KeyIter key_last,
+            ValueIter value_first, ValueIter value_last, Compare&& comp,
+            std::false_type)
+        {
+            return detail::get_iter_tagged_pair<tag::in1, tag::in2>(
+                hpx::parallel::sort(std::forward<ExPolicy>(policy),
+                    hpx::util::make_zip_iterator(key_first, value_first),
+                    hpx::util::make_zip_iterator(key_last, value_last),
+                    std::forward<Compare>(comp), detail::extract_key()));
+        }
+#endif
+
+        // arithmetic keys compared with operator<() are radix sorted, the
+        // values are permuted alongside the keys
+        template <typename ExPolicy, typename KeyIter, typename ValueIter,
+            typename Compare>
+        typename util::detail::algorithm_result<ExPolicy,
+            hpx::util::tagged_pair<tag::in1(KeyIter),
+                tag::in2(ValueIter)>>::type
+        sort_by_key(ExPolicy&& policy, KeyIter key_first, KeyIter key_last,
+            ValueIter value_first, ValueIter value_last, Compare&&,
+            std::true_type)
+        {
+            typedef hpx::util::tagged_pair<tag::in1(KeyIter),
+                tag::in2(ValueIter)>
+                result_type;
+            typedef util::detail::algorithm_result<ExPolicy, result_type>
+                algorithm_result;
+
+            std::size_t const count = std::distance(key_first, key_last);
+            if (count < radix_sort_limit_per_task)
+            {
+                std::sort(hpx::util::make_zip_iterator(key_first, value_first),
+                    hpx::util::make_zip_iterator(key_last, value_last),
+                    util::compare_projected<detail::less, extract_key>(
+                        detail::less(), extract_key()));
+
+                return algorithm_result::get(
+                    hpx::util::make_tagged_pair<tag::in1, tag::in2>(
+                        key_last, value_last));
+            }
+
+            return algorithm_result::get(execution::async_execute(
+                policy.executor(), [=]() mutable -> result_type {
+                    parallel_radix_sort(policy, key_first, value_first, count);
+                    return hpx::util::make_tagged_pair<tag::in1, tag::in2>(
+                        key_last, value_last);
+                }));
+        }
         /// \endcond
     }    // namespace detail
 
@@ -134,11 +195,17 @@ namespace hpx { namespace parallel { inline namespace v1 {
         ValueIter value_last = value_first;
         std::advance(value_last, std::distance(key_first, key_last));
 
-        return detail::get_iter_tagged_pair<tag::in1, tag::in2>(
-            hpx::parallel::sort(std::forward<ExPolicy>(policy),
-                hpx::util::make_zip_iterator(key_first, value_first),
-                hpx::util::make_zip_iterator(key_last, value_last),
-                std::forward<Compare>(comp), detail::extract_key()));
+        typedef typename std::iterator_traits<KeyIter>::value_type key_type;
+
+        typedef std::integral_constant<bool,
+            !execution::is_sequenced_execution_policy<ExPolicy>::value &&
+                detail::is_radix_sortable<key_type, Compare>::value &&
+                detail::is_radix_sortable_values<ValueIter>::value>
+            use_radix_sort;
+
+        return detail::sort_by_key(std::forward<ExPolicy>(policy), key_first,
+            key_last, value_first, value_last, std::forward<Compare>(comp),
+            use_radix_sort());
 #endif
     }
 }}}    // namespace hpx::parallel::v1
@@ -0,0 +1,446 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_JAN_2020)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concepts/concepts.hpp>
+#include <hpx/iterator_support/traits/is_iterator.hpp>
+#include <hpx/lcos/future.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/execution_information.hpp>
+#include <hpx/parallel/executors/execution_parameters.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/chunk_size.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 {
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail {
+        /// \cond NOINTERNAL
+
+        // Merge the sorted runs [first1, last1) and [first2, last2) of src
+        // into dest. The comparison only ever sees the elements of src as
+        // lvalues, they are moved when they are written to dest. Equal
+        // elements of the first run are kept in front of the ones of the
+        // second run.
+        template <typename Iter1, typename Iter2, typename Compare>
+        void stable_sort_sequential_merge(Iter1 first1, Iter1 last1,
+            Iter1 first2, Iter1 last2, Iter2 dest, Compare const& comp)
+        {
+            if (first1 != last1 && first2 != last2)
+            {
+                while (true)
+                {
+                    if (comp(*first2, *first1))
+                    {
+                        *dest++ = std::move(*first2++);
+                        if (first2 == last2)
+                            break;
+                    }
+                    else
+                    {
+                        *dest++ = std::move(*first1++);
+                        if (first1 == last1)
+                            break;
+                    }
+                }
+            }
+            dest = std::move(first1, last1, dest);
+            std::move(first2, last2, dest);
+        }
+
+        template <typename ExPolicy, typename Iter1, typename Iter2,
+            typename Compare>
+        void stable_sort_merge(ExPolicy& policy, Iter1 first1, Iter1 last1,
+            Iter1 first2, Iter1 last2, Iter2 dest, Compare const& comp)
+        {
+            std::size_t const threshold = 65536ul;
+
+            std::size_t const size1 = last1 - first1;
+            std::size_t const size2 = last2 - first2;
+
+            if (size1 + size2 <= threshold)
+            {
+                stable_sort_sequential_merge(
+                    first1, last1, first2, last2, dest, comp);
+                return;
+            }
+
+            // split the larger run in the middle, the elements of the other
+            // run which are equal to the middle element go to the side of
+            // the split which keeps the merge stable
+            Iter1 mid1 = first1;
+            Iter1 mid2 = first2;
+            if (size1 >= size2)
+            {
+                mid1 = first1 + size1 / 2;
+                mid2 = std::lower_bound(first2, last2, *mid1, comp);
+            }
+            else
+            {
+                mid2 = first2 + size2 / 2;
+                mid1 = std::upper_bound(first1, last1, *mid2, comp);
+            }
+
+            hpx::future<void> fut =
+                execution::async_execute(policy.executor(), [&]() -> void {
+                    stable_sort_merge(
+                        policy, first1, mid1, first2, mid2, dest, comp);
+                });
+
+            try
+            {
+                stable_sort_merge(policy, mid1, last1, mid2, last2,
+                    dest + (mid1 - first1) + (mid2 - first2), comp);
+            }
+            catch (...)
+            {
+                fut.wait();
+
+                std::vector<hpx::future<void>> futures(2);
+                futures[0] = std::move(fut);
+                futures[1] = hpx::make_exceptional_future<void>(
+                    std::current_exception());
+
+                std::list<std::exception_ptr> errors;
+                util::detail::handle_local_exceptions<ExPolicy>::call(
+                    futures, errors);
+
+                // not reachable
+                HPX_ASSERT(false);
+                return;
+            }
+
+            fut.get();
+        }
+
+        // Merge each pair of neighboring runs of src into dest, the last run
+        // is moved over if the number of runs is odd. Runs are given by their
+        // boundaries.
+        template <typename ExPolicy, typename Iter1, typename Iter2,
+            typename Compare>
+        void stable_sort_merge_runs(ExPolicy& policy, Iter1 src, Iter2 dest,
+            std::vector<std::size_t> const& runs, Compare const& comp)
+        {
+            std::size_t const num_runs = runs.size() - 1;
+
+            sort_run_tasks(policy, (num_runs + 1) / 2, [&](std::size_t i) {
+                std::size_t const begin = runs[2 * i];
+                std::size_t const middle = runs[2 * i + 1];
+
+                if (2 * i + 1 == num_runs)
+                {
+                    std::move(src + begin, src + middle, dest + begin);
+                    return;
+                }
+
+                std::size_t const end = runs[2 * i + 2];
+                stable_sort_merge(policy, src + begin, src + middle,
+                    src + middle, src + end, dest + begin, comp);
+            });
+        }
+
+        //------------------------------------------------------------------------
+        //  function : parallel_stable_sort
+        /// \brief sorts the chunks of [first, last) concurrently and merges
+        ///        the sorted runs pairwise, bouncing the elements between the
+        ///        input sequence and a temporary buffer
+        //------------------------------------------------------------------------
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_stable_sort(ExPolicy policy, RandomIt first,
+            RandomIt last, Compare comp, std::size_t chunk_size, std::true_type)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            std::size_t const count = last - first;
+            std::size_t const num_chunks =
+                (count + chunk_size - 1) / chunk_size;
+
+            std::vector<std::size_t> runs(num_chunks + 1);
+            for (std::size_t i = 0; i != num_chunks; ++i)
+                runs[i] = i * chunk_size;
+            runs[num_chunks] = count;
+
+            sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                std::stable_sort(first + runs[chunk], first + runs[chunk + 1],
+                    comp);
+            });
+
+            if (num_chunks == 1)
+                return last;
+
+            // the sorted runs are moved into the buffer first, all merge
+            // rounds can then assign to already constructed elements
+            sort_buffer<value_type> buffer(count);
+            value_type* buf = buffer.data();
+
+            sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                std::uninitialized_copy(
+                    std::make_move_iterator(first + runs[chunk]),
+                    std::make_move_iterator(first + runs[chunk + 1]),
+                    buf + runs[chunk]);
+            });
+
+            sort_buffer_elements<value_type> elements = {buf, count};
+
+            bool in_buffer = true;
+            while (runs.size() > 2)
+            {
+                if (in_buffer)
+                    stable_sort_merge_runs(policy, buf, first, runs, comp);
+                else
+                    stable_sort_merge_runs(policy, first, buf, runs, comp);
+
+                in_buffer = !in_buffer;
+
+                std::size_t const num_runs = runs.size() - 1;
+                std::vector<std::size_t> next;
+                next.reserve(num_runs / 2 + 2);
+                for (std::size_t i = 0; i < num_runs; i += 2)
+                    next.push_back(runs[i]);
+                next.push_back(count);
+                runs.swap(next);
+            }
+
+            if (in_buffer)
+            {
+                sort_run_tasks(policy, num_chunks, [&](std::size_t chunk) {
+                    std::size_t const begin = chunk * chunk_size;
+                    std::size_t const end =
+                        (std::min)(begin + chunk_size, count);
+                    std::move(buf + begin, buf + end, first + begin);
+                });
+            }
+
+            return last;
+        }
+
+        // types which can't be moved without throwing are sorted
+        // sequentially
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        RandomIt parallel_stable_sort(ExPolicy, RandomIt first, RandomIt last,
+            Compare comp, std::size_t, std::false_type)
+        {
+            std::stable_sort(first, last, comp);
+            return last;
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt> parallel_stable_sort_async(
+            ExPolicy&& policy, RandomIt first, RandomIt last, Compare comp)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            // number of elements to sort
+            std::size_t count = last - first;
+
+            // figure out the chunk size to use
+            std::size_t const cores = execution::processing_units_count(
+                policy.executor(), policy.parameters());
+
+            std::size_t max_chunks = execution::maximal_number_of_chunks(
+                policy.parameters(), policy.executor(), cores, count);
+
+            std::size_t chunk_size = execution::get_chunk_size(
+                policy.parameters(), policy.executor(), [] { return 0; }, cores,
+                count);
+
+            util::detail::adjust_chunk_size_and_max_chunks(
+                cores, count, max_chunks, chunk_size);
+
+            // we should not get smaller than our sort_limit_per_task
+            chunk_size = (std::max)(chunk_size, sort_limit_per_task);
+
+            if (count < 2 * chunk_size)
+            {
+                std::stable_sort(first, last, comp);
+                return hpx::make_ready_future(last);
+            }
+
+            typedef std::integral_constant<bool,
+                is_sort_buffer_compatible<value_type>::value>
+                use_buffer;
+
+            typedef typename std::decay<ExPolicy>::type policy_type;
+            RandomIt (*sort_impl)(policy_type, RandomIt, RandomIt, Compare,
+                std::size_t, use_buffer) =
+                &parallel_stable_sort<policy_type, RandomIt, Compare>;
+
+            return execution::async_execute(policy.executor(), sort_impl,
+                std::forward<ExPolicy>(policy), first, last, comp, chunk_size,
+                use_buffer());
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // stable_sort
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare&& comp, Proj&& proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                RandomIt>::type
+            parallel(ExPolicy&& policy, RandomIt first, RandomIt last,
+                Compare&& comp, Proj&& proj)
+            {
+                typedef util::detail::algorithm_result<ExPolicy, RandomIt>
+                    algorithm_result;
+
+                try
+                {
+                    return algorithm_result::get(parallel_stable_sort_async(
+                        std::forward<ExPolicy>(policy), first, last,
+                        util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj))));
+                }
+                catch (...)
+                {
+                    return algorithm_result::get(
+                        detail::handle_exception<ExPolicy, RandomIt>::call(
+                            std::current_exception()));
+                }
+            }
+        };
+        /// \endcond
+    }    // namespace detail
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// order of equal elements is guaranteed to be preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons.
+    ///
+    /// A sequence is sorted with respect to a comparator \a comp and a
+    /// projection \a proj if for every iterator i pointing to the sequence and
+    /// every non-negative integer n such that i + n is a valid iterator
+    /// pointing to an element of the sequence, and
+    /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam RandomIt    The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// The parallel version sorts chunks of the input concurrently and merges
+    /// the sorted chunks pairwise. It uses a temporary buffer of the size of
+    /// the input if the elements can be moved without throwing, otherwise
+    /// the elements are sorted sequentially.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+        HPX_CONCEPT_REQUIRES_(execution::is_execution_policy<ExPolicy>::value&&
+                hpx::traits::is_iterator<RandomIt>::value&&
+                    traits::is_projected<Proj, RandomIt>::value&&
+                        traits::is_indirect_callable<ExPolicy, Compare,
+                            traits::projected<Proj, RandomIt>,
+                            traits::projected<Proj, RandomIt>>::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy&& policy, RandomIt first, RandomIt last,
+        Compare&& comp = Compare(), Proj&& proj = Proj())
+    {
+        static_assert((hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}    // namespace hpx::parallel::v1
+
+#endif
@@ -117,7 +117,7 @@ namespace hpx { namespace parallel { namespace util {
             typedef typename std::iterator_traits<iterator_type>::value_type
                 value_type;
 
-            typedef typename traits::vector_pack_type<value_type> V;
+            typedef typename traits::vector_pack_type<value_type>::type V;
 
             template <typename Begin, typename End, typename F>
             HPX_HOST_DEVICE HPX_FORCEINLINE static typename std::enable_if<
@@ -218,10 +218,9 @@ namespace hpx { namespace parallel { namespace util {
             call(InIter1 first1, InIter1 last1, InIter2 first2, OutIter dest,
                 F&& f)
             {
-                return util::transform_binary_loop_n<
-                    parallel::execution::datapar_policy>(first1,
-                    std::distance(first1, last1), first2, dest,
-                    std::forward<F>(f));
+                return datapar_transform_binary_loop_n<InIter1,
+                    InIter2>::call(first1, std::distance(first1, last1),
+                    first2, dest, std::forward<F>(f));
             }
 
             template <typename InIter1, typename InIter2, typename OutIter,
@@ -256,9 +255,9 @@ namespace hpx { namespace parallel { namespace util {
                 std::size_t count = (std::min)(
                     std::distance(first1, last1), std::distance(first2, last2));
 
-                return util::transform_binary_loop_n<
-                    parallel::execution::datapar_policy>(
-                    first1, count, first2, dest, std::forward<F>(f));
+                return datapar_transform_binary_loop_n<InIter1,
+                    InIter2>::call(first1, count, first2, dest,
+                    std::forward<F>(f));
             }
 
             template <typename InIter1, typename InIter2, typename OutIter,
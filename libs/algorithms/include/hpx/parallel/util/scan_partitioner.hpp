@@ -11,11 +11,13 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
+#include <hpx/datastructures/optional.hpp>
 #if !defined(HPX_COMPUTE_DEVICE_CODE)
 #include <hpx/dataflow.hpp>
 #endif
 #include <hpx/errors.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/yield_while.hpp>
 
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/executors/execution.hpp>
@@ -27,8 +29,10 @@
 #include <hpx/parallel/util/detail/select_partitioner.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <exception>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <type_traits>
@@ -46,6 +50,110 @@ namespace hpx { namespace parallel { namespace util {
 
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Status of a chunk of a single pass scan, published to the chunks
+        // following it.
+        struct scan_chunk_status
+        {
+            enum
+            {
+                empty = 0,        // nothing available yet
+                aggregate = 1,    // the local reduction is available
+                prefix = 2,       // the inclusive prefix is available
+                failed = 3        // an exception was thrown
+            };
+        };
+
+        template <typename Result1, typename Result2>
+        struct scan_chunk_state
+        {
+            scan_chunk_state()
+              : status_(scan_chunk_status::empty)
+            {
+            }
+
+            template <typename F3, typename... Ts>
+            void set_result(F3& f3, Ts&&... ts)
+            {
+                result_.emplace(f3(std::forward<Ts>(ts)...));
+            }
+
+            hpx::future<Result2> get_result()
+            {
+                return hpx::make_ready_future(std::move(*result_));
+            }
+
+            std::atomic<int> status_;
+            hpx::util::optional<Result1> aggregate_;
+            hpx::util::optional<Result1> prefix_;
+            hpx::util::optional<Result2> result_;
+        };
+
+        template <typename Result1>
+        struct scan_chunk_state<Result1, void>
+        {
+            scan_chunk_state()
+              : status_(scan_chunk_status::empty)
+            {
+            }
+
+            template <typename F3, typename... Ts>
+            void set_result(F3& f3, Ts&&... ts)
+            {
+                f3(std::forward<Ts>(ts)...);
+            }
+
+            hpx::future<void> get_result()
+            {
+                return hpx::make_ready_future();
+            }
+
+            std::atomic<int> status_;
+            hpx::util::optional<Result1> aggregate_;
+            hpx::util::optional<Result1> prefix_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Chunks processed in one pass are kept small enough for their data
+        // to stay in cache between step 1 and step 3.
+        static constexpr std::size_t max_single_pass_chunk_size = 16384;
+
+        // Return the chunk size used by the single pass scan. The cap is
+        // applied to all chunk sizes which were not given explicitly, that
+        // is if the executor parameters don't have a chunk size of their own
+        // or if they fall back to the default of four chunks per core.
+        template <typename ExPolicy>
+        std::size_t get_single_pass_chunk_size(
+            ExPolicy& policy, std::size_t count)
+        {
+            std::size_t const cores = execution::processing_units_count(
+                policy.executor(), policy.parameters());
+
+            std::size_t const default_chunk_size =
+                (count + 4 * cores - 1) / (4 * cores);    // -V112
+
+            std::size_t chunk_size = execution::get_chunk_size(
+                policy.parameters(), policy.executor(), []() { return 0; },
+                cores, count);
+
+            if (chunk_size == 0 || chunk_size == default_chunk_size)
+            {
+                chunk_size =
+                    (std::min)(max_single_pass_chunk_size, default_chunk_size);
+            }
+
+            // honor the maximal number of chunks, if given
+            std::size_t max_chunks = execution::maximal_number_of_chunks(
+                policy.parameters(), policy.executor(), cores, count);
+            if (max_chunks != 0)
+            {
+                chunk_size = (std::max)(
+                    chunk_size, (count + max_chunks - 1) / max_chunks);
+            }
+
+            return (std::max)(chunk_size, std::size_t(1));
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // The static partitioner simply spawns one chunk of iterations for
         // each available core.
@@ -63,6 +171,13 @@ namespace hpx { namespace parallel { namespace util {
             using handle_local_exceptions =
                 detail::handle_local_exceptions<ExPolicy>;
 
+            // The normal scan is performed in a single pass over the input
+            // using decoupled look-back: every chunk publishes its local
+            // reduction (step 1) as soon as it is available. The prefix of a
+            // chunk is then accumulated from the published results of its
+            // predecessors (step 2), stopping at the first chunk which has
+            // already published its inclusive prefix. Step 3 is run directly
+            // afterwards, while the chunk is still cached.
             template <typename ExPolicy_, typename FwdIter, typename T,
                 typename F1, typename F2, typename F3, typename F4>
             static R call(scan_partitioner_normal_tag, ExPolicy_ policy,
@@ -77,82 +192,100 @@ namespace hpx { namespace parallel { namespace util {
                 scoped_executor_parameters scoped_params(
                     policy.parameters(), policy.executor());
 
-                std::vector<hpx::shared_future<Result1>> workitems;
-                std::vector<hpx::future<Result2>> finalitems;
-                std::list<std::exception_ptr> errors;
-                try
-                {
-                    // pre-initialize first intermediate result
-                    workitems.push_back(
-                        make_ready_future(std::forward<T>(init)));
-
-                    HPX_ASSERT(count > 0);
-                    FwdIter first_ = first;
-                    std::size_t count_ = count;
+                HPX_ASSERT(count > 0);
 
-                    // estimate a chunk size based on number of cores used
-                    typedef typename execution::extract_has_variable_chunk_size<
-                        parameters_type>::type has_variable_chunk_size;
+                std::vector<FwdIter> chunks;
+                std::size_t chunk_size =
+                    get_single_pass_chunk_size(policy, count);
 
-                    auto shape = detail::get_bulk_iteration_shape(
-                        has_variable_chunk_size(), policy, workitems, f1, first,
-                        count, 1);
+                std::size_t const num_chunks =
+                    (count + chunk_size - 1) / chunk_size;
 
-                    // schedule every chunk on a separate thread
-                    std::size_t size = hpx::util::size(shape);
+                // chunks are claimed in order, which guarantees that all
+                // predecessors of a chunk are being worked on while its
+                // prefix is looked up
+                std::atomic<std::size_t> next_chunk(0);
 
-                    // If the size of count was enough to warrant testing for a
-                    // chunk, pre-initialize second intermediate result and
-                    // start f3.
-                    if (workitems.size() == 2)
+                // the workers refer to all of the above, they have to stay
+                // alive until the workers have been waited for below
+                std::vector<scan_chunk_state<Result1, Result2>> states;
+                std::vector<hpx::future<void>> workers;
+                std::list<std::exception_ptr> errors;
+                Result1 const initial(std::forward<T>(init));
+                try
+                {
+                    chunks.reserve(num_chunks);
+                    for (std::size_t i = 0; i != num_chunks; ++i)
                     {
-                        HPX_ASSERT(count_ > count);
+                        chunks.push_back(first);
+                        if (i != num_chunks - 1)
+                            std::advance(first, chunk_size);
+                    }
 
-                        workitems.reserve(size + 2);
-                        finalitems.reserve(size + 1);
+                    states = std::vector<scan_chunk_state<Result1, Result2>>(
+                        num_chunks);
 
-                        hpx::shared_future<Result1> curr = workitems[1];
-                        finalitems.push_back(dataflow(hpx::launch::sync, f3,
-                            first_, count_ - count, workitems[0], curr));
+                    auto worker = [&]() {
+                        for (std::size_t idx = next_chunk++; idx < num_chunks;
+                             idx = next_chunk++)
+                        {
+                            std::size_t size = (idx == num_chunks - 1) ?
+                                count - idx * chunk_size :
+                                chunk_size;
 
-                        workitems[1] =
-                            dataflow(hpx::launch::sync, f2, workitems[0], curr);
-                    }
-                    else
+                            scan_chunk(idx, chunks[idx], size, states,
+                                initial, f1, f2, f3);
+                        }
+                    };
+
+                    std::size_t const cores = execution::processing_units_count(
+                        policy.executor(), policy.parameters());
+                    std::size_t num_workers = (std::min)(cores, num_chunks);
+
+                    workers.reserve(num_workers);
+                    for (std::size_t i = 0; i != num_workers; ++i)
                     {
-                        workitems.reserve(size + 1);
-                        finalitems.reserve(size);
+                        workers.push_back(execution::async_execute(
+                            policy.executor(), worker));
                     }
 
-                    // Schedule first step of scan algorithm, step 2 is
-                    // performed as soon as the current partition and the
-                    // partition to the left is ready.
-                    for (auto const& elem : shape)
-                    {
-                        FwdIter it = hpx::util::get<0>(elem);
-                        std::size_t size = hpx::util::get<1>(elem);
+                    scoped_params.mark_end_of_scheduling();
+                }
+                catch (...)
+                {
+                    handle_local_exceptions::call(
+                        std::current_exception(), errors);
+                }
 
-                        hpx::shared_future<Result1> prev = workitems.back();
-                        auto curr = execution::async_execute(
-                            policy.executor(), f1, it, size)
-                                        .share();
+                // wait for all tasks to finish
+                hpx::wait_all(workers);
 
-                        finalitems.push_back(dataflow(
-                            hpx::launch::sync, f3, it, size, prev, curr));
+                // always rethrow if 'errors' is not empty or any of the
+                // workers has failed
+                handle_local_exceptions::call(workers, errors);
+
+                std::vector<hpx::shared_future<Result1>> workitems;
+                std::vector<hpx::future<Result2>> finalitems;
+                try
+                {
+                    workitems.reserve(states.size() + 1);
+                    finalitems.reserve(states.size());
 
+                    workitems.push_back(hpx::make_ready_future(initial));
+                    for (auto& state : states)
+                    {
                         workitems.push_back(
-                            dataflow(hpx::launch::sync, f2, prev, curr));
+                            hpx::make_ready_future(std::move(*state.prefix_)));
+                        finalitems.push_back(state.get_result());
                     }
 
-                    scoped_params.mark_end_of_scheduling();
+                    return f4(std::move(workitems), std::move(finalitems));
                 }
                 catch (...)
                 {
-                    handle_local_exceptions::call(
-                        std::current_exception(), errors);
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions::call(std::current_exception());
                 }
-                return reduce(std::move(workitems), std::move(finalitems),
-                    std::move(errors), std::forward<F4>(f4));
 #endif
             }
 
@@ -294,6 +427,86 @@ namespace hpx { namespace parallel { namespace util {
             }
 
         private:
+            // Accumulate the prefix of the chunk 'idx' from the results
+            // published by its predecessors. Returns false if any of the
+            // predecessors has failed.
+            template <typename F2>
+            static bool look_back(std::size_t idx,
+                std::vector<scan_chunk_state<Result1, Result2>>& states,
+                Result1 const& init, F2& f2,
+                hpx::util::optional<Result1>& prefix)
+            {
+                while (idx-- != 0)
+                {
+                    auto& state = states[idx];
+
+                    int status;
+                    hpx::util::yield_while([&]() {
+                        status = state.status_.load(std::memory_order_acquire);
+                        return status == scan_chunk_status::empty;
+                    });
+
+                    if (status == scan_chunk_status::failed)
+                        return false;
+
+                    if (status == scan_chunk_status::prefix)
+                    {
+                        prefix = prefix ? f2(*state.prefix_, *prefix) :
+                                          *state.prefix_;
+                        return true;
+                    }
+
+                    HPX_ASSERT(status == scan_chunk_status::aggregate);
+                    prefix = prefix ? f2(*state.aggregate_, *prefix) :
+                                      *state.aggregate_;
+                }
+
+                prefix = prefix ? f2(init, *prefix) : init;
+                return true;
+            }
+
+            template <typename FwdIter, typename F1, typename F2,
+                typename F3>
+            static void scan_chunk(std::size_t idx, FwdIter it,
+                std::size_t size,
+                std::vector<scan_chunk_state<Result1, Result2>>& states,
+                Result1 const& init, F1& f1, F2& f2, F3& f3)
+            {
+                auto& state = states[idx];
+                try
+                {
+                    // step 1: reduce this chunk and publish the result
+                    state.aggregate_.emplace(f1(it, size));
+                    state.status_.store(scan_chunk_status::aggregate,
+                        std::memory_order_release);
+
+                    // step 2: look up the prefix of this chunk
+                    hpx::util::optional<Result1> prev;
+                    if (!look_back(idx, states, init, f2, prev))
+                    {
+                        // a predecessor has already reported the error
+                        state.status_.store(scan_chunk_status::failed,
+                            std::memory_order_release);
+                        return;
+                    }
+
+                    state.prefix_.emplace(f2(*prev, *state.aggregate_));
+                    state.status_.store(
+                        scan_chunk_status::prefix, std::memory_order_release);
+
+                    // step 3: run the final accumulation on this chunk
+                    state.set_result(f3, it, size,
+                        hpx::make_ready_future(std::move(*prev)).share(),
+                        hpx::make_ready_future(*state.aggregate_).share());
+                }
+                catch (...)
+                {
+                    state.status_.store(scan_chunk_status::failed,
+                        std::memory_order_release);
+                    throw;
+                }
+            }
+
             template <typename F>
             static R reduce(
                 std::vector<hpx::shared_future<Result1>>&& workitems,
@@ -73,6 +73,53 @@ void inclusive_scan_test3()
     test_inclusive_scan3<std::forward_iterator_tag>();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename IteratorTag>
+void test_inclusive_scan4()
+{
+    using namespace hpx::parallel;
+
+    test_inclusive_scan4(execution::par, IteratorTag());
+
+    test_inclusive_scan4_async(execution::par(execution::task), IteratorTag());
+}
+
+void inclusive_scan_test4()
+{
+    test_inclusive_scan4<std::random_access_iterator_tag>();
+    test_inclusive_scan4<std::forward_iterator_tag>();
+}
+
+// the chunks of the single pass scan are capped unless a chunk size is given
+// explicitly
+void inclusive_scan_chunk_size_test()
+{
+    using namespace hpx::parallel;
+    using hpx::parallel::util::detail::get_single_pass_chunk_size;
+    using hpx::parallel::util::detail::max_single_pass_chunk_size;
+
+    // the default chunk size would be ten times the cap
+    std::size_t const cores = hpx::get_os_thread_count();
+    std::size_t const count = 40 * cores * max_single_pass_chunk_size;
+
+    auto policy = execution::par;
+    HPX_TEST_EQ(get_single_pass_chunk_size(policy, count),
+        max_single_pass_chunk_size);
+
+    auto task_policy = execution::par(execution::task);
+    HPX_TEST_EQ(get_single_pass_chunk_size(task_policy, count),
+        max_single_pass_chunk_size);
+
+    // small inputs are still split into four chunks per core
+    HPX_TEST_EQ(get_single_pass_chunk_size(policy, 4 * cores * 100),
+        std::size_t(100));
+
+    auto explicit_policy = execution::par.with(
+        execution::static_chunk_size(3 * max_single_pass_chunk_size));
+    HPX_TEST_EQ(get_single_pass_chunk_size(explicit_policy, count),
+        3 * max_single_pass_chunk_size);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename IteratorTag>
 void test_inclusive_scan_exception()
@@ -148,6 +195,8 @@ int hpx_main(hpx::program_options::variables_map& vm)
     inclusive_scan_test1();
     inclusive_scan_test2();
     inclusive_scan_test3();
+    inclusive_scan_test4();
+    inclusive_scan_chunk_size_test();
 
     inclusive_scan_exception_test();
     inclusive_scan_bad_alloc_test();
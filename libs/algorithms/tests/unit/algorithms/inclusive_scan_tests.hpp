@@ -15,7 +15,9 @@
 
 #include <boost/iterator/counting_iterator.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <utility>
@@ -201,6 +203,71 @@ void test_inclusive_scan3_async(ExPolicy p, IteratorTag)
     HPX_TEST(std::equal(std::begin(d), std::end(d), std::begin(e)));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Small chunks create many more chunks than there are cores, the prefix of
+// most of them is looked up from the results published by their
+// predecessors.
+template <typename ExPolicy, typename IteratorTag>
+void test_inclusive_scan4(ExPolicy policy, IteratorTag)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c(100007);
+    std::vector<std::size_t> d(c.size());
+    std::generate(std::begin(c), std::end(c), std::rand);
+
+    std::size_t const val(std::rand());
+    auto op = [](std::size_t v1, std::size_t v2) { return v1 + v2; };
+
+    for (std::size_t chunk_size : {1, 3, 16, 1000})
+    {
+        hpx::parallel::inclusive_scan(
+            policy.with(hpx::parallel::execution::static_chunk_size(
+                chunk_size)),
+            iterator(std::begin(c)), iterator(std::end(c)), std::begin(d), op,
+            val);
+
+        // verify values
+        std::vector<std::size_t> e(c.size());
+        hpx::parallel::v1::detail::sequential_inclusive_scan(
+            std::begin(c), std::end(c), std::begin(e), val, op);
+
+        HPX_TEST(std::equal(std::begin(d), std::end(d), std::begin(e)));
+    }
+}
+
+template <typename ExPolicy, typename IteratorTag>
+void test_inclusive_scan4_async(ExPolicy p, IteratorTag)
+{
+    typedef std::vector<std::size_t>::iterator base_iterator;
+    typedef test::test_iterator<base_iterator, IteratorTag> iterator;
+
+    std::vector<std::size_t> c(100007);
+    std::vector<std::size_t> d(c.size());
+    std::generate(std::begin(c), std::end(c), std::rand);
+
+    std::size_t const val(std::rand());
+    auto op = [](std::size_t v1, std::size_t v2) { return v1 + v2; };
+
+    hpx::future<void> f = hpx::parallel::inclusive_scan(
+        p.with(hpx::parallel::execution::static_chunk_size(7)),
+        iterator(std::begin(c)), iterator(std::end(c)), std::begin(d), op,
+        val);
+    f.wait();
+
+    // verify values
+    std::vector<std::size_t> e(c.size());
+    hpx::parallel::v1::detail::sequential_inclusive_scan(
+        std::begin(c), std::end(c), std::begin(e), val, op);
+
+    HPX_TEST(std::equal(std::begin(d), std::end(d), std::begin(e)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename ExPolicy, typename IteratorTag>
 void test_inclusive_scan_exception(ExPolicy policy, IteratorTag)
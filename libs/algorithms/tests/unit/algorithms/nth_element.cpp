@@ -0,0 +1,139 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_NTH_ELEMENT_TEST_SIZE 200000
+#else
+#define HPX_NTH_ELEMENT_TEST_SIZE 1000000
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+template <typename Compare>
+void verify_nth_element(std::vector<int> const& c, std::vector<int> sorted,
+    std::size_t nth, Compare comp)
+{
+    std::sort(sorted.begin(), sorted.end(), comp);
+    HPX_TEST_EQ(c[nth], sorted[nth]);
+
+    bool partitioned = true;
+    for (std::size_t i = 0; i != nth; ++i)
+        partitioned = partitioned && !comp(c[nth], c[i]);
+    for (std::size_t i = nth + 1; i < c.size(); ++i)
+        partitioned = partitioned && !comp(c[i], c[nth]);
+    HPX_TEST(partitioned);
+}
+
+template <typename ExPolicy>
+void test_nth_element(ExPolicy&& policy, std::size_t size, int range)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c(size);
+    for (auto& v : c)
+        v = std::rand() % range;
+
+    for (std::size_t nth : {std::size_t(0), size / 3, size - 1})
+    {
+        std::vector<int> orig(c);
+
+        auto result = hpx::parallel::nth_element(
+            policy, c.begin(), c.begin() + nth, c.end());
+        HPX_TEST(result == c.end());
+        verify_nth_element(c, orig, nth, std::less<int>());
+
+        result = hpx::parallel::nth_element(policy, c.begin(),
+            c.begin() + nth, c.end(), std::greater<int>());
+        HPX_TEST(result == c.end());
+        verify_nth_element(c, orig, nth, std::greater<int>());
+    }
+}
+
+template <typename ExPolicy>
+void test_nth_element_async(ExPolicy&& p, std::size_t size)
+{
+    std::vector<int> c(size);
+    for (auto& v : c)
+        v = std::rand();
+
+    std::vector<int> orig(c);
+    std::size_t nth = size / 2;
+
+    auto f =
+        hpx::parallel::nth_element(p, c.begin(), c.begin() + nth, c.end());
+    HPX_TEST(f.get() == c.end());
+    verify_nth_element(c, orig, nth, std::less<int>());
+}
+
+void nth_element_test()
+{
+    using namespace hpx::parallel;
+
+    for (std::size_t size :
+        {std::size_t(1), std::size_t(1000),
+            std::size_t(HPX_NTH_ELEMENT_TEST_SIZE)})
+    {
+        // many duplicates and (almost) unique values
+        for (int range : {10, RAND_MAX})
+        {
+            test_nth_element(execution::seq, size, range);
+            test_nth_element(execution::par, size, range);
+            test_nth_element(execution::par_unseq, size, range);
+        }
+
+        test_nth_element_async(execution::seq(execution::task), size);
+        test_nth_element_async(execution::par(execution::task), size);
+    }
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    nth_element_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -8,7 +8,10 @@
 #include <hpx/hpx_init.hpp>
 #include <hpx/testing.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -52,6 +55,79 @@ void sort_benchmark()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// large inputs with few distinct values make the sample sort produce many
+// equal splitters
+template <typename ExPolicy>
+void test_sort_duplicates(ExPolicy&& policy, int range)
+{
+    std::vector<int> c(HPX_SORT_TEST_SIZE << 2);
+    for (auto& v : c)
+        v = std::rand() % range;
+
+    std::vector<int> expected(c);
+    std::sort(expected.begin(), expected.end());
+
+    hpx::parallel::sort(policy, c.begin(), c.end());
+    HPX_TEST(c == expected);
+}
+
+void test_sort_duplicates()
+{
+    using namespace hpx::parallel;
+
+    for (int range : {1, 2, 17, 1000})
+    {
+        test_sort_duplicates(execution::par, range);
+        test_sort_duplicates(execution::par_unseq, range);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// arithmetic types sorted with the default comparison use the radix sort
+template <typename ExPolicy, typename T>
+void test_sort_arithmetic(ExPolicy&& policy, T)
+{
+    std::vector<T> c(HPX_SORT_TEST_SIZE << 2);
+    for (auto& v : c)
+        v = T(std::rand() - RAND_MAX / 2) / T(3);
+
+    std::vector<T> expected(c);
+    std::sort(expected.begin(), expected.end());
+
+    hpx::parallel::sort(policy, c.begin(), c.end());
+    HPX_TEST(c == expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_arithmetic_async(ExPolicy&& policy, T)
+{
+    std::vector<T> c(HPX_SORT_TEST_SIZE << 2);
+    for (auto& v : c)
+        v = T(std::rand() - RAND_MAX / 2) / T(3);
+
+    std::vector<T> expected(c);
+    std::sort(expected.begin(), expected.end());
+
+    auto f = hpx::parallel::sort(policy, c.begin(), c.end());
+    f.wait();
+    HPX_TEST(c == expected);
+}
+
+void test_sort_arithmetic()
+{
+    using namespace hpx::parallel;
+
+    test_sort_arithmetic(execution::par, int());
+    test_sort_arithmetic(execution::par, std::int64_t());
+    test_sort_arithmetic(execution::par, std::uint16_t());
+    test_sort_arithmetic(execution::par_unseq, float());
+    test_sort_arithmetic(execution::par_unseq, double());
+
+    test_sort_arithmetic_async(execution::par(execution::task), int());
+    test_sort_arithmetic_async(execution::par(execution::task), double());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void test_sort1()
 {
@@ -166,6 +242,8 @@ int hpx_main(hpx::program_options::variables_map& vm)
 
     test_sort1();
     test_sort2();
+    test_sort_duplicates();
+    test_sort_arithmetic();
     sort_benchmark();
 
     return hpx::finalize();
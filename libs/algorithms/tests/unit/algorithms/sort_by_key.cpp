@@ -11,6 +11,10 @@
 #include <hpx/parallel/algorithms/sort_by_key.hpp>
 #include <hpx/testing.hpp>
 //
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <numeric>
 #include <string>
@@ -221,6 +225,40 @@ void test_sort_by_key_async(
     HPX_TEST(is_equal);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// arithmetic keys with duplicates and negative values, these are handled by
+// the radix sort if the values are trivially copyable
+template <typename ExPolicy, typename Tkey>
+void test_sort_by_key_arithmetic(ExPolicy&& policy, Tkey)
+{
+    std::size_t const size = std::size_t(1) << 17;
+
+    std::vector<Tkey> keys(size);
+    for (auto& k : keys)
+        k = Tkey(std::rand() % 2001 - 1000) / Tkey(3);
+
+    std::vector<std::size_t> values(size);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<Tkey> const o_keys = keys;
+
+    auto result = hpx::parallel::sort_by_key(
+        policy, keys.begin(), keys.end(), values.begin());
+    HPX_TEST(result.in1() == keys.end());
+    HPX_TEST(result.in2() == values.end());
+
+    HPX_TEST(std::is_sorted(keys.begin(), keys.end()));
+
+    // every value has to stay attached to its key
+    bool is_equal = true;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (keys[i] != o_keys[values[i]])    //-V550
+            is_equal = false;
+    }
+    HPX_TEST(is_equal);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void test_sort_by_key1()
 {
@@ -294,6 +332,13 @@ int hpx_main(hpx::program_options::variables_map& vm)
     std::srand(seed);
 
     test_sort_by_key1();
+
+    using namespace hpx::parallel;
+    test_sort_by_key_arithmetic(execution::par, int());
+    test_sort_by_key_arithmetic(execution::par, std::int64_t());
+    test_sort_by_key_arithmetic(execution::par_unseq, float());
+    test_sort_by_key_arithmetic(execution::par_unseq, double());
+
     sort_by_key_benchmark();
 
     return hpx::finalize();
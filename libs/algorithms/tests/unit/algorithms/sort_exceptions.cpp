@@ -7,7 +7,12 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -43,6 +48,99 @@ void test_exceptions()
         execution::par(execution::task), int(), std::less<int>());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Large inputs are sorted through a temporary buffer, a comparison operator
+// throwing in any of the phases of the sort must not leak elements.
+std::atomic<std::int64_t> num_instances(0);
+std::atomic<std::size_t> num_comparisons(0);
+
+struct counted
+{
+    counted(int value = 0) noexcept
+      : value_(value)
+    {
+        ++num_instances;
+    }
+
+    counted(counted const& rhs) noexcept
+      : value_(rhs.value_)
+    {
+        ++num_instances;
+    }
+
+    counted(counted&& rhs) noexcept
+      : value_(rhs.value_)
+    {
+        ++num_instances;
+    }
+
+    counted& operator=(counted const& rhs) noexcept = default;
+    counted& operator=(counted&& rhs) noexcept = default;
+
+    ~counted()
+    {
+        --num_instances;
+    }
+
+    int value_;
+};
+
+struct throwing_less
+{
+    bool operator()(counted const& lhs, counted const& rhs) const
+    {
+        if (++num_comparisons == throw_after_)
+            throw std::runtime_error("test");
+        return lhs.value_ < rhs.value_;
+    }
+
+    std::size_t throw_after_;
+};
+
+template <typename ExPolicy>
+void test_sort_comp_exception(ExPolicy&& policy, std::size_t throw_after)
+{
+    {
+        std::vector<counted> c(std::size_t(1) << 20);
+        for (counted& v : c)
+            v.value_ = std::rand();
+
+        num_comparisons = 0;
+
+        bool caught_exception = false;
+        try
+        {
+            hpx::parallel::sort(
+                policy, c.begin(), c.end(), throwing_less{throw_after});
+            HPX_TEST(false);
+        }
+        catch (hpx::exception_list const&)
+        {
+            caught_exception = true;
+        }
+        catch (...)
+        {
+            HPX_TEST(false);
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    HPX_TEST_EQ(num_instances.load(), std::int64_t(0));
+}
+
+void test_comp_exceptions()
+{
+    using namespace hpx::parallel;
+
+    // throw while the splitters are selected, while the elements are
+    // classified, and while the buckets are sorted
+    std::size_t const count = std::size_t(1) << 20;
+    for (std::size_t throw_after : {std::size_t(1000), count, 8 * count})
+    {
+        test_sort_comp_exception(execution::par, throw_after);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int hpx_main(hpx::program_options::variables_map& vm)
 {
@@ -54,6 +152,7 @@ int hpx_main(hpx::program_options::variables_map& vm)
     std::srand(seed);
 
     test_exceptions();
+    test_comp_exceptions();
     return hpx::finalize();
 }
 
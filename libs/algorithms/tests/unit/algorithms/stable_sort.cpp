@@ -0,0 +1,179 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_STABLE_SORT_TEST_SIZE 200000
+#else
+#define HPX_STABLE_SORT_TEST_SIZE 1000000
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// the keys are drawn from a small range, the second element records the
+// original position of each element
+std::vector<std::pair<int, std::size_t>> make_input(std::size_t size)
+{
+    std::vector<std::pair<int, std::size_t>> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c[i] = std::make_pair(std::rand() % 1000, i);
+    return c;
+}
+
+bool is_stably_sorted(std::vector<std::pair<int, std::size_t>> const& c)
+{
+    for (std::size_t i = 1; i < c.size(); ++i)
+    {
+        if (c[i].first < c[i - 1].first)
+            return false;
+        if (c[i].first == c[i - 1].first && c[i].second < c[i - 1].second)
+            return false;
+    }
+    return true;
+}
+
+template <typename ExPolicy>
+void test_stable_sort(ExPolicy&& policy, std::size_t size)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    auto c = make_input(size);
+
+    auto result = hpx::parallel::stable_sort(policy, c.begin(), c.end(),
+        std::less<int>(),
+        [](std::pair<int, std::size_t> const& p) { return p.first; });
+
+    HPX_TEST(result == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy&& p, std::size_t size)
+{
+    auto c = make_input(size);
+
+    auto f = hpx::parallel::stable_sort(p, c.begin(), c.end(),
+        [](std::pair<int, std::size_t> const& lhs,
+            std::pair<int, std::size_t> const& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+    HPX_TEST(f.get() == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_strings(ExPolicy&& policy)
+{
+    std::vector<std::string> c(HPX_STABLE_SORT_TEST_SIZE / 4);
+    for (auto& s : c)
+        s = std::to_string(std::rand());
+
+    std::vector<std::string> expected(c);
+    std::stable_sort(expected.begin(), expected.end(),
+        std::greater<std::string>());
+
+    hpx::parallel::stable_sort(
+        policy, c.begin(), c.end(), std::greater<std::string>());
+    HPX_TEST(c == expected);
+}
+
+// comparators and projections taking their arguments by value must never see
+// elements which were moved from
+template <typename ExPolicy>
+void test_stable_sort_strings_by_value(ExPolicy&& policy)
+{
+    std::vector<std::string> c(HPX_STABLE_SORT_TEST_SIZE / 4);
+    for (std::size_t i = 0; i != c.size(); ++i)
+        c[i] = std::to_string(std::rand() % 10) + "_" + std::to_string(i);
+
+    // only the first character is compared, equal elements must keep their
+    // order
+    auto comp = [](std::string lhs, std::string rhs) {
+        return lhs[0] < rhs[0];
+    };
+
+    std::vector<std::string> expected(c);
+    std::stable_sort(expected.begin(), expected.end(), comp);
+
+    std::vector<std::string> d(c);
+    hpx::parallel::stable_sort(policy, c.begin(), c.end(), comp);
+    HPX_TEST(c == expected);
+
+    hpx::parallel::stable_sort(policy, d.begin(), d.end(), std::less<char>(),
+        [](std::string s) { return s[0]; });
+    HPX_TEST(d == expected);
+}
+
+void stable_sort_test()
+{
+    using namespace hpx::parallel;
+
+    for (std::size_t size : {std::size_t(0), std::size_t(1),
+             std::size_t(1000), std::size_t(HPX_STABLE_SORT_TEST_SIZE)})
+    {
+        test_stable_sort(execution::seq, size);
+        test_stable_sort(execution::par, size);
+        test_stable_sort(execution::par_unseq, size);
+
+        test_stable_sort_async(execution::seq(execution::task), size);
+        test_stable_sort_async(execution::par(execution::task), size);
+    }
+
+    test_stable_sort_strings(execution::seq);
+    test_stable_sort_strings(execution::par);
+
+    test_stable_sort_strings_by_value(execution::seq);
+    test_stable_sort_strings_by_value(execution::par);
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    stable_sort_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_NTH_ELEMENT_TEST_SIZE 200000
+#else
+#define HPX_NTH_ELEMENT_TEST_SIZE 1000000
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_input()
+{
+    std::vector<int> c(HPX_NTH_ELEMENT_TEST_SIZE);
+    for (auto& v : c)
+        v = std::rand();
+    return c;
+}
+
+void verify_nth_element(
+    std::vector<int> const& c, std::vector<int> sorted, std::size_t nth)
+{
+    std::sort(sorted.begin(), sorted.end());
+    HPX_TEST_EQ(c[nth], sorted[nth]);
+    HPX_TEST(std::all_of(c.begin(), c.begin() + nth,
+        [&](int v) { return v <= c[nth]; }));
+    HPX_TEST(std::all_of(c.begin() + nth, c.end(),
+        [&](int v) { return v >= c[nth]; }));
+}
+
+template <typename ExPolicy>
+void test_nth_element(ExPolicy&& policy)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_input();
+    std::vector<int> orig(c);
+    std::size_t nth = c.size() / 3;
+
+    auto result = hpx::parallel::nth_element(policy, c, c.begin() + nth);
+    HPX_TEST(result == c.end());
+    verify_nth_element(c, orig, nth);
+}
+
+template <typename ExPolicy>
+void test_nth_element_async(ExPolicy&& p)
+{
+    std::vector<int> c = make_input();
+    std::vector<int> orig(c);
+    std::size_t nth = c.size() / 3;
+
+    auto f = hpx::parallel::nth_element(p, c, c.begin() + nth);
+    HPX_TEST(f.get() == c.end());
+    verify_nth_element(c, orig, nth);
+}
+
+void nth_element_test()
+{
+    using namespace hpx::parallel;
+
+    test_nth_element(execution::seq);
+    test_nth_element(execution::par);
+    test_nth_element(execution::par_unseq);
+
+    test_nth_element_async(execution::seq(execution::task));
+    test_nth_element_async(execution::par(execution::task));
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    nth_element_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
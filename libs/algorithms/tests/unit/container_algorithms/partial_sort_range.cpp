@@ -0,0 +1,116 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_PARTIAL_SORT_TEST_SIZE 200000
+#else
+#define HPX_PARTIAL_SORT_TEST_SIZE 1000000
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+std::vector<int> make_input()
+{
+    std::vector<int> c(HPX_PARTIAL_SORT_TEST_SIZE);
+    for (auto& v : c)
+        v = std::rand();
+    return c;
+}
+
+void verify_partial_sort(
+    std::vector<int> const& c, std::vector<int> sorted, std::size_t middle)
+{
+    std::sort(sorted.begin(), sorted.end());
+    HPX_TEST(std::equal(c.begin(), c.begin() + middle, sorted.begin()));
+}
+
+template <typename ExPolicy>
+void test_partial_sort(ExPolicy&& policy)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<int> c = make_input();
+    std::vector<int> orig(c);
+    std::size_t middle = c.size() / 10;
+
+    auto result =
+        hpx::parallel::partial_sort(policy, c, c.begin() + middle);
+    HPX_TEST(result == c.end());
+    verify_partial_sort(c, orig, middle);
+}
+
+template <typename ExPolicy>
+void test_partial_sort_async(ExPolicy&& p)
+{
+    std::vector<int> c = make_input();
+    std::vector<int> orig(c);
+    std::size_t middle = c.size() / 10;
+
+    auto f = hpx::parallel::partial_sort(p, c, c.begin() + middle);
+    HPX_TEST(f.get() == c.end());
+    verify_partial_sort(c, orig, middle);
+}
+
+void partial_sort_test()
+{
+    using namespace hpx::parallel;
+
+    test_partial_sort(execution::seq);
+    test_partial_sort(execution::par);
+    test_partial_sort(execution::par_unseq);
+
+    test_partial_sort_async(execution::seq(execution::task));
+    test_partial_sort_async(execution::par(execution::task));
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    partial_sort_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,121 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_STABLE_SORT_TEST_SIZE 200000
+#else
+#define HPX_STABLE_SORT_TEST_SIZE 1000000
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+struct element
+{
+    int key;
+    std::size_t index;
+};
+
+std::vector<element> make_input()
+{
+    std::vector<element> c(HPX_STABLE_SORT_TEST_SIZE);
+    for (std::size_t i = 0; i != c.size(); ++i)
+        c[i] = element{std::rand() % 1000, i};
+    return c;
+}
+
+bool is_stably_sorted(std::vector<element> const& c)
+{
+    return std::is_sorted(
+        c.begin(), c.end(), [](element const& lhs, element const& rhs) {
+            return lhs.key < rhs.key ||
+                (lhs.key == rhs.key && lhs.index < rhs.index);
+        });
+}
+
+template <typename ExPolicy>
+void test_stable_sort(ExPolicy&& policy)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<element> c = make_input();
+
+    auto result = hpx::parallel::stable_sort(
+        policy, c, std::less<int>(), [](element const& e) { return e.key; });
+    HPX_TEST(result == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy&& p)
+{
+    std::vector<element> c = make_input();
+
+    auto f = hpx::parallel::stable_sort(
+        p, c, std::less<int>(), [](element const& e) { return e.key; });
+    HPX_TEST(f.get() == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+void stable_sort_test()
+{
+    using namespace hpx::parallel;
+
+    test_stable_sort(execution::seq);
+    test_stable_sort(execution::par);
+    test_stable_sort(execution::par_unseq);
+
+    test_stable_sort_async(execution::seq(execution::task));
+    test_stable_sort_async(execution::par(execution::task));
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    stable_sort_test();
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,287 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_THREAD_LOCAL_CACHING_ALLOCATOR_JAN_2020)
+#define HPX_UTIL_THREAD_LOCAL_CACHING_ALLOCATOR_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/internal_allocator.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util {
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Memory blocks released by a (kernel-) thread are kept in a cache
+        // local to this thread and are handed out again for the next
+        // allocation of the same size class. This avoids going to the system
+        // allocator for short-lived objects which are created and destroyed
+        // in quick succession (e.g. the shared states of futures).
+        template <typename Allocator>
+        class thread_local_cache
+        {
+        public:
+            // blocks of up to 1kB are cached in size classes of 64 bytes
+            static constexpr std::size_t size_class_granularity = 64;
+            static constexpr std::size_t num_size_classes = 16;
+            static constexpr std::size_t max_cached_size =
+                size_class_granularity * num_size_classes;
+
+            // maximum number of blocks kept per size class
+            static constexpr std::size_t max_cached_blocks = 64;
+
+            static std::size_t size_class(std::size_t size) noexcept
+            {
+                return (size - 1) / size_class_granularity;
+            }
+
+            // allocate a block of the size class of the given size
+            static void* allocate(std::size_t size)
+            {
+                std::size_t cls = size_class(size);
+
+                thread_local_cache* cache = get();
+                if (cache != nullptr && cache->counts_[cls] != 0)
+                    return cache->blocks_[cls][--cache->counts_[cls]];
+
+                ++upstream_allocations();
+
+                char_allocator alloc;
+                return alloc.allocate(block_size(cls));
+            }
+
+            // release a block allocated by any thread to the cache of this
+            // thread
+            static void deallocate(void* p, std::size_t size) noexcept
+            {
+                std::size_t cls = size_class(size);
+
+                thread_local_cache* cache = get();
+                if (cache != nullptr &&
+                    cache->counts_[cls] != max_cached_blocks)
+                {
+                    cache->blocks_[cls][cache->counts_[cls]++] = p;
+                    return;
+                }
+
+                ++upstream_deallocations();
+
+                char_allocator alloc;
+                alloc.deallocate(static_cast<char*>(p), block_size(cls));
+            }
+
+            thread_local_cache(thread_local_cache const&) = delete;
+            thread_local_cache& operator=(thread_local_cache const&) = delete;
+
+            // number of blocks allocated from (returned to) the system by
+            // all threads
+            static std::atomic<std::int64_t>& upstream_allocations() noexcept
+            {
+                static std::atomic<std::int64_t> allocations(0);
+                return allocations;
+            }
+
+            static std::atomic<std::int64_t>& upstream_deallocations() noexcept
+            {
+                static std::atomic<std::int64_t> deallocations(0);
+                return deallocations;
+            }
+
+        private:
+            typedef typename std::allocator_traits<
+                Allocator>::template rebind_alloc<char>
+                char_allocator;
+
+            enum cache_status
+            {
+                uninitialized = 0,
+                alive = 1,
+                destroyed = 2
+            };
+
+            static thread_local_cache* get() noexcept
+            {
+                // the cache is not accessible anymore while this thread is
+                // being shut down, all blocks are returned to the system
+                if (status() == destroyed)
+                    return nullptr;
+
+                static thread_local thread_local_cache cache;
+                return &cache;
+            }
+
+            // the status is trivially destructible and can be queried after
+            // the cache has been destroyed
+            static cache_status& status() noexcept
+            {
+                static thread_local cache_status status_ = uninitialized;
+                return status_;
+            }
+
+            static std::size_t block_size(std::size_t cls) noexcept
+            {
+                return (cls + 1) * size_class_granularity;
+            }
+
+            thread_local_cache()
+              : counts_()
+            {
+                status() = alive;
+            }
+
+            ~thread_local_cache()
+            {
+                char_allocator alloc;
+                for (std::size_t cls = 0; cls != num_size_classes; ++cls)
+                {
+                    for (std::size_t i = 0; i != counts_[cls]; ++i)
+                    {
+                        ++upstream_deallocations();
+                        alloc.deallocate(static_cast<char*>(blocks_[cls][i]),
+                            block_size(cls));
+                    }
+                }
+                status() = destroyed;
+            }
+
+            std::size_t counts_[num_size_classes];
+            void* blocks_[num_size_classes][max_cached_blocks];
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An allocator caching the memory of small objects in the (kernel-)
+    // thread releasing them. Larger and over-aligned objects are directly
+    // allocated using the underlying allocator.
+    template <typename T = char, typename Allocator = internal_allocator<char>>
+    struct thread_local_caching_allocator
+    {
+    private:
+        typedef detail::thread_local_cache<Allocator> cache_type;
+        typedef typename std::allocator_traits<
+            Allocator>::template rebind_alloc<T>
+            upstream_allocator;
+
+        // T may still be incomplete when the allocator type is instantiated
+        static constexpr bool is_cachable(std::size_t size) noexcept
+        {
+            return alignof(T) <= alignof(std::max_align_t) && size != 0 &&
+                size <= cache_type::max_cached_size;
+        }
+
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef thread_local_caching_allocator<U, Allocator> other;
+        };
+
+        typedef std::true_type is_always_equal;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        thread_local_caching_allocator() = default;
+
+        template <typename U>
+        explicit thread_local_caching_allocator(
+            thread_local_caching_allocator<U, Allocator> const&)
+        {
+        }
+
+        pointer allocate(size_type n, void const* = nullptr)
+        {
+            std::size_t size = n * sizeof(T);
+            if (is_cachable(size))
+            {
+                return static_cast<pointer>(cache_type::allocate(size));
+            }
+
+            upstream_allocator alloc;
+            return std::allocator_traits<upstream_allocator>::allocate(
+                alloc, n);
+        }
+
+        void deallocate(pointer p, size_type n) noexcept
+        {
+            std::size_t size = n * sizeof(T);
+            if (is_cachable(size))
+            {
+                cache_type::deallocate(p, size);
+                return;
+            }
+
+            upstream_allocator alloc;
+            std::allocator_traits<upstream_allocator>::deallocate(alloc, p, n);
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(T);
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args)
+        {
+            ::new ((void*) p) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+
+        // Return the number of memory blocks which had to be allocated from
+        // (were returned to) the underlying allocator, accumulated over all
+        // threads.
+        static std::int64_t get_upstream_allocations() noexcept
+        {
+            return cache_type::upstream_allocations().load(
+                std::memory_order_relaxed);
+        }
+
+        static std::int64_t get_upstream_deallocations() noexcept
+        {
+            return cache_type::upstream_deallocations().load(
+                std::memory_order_relaxed);
+        }
+    };
+
+    template <typename T, typename U, typename Allocator>
+    HPX_CONSTEXPR bool operator==(
+        thread_local_caching_allocator<T, Allocator> const&,
+        thread_local_caching_allocator<U, Allocator> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U, typename Allocator>
+    HPX_CONSTEXPR bool operator!=(
+        thread_local_caching_allocator<T, Allocator> const&,
+        thread_local_caching_allocator<U, Allocator> const&)
+    {
+        return false;
+    }
+}}    // namespace hpx::util
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,424 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_THREAD_LOCAL_SLAB_ALLOCATOR_OCT_2020)
+#define HPX_UTIL_THREAD_LOCAL_SLAB_ALLOCATOR_OCT_2020
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/internal_allocator.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util {
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // A slab_pool hands out equally sized slots for objects of type T
+        // from slabs of slots_per_slab slots each. Only the owning (kernel-)
+        // thread allocates from a pool, therefore carving out new slots and
+        // reusing slots freed by the owner does not need any synchronization.
+        // Slots freed by other threads are pushed onto a lock-free list which
+        // the owner takes over as a whole once its local free list runs dry.
+        //
+        // Every slot starts with a pointer to the pool it belongs to, which
+        // allows to release an object from any thread. A pool stays alive
+        // until the owning thread has exited and all of its objects have been
+        // released.
+        template <typename T, typename Allocator>
+        class slab_pool
+        {
+            struct free_node
+            {
+                free_node* next;
+            };
+
+            typedef typename std::allocator_traits<
+                Allocator>::template rebind_alloc<char>
+                char_allocator;
+
+        public:
+            static constexpr std::size_t slots_per_slab = 64;
+
+            // T may still be incomplete when the pool type is instantiated
+            static constexpr std::size_t alignment() noexcept
+            {
+                return alignof(T) > alignof(slab_pool*) ? alignof(T) :
+                                                          alignof(slab_pool*);
+            }
+
+            static constexpr std::size_t header_size() noexcept
+            {
+                return (sizeof(slab_pool*) + alignment() - 1) &
+                    ~(alignment() - 1);
+            }
+
+            static constexpr std::size_t slot_size() noexcept
+            {
+                return (header_size() + sizeof(T) + alignment() - 1) &
+                    ~(alignment() - 1);
+            }
+
+            slab_pool()
+              : next_slot_(slots_per_slab)
+              , local_free_(nullptr)
+              , remote_free_(nullptr)
+              , refcount_(1)
+            {
+            }
+
+            slab_pool(slab_pool const&) = delete;
+            slab_pool& operator=(slab_pool const&) = delete;
+
+            // may be called by the owning thread only
+            void* allocate()
+            {
+                if (local_free_ == nullptr &&
+                    remote_free_.load(std::memory_order_relaxed) != nullptr)
+                {
+                    local_free_ =
+                        remote_free_.exchange(nullptr, std::memory_order_acquire);
+                }
+
+                void* p = nullptr;
+                if (local_free_ != nullptr)
+                {
+                    free_node* node = local_free_;
+                    local_free_ = node->next;
+                    p = node;
+                }
+                else
+                {
+                    if (next_slot_ == slots_per_slab)
+                        new_slab();
+
+                    char* slot = slabs_.back() + next_slot_++ * slot_size();
+                    ::new (static_cast<void*>(slot)) slab_pool*(this);
+                    p = slot + header_size();
+                }
+
+                refcount_.fetch_add(1, std::memory_order_relaxed);
+                return p;
+            }
+
+            // may be called by any thread, owner is true if the calling
+            // thread is the one owning the pool
+            void deallocate(void* p, bool owner) noexcept
+            {
+                free_node* node = ::new (p) free_node;
+                if (owner)
+                {
+                    node->next = local_free_;
+                    local_free_ = node;
+                }
+                else
+                {
+                    node->next = remote_free_.load(std::memory_order_relaxed);
+                    while (!remote_free_.compare_exchange_weak(node->next,
+                        node, std::memory_order_release,
+                        std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                release();
+            }
+
+            // called once the owning thread exits, the pool is destroyed as
+            // soon as the last object allocated from it has been released
+            void release() noexcept
+            {
+                if (refcount_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            // return the pool the given object was allocated from
+            static slab_pool* get_pool(void* p) noexcept
+            {
+                return *reinterpret_cast<slab_pool**>(
+                    static_cast<char*>(p) - header_size());
+            }
+
+            // number of slabs allocated from (returned to) the underlying
+            // allocator by all threads
+            static std::atomic<std::int64_t>& upstream_allocations() noexcept
+            {
+                static std::atomic<std::int64_t> allocations(0);
+                return allocations;
+            }
+
+            static std::atomic<std::int64_t>& upstream_deallocations() noexcept
+            {
+                static std::atomic<std::int64_t> deallocations(0);
+                return deallocations;
+            }
+
+        private:
+            ~slab_pool()
+            {
+                char_allocator alloc;
+                for (char* slab : slabs_)
+                {
+                    ++upstream_deallocations();
+                    alloc.deallocate(slab, slots_per_slab * slot_size());
+                }
+            }
+
+            void new_slab()
+            {
+                char_allocator alloc;
+                slabs_.reserve(slabs_.size() + 1);
+                slabs_.push_back(alloc.allocate(slots_per_slab * slot_size()));
+                ++upstream_allocations();
+                next_slot_ = 0;
+            }
+
+            // accessed by the owning thread only
+            std::vector<char*> slabs_;
+            std::size_t next_slot_;
+            free_node* local_free_;
+
+            std::atomic<free_node*> remote_free_;
+
+            // number of outstanding objects plus one for the owning thread
+            std::atomic<std::size_t> refcount_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The pool owned by the calling (kernel-) thread
+        template <typename T, typename Allocator>
+        class thread_slab_pool
+        {
+            typedef slab_pool<T, Allocator> pool_type;
+
+            enum pool_status
+            {
+                uninitialized = 0,
+                alive = 1,
+                destroyed = 2
+            };
+
+        public:
+            thread_slab_pool(thread_slab_pool const&) = delete;
+            thread_slab_pool& operator=(thread_slab_pool const&) = delete;
+
+            // return the pool of this thread, nullptr if this thread is
+            // being shut down
+            static pool_type* get() noexcept
+            {
+                if (status() == destroyed)
+                    return nullptr;
+
+                static thread_local thread_slab_pool pool;
+                return pool.pool_;
+            }
+
+            // return whether the given pool is owned by this thread, does not
+            // create the pool if this thread hasn't allocated anything yet
+            static bool owns(pool_type const* pool) noexcept
+            {
+                return status() == alive && get() == pool;
+            }
+
+        private:
+            // the status is trivially destructible and can be queried after
+            // the pool has been released
+            static pool_status& status() noexcept
+            {
+                static thread_local pool_status status_ = uninitialized;
+                return status_;
+            }
+
+            thread_slab_pool()
+              : pool_(new pool_type)
+            {
+                status() = alive;
+            }
+
+            ~thread_slab_pool()
+            {
+                status() = destroyed;
+                pool_->release();
+            }
+
+            pool_type* pool_;
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An allocator for single objects of one type handing out slots from
+    // slabs owned by the (kernel-) thread allocating them. Releasing an
+    // object on the allocating thread puts its slot back onto a local free
+    // list, other threads give it back to the owner using a lock-free list.
+    // Neither path takes a lock. Arrays of objects are directly allocated
+    // using the underlying allocator.
+    template <typename T, typename Allocator = internal_allocator<char>>
+    struct thread_local_slab_allocator
+    {
+    private:
+        typedef detail::slab_pool<T, Allocator> pool_type;
+        typedef detail::thread_slab_pool<T, Allocator> thread_pool_type;
+        typedef typename std::allocator_traits<
+            Allocator>::template rebind_alloc<T>
+            upstream_allocator;
+
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef thread_local_slab_allocator<U, Allocator> other;
+        };
+
+        typedef std::true_type is_always_equal;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        thread_local_slab_allocator() = default;
+
+        template <typename U>
+        explicit thread_local_slab_allocator(
+            thread_local_slab_allocator<U, Allocator> const&)
+        {
+        }
+
+        pointer allocate(size_type n, void const* = nullptr)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t),
+                "thread_local_slab_allocator does not support over-aligned "
+                "types");
+
+            if (n == 1)
+            {
+                pool_type* pool = thread_pool_type::get();
+                if (pool != nullptr)
+                    return static_cast<pointer>(pool->allocate());
+            }
+
+            // the slot of a single object allocated while this thread is
+            // being shut down is not owned by any pool
+            return allocate_unpooled(n);
+        }
+
+        void deallocate(pointer p, size_type n) noexcept
+        {
+            if (n == 1)
+            {
+                pool_type* pool = pool_type::get_pool(p);
+                if (pool != nullptr)
+                {
+                    pool->deallocate(p, thread_pool_type::owns(pool));
+                    return;
+                }
+            }
+            deallocate_unpooled(p, n);
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(T);
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args)
+        {
+            ::new ((void*) p) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+
+        // Return the number of slabs which had to be allocated from (were
+        // returned to) the underlying allocator, accumulated over all
+        // threads.
+        static std::int64_t get_upstream_allocations() noexcept
+        {
+            return pool_type::upstream_allocations().load(
+                std::memory_order_relaxed);
+        }
+
+        static std::int64_t get_upstream_deallocations() noexcept
+        {
+            return pool_type::upstream_deallocations().load(
+                std::memory_order_relaxed);
+        }
+
+    private:
+        typedef typename std::allocator_traits<
+            Allocator>::template rebind_alloc<char>
+            char_allocator;
+
+        static pointer allocate_unpooled(size_type n)
+        {
+            if (n != 1)
+            {
+                upstream_allocator alloc;
+                return std::allocator_traits<upstream_allocator>::allocate(
+                    alloc, n);
+            }
+
+            char_allocator alloc;
+            char* slot = alloc.allocate(pool_type::slot_size());
+            ::new (static_cast<void*>(slot)) pool_type*(nullptr);
+            return reinterpret_cast<pointer>(slot + pool_type::header_size());
+        }
+
+        static void deallocate_unpooled(pointer p, size_type n) noexcept
+        {
+            if (n != 1)
+            {
+                upstream_allocator alloc;
+                std::allocator_traits<upstream_allocator>::deallocate(
+                    alloc, p, n);
+                return;
+            }
+
+            char_allocator alloc;
+            alloc.deallocate(
+                reinterpret_cast<char*>(p) - pool_type::header_size(),
+                pool_type::slot_size());
+        }
+    };
+
+    template <typename T, typename U, typename Allocator>
+    HPX_CONSTEXPR bool operator==(
+        thread_local_slab_allocator<T, Allocator> const&,
+        thread_local_slab_allocator<U, Allocator> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U, typename Allocator>
+    HPX_CONSTEXPR bool operator!=(
+        thread_local_slab_allocator<T, Allocator> const&,
+        thread_local_slab_allocator<U, Allocator> const&)
+    {
+        return false;
+    }
+}}    // namespace hpx::util
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,197 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
+#include <hpx/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The upstream allocator keeps track of the number of blocks it has handed
+// out. Using it also gives the tests a cache of their own.
+std::atomic<std::int64_t> live_blocks(0);
+
+template <typename T>
+struct counting_allocator
+{
+    typedef T value_type;
+
+    counting_allocator() = default;
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        --live_blocks;
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+typedef hpx::util::thread_local_caching_allocator<char,
+    counting_allocator<char>>
+    allocator_type;
+typedef hpx::util::detail::thread_local_cache<counting_allocator<char>>
+    cache_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_size_classes()
+{
+    allocator_type alloc;
+
+    // sizes in the same size class share their blocks
+    char* p = alloc.allocate(cache_type::size_class_granularity);
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    alloc.deallocate(p, cache_type::size_class_granularity);
+
+    char* q = alloc.allocate(1);
+    HPX_TEST(p == q);
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations);
+
+    // the next size class needs a block of its own
+    char* r = alloc.allocate(cache_type::size_class_granularity + 1);
+    HPX_TEST(r != q);
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations + 1);
+
+    alloc.deallocate(q, 1);
+    alloc.deallocate(r, cache_type::size_class_granularity + 1);
+
+    // the largest cached size is served from the cache as well
+    p = alloc.allocate(cache_type::max_cached_size);
+    alloc.deallocate(p, cache_type::max_cached_size);
+    q = alloc.allocate(cache_type::max_cached_size - 1);
+    HPX_TEST(p == q);
+    alloc.deallocate(q, cache_type::max_cached_size - 1);
+}
+
+void test_large_sizes()
+{
+    allocator_type alloc;
+
+    // larger blocks bypass the cache and are given back to the upstream
+    // allocator right away
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    std::int64_t const deallocations =
+        allocator_type::get_upstream_deallocations();
+    std::int64_t const blocks = live_blocks.load();
+
+    char* p = alloc.allocate(cache_type::max_cached_size + 1);
+    HPX_TEST_EQ(live_blocks.load(), blocks + 1);
+
+    alloc.deallocate(p, cache_type::max_cached_size + 1);
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations);
+    HPX_TEST_EQ(allocator_type::get_upstream_deallocations(), deallocations);
+
+    // so are empty allocations
+    p = alloc.allocate(0);
+    alloc.deallocate(p, 0);
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+}
+
+void test_cross_thread_deallocation()
+{
+    allocator_type alloc;
+    std::size_t const size = 3 * cache_type::size_class_granularity;
+
+    // blocks allocated by one thread are cached by the thread releasing them
+    std::vector<char*> blocks(cache_type::max_cached_blocks);
+    std::thread t([&]() {
+        for (char*& p : blocks)
+            p = alloc.allocate(size);
+    });
+    t.join();
+
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    for (char* p : blocks)
+        alloc.deallocate(p, size);
+
+    for (std::size_t i = blocks.size(); i != 0; --i)
+    {
+        char* p = alloc.allocate(size);
+        HPX_TEST(p == blocks[i - 1]);
+    }
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations);
+
+    // and handed back to the upstream allocator once the cache is full
+    char* extra = alloc.allocate(size);
+    std::int64_t const deallocations =
+        allocator_type::get_upstream_deallocations();
+
+    t = std::thread([&]() {
+        for (char* p : blocks)
+            alloc.deallocate(p, size);
+        HPX_TEST_EQ(allocator_type::get_upstream_deallocations(),
+            deallocations);
+
+        alloc.deallocate(extra, size);
+        HPX_TEST_EQ(allocator_type::get_upstream_deallocations(),
+            deallocations + 1);
+    });
+    t.join();
+}
+
+void test_thread_exit()
+{
+    allocator_type alloc;
+    std::int64_t const blocks = live_blocks.load();
+
+    // all blocks cached by a thread are returned to the upstream allocator
+    // once the thread exits
+    std::thread t([&]() {
+        std::vector<char*> allocated;
+        for (std::size_t cls = 0; cls != cache_type::num_size_classes; ++cls)
+        {
+            for (std::size_t i = 0; i != 2 * cache_type::max_cached_blocks;
+                 ++i)
+            {
+                allocated.push_back(alloc.allocate(
+                    (cls + 1) * cache_type::size_class_granularity));
+            }
+        }
+
+        std::size_t i = 0;
+        for (char* p : allocated)
+        {
+            std::size_t cls = i++ / (2 * cache_type::max_cached_blocks);
+            alloc.deallocate(
+                p, (cls + 1) * cache_type::size_class_granularity);
+        }
+
+        HPX_TEST_EQ(live_blocks.load(),
+            blocks +
+                std::int64_t(cache_type::num_size_classes *
+                    cache_type::max_cached_blocks));
+    });
+    t.join();
+
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+}
+
+int main()
+{
+    test_size_classes();
+    test_large_sizes();
+    test_cross_thread_deallocation();
+    test_thread_exit();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,190 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/thread_local_slab_allocator.hpp>
+#include <hpx/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The upstream allocator keeps track of the number of blocks it has handed
+// out. Using it also gives the tests a pool of their own.
+std::atomic<std::int64_t> live_blocks(0);
+
+template <typename T>
+struct counting_allocator
+{
+    typedef T value_type;
+
+    counting_allocator() = default;
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        --live_blocks;
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+struct object
+{
+    char data[200];
+};
+
+typedef hpx::util::thread_local_slab_allocator<object,
+    counting_allocator<char>>
+    allocator_type;
+typedef hpx::util::detail::slab_pool<object, counting_allocator<char>>
+    pool_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_slabs()
+{
+    allocator_type alloc;
+
+    // all objects of one slab are carved out of a single block
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    std::int64_t const blocks = live_blocks.load();
+
+    std::vector<object*> objects;
+    std::set<object*> distinct;
+    for (std::size_t i = 0; i != pool_type::slots_per_slab; ++i)
+    {
+        object* p = alloc.allocate(1);
+        objects.push_back(p);
+        distinct.insert(p);
+    }
+    HPX_TEST_EQ(distinct.size(), objects.size());
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations + 1);
+    HPX_TEST_EQ(live_blocks.load(), blocks + 1);
+
+    // released objects are reused, the most recently released one first
+    alloc.deallocate(objects.back(), 1);
+    object* p = alloc.allocate(1);
+    HPX_TEST(p == objects.back());
+
+    std::int64_t const slabs = allocator_type::get_upstream_allocations();
+    for (object* q : objects)
+        alloc.deallocate(q, 1);
+
+    for (std::size_t i = 0; i != objects.size(); ++i)
+        objects[i] = alloc.allocate(1);
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), slabs);
+
+    for (object* q : objects)
+        alloc.deallocate(q, 1);
+
+    // slabs are kept while the owning thread is alive
+    HPX_TEST_EQ(allocator_type::get_upstream_deallocations(), std::int64_t(0));
+}
+
+void test_arrays()
+{
+    allocator_type alloc;
+
+    // arrays bypass the slabs
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    std::int64_t const blocks = live_blocks.load();
+
+    object* p = alloc.allocate(3);
+    HPX_TEST_EQ(live_blocks.load(), blocks + 1);
+
+    alloc.deallocate(p, 3);
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+    HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations);
+}
+
+void test_cross_thread_deallocation()
+{
+    allocator_type alloc;
+
+    // objects released by other threads are given back to the owner, the
+    // owner is a new thread which has no locally released objects
+    std::thread owner([&]() {
+        std::vector<object*> objects(pool_type::slots_per_slab / 2);
+        for (object*& p : objects)
+            p = alloc.allocate(1);
+
+        std::thread t([&]() {
+            for (object* p : objects)
+                alloc.deallocate(p, 1);
+        });
+        t.join();
+
+        std::int64_t const allocations =
+            allocator_type::get_upstream_allocations();
+        std::set<object*> released(objects.begin(), objects.end());
+        for (object*& p : objects)
+        {
+            p = alloc.allocate(1);
+            HPX_TEST_EQ(released.count(p), std::size_t(1));
+        }
+        HPX_TEST_EQ(allocator_type::get_upstream_allocations(), allocations);
+
+        for (object* p : objects)
+            alloc.deallocate(p, 1);
+    });
+    owner.join();
+}
+
+void test_thread_exit()
+{
+    allocator_type alloc;
+    std::int64_t const blocks = live_blocks.load();
+
+    // the slabs of an exited thread are released as soon as the last of
+    // their objects has been released
+    std::vector<object*> objects(2 * pool_type::slots_per_slab);
+    std::thread t([&]() {
+        for (object*& p : objects)
+            p = alloc.allocate(1);
+    });
+    t.join();
+
+    HPX_TEST(live_blocks.load() > blocks);
+
+    for (object* p : objects)
+        alloc.deallocate(p, 1);
+
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+
+    // as are the slabs of a thread which released all of its objects itself
+    // once it exits
+    t = std::thread([&]() {
+        object* p = alloc.allocate(1);
+        alloc.deallocate(p, 1);
+    });
+    t.join();
+
+    HPX_TEST_EQ(live_blocks.load(), blocks);
+}
+
+int main()
+{
+    test_slabs();
+    test_arrays();
+    test_cross_thread_deallocation();
+    test_thread_exit();
+
+    return hpx::util::report_errors();
+}
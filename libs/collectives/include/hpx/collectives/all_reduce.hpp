@@ -90,6 +90,29 @@ namespace hpx { namespace lcos {
         std::size_t generation = std::size_t(-1),
         std::size_t this_site = std::size_t(-1), std::size_t root_site = 0);
 
+    /// AllReduce a set of values from all sites of a communicator
+    ///
+    /// \param  comm        The communicator identifying the participating
+    ///                     sites (see \a create_communicator).
+    /// \param  local_result The value (or a future referring to the value)
+    ///                     to transmit to all participating sites from this
+    ///                     call site.
+    /// \param  op          Reduction operation to apply to all values supplied
+    ///                     from all participating sites
+    ///
+    /// \note       The support objects created for the communicator are
+    ///             reused by all subsequent operations, no further AGAS
+    ///             registration is needed. The \a HPX_REGISTER_ALLREDUCE
+    ///             macro has to be used for the type \a T.
+    ///
+    /// \returns    This function returns a future holding the result of
+    ///             the reduction. It will become ready once the all_reduce
+    ///             operation has been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<std::decay_t<T>> all_reduce(communicator const& comm,
+        T&& local_result, F&& op);
+
 /// \def HPX_REGISTER_ALLREDUCE_DECLARATION(type, name)
 ///
 /// \brief Declare a all_reduce object named \a name for a given data type \a type.
@@ -139,6 +162,8 @@ namespace hpx { namespace lcos {
 
 #include <hpx/assertion.hpp>
 #include <hpx/basic_execution/register_locks.hpp>
+#include <hpx/collectives/communicator.hpp>
+#include <hpx/collectives/detail/communication_node.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/lcos/future.hpp>
@@ -152,6 +177,7 @@ namespace hpx { namespace lcos {
 #include <hpx/runtime/components/new.hpp>
 #include <hpx/runtime/components/server/component_base.hpp>
 #include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming/unmanaged.hpp>
@@ -159,6 +185,7 @@ namespace hpx { namespace lcos {
 #include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
@@ -282,6 +309,164 @@ namespace hpx { namespace lcos {
                     return target;
                 });
         }
+
+        ////////////////////////////////////////////////////////////////////////
+        struct all_reduce_tag
+        {
+        };
+
+        template <typename T>
+        using all_reduce_node = communication_node<T, all_reduce_tag>;
+
+        // Recursive doubling: the values are combined pairwise between sites
+        // whose numbers differ in a single bit, every site holds the overall
+        // result after log2(num_sites) rounds. The sites exceeding the
+        // largest power of two first hand their values to a partner and
+        // receive the result from it at the end. All sites combine the
+        // values in the same order, thus they all end up with the same
+        // result.
+        //
+        // slots: num_sites - final result, num_sites + 1 - value handed to
+        // the partner, num_sites + 2 + round - value exchanged in round
+        template <typename Channel, typename T, typename F>
+        hpx::future<T> all_reduce_recursive_doubling_round(
+            Channel const& channel, T value, F op, std::size_t num_sites,
+            std::size_t this_site, std::size_t mask, std::size_t round,
+            std::size_t pof2)
+        {
+            if (mask == pof2)
+                return hpx::make_ready_future(std::move(value));
+
+            std::size_t const partner = this_site ^ mask;
+            std::size_t const which = num_sites + 2 + round;
+
+            hpx::future<void> sent = channel.send(partner, which, value);
+
+            return hpx::dataflow(hpx::launch::sync,
+                [channel, HPX_CAPTURE_MOVE(value), HPX_CAPTURE_MOVE(op),
+                    num_sites, this_site, mask, round, pof2, partner](
+                    hpx::future<void>&& sent,
+                    hpx::future<T>&& received) mutable -> hpx::future<T> {
+                    sent.get();    // propagate any exceptions
+
+                    T combined = partner < this_site ?
+                        op(received.get(), std::move(value)) :
+                        op(std::move(value), received.get());
+
+                    return all_reduce_recursive_doubling_round(channel,
+                        std::move(combined), std::move(op), num_sites,
+                        this_site, mask << 1, round + 1, pof2);
+                },
+                std::move(sent), channel.get(which));
+        }
+
+        template <typename Channel, typename T, typename F>
+        hpx::future<T> all_reduce_recursive_doubling(Channel const& channel,
+            T local_result, F op, std::size_t num_sites, std::size_t this_site)
+        {
+            std::size_t pof2 = 1;
+            while (2 * pof2 <= num_sites)
+                pof2 *= 2;
+
+            if (this_site >= pof2)
+            {
+                hpx::future<void> sent = channel.send(
+                    this_site - pof2, num_sites + 1, std::move(local_result));
+
+                return hpx::dataflow(hpx::launch::sync,
+                    [](hpx::future<void>&& sent,
+                        hpx::future<T>&& result) -> T {
+                        sent.get();    // propagate any exceptions
+                        return result.get();
+                    },
+                    std::move(sent), channel.get(num_sites));
+            }
+
+            hpx::future<T> value;
+            if (this_site + pof2 < num_sites)
+            {
+                value = channel.get(num_sites + 1).then(hpx::launch::sync,
+                    [HPX_CAPTURE_MOVE(local_result), op](
+                        hpx::future<T>&& f) mutable -> T {
+                        return op(std::move(local_result), f.get());
+                    });
+            }
+            else
+            {
+                value = hpx::make_ready_future(std::move(local_result));
+            }
+
+            hpx::future<T> result = value.then(hpx::launch::sync,
+                [channel, op, num_sites, this_site, pof2](
+                    hpx::future<T>&& f) -> hpx::future<T> {
+                    return all_reduce_recursive_doubling_round(channel,
+                        f.get(), op, num_sites, this_site, 1, 0, pof2);
+                });
+
+            if (this_site + pof2 >= num_sites)
+                return result;
+
+            // hand the result back to the partner
+            return result.then(hpx::launch::sync,
+                [channel, num_sites, this_site, pof2](
+                    hpx::future<T>&& f) -> hpx::future<T> {
+                    T result = f.get();
+                    hpx::future<void> sent =
+                        channel.send(this_site + pof2, num_sites, result);
+
+                    return sent.then(hpx::launch::sync,
+                        [HPX_CAPTURE_MOVE(result)](
+                            hpx::future<void>&& sent) mutable -> T {
+                            sent.get();    // propagate any exceptions
+                            return std::move(result);
+                        });
+                });
+        }
+
+        // Small values are exchanged using recursive doubling, everything
+        // else is reduced along a k-ary tree and sent back down that tree.
+        template <typename Channel, typename T, typename F>
+        hpx::future<T> all_reduce_on_channel(Channel const& channel,
+            T local_result, F op, std::size_t num_sites, std::size_t this_site)
+        {
+            if (std::is_trivially_copyable<T>::value &&
+                sizeof(T) <= get_collectives_small_data_size())
+            {
+                return all_reduce_recursive_doubling(channel,
+                    std::move(local_result), std::move(op), num_sites,
+                    this_site);
+            }
+
+            return tree_combine_broadcast(
+                channel, std::move(local_result),
+                [HPX_CAPTURE_MOVE(op)](T&& result,
+                    std::vector<hpx::future<T>>&& values) mutable {
+                    for (auto& value : values)
+                    {
+                        result = op(std::move(result), value.get());
+                    }
+                    return std::move(result);
+                },
+                num_sites, this_site);
+        }
+
+        template <typename T, typename F>
+        hpx::future<T> all_reduce_distributed(std::string basename,
+            hpx::future<T>&& local_result, F&& op, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            auto algorithm = [HPX_CAPTURE_FORWARD(op), num_sites, this_site](
+                                 communication_channel<all_reduce_node<T>> const&
+                                     channel,
+                                 T&& local_result) -> hpx::future<T> {
+                return all_reduce_on_channel(
+                    channel, std::move(local_result), op, num_sites, this_site);
+            };
+
+            return run_on_communication_node<all_reduce_node<T>>(
+                std::move(basename), num_sites, this_site,
+                std::move(local_result), std::move(algorithm));
+        }
     }    // namespace detail
 
     ////////////////////////////////////////////////////////////////////////////
@@ -363,6 +548,17 @@ namespace hpx { namespace lcos {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+
+        if (detail::use_distributed_collective(num_sites))
+        {
+            return detail::all_reduce_distributed(std::move(name),
+                std::move(local_result), std::forward<F>(op), num_sites,
+                this_site);
+        }
+
         if (this_site == 0)
         {
             return all_reduce(create_all_reduce<T>(
@@ -370,10 +566,6 @@ namespace hpx { namespace lcos {
                 std::move(local_result), std::forward<F>(op), this_site);
         }
 
-        std::string name(basename);
-        if (generation != std::size_t(-1))
-            name += std::to_string(generation) + "/";
-
         return all_reduce(hpx::find_from_basename(std::move(name), root_site),
             std::move(local_result), std::forward<F>(op), this_site);
     }
@@ -428,6 +620,18 @@ namespace hpx { namespace lcos {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+
+        if (detail::use_distributed_collective(num_sites))
+        {
+            using arg_type = typename std::decay<T>::type;
+            return detail::all_reduce_distributed(std::move(name),
+                hpx::make_ready_future<arg_type>(std::forward<T>(local_result)),
+                std::forward<F>(op), num_sites, this_site);
+        }
+
         if (this_site == root_site)
         {
             return all_reduce(create_all_reduce<T>(
@@ -435,13 +639,44 @@ namespace hpx { namespace lcos {
                 std::forward<T>(local_result), std::forward<F>(op), this_site);
         }
 
-        std::string name(basename);
-        if (generation != std::size_t(-1))
-            name += std::to_string(generation) + "/";
-
         return all_reduce(hpx::find_from_basename(std::move(name), root_site),
             std::forward<T>(local_result), std::forward<F>(op), this_site);
     }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // all_reduce on a communicator
+    template <typename T, typename F>
+    hpx::future<T> all_reduce(
+        communicator const& comm, hpx::future<T>&& local_result, F&& op)
+    {
+        using node_type = detail::all_reduce_node<T>;
+        using channel_type = detail::communication_channel<node_type>;
+
+        std::size_t num_sites = comm.get_num_sites();
+        std::size_t this_site = comm.get_this_site();
+
+        auto all_reduce_data = [HPX_CAPTURE_FORWARD(op), num_sites, this_site](
+                                   hpx::future<channel_type>&& channel,
+                                   hpx::future<T>&& local_result) mutable
+            -> hpx::future<T> {
+            return detail::all_reduce_on_channel(channel.get(),
+                local_result.get(), std::move(op), num_sites, this_site);
+        };
+
+        // the generation of this operation is determined right away
+        return dataflow(hpx::launch::sync, std::move(all_reduce_data),
+            comm.template get_channel<node_type>(), std::move(local_result));
+    }
+
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type> all_reduce(
+        communicator const& comm, T&& local_result, F&& op)
+    {
+        using arg_type = typename std::decay<T>::type;
+        return all_reduce(comm,
+            hpx::make_ready_future<arg_type>(std::forward<T>(local_result)),
+            std::forward<F>(op));
+    }
 }}    // namespace hpx::lcos
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,6 +707,10 @@ namespace hpx {
         hpx::lcos::detail::all_reduce_server<type>>                            \
         HPX_PP_CAT(all_reduce_, name);                                         \
     HPX_REGISTER_COMPONENT(HPX_PP_CAT(all_reduce_, name))                      \
+    typedef hpx::components::component<                                        \
+        hpx::lcos::detail::all_reduce_node<type>>                              \
+        HPX_PP_CAT(all_reduce_node_, name);                                    \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(all_reduce_node_, name))                 \
     /**/
 
 #endif    // COMPUTE_HOST_CODE
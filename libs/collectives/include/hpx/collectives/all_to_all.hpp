@@ -86,6 +86,27 @@ namespace hpx { namespace lcos {
         std::size_t generation = std::size_t(-1),
         std::size_t this_site = std::size_t(-1), std::size_t root_site = 0);
 
+    /// AllToAll a set of values from all sites of a communicator
+    ///
+    /// \param  comm        The communicator identifying the participating
+    ///                     sites (see \a create_communicator).
+    /// \param  local_result The value (or a future referring to the value)
+    ///                     to transmit to all participating sites from this
+    ///                     call site.
+    ///
+    /// \note       The support objects created for the communicator are
+    ///             reused by all subsequent operations, no further AGAS
+    ///             registration is needed. The \a HPX_REGISTER_ALLTOALL
+    ///             macro has to be used for the type \a T.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             values send by all participating sites. It will become
+    ///             ready once the all_to_all operation has been completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<std::decay_t<T>>> all_to_all(
+        communicator const& comm, T&& local_result);
+
 /// \def HPX_REGISTER_ALLTOALL_DECLARATION(type, name)
 ///
 /// \brief Declare a all_to_all object named \a name for a given data type \a type.
@@ -135,6 +156,8 @@ namespace hpx { namespace lcos {
 
 #include <hpx/assertion.hpp>
 #include <hpx/basic_execution/register_locks.hpp>
+#include <hpx/collectives/communicator.hpp>
+#include <hpx/collectives/detail/communication_node.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/functional/bind_front.hpp>
@@ -155,6 +178,7 @@ namespace hpx { namespace lcos {
 #include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
@@ -267,6 +291,47 @@ namespace hpx { namespace lcos {
                     return target;
                 });
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct all_to_all_tag
+        {
+        };
+
+        template <typename T>
+        using all_to_all_node =
+            communication_node<std::vector<T>, all_to_all_tag>;
+
+        // The values are gathered in order of the sites along a k-ary tree
+        // and the overall result is sent back down that tree.
+        template <typename Channel, typename T>
+        hpx::future<std::vector<T>> all_to_all_on_channel(
+            Channel const& channel, T local_result, std::size_t num_sites,
+            std::size_t this_site)
+        {
+            std::vector<T> data;
+            data.push_back(std::move(local_result));
+
+            return tree_combine_broadcast(channel, std::move(data),
+                append_subtrees<T>(), num_sites, this_site);
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T>> all_to_all_distributed(
+            std::string basename, hpx::future<T>&& local_result,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            auto algorithm = [num_sites, this_site](
+                                 communication_channel<all_to_all_node<T>> const&
+                                     channel,
+                                 T&& local_result) {
+                return all_to_all_on_channel(
+                    channel, std::move(local_result), num_sites, this_site);
+            };
+
+            return run_on_communication_node<all_to_all_node<T>>(
+                std::move(basename), num_sites, this_site,
+                std::move(local_result), std::move(algorithm));
+        }
     }    // namespace detail
 
     ///////////////////////////////////////////////////////////////////////////
@@ -346,6 +411,16 @@ namespace hpx { namespace lcos {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+
+        if (detail::use_distributed_collective(num_sites))
+        {
+            return detail::all_to_all_distributed(
+                std::move(name), std::move(local_result), num_sites, this_site);
+        }
+
         if (this_site == 0)
         {
             return all_to_all(create_all_to_all<T>(
@@ -353,10 +428,6 @@ namespace hpx { namespace lcos {
                 std::move(local_result), this_site);
         }
 
-        std::string name(basename);
-        if (generation != std::size_t(-1))
-            name += std::to_string(generation) + "/";
-
         return all_to_all(hpx::find_from_basename(std::move(name), root_site),
             std::move(local_result), this_site);
     }
@@ -412,6 +483,18 @@ namespace hpx { namespace lcos {
         if (this_site == std::size_t(-1))
             this_site = static_cast<std::size_t>(hpx::get_locality_id());
 
+        std::string name(basename);
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+
+        if (detail::use_distributed_collective(num_sites))
+        {
+            using arg_type = typename util::decay<T>::type;
+            return detail::all_to_all_distributed(std::move(name),
+                hpx::make_ready_future<arg_type>(std::forward<T>(local_result)),
+                num_sites, this_site);
+        }
+
         if (this_site == root_site)
         {
             return all_to_all(create_all_to_all<T>(
@@ -419,13 +502,42 @@ namespace hpx { namespace lcos {
                 std::forward<T>(local_result), this_site);
         }
 
-        std::string name(basename);
-        if (generation != std::size_t(-1))
-            name += std::to_string(generation) + "/";
-
         return all_to_all(hpx::find_from_basename(std::move(name), root_site),
             std::forward<T>(local_result), this_site);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // all_to_all on a communicator
+    template <typename T>
+    hpx::future<std::vector<T>> all_to_all(
+        communicator const& comm, hpx::future<T>&& local_result)
+    {
+        using node_type = detail::all_to_all_node<T>;
+        using channel_type = detail::communication_channel<node_type>;
+
+        std::size_t num_sites = comm.get_num_sites();
+        std::size_t this_site = comm.get_this_site();
+
+        auto all_to_all_data = [num_sites, this_site](
+                                   hpx::future<channel_type>&& channel,
+                                   hpx::future<T>&& local_result) {
+            return detail::all_to_all_on_channel(
+                channel.get(), local_result.get(), num_sites, this_site);
+        };
+
+        // the generation of this operation is determined right away
+        return dataflow(hpx::launch::sync, std::move(all_to_all_data),
+            comm.template get_channel<node_type>(), std::move(local_result));
+    }
+
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type>> all_to_all(
+        communicator const& comm, T&& local_result)
+    {
+        using arg_type = typename util::decay<T>::type;
+        return all_to_all(comm,
+            hpx::make_ready_future<arg_type>(std::forward<T>(local_result)));
+    }
 }}    // namespace hpx::lcos
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -476,6 +588,10 @@ namespace hpx {
         hpx::lcos::detail::all_to_all_server<type>>                            \
         HPX_PP_CAT(all_to_all_, name);                                         \
     HPX_REGISTER_COMPONENT(HPX_PP_CAT(all_to_all_, name))                      \
+    typedef hpx::components::component<                                        \
+        hpx::lcos::detail::all_to_all_node<type>>                              \
+        HPX_PP_CAT(all_to_all_node_, name);                                    \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(all_to_all_node_, name))                 \
     /**/
 
 #endif    // COMPUTE_HOST_CODE
@@ -0,0 +1,261 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file communicator.hpp
+
+#if !defined(HPX_COLLECTIVES_COMMUNICATOR_HPP)
+#define HPX_COLLECTIVES_COMMUNICATOR_HPP
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+
+#include <hpx/assertion.hpp>
+#include <hpx/collectives/detail/communication_node.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/synchronization/mutex.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace hpx { namespace lcos {
+
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // The nodes of a communicator are created (and registered) on first
+        // use, one for each kind of collective operation and type of data.
+        struct communicator_node_base
+        {
+            virtual ~communicator_node_base() = default;
+        };
+
+        template <typename Node>
+        struct communicator_node : communicator_node_base
+        {
+            communicator_node(std::string const& basename,
+                std::size_t num_sites, std::size_t this_site)
+              : basename_(basename)
+              , this_site_(this_site)
+              , id_(create_communication_node<Node>(basename, this_site))
+              , node_(id_.then(hpx::launch::sync,
+                    [](hpx::shared_future<hpx::id_type> const& f) {
+                        return hpx::get_ptr<Node>(f.get());
+                    }))
+              , peers_(std::make_shared<communication_peers>(
+                    basename, num_sites))
+            {
+            }
+
+            ~communicator_node()
+            {
+                if (id_.has_value())
+                {
+                    hpx::unregister_with_basename(basename_, this_site_);
+                }
+                else if (!id_.has_exception())
+                {
+                    // the registration is still in flight, undo it as soon
+                    // as it has finished
+                    std::string basename = basename_;
+                    std::size_t this_site = this_site_;
+                    id_.then(hpx::launch::sync,
+                        [HPX_CAPTURE_MOVE(basename), this_site](
+                            hpx::shared_future<hpx::id_type> const& f) {
+                            if (f.has_value())
+                            {
+                                hpx::unregister_with_basename(
+                                    basename, this_site);
+                            }
+                        });
+                }
+            }
+
+            std::string basename_;
+            std::size_t this_site_;
+            hpx::shared_future<hpx::id_type> id_;
+            hpx::shared_future<std::shared_ptr<Node>> node_;
+            std::shared_ptr<communication_peers> peers_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class communicator_data
+        {
+            using mutex_type = lcos::local::mutex;
+
+        public:
+            communicator_data(std::string basename, std::size_t num_sites,
+                std::size_t this_site)
+              : basename_(std::move(basename))
+              , num_sites_(num_sites)
+              , this_site_(this_site)
+              , generation_(0)
+            {
+                HPX_ASSERT(this_site_ < num_sites_);
+            }
+
+            std::size_t get_num_sites() const
+            {
+                return num_sites_;
+            }
+
+            std::size_t get_this_site() const
+            {
+                return this_site_;
+            }
+
+            // Every collective operation performed on a communicator uses the
+            // next generation. The node used by an operation is identified by
+            // the order in which the kinds of operations were used first.
+            template <typename Node>
+            hpx::future<communication_channel<Node>> get_channel(
+                std::size_t root_site)
+            {
+                communicator_node<Node>* node = nullptr;
+                std::size_t generation = 0;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    generation = generation_++;
+
+                    std::type_index const key(typeid(Node));
+                    auto it = nodes_.find(key);
+                    if (it == nodes_.end())
+                    {
+                        std::string name = basename_ +
+                            std::to_string(nodes_.size()) + "/";
+
+                        std::unique_ptr<communicator_node_base> p(
+                            new communicator_node<Node>(
+                                name, num_sites_, this_site_));
+
+                        it = nodes_.emplace(key, std::move(p)).first;
+                    }
+                    node = static_cast<communicator_node<Node>*>(
+                        it->second.get());
+                }
+
+                std::shared_ptr<communication_peers> peers = node->peers_;
+                if (node->node_.is_ready())
+                {
+                    return hpx::make_ready_future(communication_channel<Node>(
+                        node->node_.get(), std::move(peers), generation,
+                        root_site));
+                }
+
+                return node->node_.then(hpx::launch::sync,
+                    [HPX_CAPTURE_MOVE(peers), generation, root_site](
+                        hpx::shared_future<std::shared_ptr<Node>> const& f) {
+                        return communication_channel<Node>(
+                            f.get(), peers, generation, root_site);
+                    });
+            }
+
+        private:
+            mutex_type mtx_;
+            std::string basename_;
+            std::size_t num_sites_;
+            std::size_t this_site_;
+            std::size_t generation_;
+            std::map<std::type_index, std::unique_ptr<communicator_node_base>>
+                nodes_;
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A communicator represents a fixed set of sites which repeatedly take
+    /// part in collective operations (\a all_reduce, \a all_to_all,
+    /// \a gather_here, and \a gather_there). The support objects needed for
+    /// those are created and registered with AGAS once for each kind of
+    /// operation and data type, and are reused afterwards. All sites have to
+    /// perform the collective operations on a communicator in the same
+    /// order. A communicator has to be kept alive until all operations
+    /// performed on it have finished.
+    class communicator
+    {
+    public:
+        communicator() = default;
+
+        /// Create a communicator for the given set of sites
+        ///
+        /// \param  basename    The base name identifying the communicator
+        /// \param  num_sites   The number of participating sites (default: all
+        ///                     localities).
+        /// \param this_site    The sequence number of this invocation (usually
+        ///                     the locality id). This value is optional and
+        ///                     defaults to whatever hpx::get_locality_id()
+        ///                     returns.
+        explicit communicator(char const* basename,
+            std::size_t num_sites = std::size_t(-1),
+            std::size_t this_site = std::size_t(-1))
+        {
+            if (num_sites == std::size_t(-1))
+            {
+                num_sites = static_cast<std::size_t>(
+                    hpx::get_num_localities(hpx::launch::sync));
+            }
+            if (this_site == std::size_t(-1))
+                this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+            data_ = std::make_shared<detail::communicator_data>(
+                basename, num_sites, this_site);
+        }
+
+        std::size_t get_num_sites() const
+        {
+            HPX_ASSERT(data_);
+            return data_->get_num_sites();
+        }
+
+        std::size_t get_this_site() const
+        {
+            HPX_ASSERT(data_);
+            return data_->get_this_site();
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Node>
+        hpx::future<detail::communication_channel<Node>> get_channel(
+            std::size_t root_site = 0) const
+        {
+            HPX_ASSERT(data_);
+            return data_->template get_channel<Node>(root_site);
+        }
+        /// \endcond
+
+    private:
+        std::shared_ptr<detail::communicator_data> data_;
+    };
+
+    /// Create a communicator for the given set of sites, see \a communicator
+    inline communicator create_communicator(char const* basename,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        return communicator(basename, num_sites, this_site);
+    }
+}}    // namespace hpx::lcos
+
+namespace hpx {
+    using lcos::communicator;
+    using lcos::create_communicator;
+}    // namespace hpx
+
+#endif    // COMPUTE_HOST_CODE
+#endif
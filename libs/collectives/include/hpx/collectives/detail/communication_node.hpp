@@ -0,0 +1,454 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COLLECTIVES_DETAIL_COMMUNICATION_NODE_HPP)
+#define HPX_COLLECTIVES_DETAIL_COMMUNICATION_NODE_HPP
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+
+#include <hpx/assertion.hpp>
+#include <hpx/async.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/functional/bind_back.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/local_lcos/promise.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/type_support/unused.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Configuration of the distributed algorithms used by the data collectives
+    // (see section [hpx.lcos.collectives] of the runtime configuration).
+    HPX_EXPORT std::size_t get_collectives_arity();
+    HPX_EXPORT std::size_t get_collectives_data_cut_off();
+    HPX_EXPORT std::size_t get_collectives_small_data_size();
+
+    // The data collectives use a single server component on the root site
+    // for small numbers of sites only, starting at the configured cut-off
+    // every site takes part in a distributed algorithm instead.
+    inline bool use_distributed_collective(std::size_t num_sites)
+    {
+        return num_sites >= get_collectives_data_cut_off();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The sites are arranged in a k-ary tree rooted at site zero. Every node
+    // of the tree spans the contiguous range of sites [site, last), the sites
+    // following the node itself are split into up to 'arity' equally sized
+    // ranges, the first site of each of those being a child of the node.
+    // Collecting the data of the children in order yields the data of the
+    // whole range in order.
+    HPX_EXPORT void get_tree_position(std::size_t site, std::size_t num_sites,
+        std::size_t arity, std::size_t& parent, std::size_t& last);
+
+    HPX_EXPORT std::vector<std::size_t> get_tree_children(
+        std::size_t site, std::size_t last, std::size_t arity);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every site taking part in a distributed collective operation owns one
+    // node. The other sites send their values to numbered slots of this node,
+    // those become available locally as futures independently of whether a
+    // value arrives before or after it is asked for. The slots are keyed by
+    // the generation of the operation as well, which allows to reuse a node
+    // for any number of operations.
+    template <typename T, typename Tag>
+    class communication_node
+      : public hpx::components::component_base<communication_node<T, Tag>>
+    {
+        using mutex_type = lcos::local::spinlock;
+        using key_type = std::pair<std::size_t, std::size_t>;
+
+        struct slot
+        {
+            slot()
+              : value_set(false)
+              , future_retrieved(false)
+            {
+            }
+
+            lcos::local::promise<T> promise;
+            bool value_set;
+            bool future_retrieved;
+        };
+
+    public:
+        using value_type = T;
+
+        void set(std::size_t generation, std::size_t which, T t)
+        {
+            key_type const key(generation, which);
+
+            // references to the elements of a std::map stay valid while
+            // other elements are inserted or erased
+            lcos::local::promise<T>* p = nullptr;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                p = &slots_[key].promise;
+            }
+
+            p->set_value(std::move(t));
+
+            // the slot is not needed anymore once both sides are done with it
+            std::lock_guard<mutex_type> l(mtx_);
+            auto it = slots_.find(key);
+            HPX_ASSERT(it != slots_.end());
+            if (it->second.future_retrieved)
+                slots_.erase(it);
+            else
+                it->second.value_set = true;
+        }
+
+        hpx::future<T> get(std::size_t generation, std::size_t which)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            auto it = slots_.emplace(key_type(generation, which), slot()).first;
+            hpx::future<T> f = it->second.promise.get_future();
+
+            if (it->second.value_set)
+                slots_.erase(it);
+            else
+                it->second.future_retrieved = true;
+
+            return f;
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(communication_node, set, set_action);
+
+    private:
+        mutex_type mtx_;
+        std::map<key_type, slot> slots_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Resolves the ids of the nodes registered by all sites under a common
+    // basename, every id is looked up once only.
+    class HPX_EXPORT communication_peers
+    {
+        using mutex_type = lcos::local::spinlock;
+
+    public:
+        communication_peers(std::string basename, std::size_t num_sites);
+
+        std::size_t get_num_sites() const
+        {
+            return ids_.size();
+        }
+
+        hpx::shared_future<hpx::id_type> get(std::size_t site);
+
+    private:
+        mutex_type mtx_;
+        std::string basename_;
+        std::vector<hpx::shared_future<hpx::id_type>> ids_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The algorithms below exchange their data through a channel which
+    // represents one operation (generation) on the nodes of all sites. Site
+    // numbers are relative to the given root site.
+    template <typename Node>
+    class communication_channel
+    {
+    public:
+        using value_type = typename Node::value_type;
+
+        communication_channel(std::shared_ptr<Node> node,
+            std::shared_ptr<communication_peers> peers, std::size_t generation,
+            std::size_t root_site = 0)
+          : node_(std::move(node))
+          , peers_(std::move(peers))
+          , generation_(generation)
+          , root_site_(root_site)
+        {
+        }
+
+        // retrieve the value sent to the given slot of the node of this site
+        hpx::future<value_type> get(std::size_t which) const
+        {
+            return node_->get(generation_, which);
+        }
+
+        // send a value to the given slot of the node of the given site
+        hpx::future<void> send(
+            std::size_t site, std::size_t which, value_type t) const
+        {
+            using action_type = typename Node::set_action;
+
+            hpx::shared_future<hpx::id_type> id = peers_->get(
+                (site + root_site_) % peers_->get_num_sites());
+
+            if (id.is_ready())
+            {
+                return hpx::async(
+                    action_type(), id.get(), generation_, which, std::move(t));
+            }
+
+            std::size_t generation = generation_;
+            return id.then(hpx::launch::sync,
+                [generation, which, HPX_CAPTURE_MOVE(t)](
+                    hpx::shared_future<hpx::id_type>&& f) mutable
+                -> hpx::future<void> {
+                    return hpx::async(
+                        action_type(), f.get(), generation, which, std::move(t));
+                });
+        }
+
+    private:
+        std::shared_ptr<Node> node_;
+        std::shared_ptr<communication_peers> peers_;
+        std::size_t generation_;
+        std::size_t root_site_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline hpx::future<hpx::id_type> register_communication_node(
+        hpx::future<hpx::id_type>&& f, std::string basename, std::size_t site)
+    {
+        hpx::id_type target = f.get();
+
+        // Register unmanaged id to avoid cyclic dependencies, unregister
+        // is done once the node is not used anymore on this site.
+        hpx::future<bool> result = hpx::register_with_basename(
+            basename, hpx::unmanaged(target), site);
+
+        return result.then(hpx::launch::sync,
+            [HPX_CAPTURE_MOVE(target), HPX_CAPTURE_MOVE(basename)](
+                hpx::future<bool>&& f) -> hpx::id_type {
+                bool result = f.get();
+                if (!result)
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::lcos::detail::register_communication_node",
+                        "the given base name for the collective operation "
+                        "was already registered: " +
+                            basename);
+                }
+                return target;
+            });
+    }
+
+    // create the node of this site and register it under the given basename
+    template <typename Node>
+    hpx::future<hpx::id_type> create_communication_node(
+        std::string const& basename, std::size_t site)
+    {
+        return hpx::new_<Node>(hpx::find_here())
+            .then(hpx::launch::sync,
+                util::bind_back(&register_communication_node, basename, site));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Create and register the node of this site, invoke the given algorithm
+    // once the local value is available, and unregister the node once the
+    // algorithm has finished. All values sent to the node have been received
+    // at this point.
+    template <typename Node, typename T, typename F>
+    hpx::future<typename Node::value_type> run_on_communication_node(
+        std::string basename, std::size_t num_sites, std::size_t site,
+        hpx::future<T>&& local_result, F&& f)
+    {
+        using value_type = typename Node::value_type;
+
+        auto run = [HPX_CAPTURE_MOVE(basename), num_sites, site,
+                       HPX_CAPTURE_FORWARD(f)](hpx::future<hpx::id_type>&& fid,
+                       hpx::future<T>&& local_result) mutable
+            -> hpx::future<value_type> {
+            hpx::id_type id = fid.get();
+
+            communication_channel<Node> channel(
+                hpx::get_ptr<Node>(hpx::launch::sync, id),
+                std::make_shared<communication_peers>(basename, num_sites), 0);
+
+            hpx::future<value_type> result = f(channel, local_result.get());
+
+            return result.then(hpx::launch::async,
+                [HPX_CAPTURE_MOVE(id), HPX_CAPTURE_MOVE(channel),
+                    HPX_CAPTURE_MOVE(basename),
+                    site](hpx::future<value_type>&& f) -> value_type {
+                    // this is a one-shot object (generations counters are
+                    // not supported), unregister it
+                    hpx::unregister_with_basename(basename, site).get();
+
+                    HPX_UNUSED(id);
+                    HPX_UNUSED(channel);
+                    return f.get();
+                });
+        };
+
+        return hpx::dataflow(hpx::launch::async, std::move(run),
+            create_communication_node<Node>(basename, site),
+            std::move(local_result));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Combine the values of all sites along the tree towards site zero. The
+    // function 'combine' is invoked with the value of this site and the
+    // (ordered) futures holding the values of the sub-trees rooted at its
+    // children. The returned future holds the overall result on site zero
+    // and the value of the sub-tree rooted at this site everywhere else.
+    template <typename Channel, typename Combine>
+    hpx::future<typename Channel::value_type> tree_combine(
+        Channel const& channel, typename Channel::value_type local_result,
+        Combine&& combine, std::size_t num_sites, std::size_t this_site)
+    {
+        using value_type = typename Channel::value_type;
+
+        std::size_t parent = 0;
+        std::size_t last = num_sites;
+        std::size_t const arity = get_collectives_arity();
+        get_tree_position(this_site, num_sites, arity, parent, last);
+
+        // children send the values of their sub-trees to the slot numbered
+        // with their site
+        std::vector<hpx::future<value_type>> values;
+        for (std::size_t child : get_tree_children(this_site, last, arity))
+        {
+            values.push_back(channel.get(child));
+        }
+
+        hpx::future<value_type> subtree = hpx::dataflow(hpx::launch::sync,
+            [HPX_CAPTURE_MOVE(local_result), HPX_CAPTURE_FORWARD(combine)](
+                std::vector<hpx::future<value_type>>&& values) mutable
+            -> value_type {
+                return combine(std::move(local_result), std::move(values));
+            },
+            std::move(values));
+
+        if (this_site == 0)
+            return subtree;
+
+        return subtree.then(hpx::launch::sync,
+            [channel, parent, this_site](
+                hpx::future<value_type>&& f) -> hpx::future<value_type> {
+                value_type value = f.get();
+                hpx::future<void> sent =
+                    channel.send(parent, this_site, value);
+
+                return sent.then(hpx::launch::sync,
+                    [HPX_CAPTURE_MOVE(value)](
+                        hpx::future<void>&& sent) mutable -> value_type {
+                        sent.get();    // propagate any exceptions
+                        return std::move(value);
+                    });
+            });
+    }
+
+    // Send the value of site zero down the tree to all other sites, the value
+    // arrives in slot 'num_sites'. The given future has to become ready
+    // before the value is considered to be available on any other site.
+    template <typename Channel>
+    hpx::future<typename Channel::value_type> tree_broadcast(
+        Channel const& channel, hpx::future<typename Channel::value_type>&& f,
+        std::size_t num_sites, std::size_t this_site)
+    {
+        using value_type = typename Channel::value_type;
+
+        std::size_t parent = 0;
+        std::size_t last = num_sites;
+        std::size_t const arity = get_collectives_arity();
+        get_tree_position(this_site, num_sites, arity, parent, last);
+
+        hpx::future<value_type> result;
+        if (this_site == 0)
+        {
+            result = std::move(f);
+        }
+        else
+        {
+            result = hpx::dataflow(hpx::launch::sync,
+                [](hpx::future<value_type>&& f,
+                    hpx::future<value_type>&& result) -> value_type {
+                    f.get();    // propagate any exceptions
+                    return result.get();
+                },
+                std::move(f), channel.get(num_sites));
+        }
+
+        std::vector<std::size_t> children =
+            get_tree_children(this_site, last, arity);
+        if (children.empty())
+            return result;
+
+        // pass the value on to the children
+        return result.then(hpx::launch::sync,
+            [channel, num_sites, HPX_CAPTURE_MOVE(children)](
+                hpx::future<value_type>&& f) -> hpx::future<value_type> {
+                value_type result = f.get();
+
+                std::vector<hpx::future<void>> sent;
+                sent.reserve(children.size());
+                for (std::size_t child : children)
+                {
+                    sent.push_back(channel.send(child, num_sites, result));
+                }
+
+                return hpx::dataflow(hpx::launch::sync,
+                    [HPX_CAPTURE_MOVE(result)](
+                        std::vector<hpx::future<void>>&& sent) mutable
+                    -> value_type {
+                        for (auto& f : sent)
+                        {
+                            f.get();    // propagate any exceptions
+                        }
+                        return std::move(result);
+                    },
+                    std::move(sent));
+            });
+    }
+
+    // Combine function appending the data of the sub-trees to the data of
+    // this site, used to gather values in order of the sites.
+    template <typename T>
+    struct append_subtrees
+    {
+        std::vector<T> operator()(std::vector<T>&& data,
+            std::vector<hpx::future<std::vector<T>>>&& subtrees) const
+        {
+            for (auto& f : subtrees)
+            {
+                std::vector<T> subtree = f.get();
+                data.insert(data.end(),
+                    std::make_move_iterator(subtree.begin()),
+                    std::make_move_iterator(subtree.end()));
+            }
+            return std::move(data);
+        }
+    };
+
+    template <typename Channel, typename Combine>
+    hpx::future<typename Channel::value_type> tree_combine_broadcast(
+        Channel const& channel, typename Channel::value_type local_result,
+        Combine&& combine, std::size_t num_sites, std::size_t this_site)
+    {
+        return tree_broadcast(channel,
+            tree_combine(channel, std::move(local_result),
+                std::forward<Combine>(combine), num_sites, this_site),
+            num_sites, this_site);
+    }
+}}}    // namespace hpx::lcos::detail
+
+#endif    // COMPUTE_HOST_CODE
+#endif
@@ -147,6 +147,44 @@ namespace hpx { namespace lcos {
         std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
         std::size_t this_site = std::size_t(-1));
 
+    /// Gather a set of values from all sites of a communicator on this site
+    ///
+    /// \param  comm        The communicator identifying the participating
+    ///                     sites (see \a create_communicator).
+    /// \param  result      The value (or a future referring to the value)
+    ///                     contributed by this call site.
+    ///
+    /// \note       The support objects created for the communicator are
+    ///             reused by all subsequent operations, no further AGAS
+    ///             registration is needed. The \a HPX_REGISTER_GATHER macro
+    ///             has to be used for the type \a T.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             gathered values. It will become ready once the gather
+    ///             operation has been completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<std::decay_t<T>>> gather_here(
+        communicator const& comm, T&& result);
+
+    /// Gather a given value on the given site of a communicator
+    ///
+    /// \param  comm        The communicator identifying the participating
+    ///                     sites (see \a create_communicator).
+    /// \param  result      The value (or a future referring to the value)
+    ///                     contributed by this call site.
+    /// \param  root_site   The site which gathers all values (i.e. which
+    ///                     invokes \a gather_here). This value is optional
+    ///                     and defaults to '0' (zero).
+    ///
+    /// \returns    This function returns a future which will become ready
+    ///             once this site's part in the gather operation has been
+    ///             completed.
+    ///
+    template <typename T>
+    hpx::future<void> gather_there(communicator const& comm, T&& result,
+        std::size_t root_site = 0);
+
 /// \def HPX_REGISTER_GATHER_DECLARATION(type, name)
 ///
 /// \brief Declare a gather object named \a name for a given data type \a type.
@@ -195,6 +233,8 @@ namespace hpx { namespace lcos {
 
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
+#include <hpx/collectives/communicator.hpp>
+#include <hpx/collectives/detail/communication_node.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/functional/bind_back.hpp>
 #include <hpx/functional/bind_front.hpp>
@@ -214,6 +254,7 @@ namespace hpx { namespace lcos {
 #include <hpx/type_support/decay.hpp>
 #include <hpx/type_support/unused.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <mutex>
 #include <string>
@@ -390,6 +431,45 @@ namespace hpx { namespace lcos {
             typedef typename gather_server<T>::set_result_action action_type;
             return async(action_type(), f.get(), which, result.get());
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct gather_tag
+        {
+        };
+
+        template <typename T>
+        using gather_node = communication_node<std::vector<T>, gather_tag>;
+
+        // The values are gathered along a k-ary tree rooted at the given
+        // site. The channel is expected to number the sites relative to the
+        // root site as well.
+        template <typename Channel, typename T>
+        hpx::future<std::vector<T>> gather_on_channel(Channel const& channel,
+            T local_result, std::size_t num_sites, std::size_t this_site,
+            std::size_t root_site)
+        {
+            std::size_t const site = (this_site + num_sites - root_site) %
+                num_sites;
+
+            std::vector<T> data;
+            data.push_back(std::move(local_result));
+
+            hpx::future<std::vector<T>> result = tree_combine(channel,
+                std::move(data), append_subtrees<T>(), num_sites, site);
+
+            if (site != 0 || root_site == 0)
+                return result;
+
+            // the values were gathered in order of the relative site numbers
+            return result.then(hpx::launch::sync,
+                [num_sites, root_site](hpx::future<std::vector<T>>&& f)
+                    -> std::vector<T> {
+                    std::vector<T> data = f.get();
+                    std::rotate(data.begin(),
+                        data.begin() + (num_sites - root_site), data.end());
+                    return data;
+                });
+        }
     }    // namespace detail
 
     ///////////////////////////////////////////////////////////////////////////
@@ -545,6 +625,75 @@ namespace hpx { namespace lcos {
         return gather_there(hpx::find_from_basename(std::move(name), root_site),
             std::forward<T>(result), this_site);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // gather on a communicator
+    template <typename T>
+    hpx::future<std::vector<T>> gather_here(
+        communicator const& comm, hpx::future<T>&& result)
+    {
+        using node_type = detail::gather_node<T>;
+        using channel_type = detail::communication_channel<node_type>;
+
+        std::size_t num_sites = comm.get_num_sites();
+        std::size_t this_site = comm.get_this_site();
+
+        auto gather_data = [num_sites, this_site](
+                               hpx::future<channel_type>&& channel,
+                               hpx::future<T>&& result) {
+            return detail::gather_on_channel(channel.get(), result.get(),
+                num_sites, this_site, this_site);
+        };
+
+        // the generation of this operation is determined right away
+        return dataflow(hpx::launch::sync, std::move(gather_data),
+            comm.template get_channel<node_type>(this_site), std::move(result));
+    }
+
+    template <typename T>
+    hpx::future<std::vector<typename std::decay<T>::type>> gather_here(
+        communicator const& comm, T&& result)
+    {
+        using arg_type = typename std::decay<T>::type;
+        return gather_here(
+            comm, hpx::make_ready_future<arg_type>(std::forward<T>(result)));
+    }
+
+    template <typename T>
+    hpx::future<void> gather_there(communicator const& comm,
+        hpx::future<T>&& result, std::size_t root_site = 0)
+    {
+        using node_type = detail::gather_node<T>;
+        using channel_type = detail::communication_channel<node_type>;
+
+        std::size_t num_sites = comm.get_num_sites();
+        std::size_t this_site = comm.get_this_site();
+
+        auto gather_data = [num_sites, this_site, root_site](
+                               hpx::future<channel_type>&& channel,
+                               hpx::future<T>&& result) {
+            return detail::gather_on_channel(channel.get(), result.get(),
+                num_sites, this_site, root_site)
+                .then(hpx::launch::sync,
+                    [](hpx::future<std::vector<T>>&& f) -> void {
+                        f.get();    // propagate any exceptions
+                    });
+        };
+
+        // the generation of this operation is determined right away
+        return dataflow(hpx::launch::sync, std::move(gather_data),
+            comm.template get_channel<node_type>(root_site), std::move(result));
+    }
+
+    template <typename T>
+    hpx::future<void> gather_there(
+        communicator const& comm, T&& result, std::size_t root_site = 0)
+    {
+        using arg_type = typename std::decay<T>::type;
+        return gather_there(comm,
+            hpx::make_ready_future<arg_type>(std::forward<T>(result)),
+            root_site);
+    }
 }}    // namespace hpx::lcos
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -595,6 +744,10 @@ namespace hpx { namespace lcos {
         hpx::lcos::detail::gather_server<type>>                                \
         HPX_PP_CAT(gather_, name);                                             \
     HPX_REGISTER_COMPONENT(HPX_PP_CAT(gather_, name))                          \
+    typedef hpx::components::component<                                        \
+        hpx::lcos::detail::gather_node<type>>                                  \
+        HPX_PP_CAT(gather_node_, name);                                        \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(gather_node_, name))                     \
     /**/
 
 #endif    // COMPUTE_HOST_CODE
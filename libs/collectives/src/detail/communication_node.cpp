@@ -0,0 +1,111 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/assertion.hpp>
+#include <hpx/collectives/detail/communication_node.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/from_string.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail {
+
+    std::size_t get_collectives_arity()
+    {
+        std::size_t arity = hpx::util::from_string<std::size_t>(
+            get_config_entry("hpx.lcos.collectives.arity", 32));
+        return arity < 2 ? 2 : arity;
+    }
+
+    std::size_t get_collectives_data_cut_off()
+    {
+        return hpx::util::from_string<std::size_t>(
+            get_config_entry("hpx.lcos.collectives.data_cut_off", 16));
+    }
+
+    std::size_t get_collectives_small_data_size()
+    {
+        return hpx::util::from_string<std::size_t>(
+            get_config_entry("hpx.lcos.collectives.small_data_size", 256));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void get_tree_position(std::size_t site, std::size_t num_sites,
+        std::size_t arity, std::size_t& parent, std::size_t& last)
+    {
+        HPX_ASSERT(site < num_sites && arity != 0);
+
+        std::size_t first = 0;
+        parent = std::size_t(-1);
+        last = num_sites;
+
+        // descend from the root into the range holding the given site
+        while (first != site)
+        {
+            std::size_t const begin = first + 1;
+            std::size_t const chunk = (last - begin + arity - 1) / arity;
+
+            parent = first;
+            first = begin + ((site - begin) / chunk) * chunk;
+            if (first + chunk < last)
+                last = first + chunk;
+        }
+    }
+
+    std::vector<std::size_t> get_tree_children(
+        std::size_t site, std::size_t last, std::size_t arity)
+    {
+        std::vector<std::size_t> children;
+
+        std::size_t const begin = site + 1;
+        if (begin >= last)
+            return children;
+
+        std::size_t const chunk = (last - begin + arity - 1) / arity;
+
+        children.reserve((last - begin + chunk - 1) / chunk);
+        for (std::size_t child = begin; child < last; child += chunk)
+        {
+            children.push_back(child);
+        }
+        return children;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    communication_peers::communication_peers(
+        std::string basename, std::size_t num_sites)
+      : basename_(std::move(basename))
+      , ids_(num_sites)
+    {
+    }
+
+    hpx::shared_future<hpx::id_type> communication_peers::get(std::size_t site)
+    {
+        HPX_ASSERT(site < ids_.size());
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (ids_[site].valid())
+                return ids_[site];
+        }
+
+        // don't hold the lock while talking to AGAS
+        hpx::shared_future<hpx::id_type> id =
+            hpx::find_from_basename(basename_, site);
+
+        std::lock_guard<mutex_type> l(mtx_);
+        if (!ids_[site].valid())
+            ids_[site] = std::move(id);
+        return ids_[site];
+    }
+}}}    // namespace hpx::lcos::detail
@@ -18,10 +18,15 @@
 
 char const* all_reduce_basename = "/test/all_reduce/";
 char const* all_reduce_direct_basename = "/test/all_reduce_direct/";
+char const* all_reduce_rd_basename = "/test/all_reduce_rd/";
+char const* all_reduce_rd_direct_basename = "/test/all_reduce_rd_direct/";
+char const* all_reduce_tree_basename = "/test/all_reduce_tree/";
+char const* all_reduce_tree_direct_basename =
+    "/test/all_reduce_tree_direct/";
 
 HPX_REGISTER_ALLREDUCE(std::uint32_t, test_all_reduce);
 
-int hpx_main(int argc, char* argv[])
+void test_all_reduce(char const* basename, char const* direct_basename)
 {
     std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
 
@@ -32,7 +37,7 @@ int hpx_main(int argc, char* argv[])
             hpx::make_ready_future(hpx::get_locality_id());
 
         hpx::future<std::uint32_t> overall_result =
-            hpx::all_reduce(all_reduce_basename, std::move(value),
+            hpx::all_reduce(basename, std::move(value),
                 std::plus<std::uint32_t>{}, num_localities, i);
 
         std::uint32_t sum = 0;
@@ -49,7 +54,7 @@ int hpx_main(int argc, char* argv[])
         std::uint32_t value = hpx::get_locality_id();
 
         hpx::future<std::uint32_t> overall_result =
-            hpx::all_reduce(all_reduce_direct_basename, value,
+            hpx::all_reduce(direct_basename, value,
                 std::plus<std::uint32_t>{}, num_localities, i);
 
         std::uint32_t sum = 0;
@@ -59,6 +64,22 @@ int hpx_main(int argc, char* argv[])
         }
         HPX_TEST_EQ(sum, overall_result.get());
     }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_all_reduce(all_reduce_basename, all_reduce_direct_basename);
+
+    // use the distributed algorithms for any number of sites, small
+    // values are combined using recursive doubling
+    hpx::set_config_entry("hpx.lcos.collectives.data_cut_off", std::size_t(0));
+    test_all_reduce(all_reduce_rd_basename, all_reduce_rd_direct_basename);
+
+    // all values are combined along a tree
+    hpx::set_config_entry(
+        "hpx.lcos.collectives.small_data_size", std::size_t(0));
+    test_all_reduce(
+        all_reduce_tree_basename, all_reduce_tree_direct_basename);
 
     return hpx::finalize();
 }
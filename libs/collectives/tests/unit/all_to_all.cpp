@@ -18,10 +18,13 @@
 
 char const* all_to_all_basename = "/test/all_to_all/";
 char const* all_to_all_direct_basename = "/test/all_to_all_direct/";
+char const* all_to_all_tree_basename = "/test/all_to_all_tree/";
+char const* all_to_all_tree_direct_basename =
+    "/test/all_to_all_tree_direct/";
 
 HPX_REGISTER_ALLTOALL(std::uint32_t, test_all_to_all);
 
-int hpx_main(int argc, char* argv[])
+void test_all_to_all(char const* basename, char const* direct_basename)
 {
     std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
 
@@ -33,7 +36,7 @@ int hpx_main(int argc, char* argv[])
 
         hpx::future<std::vector<std::uint32_t>> overall_result =
             hpx::all_to_all(
-                all_to_all_basename, std::move(value), num_localities, i);
+                basename, std::move(value), num_localities, i);
 
         std::vector<std::uint32_t> r = overall_result.get();
         HPX_TEST_EQ(r.size(), num_localities);
@@ -51,7 +54,7 @@ int hpx_main(int argc, char* argv[])
 
         hpx::future<std::vector<std::uint32_t>> overall_result =
             hpx::all_to_all(
-                all_to_all_direct_basename, value, num_localities, i);
+                direct_basename, value, num_localities, i);
 
         std::vector<std::uint32_t> r = overall_result.get();
         HPX_TEST_EQ(r.size(), num_localities);
@@ -61,6 +64,16 @@ int hpx_main(int argc, char* argv[])
             HPX_TEST_EQ(r[j], j);
         }
     }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_all_to_all(all_to_all_basename, all_to_all_direct_basename);
+
+    // use the distributed algorithm for any number of sites
+    hpx::set_config_entry("hpx.lcos.collectives.data_cut_off", std::size_t(0));
+    test_all_to_all(
+        all_to_all_tree_basename, all_to_all_tree_direct_basename);
 
     return hpx::finalize();
 }
@@ -0,0 +1,133 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/collectives.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+char const* communicator_basename = "/test/communicator/";
+
+HPX_REGISTER_ALLREDUCE(std::uint32_t, test_communicator_all_reduce);
+HPX_REGISTER_ALLTOALL(std::uint32_t, test_communicator_all_to_all);
+HPX_REGISTER_GATHER(std::uint32_t, test_communicator_gather);
+
+void test_all_reduce(hpx::communicator const& comm)
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+
+    std::uint32_t sum = 0;
+    for (std::uint32_t j = 0; j != num_localities; ++j)
+    {
+        sum += j;
+    }
+
+    for (int i = 0; i != 10; ++i)
+    {
+        hpx::future<std::uint32_t> value =
+            hpx::make_ready_future(hpx::get_locality_id() + i);
+
+        hpx::future<std::uint32_t> overall_result = hpx::all_reduce(
+            comm, std::move(value), std::plus<std::uint32_t>{});
+
+        HPX_TEST_EQ(sum + i * num_localities, overall_result.get());
+    }
+
+    for (int i = 0; i != 10; ++i)
+    {
+        std::uint32_t value = hpx::get_locality_id();
+
+        hpx::future<std::uint32_t> overall_result =
+            hpx::all_reduce(comm, value, std::plus<std::uint32_t>{});
+
+        HPX_TEST_EQ(sum, overall_result.get());
+    }
+}
+
+void test_all_to_all(hpx::communicator const& comm)
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+
+    for (int i = 0; i != 10; ++i)
+    {
+        std::uint32_t value = hpx::get_locality_id();
+
+        hpx::future<std::vector<std::uint32_t>> overall_result =
+            hpx::all_to_all(comm, value);
+
+        std::vector<std::uint32_t> r = overall_result.get();
+        HPX_TEST_EQ(r.size(), num_localities);
+
+        for (std::size_t j = 0; j != r.size(); ++j)
+        {
+            HPX_TEST_EQ(r[j], j);
+        }
+    }
+}
+
+void test_gather(hpx::communicator const& comm)
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t this_locality = hpx::get_locality_id();
+
+    for (std::uint32_t i = 0; i != 10; ++i)
+    {
+        std::uint32_t root_site = i % num_localities;
+        std::uint32_t value = this_locality + 42;
+
+        if (this_locality == root_site)
+        {
+            hpx::future<std::vector<std::uint32_t>> overall_result =
+                hpx::lcos::gather_here(comm, value);
+
+            std::vector<std::uint32_t> r = overall_result.get();
+            HPX_TEST_EQ(r.size(), num_localities);
+
+            for (std::size_t j = 0; j != r.size(); ++j)
+            {
+                HPX_TEST_EQ(r[j], j + 42);
+            }
+        }
+        else
+        {
+            hpx::future<void> overall_result =
+                hpx::lcos::gather_there(comm, value, root_site);
+            overall_result.get();
+        }
+    }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    // all collective operations below reuse the same communicator
+    hpx::communicator comm = hpx::create_communicator(communicator_basename);
+
+    test_all_reduce(comm);
+    test_all_to_all(comm);
+    test_gather(comm);
+
+    // values of all sizes are combined along a tree
+    hpx::set_config_entry(
+        "hpx.lcos.collectives.small_data_size", std::size_t(0));
+    test_all_reduce(comm);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.run_hpx_main!=1"};
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
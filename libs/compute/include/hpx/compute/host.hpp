@@ -10,6 +10,7 @@
 #define HPX_COMPUTE_HOST_HPP
 
 #include <hpx/compute/host/block_allocator.hpp>
+#include <hpx/compute/host/block_chunk_size.hpp>
 #include <hpx/compute/host/block_executor.hpp>
 #include <hpx/compute/host/default_executor.hpp>
 #include <hpx/compute/host/get_targets.hpp>
@@ -12,6 +12,7 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/compute/host/block_chunk_size.hpp>
 #include <hpx/compute/host/block_executor.hpp>
 #include <hpx/compute/host/target.hpp>
 #include <hpx/datastructures/tuple.hpp>
@@ -19,7 +20,6 @@
 #include <hpx/iterator_support/range.hpp>
 #include <hpx/parallel/algorithms/for_each.hpp>
 #include <hpx/parallel/execution_policy.hpp>
-#include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/parallel/util/cancellation_token.hpp>
 #include <hpx/parallel/util/partitioner_with_cleanup.hpp>
 #include <hpx/runtime/threads/executors/thread_pool_attached_executors.hpp>
@@ -48,6 +48,15 @@ namespace hpx { namespace compute { namespace host {
     /// std::size_t N = 2048;
     /// vector_type v(N, allocator_type(numa_nodes));
     ///
+    /// The elements are constructed using the \a block_chunk_size executor
+    /// parameters. Algorithms run on such a vector using a block_executor
+    /// for the same targets and block_chunk_size will process each element
+    /// on the NUMA domain which has touched it first:
+    ///
+    /// auto policy = hpx::parallel::execution::par.on(
+    ///     hpx::compute::host::block_executor<>(numa_nodes)).with(
+    ///     hpx::compute::host::block_chunk_size());
+    ///
     template <typename T,
         typename Executor =
             hpx::parallel::execution::local_priority_queue_attached_executor>
@@ -166,7 +175,9 @@ namespace hpx { namespace compute { namespace host {
         // Constructs count objects of type T in allocated uninitialized
         // storage pointed to by p, using placement-new. This will use the
         // underlying executors to distribute the memory according to
-        // first touch memory placement.
+        // first touch memory placement. The chunks are the same as the ones
+        // created by block_chunk_size for algorithms operating on the same
+        // number of elements.
         template <typename U, typename... Args>
         void bulk_construct(U* p, std::size_t count, Args&&... args)
         {
@@ -178,7 +189,7 @@ namespace hpx { namespace compute { namespace host {
             auto irange = boost::irange(std::size_t(0), count);
             auto policy =
                 hpx::parallel::execution::parallel_policy().on(executor_).with(
-                    hpx::parallel::execution::static_chunk_size());
+                    block_chunk_size());
 
             typedef boost::range_detail::integer_iterator<std::size_t>
                 iterator_type;
@@ -250,7 +261,7 @@ namespace hpx { namespace compute { namespace host {
             auto irange = boost::irange(std::size_t(0), count);
             hpx::parallel::for_each(
                 hpx::parallel::execution::par.on(executor_).with(
-                    hpx::parallel::execution::static_chunk_size()),
+                    block_chunk_size()),
                 util::begin(irange), util::end(irange),
                 [p](std::size_t i) { (p + i)->~U(); });
         }
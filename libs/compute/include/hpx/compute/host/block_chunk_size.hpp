@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_COMPUTE_HOST_BLOCK_CHUNK_SIZE_HPP
+#define HPX_COMPUTE_HOST_BLOCK_CHUNK_SIZE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hpx { namespace compute { namespace host {
+    /// The block_chunk_size executor parameters type makes the parallel
+    /// algorithms place their chunks in the same way as the block_allocator
+    /// places the memory.
+    ///
+    /// A block_executor hands the chunks of an algorithm to its targets in
+    /// contiguous blocks (chunk i goes to target i * targets / chunks). The
+    /// chunk size calculated by this parameters type depends only on the
+    /// number of elements and on the targets of the executor, but neither on
+    /// the number of cores nor on any measurements. Thus, for the same number
+    /// of elements every chunk is always run on the NUMA domain which first
+    /// touched its memory (the block_allocator constructs its elements using
+    /// this parameters type), regardless of how often the algorithm is
+    /// invoked.
+    ///
+    /// \note This executor parameters type can be used with executors
+    ///       exposing the list of their targets only (like the block_executor).
+    ///
+    struct block_chunk_size
+    {
+        /// Construct a \a block_chunk_size executor parameters object
+        ///
+        /// \note By default four chunks are created for each processing unit
+        ///       of the first target of the executor.
+        ///
+        HPX_CONSTEXPR block_chunk_size()
+          : chunks_per_target_(0)
+        {
+        }
+
+        /// Construct a \a block_chunk_size executor parameters object
+        ///
+        /// \param chunks_per_target [in] The number of chunks to create for
+        ///                     each of the targets of the executor.
+        ///
+        HPX_CONSTEXPR explicit block_chunk_size(std::size_t chunks_per_target)
+          : chunks_per_target_(chunks_per_target)
+        {
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(
+            Executor& exec, F&&, std::size_t, std::size_t num_tasks) const
+        {
+            auto const& targets = exec.targets();
+            std::size_t const num_targets =
+                targets.empty() ? std::size_t(1) : targets.size();
+
+            std::size_t chunks_per_target = chunks_per_target_;
+            if (chunks_per_target == 0)
+            {
+                chunks_per_target = targets.empty() ?
+                    std::size_t(1) :
+                    4 * targets[0].num_pus().second;    // -V112
+                if (chunks_per_target == 0)
+                    chunks_per_target = 1;
+            }
+
+            std::size_t const num_chunks = num_targets * chunks_per_target;
+            std::size_t const chunk_size =
+                (num_tasks + num_chunks - 1) / num_chunks;
+
+            return chunk_size == 0 ? std::size_t(1) : chunk_size;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            ar& chunks_per_target_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t chunks_per_target_;
+        /// \endcond
+    };
+}}}    // namespace hpx::compute::host
+
+namespace hpx { namespace parallel { namespace execution {
+    /// \cond NOINTERNAL
+    template <>
+    struct is_executor_parameters<compute::host::block_chunk_size>
+      : std::true_type
+    {
+    };
+    /// \endcond
+}}}    // namespace hpx::parallel::execution
+
+#endif
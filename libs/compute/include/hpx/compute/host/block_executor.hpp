@@ -8,6 +8,7 @@
 #define HPX_COMPUTE_HOST_BLOCK_EXECUTOR_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/compute/host/block_chunk_size.hpp>
 #include <hpx/compute/host/target.hpp>
 #include <hpx/functional/deferred_call.hpp>
 #include <hpx/iterator_support/iterator_range.hpp>
@@ -15,7 +16,6 @@
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/parallel/executors/execution.hpp>
-#include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/parallel/executors/thread_pool_attached_executors.hpp>
 #include <hpx/traits/executor_traits.hpp>
 #include <hpx/traits/is_executor.hpp>
@@ -32,7 +32,10 @@
 
 namespace hpx { namespace compute { namespace host {
     /// The block executor can be used to build NUMA aware programs.
-    /// It will distribute work evenly across the passed targets
+    /// It will distribute work evenly across the passed targets. The bulk
+    /// operations always run the i-th part of the given shape on the i-th
+    /// target, use \a block_chunk_size to keep the chunks of repeated
+    /// algorithm invocations on the same targets.
     ///
     /// \tparam Executor The underlying executor to use
     template <
@@ -41,8 +44,7 @@ namespace hpx { namespace compute { namespace host {
     struct block_executor
     {
     public:
-        typedef hpx::parallel::execution::static_chunk_size
-            executor_parameters_type;
+        typedef block_chunk_size executor_parameters_type;
 
         block_executor(std::vector<host::target> const& targets)
           : targets_(targets)
@@ -209,7 +211,7 @@ namespace hpx { namespace compute { namespace host {
                     std::advance(part_end, part_end_offset);
                     auto part_results = parallel::execution::bulk_sync_execute(
                         executors_[i], std::forward<F>(f),
-                        util::make_iterator_range(begin, part_end),
+                        util::make_iterator_range(part_begin, part_end),
                         std::forward<Ts>(ts)...);
                     results.insert(results.end(),
                         std::make_move_iterator(part_results.begin()),
@@ -0,0 +1,173 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/compute/host.hpp>
+#include <hpx/compute/vector.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The executor below runs all work inline and records which of the targets
+// of the block_executor the currently executed chunk was handed to.
+std::size_t current_target = std::size_t(-1);
+
+struct recording_executor
+{
+    recording_executor(std::size_t first_pu, std::size_t)
+      : target_(first_pu)
+    {
+    }
+
+    bool operator==(recording_executor const& rhs) const noexcept
+    {
+        return target_ == rhs.target_;
+    }
+
+    bool operator!=(recording_executor const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    template <typename F, typename... Ts>
+    hpx::future<
+        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
+    async_execute(F&& f, Ts&&... ts) const
+    {
+        current_target = target_;
+        return hpx::async(
+            hpx::launch::sync, std::forward<F>(f), std::forward<Ts>(ts)...);
+    }
+
+    std::size_t target_;
+};
+
+namespace hpx { namespace parallel { namespace execution {
+    template <>
+    struct is_two_way_executor<recording_executor> : std::true_type
+    {
+    };
+}}}    // namespace hpx::parallel::execution
+
+///////////////////////////////////////////////////////////////////////////////
+struct placed
+{
+    placed()
+      : target_(current_target)
+    {
+    }
+
+    std::size_t target_;
+};
+
+using executor_type = hpx::compute::host::block_executor<recording_executor>;
+using allocator_type =
+    hpx::compute::host::block_allocator<placed, recording_executor>;
+
+std::vector<hpx::compute::host::target> get_targets()
+{
+    // one target for each of the worker threads
+    auto& rp = hpx::resource::get_partitioner();
+
+    std::vector<hpx::compute::host::target> targets;
+    for (std::size_t i = 0; i != hpx::get_os_thread_count(); ++i)
+    {
+        targets.emplace_back(rp.get_pu_mask(i));
+    }
+    return targets;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_chunk_size(std::size_t count, std::size_t chunks_per_target)
+{
+    auto targets = get_targets();
+    executor_type exec(targets);
+
+    hpx::compute::host::block_chunk_size params(chunks_per_target);
+
+    // the chunk size does not depend on the number of cores
+    std::size_t chunk_size = params.get_chunk_size(exec, [] { return 0; },
+        hpx::get_os_thread_count(), count);
+    HPX_TEST_EQ(chunk_size,
+        params.get_chunk_size(exec, [] { return 0; }, 1, count));
+
+    // there are at most chunks_per_target chunks for each of the targets
+    HPX_TEST((count + chunk_size - 1) / chunk_size <=
+        targets.size() * chunks_per_target);
+}
+
+void test_placement(std::size_t count)
+{
+    auto targets = get_targets();
+
+    hpx::compute::vector<placed, allocator_type> v(
+        count, allocator_type(targets));
+
+    // the memory was touched on all of the targets (by default four chunks
+    // are created for each target)
+    if (count >= 4 * targets.size())
+    {
+        std::vector<std::size_t> touched(targets.size(), 0);
+        for (placed const& p : v)
+        {
+            HPX_TEST(p.target_ < targets.size());
+            ++touched[p.target_];
+        }
+        for (std::size_t t : touched)
+        {
+            HPX_TEST_NEQ(t, std::size_t(0));
+        }
+    }
+
+    // repeated invocations of the algorithms process each element on the
+    // target which has constructed it
+    auto policy = hpx::parallel::execution::par.on(executor_type(targets))
+                      .with(hpx::compute::host::block_chunk_size());
+
+    for (int i = 0; i != 3; ++i)
+    {
+        std::size_t mismatches = 0;
+        hpx::parallel::for_each(policy, v.begin(), v.end(),
+            [&mismatches](placed const& p) {
+                if (p.target_ != current_target)
+                    ++mismatches;
+            });
+        HPX_TEST_EQ(mismatches, std::size_t(0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (std::size_t count : {1, 7, 100, 1000, 10007})
+    {
+        test_chunk_size(count, 1);
+        test_chunk_size(count, 4);
+        test_placement(count);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
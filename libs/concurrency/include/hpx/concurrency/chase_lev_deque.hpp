@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: https://dl.acm.org/doi/10.1145/1073970.1073974
+//
+//  Memory orderings follow "Correct and Efficient Work-Stealing for Weak
+//  Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//  Link: https://dl.acm.org/doi/10.1145/2442516.2442524
+//
+//  C++ implementation - Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The deque has a single owner which is the only thread allowed to call
+//  push_bottom() and pop_bottom(). Those operations do not require any atomic
+//  read-modify-write instructions unless the deque holds exactly one element.
+//  Any thread may call steal(), which removes the oldest element using a
+//  single CAS on the top index.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_CONCURRENCY_CHASE_LEV_DEQUE_HPP)
+#define HPX_CONCURRENCY_CHASE_LEV_DEQUE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace util {
+
+    template <typename T>
+    class chase_lev_deque
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "chase_lev_deque requires a trivially copyable value type");
+
+        // circular buffer holding the elements, the capacity is always a
+        // power of two
+        class circular_array
+        {
+        public:
+            explicit circular_array(std::int64_t capacity)
+              : mask_(capacity - 1)
+              , data_(new std::atomic<T>[std::size_t(capacity)])
+            {
+                HPX_ASSERT((capacity & mask_) == 0);
+            }
+
+            std::int64_t capacity() const
+            {
+                return mask_ + 1;
+            }
+
+            void put(std::int64_t i, T val)
+            {
+                data_[std::size_t(i & mask_)].store(
+                    val, std::memory_order_relaxed);
+            }
+
+            T get(std::int64_t i) const
+            {
+                return data_[std::size_t(i & mask_)].load(
+                    std::memory_order_relaxed);
+            }
+
+            // create a copy of this array with twice the capacity holding
+            // the elements in [top, bottom)
+            circular_array* grow(std::int64_t bottom, std::int64_t top) const
+            {
+                circular_array* a = new circular_array(2 * capacity());
+                for (std::int64_t i = top; i != bottom; ++i)
+                {
+                    a->put(i, get(i));
+                }
+                return a;
+            }
+
+        private:
+            std::int64_t mask_;
+            std::unique_ptr<std::atomic<T>[]> data_;
+        };
+
+        static std::int64_t round_up_capacity(std::size_t initial_size)
+        {
+            std::int64_t capacity = 32;
+            while (capacity < std::int64_t(initial_size))
+                capacity *= 2;
+            return capacity;
+        }
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        explicit chase_lev_deque(std::size_t initial_size = 0)
+          : array_(nullptr)
+        {
+            top_.data_.store(0, std::memory_order_relaxed);
+            bottom_.data_.store(0, std::memory_order_relaxed);
+
+            retired_.emplace_back(
+                new circular_array(round_up_capacity(initial_size)));
+            array_.store(retired_.back().get(), std::memory_order_relaxed);
+        }
+
+        chase_lev_deque(chase_lev_deque const&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque const&) = delete;
+
+        // Add an element at the bottom of the deque, may be called by the
+        // owner only.
+        void push_bottom(T val)
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_acquire);
+            circular_array* a = array_.load(std::memory_order_relaxed);
+
+            if (HPX_UNLIKELY(b - t > a->capacity() - 1))
+            {
+                // thieves may still be reading from the old array, it is
+                // released only once the deque is destroyed
+                retired_.emplace_back(a->grow(b, t));
+                a = retired_.back().get();
+                array_.store(a, std::memory_order_release);
+            }
+
+            a->put(b, val);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.data_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // Remove the most recently pushed element, may be called by the owner
+        // only.
+        bool pop_bottom(T& val)
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed) - 1;
+            circular_array* a = array_.load(std::memory_order_relaxed);
+            bottom_.data_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // the deque was empty
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            val = a->get(b);
+            if (t == b)
+            {
+                // this is the last element, compete with the thieves
+                bool result = top_.data_.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return result;
+            }
+            return true;
+        }
+
+        // Remove the oldest element, may be called by any thread. This
+        // returns false if the deque was empty or if another thread won the
+        // race for the top element.
+        bool steal(T& val)
+        {
+            std::int64_t t = top_.data_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = bottom_.data_.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            circular_array* a = array_.load(std::memory_order_acquire);
+            T result = a->get(t);
+            if (!top_.data_.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            val = result;
+            return true;
+        }
+
+        bool empty() const
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+            return b <= t;
+        }
+
+        // approximate number of elements
+        std::size_t size() const
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+            return b > t ? std::size_t(b - t) : 0;
+        }
+
+    private:
+        // top and bottom are modified by different threads, keep them on
+        // separate cache lines
+        util::cache_line_data<std::atomic<std::int64_t>> top_;
+        util::cache_line_data<std::atomic<std::int64_t>> bottom_;
+
+        std::atomic<circular_array*> array_;
+
+        // all arrays ever allocated, owned by the owner thread
+        std::vector<std::unique_ptr<circular_array>> retired_;
+    };
+}}    // namespace hpx::util
+
+#endif
@@ -0,0 +1,111 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/chase_lev_deque.hpp>
+#include <hpx/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_single_thread()
+{
+    hpx::util::chase_lev_deque<std::size_t> d(4);
+    HPX_TEST(d.empty());
+
+    // force the underlying buffer to grow a couple of times
+    for (std::size_t i = 0; i != 1000; ++i)
+        d.push_bottom(i);
+    HPX_TEST_EQ(d.size(), std::size_t(1000));
+
+    // the owner sees the elements in LIFO order
+    std::size_t val = 0;
+    HPX_TEST(d.pop_bottom(val));
+    HPX_TEST_EQ(val, std::size_t(999));
+
+    // thieves see the elements in FIFO order
+    HPX_TEST(d.steal(val));
+    HPX_TEST_EQ(val, std::size_t(0));
+
+    for (std::size_t i = 998; i != 0; --i)
+    {
+        HPX_TEST(d.pop_bottom(val));
+        HPX_TEST_EQ(val, i);
+    }
+
+    HPX_TEST(d.empty());
+    HPX_TEST(!d.pop_bottom(val));
+    HPX_TEST(!d.steal(val));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent_steal(std::size_t num_thieves, std::size_t items)
+{
+    hpx::util::chase_lev_deque<std::size_t> d;
+
+    std::vector<std::atomic<std::size_t>> seen(items);
+    for (auto& s : seen)
+        s.store(0);
+
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> count(0);
+
+    std::vector<std::thread> thieves;
+    for (std::size_t i = 0; i != num_thieves; ++i)
+    {
+        thieves.emplace_back([&]() {
+            std::size_t val = 0;
+            while (!done.load() || !d.empty())
+            {
+                if (d.steal(val))
+                {
+                    ++seen[val];
+                    ++count;
+                }
+            }
+        });
+    }
+
+    // the owner interleaves pushing and popping
+    std::size_t val = 0;
+    for (std::size_t i = 0; i != items; ++i)
+    {
+        d.push_bottom(i);
+        if (i % 3 == 0 && d.pop_bottom(val))
+        {
+            ++seen[val];
+            ++count;
+        }
+    }
+    while (d.pop_bottom(val))
+    {
+        ++seen[val];
+        ++count;
+    }
+
+    done.store(true);
+    for (auto& t : thieves)
+        t.join();
+
+    // every element has been retrieved exactly once
+    HPX_TEST_EQ(count.load(), items);
+    for (auto& s : seen)
+        HPX_TEST_EQ(s.load(), std::size_t(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_single_thread();
+    test_concurrent_steal(1, 100000);
+    test_concurrent_steal(3, 100000);
+
+    return hpx::util::report_errors();
+}
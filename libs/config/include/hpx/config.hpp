@@ -430,6 +430,13 @@
 #  define HPX_IDLE_BACKOFF_TIME_MAX 1000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Number of times an idle scheduler thread yields to the OS before it parks
+// itself (used only if HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF is defined).
+#if !defined(HPX_IDLE_YIELD_COUNT_MAX)
+#  define HPX_IDLE_YIELD_COUNT_MAX 16
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 #if !defined(HPX_WRAPPER_HEAP_STEP)
 #  define HPX_WRAPPER_HEAP_STEP 0xFFFFU
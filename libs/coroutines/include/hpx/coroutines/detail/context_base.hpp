@@ -173,6 +173,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             this->init();
             HPX_ASSERT(is_ready());
             do_invoke();
+
+            // a coroutine which has run to completion does not need its stack
+            // anymore, the stack is rebuilt from scratch on rebind
+            if (m_state == ctx_exited)
+                this->release_stack();
+
             // TODO: could use a binary or here to eliminate
             // shortcut evaluation (and a branch), but maybe the compiler is
             // smart enough to do it anyway as there are no side effects.
@@ -259,6 +259,9 @@ namespace hpx { namespace threads { namespace coroutines {
                 }
             }
 
+            // the stack stays bound to the context for its whole lifetime
+            void release_stack() {}
+
             void rebind_stack()
             {
                 if (ctx_)
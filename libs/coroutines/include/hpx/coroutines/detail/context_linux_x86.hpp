@@ -202,7 +202,12 @@ namespace hpx { namespace threads { namespace coroutines {
                         static_cast<std::ptrdiff_t>(default_stack_size) :
                         stack_size)
               , m_stack(nullptr)
+              , m_stack_pool(nullptr)
             {
+#if defined(HPX_HAVE_STACKOVERFLOW_DETECTION) &&                               \
+    !defined(HPX_HAVE_ADDRESS_SANITIZER)
+                segv_stack.ss_sp = nullptr;
+#endif
             }
 
             void init()
@@ -224,8 +229,8 @@ namespace hpx { namespace threads { namespace coroutines {
                         "stack size of {1} is invalid", m_stack_size));
                 }
 
-                m_stack =
-                    posix::alloc_stack(static_cast<std::size_t>(m_stack_size));
+                m_stack = posix::acquire_stack(
+                    static_cast<std::size_t>(m_stack_size), m_stack_pool);
                 if (m_stack == nullptr)
                 {
                     throw std::runtime_error(
@@ -269,8 +274,27 @@ namespace hpx { namespace threads { namespace coroutines {
                     VALGRIND_STACK_DEREGISTER(
                         reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
 #endif
-                    posix::free_stack(
-                        m_stack, static_cast<std::size_t>(m_stack_size));
+                    posix::free_stack(m_stack,
+                        static_cast<std::size_t>(m_stack_size), m_stack_pool);
+                }
+            }
+
+            // Give the stack of an exited context back to the OS thread which
+            // is currently executing, the next coroutine started on this OS
+            // thread will reuse it. A context gets a new stack in init() once
+            // it is invoked again.
+            void release_stack()
+            {
+                if (m_stack && posix::use_adaptive_stacks)
+                {
+#if defined(HPX_HAVE_VALGRIND) && !defined(NVALGRIND)
+                    VALGRIND_STACK_DEREGISTER(
+                        reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
+#endif
+                    posix::release_stack(m_stack,
+                        static_cast<std::size_t>(m_stack_size), m_stack_pool);
+                    m_stack = nullptr;
+                    m_stack_pool = nullptr;
                 }
             }
 
@@ -360,7 +384,11 @@ namespace hpx { namespace threads { namespace coroutines {
 
                         void rebind_stack()
                         {
-                            HPX_ASSERT(m_stack);
+                            // the stack has been released, init() will set up
+                            // a new one
+                            if (!m_stack)
+                                return;
+
 #if defined(HPX_HAVE_COROUTINE_COUNTERS)
                             increment_stack_recycle_count();
 #endif
@@ -448,7 +476,10 @@ namespace hpx { namespace threads { namespace coroutines {
                             // https://rethinkdb.com/blog/handling-stack-overflow-on-custom-stacks/
                             // http://www.evanjones.ca/software/threading.html
                             //
-                            segv_stack.ss_sp = valloc(SEGV_STACK_SIZE);
+                            // init() runs again whenever the stack has
+                            // been released, keep the signal stack around
+                            if (segv_stack.ss_sp == nullptr)
+                                segv_stack.ss_sp = valloc(SEGV_STACK_SIZE);
                             segv_stack.ss_flags = 0;
                             segv_stack.ss_size = SEGV_STACK_SIZE;
 
@@ -510,6 +541,7 @@ namespace hpx { namespace threads { namespace coroutines {
 
                         std::ptrdiff_t m_stack_size;
                         void* m_stack;
+                        posix::stack_pool* m_stack_pool;
 
 #if defined(HPX_HAVE_STACKOVERFLOW_DETECTION) &&                               \
     !defined(HPX_HAVE_ADDRESS_SANITIZER)
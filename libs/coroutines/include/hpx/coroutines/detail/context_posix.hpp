@@ -233,8 +233,12 @@ namespace hpx { namespace threads { namespace coroutines {
                         static_cast<std::ptrdiff_t>(default_stack_size) :
                         stack_size)
               , m_stack(nullptr)
+              , m_stack_pool(nullptr)
               , funp_(&trampoline<CoroutineImpl>)
             {
+#if defined(HPX_HAVE_STACKOVERFLOW_DETECTION)
+                segv_stack.ss_sp = nullptr;
+#endif
             }
 
             void init()
@@ -242,7 +246,8 @@ namespace hpx { namespace threads { namespace coroutines {
                 if (m_stack != nullptr)
                     return;
 
-                m_stack = alloc_stack(static_cast<std::size_t>(m_stack_size));
+                m_stack = acquire_stack(
+                    static_cast<std::size_t>(m_stack_size), m_stack_pool);
                 if (m_stack == nullptr)
                 {
                     throw std::runtime_error(
@@ -261,7 +266,10 @@ namespace hpx { namespace threads { namespace coroutines {
                 // https://rethinkdb.com/blog/handling-stack-overflow-on-custom-stacks/
                 // http://www.evanjones.ca/software/threading.html
                 //
-                segv_stack.ss_sp = valloc(SEGV_STACK_SIZE);
+                // init() runs again whenever the stack has been released,
+                // keep the signal stack around
+                if (segv_stack.ss_sp == nullptr)
+                    segv_stack.ss_sp = valloc(SEGV_STACK_SIZE);
                 segv_stack.ss_flags = 0;
                 segv_stack.ss_size = SEGV_STACK_SIZE;
 
@@ -327,7 +335,19 @@ namespace hpx { namespace threads { namespace coroutines {
             ~ucontext_context_impl()
             {
                 if (m_stack)
-                    free_stack(m_stack, m_stack_size);
+                    free_stack(m_stack, m_stack_size, m_stack_pool);
+            }
+
+            // Give the stack of an exited context back to the OS thread which
+            // is currently executing, init() allocates a new one if needed.
+            void release_stack()
+            {
+                if (m_stack && use_adaptive_stacks)
+                {
+                    posix::release_stack(m_stack, m_stack_size, m_stack_pool);
+                    m_stack = nullptr;
+                    m_stack_pool = nullptr;
+                }
             }
 
             // Return the size of the reserved stack address space.
@@ -419,6 +439,7 @@ namespace hpx { namespace threads { namespace coroutines {
             // declare m_stack_size first so we can use it to initialize m_stack
             std::ptrdiff_t m_stack_size;
             void* m_stack;
+            stack_pool* m_stack_pool;
             void (*funp_)(void*);
 
 #if defined(HPX_HAVE_STACKOVERFLOW_DETECTION)
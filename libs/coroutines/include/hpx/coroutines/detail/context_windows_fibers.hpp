@@ -241,6 +241,9 @@ namespace hpx { namespace threads { namespace coroutines {
 
             HPX_CXX14_CONSTEXPR void reset_stack() noexcept {}
 
+            // fibers always own their stack
+            HPX_CXX14_CONSTEXPR void release_stack() noexcept {}
+
             void rebind_stack() noexcept
             {
 #if defined(HPX_HAVE_COROUTINE_COUNTERS)
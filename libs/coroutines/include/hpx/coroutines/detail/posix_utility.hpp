@@ -74,6 +74,13 @@
 namespace hpx { namespace threads { namespace coroutines { namespace detail {
     namespace posix {
         HPX_EXPORT extern bool use_guard_pages;
+        HPX_EXPORT extern bool use_stack_pool;
+        HPX_EXPORT extern bool use_adaptive_stacks;
+
+        // Stacks of a given size are carved out of large address space
+        // reservations owned by the OS thread allocating them, see
+        // stack_pool.cpp.
+        class stack_pool;
 
 #if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&     \
     _POSIX_MAPPED_FILES > 0
@@ -134,6 +141,19 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
         }
 
+        // Give the physical pages backing the given range back to the
+        // operating system while keeping the address range mapped. MADV_FREE
+        // lets the kernel reclaim the pages lazily, which is considerably
+        // cheaper than MADV_DONTNEED if the memory is reused soon.
+        inline void discard_stack_pages(void* addr, std::size_t size)
+        {
+#if defined(MADV_FREE)
+            if (::madvise(addr, size, MADV_FREE) == 0)
+                return;
+#endif
+            ::madvise(addr, size, MADV_DONTNEED);
+        }
+
         inline bool reset_stack(void* stack, std::size_t size)
         {
             void** watermark = static_cast<void**>(stack) +
@@ -145,7 +165,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             {
                 // We never free up the first page, as it's initialized only when the
                 // stack is created.
-                ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+                discard_stack_pages(stack, size - EXEC_PAGESIZE);
                 return true;
             }
 
@@ -170,6 +190,25 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
 #endif
         }
 
+        // Allocate a stack from the pool owned by the calling OS thread. On
+        // return 'pool' refers to the pool the stack was taken from, or is
+        // nullptr if the stack was allocated using alloc_stack(size) above.
+        HPX_EXPORT void* alloc_stack(std::size_t size, stack_pool*& pool);
+
+        // Release a stack previously allocated using alloc_stack(size, pool).
+        // This may be called from any OS thread.
+        HPX_EXPORT void free_stack(
+            void* stack, std::size_t size, stack_pool* pool);
+
+        // Take the stack cached by the calling OS thread, allocates a new
+        // stack if none of the requested size is available.
+        HPX_EXPORT void* acquire_stack(std::size_t size, stack_pool*& pool);
+
+        // Hand a stack of a finished coroutine back to the calling OS thread,
+        // which keeps it for the next coroutine it runs.
+        HPX_EXPORT void release_stack(
+            void* stack, std::size_t size, stack_pool* pool);
+
 #else    // non-mmap()
 
         //this should be a fine default.
@@ -209,6 +248,28 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             delete[] static_cast<stack_aligner*>(stack);
         }
 
+        inline void* alloc_stack(std::size_t size, stack_pool*& pool)
+        {
+            pool = nullptr;
+            return alloc_stack(size);
+        }
+
+        inline void free_stack(void* stack, std::size_t size, stack_pool*)
+        {
+            free_stack(stack, size);
+        }
+
+        inline void* acquire_stack(std::size_t size, stack_pool*& pool)
+        {
+            return alloc_stack(size, pool);
+        }
+
+        inline void release_stack(
+            void* stack, std::size_t size, stack_pool* pool)
+        {
+            free_stack(stack, size, pool);
+        }
+
 #endif    // non-mmap() implementation of alloc_stack()/free_stack()
 
         /**
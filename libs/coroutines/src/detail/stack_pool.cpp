@@ -0,0 +1,378 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_VERSION)
+#include <hpx/assertion.hpp>
+#include <hpx/coroutines/detail/posix_utility.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) &&     \
+    _POSIX_MAPPED_FILES > 0
+
+#include <atomic>
+#include <cstddef>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail {
+    namespace posix {
+
+        namespace {
+            // address space reserved by each pool, only the pages actually
+            // touched by a coroutine are ever committed
+            constexpr std::size_t pool_reserve_size =
+                std::size_t(256) * 1024 * 1024;
+
+            // stack sizes for which fewer stacks fit into one reservation are
+            // allocated directly
+            constexpr std::size_t min_stacks_per_pool = 16;
+
+            // number of different stack sizes a single OS thread pools
+            constexpr std::size_t max_pools_per_thread = 4;
+        }    // namespace
+
+        ///////////////////////////////////////////////////////////////////////
+        // A stack_pool hands out equally sized stacks from one contiguous
+        // address space reservation. Only the owning OS thread allocates from
+        // a pool, therefore carving out new stacks and reusing stacks freed
+        // by the owner does not need any synchronization. Stacks freed by
+        // other OS threads are pushed onto a lock-free list which the owner
+        // takes over as a whole once its local free list runs dry.
+        //
+        // Freed stacks keep their address range, all but their topmost page
+        // are handed back to the operating system. The topmost page holds the
+        // free list link. Stacks kept as a spare by the OS thread which ran
+        // the finished coroutine (see release_stack) are not discarded.
+        class stack_pool
+        {
+            struct free_node
+            {
+                free_node* next;
+            };
+
+        public:
+            static stack_pool* create(std::size_t stack_size)
+            {
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+                std::size_t guard_size = use_guard_pages ? EXEC_PAGESIZE : 0;
+#else
+                std::size_t guard_size = 0;
+#endif
+                std::size_t slot_size = stack_size + guard_size;
+                if (stack_size <= EXEC_PAGESIZE ||
+                    stack_size % EXEC_PAGESIZE != 0 ||
+                    pool_reserve_size / slot_size < min_stacks_per_pool)
+                {
+                    return nullptr;
+                }
+
+                void* region = ::mmap(nullptr, pool_reserve_size,
+                    PROT_EXEC | PROT_READ | PROT_WRITE,
+#if defined(__APPLE__)
+                    MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
+#elif defined(__FreeBSD__)
+                    MAP_PRIVATE | MAP_ANON,
+#else
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+#endif
+                    -1, 0);
+
+                if (region == MAP_FAILED)
+                    return nullptr;
+
+                return new stack_pool(
+                    static_cast<char*>(region), stack_size, guard_size);
+            }
+
+            std::size_t stack_size() const
+            {
+                return stack_size_;
+            }
+
+            // may be called by the owning OS thread only
+            void* allocate()
+            {
+                if (local_free_ == nullptr &&
+                    remote_free_.load(std::memory_order_relaxed) != nullptr)
+                {
+                    local_free_ =
+                        remote_free_.exchange(nullptr, std::memory_order_acquire);
+                }
+
+                void* stack = nullptr;
+                if (local_free_ != nullptr)
+                {
+                    free_node* node = local_free_;
+                    local_free_ = node->next;
+                    stack = stack_from_node(node);
+                }
+                else if (next_slot_ != num_slots_)
+                {
+                    char* slot = region_ + next_slot_++ * slot_size_;
+                    if (guard_size_ != 0)
+                    {
+                        // the guard page stays in place while the slot gets
+                        // reused
+                        ::mprotect(slot, guard_size_, PROT_NONE);
+                    }
+                    stack = slot + guard_size_;
+                }
+                else
+                {
+                    return nullptr;
+                }
+
+                refcount_.fetch_add(1, std::memory_order_relaxed);
+                return stack;
+            }
+
+            // may be called by any OS thread
+            void deallocate(void* stack, bool owner)
+            {
+                HPX_ASSERT(static_cast<char*>(stack) >= region_ &&
+                    static_cast<char*>(stack) < region_ + pool_reserve_size);
+
+                discard_stack_pages(stack, stack_size_ - EXEC_PAGESIZE);
+
+                free_node* node = node_from_stack(stack);
+                if (owner)
+                {
+                    node->next = local_free_;
+                    local_free_ = node;
+                }
+                else
+                {
+                    node->next = remote_free_.load(std::memory_order_relaxed);
+                    while (!remote_free_.compare_exchange_weak(node->next,
+                        node, std::memory_order_release,
+                        std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                release();
+            }
+
+            // called once the owning OS thread exits, the pool is destroyed
+            // as soon as the last stack allocated from it has been freed
+            void release()
+            {
+                if (refcount_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+        private:
+            stack_pool(
+                char* region, std::size_t stack_size, std::size_t guard_size)
+              : region_(region)
+              , stack_size_(stack_size)
+              , guard_size_(guard_size)
+              , slot_size_(stack_size + guard_size)
+              , num_slots_(pool_reserve_size / slot_size_)
+              , next_slot_(0)
+              , local_free_(nullptr)
+              , remote_free_(nullptr)
+              , refcount_(1)
+            {
+            }
+
+            ~stack_pool()
+            {
+                ::munmap(region_, pool_reserve_size);
+            }
+
+            free_node* node_from_stack(void* stack) const
+            {
+                return reinterpret_cast<free_node*>(
+                    static_cast<char*>(stack) + stack_size_ - sizeof(free_node));
+            }
+
+            void* stack_from_node(free_node* node) const
+            {
+                return reinterpret_cast<char*>(node) + sizeof(free_node) -
+                    stack_size_;
+            }
+
+            char* const region_;
+            std::size_t const stack_size_;
+            std::size_t const guard_size_;
+            std::size_t const slot_size_;
+            std::size_t const num_slots_;
+
+            // accessed by the owning OS thread only
+            std::size_t next_slot_;
+            free_node* local_free_;
+
+            std::atomic<free_node*> remote_free_;
+
+            // number of outstanding stacks plus one for the owning OS thread
+            std::atomic<std::size_t> refcount_;
+        };
+
+        namespace {
+            struct thread_stack_pools
+            {
+                thread_stack_pools() = default;
+                thread_stack_pools(thread_stack_pools const&) = delete;
+                thread_stack_pools& operator=(
+                    thread_stack_pools const&) = delete;
+
+                ~thread_stack_pools()
+                {
+                    for (spare_stack& spare : spares_)
+                    {
+                        if (spare.stack != nullptr)
+                        {
+                            free_stack(spare.stack, spare.size, spare.pool);
+                            spare.stack = nullptr;
+                        }
+                    }
+
+                    for (stack_pool*& pool : pools_)
+                    {
+                        if (pool != nullptr)
+                        {
+                            pool->release();
+                            pool = nullptr;
+                        }
+                    }
+                }
+
+                stack_pool* get(std::size_t stack_size)
+                {
+                    for (stack_pool*& pool : pools_)
+                    {
+                        if (pool == nullptr)
+                        {
+                            pool = stack_pool::create(stack_size);
+                            return pool;
+                        }
+                        if (pool->stack_size() == stack_size)
+                            return pool;
+                    }
+                    return nullptr;
+                }
+
+                bool owns(stack_pool const* p) const
+                {
+                    for (stack_pool const* pool : pools_)
+                    {
+                        if (pool == p)
+                            return true;
+                    }
+                    return false;
+                }
+
+                // stacks of finished coroutines kept for reuse by the next
+                // coroutine running on this OS thread, at most one per size
+                struct spare_stack
+                {
+                    void* stack = nullptr;
+                    std::size_t size = 0;
+                    stack_pool* pool = nullptr;
+                };
+
+                bool take_spare(
+                    std::size_t size, void*& stack, stack_pool*& pool)
+                {
+                    for (spare_stack& spare : spares_)
+                    {
+                        if (spare.stack != nullptr && spare.size == size)
+                        {
+                            stack = spare.stack;
+                            pool = spare.pool;
+                            spare.stack = nullptr;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                bool put_spare(void* stack, std::size_t size, stack_pool* pool)
+                {
+                    spare_stack* empty = nullptr;
+                    for (spare_stack& spare : spares_)
+                    {
+                        if (spare.stack == nullptr)
+                        {
+                            empty = &spare;
+                        }
+                        else if (spare.size == size)
+                        {
+                            return false;
+                        }
+                    }
+
+                    if (empty == nullptr)
+                        return false;
+
+                    empty->stack = stack;
+                    empty->size = size;
+                    empty->pool = pool;
+                    return true;
+                }
+
+                stack_pool* pools_[max_pools_per_thread] = {};
+                spare_stack spares_[max_pools_per_thread];
+            };
+
+            thread_local thread_stack_pools stack_pools;
+        }    // namespace
+
+        ///////////////////////////////////////////////////////////////////////
+        void* alloc_stack(std::size_t size, stack_pool*& pool)
+        {
+            pool = nullptr;
+            if (use_stack_pool)
+            {
+                stack_pool* p = stack_pools.get(size);
+                if (p != nullptr)
+                {
+                    void* stack = p->allocate();
+                    if (stack != nullptr)
+                    {
+                        pool = p;
+                        return stack;
+                    }
+                }
+            }
+            return alloc_stack(size);
+        }
+
+        void free_stack(void* stack, std::size_t size, stack_pool* pool)
+        {
+            if (pool == nullptr)
+            {
+                free_stack(stack, size);
+                return;
+            }
+
+            HPX_ASSERT(pool->stack_size() == size);
+            pool->deallocate(stack, stack_pools.owns(pool));
+        }
+
+        void* acquire_stack(std::size_t size, stack_pool*& pool)
+        {
+            void* stack = nullptr;
+            if (stack_pools.take_spare(size, stack, pool))
+                return stack;
+            return alloc_stack(size, pool);
+        }
+
+        void release_stack(void* stack, std::size_t size, stack_pool* pool)
+        {
+            if (!stack_pools.put_spare(stack, size, pool))
+                free_stack(stack, size, pool);
+        }
+}}}}}    // namespace hpx::threads::coroutines::detail::posix
+
+#endif
+#endif
@@ -14,6 +14,7 @@
 #include <hpx/parallel/executors/parallel_executor.hpp>
 #include <hpx/parallel/executors/parallel_executor_aggregated.hpp>
 #include <hpx/parallel/executors/pool_executor.hpp>
+#include <hpx/parallel/executors/sender.hpp>
 #include <hpx/parallel/executors/sequenced_executor.hpp>
 #include <hpx/parallel/executors/service_executors.hpp>
 #include <hpx/parallel/executors/this_thread_executors.hpp>
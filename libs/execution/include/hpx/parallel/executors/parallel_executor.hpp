@@ -20,11 +20,14 @@
 #include <hpx/functional/one_shot.hpp>
 #include <hpx/iterator_support/range.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos_fwd.hpp>
+#include <hpx/local_lcos/packaged_task.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/executors/fused_bulk_execute.hpp>
 #include <hpx/parallel/executors/post_policy_dispatch.hpp>
 #include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/threads/register_thread.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
@@ -298,7 +301,54 @@ namespace hpx { namespace parallel { namespace execution {
             }
 
             // spawn remaining tasks sequentially
-            spawn_sequential(results, l, base, size, func, it, ts...);
+            if (policy_ == launch::async)
+            {
+                spawn_batched(results, l, base, size, func, it, ts...);
+            }
+            else
+            {
+                spawn_sequential(results, l, base, size, func, it, ts...);
+            }
+        }
+
+        template <typename Result, typename F, typename Iter, typename... Ts>
+        void spawn_batched(std::vector<hpx::future<Result>>& results,
+            lcos::local::latch& l, std::size_t base, std::size_t size,
+            F const& func, Iter it, Ts const&... ts) const
+        {
+            // create all tasks first and hand them to the scheduler in one
+            // go, this avoids entering the scheduler (and locking a thread
+            // queue) for each of the tasks separately
+            HPX_ASSERT(base + size <= results.size());
+
+            auto pool = threads::detail::get_self_or_default_pool();
+            std::ptrdiff_t stacksize = pool->get_scheduler()->get_stack_size(
+                threads::thread_stacksize_default);
+            hpx::util::thread_description desc(func,
+                "hpx::parallel::execution::parallel_executor::"
+                "bulk_async_execute");
+
+            std::vector<threads::thread_init_data> data;
+            data.reserve(size);
+
+            for (std::size_t i = 0; i != size; ++i, ++it)
+            {
+                lcos::local::packaged_task<Result()> task(
+                    hpx::util::deferred_call(func, *it, ts...));
+                results[base + i] = task.get_future();
+
+                data.emplace_back(
+                    threads::thread_function_type(
+                        threads::detail::thread_function_nullary<
+                            lcos::local::packaged_task<Result()>>{
+                            std::move(task)}),
+                    desc, policy_.priority(), threads::thread_schedule_hint(),
+                    stacksize);
+            }
+
+            threads::register_threads_plain(pool, data.data(), size);
+
+            l.count_down(size);
         }
         /// \endcond
 
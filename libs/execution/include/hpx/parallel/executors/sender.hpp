@@ -0,0 +1,685 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/sender.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_SENDER_JAN_2020)
+#define HPX_PARALLEL_EXECUTORS_SENDER_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/datastructures/tuple.hpp>
+#include <hpx/functional/invoke.hpp>
+#include <hpx/functional/result_of.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/memory/intrusive_ptr.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/synchronization/condition_variable.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/type_support/pack.hpp>
+#include <hpx/type_support/unused.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+// A sender describes work which has not been started yet. Senders are
+// composed into a single object describing the whole pipeline, which is
+// connected to a receiver and started only once the result is requested
+// (see sync_wait and make_future). Each stage of a pipeline is stored inside
+// of the operation state of its successor, no shared state is allocated and
+// no reference count is maintained for passing values between stages.
+//
+// A sender exposes the type of the value it produces (result_type, possibly
+// void) and the executor the work is scheduled on (executor_type). Calling
+// connect() on an rvalue sender returns an operation state, which invokes
+// either set_value or set_error on the receiver after start() was called.
+// The operation state has to be kept alive until then.
+namespace hpx { namespace parallel { namespace execution {
+    namespace experimental {
+        /// \cond NOINTERNAL
+        namespace detail {
+            ///////////////////////////////////////////////////////////////////
+            template <typename Sender, typename Receiver>
+            struct connect_result
+            {
+                typedef decltype(std::declval<Sender>().connect(
+                    std::declval<Receiver>())) type;
+            };
+
+            // Values of senders producing no value are represented by
+            // unused_type wherever they have to be stored.
+            template <typename T>
+            struct value_or_unused
+            {
+                typedef T type;
+            };
+
+            template <>
+            struct value_or_unused<void>
+            {
+                typedef hpx::util::unused_type type;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            template <typename Executor, typename Receiver>
+            struct schedule_operation
+            {
+                void start() noexcept
+                {
+                    try
+                    {
+                        execution::post(exec_, [this]() { r_.set_value(); });
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                    }
+                }
+
+                Executor exec_;
+                Receiver r_;
+            };
+
+            template <typename Executor>
+            struct schedule_sender
+            {
+                typedef void result_type;
+                typedef Executor executor_type;
+
+                executor_type const& get_executor() const noexcept
+                {
+                    return exec_;
+                }
+
+                template <typename Receiver>
+                schedule_operation<Executor, typename std::decay<Receiver>::type>
+                connect(Receiver&& r) &&
+                {
+                    return {std::move(exec_), std::forward<Receiver>(r)};
+                }
+
+                Executor exec_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            template <typename F, typename T>
+            struct then_result : hpx::util::invoke_result<F&, T>
+            {
+            };
+
+            template <typename F>
+            struct then_result<F, void> : hpx::util::invoke_result<F&>
+            {
+            };
+
+            template <typename F, typename Receiver>
+            struct then_receiver
+            {
+                template <typename... Ts>
+                void set_value(Ts&&... ts) noexcept
+                {
+                    typedef typename hpx::util::invoke_result<F&, Ts...>::type
+                        result_type;
+
+                    try
+                    {
+                        set_value_impl(std::is_void<result_type>(),
+                            std::forward<Ts>(ts)...);
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                    }
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    r_.set_error(std::move(e));
+                }
+
+                template <typename... Ts>
+                void set_value_impl(std::true_type, Ts&&... ts)
+                {
+                    hpx::util::invoke(f_, std::forward<Ts>(ts)...);
+                    r_.set_value();
+                }
+
+                template <typename... Ts>
+                void set_value_impl(std::false_type, Ts&&... ts)
+                {
+                    r_.set_value(
+                        hpx::util::invoke(f_, std::forward<Ts>(ts)...));
+                }
+
+                F f_;
+                Receiver r_;
+            };
+
+            template <typename Sender, typename F>
+            struct then_sender
+            {
+                typedef typename then_result<F,
+                    typename Sender::result_type>::type result_type;
+                typedef typename Sender::executor_type executor_type;
+
+                executor_type const& get_executor() const noexcept
+                {
+                    return s_.get_executor();
+                }
+
+                template <typename Receiver>
+                typename connect_result<Sender,
+                    then_receiver<F, typename std::decay<Receiver>::type>>::type
+                connect(Receiver&& r) &&
+                {
+                    typedef then_receiver<F,
+                        typename std::decay<Receiver>::type>
+                        receiver_type;
+
+                    return std::move(s_).connect(
+                        receiver_type{std::move(f_), std::forward<Receiver>(r)});
+                }
+
+                Sender s_;
+                F f_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            template <typename F, typename T>
+            struct bulk_function
+            {
+                template <typename Index>
+                void operator()(Index&& i) const
+                {
+                    hpx::util::invoke(*f_, std::forward<Index>(i), *t_);
+                }
+
+                F* f_;
+                T* t_;
+            };
+
+            template <typename F>
+            struct bulk_function<F, void>
+            {
+                template <typename Index>
+                void operator()(Index&& i) const
+                {
+                    hpx::util::invoke(*f_, std::forward<Index>(i));
+                }
+
+                F* f_;
+            };
+
+            template <typename Executor, typename Shape, typename F,
+                typename Receiver>
+            struct bulk_receiver
+            {
+                void set_value() noexcept
+                {
+                    try
+                    {
+                        execution::bulk_sync_execute(
+                            exec_, bulk_function<F, void>{&f_}, shape_);
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                        return;
+                    }
+                    r_.set_value();
+                }
+
+                template <typename T>
+                void set_value(T&& t) noexcept
+                {
+                    typedef typename std::decay<T>::type value_type;
+
+                    try
+                    {
+                        value_type value(std::forward<T>(t));
+                        execution::bulk_sync_execute(exec_,
+                            bulk_function<F, value_type>{&f_, &value}, shape_);
+                        r_.set_value(std::move(value));
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                    }
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    r_.set_error(std::move(e));
+                }
+
+                Executor exec_;
+                Shape shape_;
+                F f_;
+                Receiver r_;
+            };
+
+            template <typename Sender, typename Shape, typename F>
+            struct bulk_sender
+            {
+                typedef typename Sender::result_type result_type;
+                typedef typename Sender::executor_type executor_type;
+
+                executor_type const& get_executor() const noexcept
+                {
+                    return s_.get_executor();
+                }
+
+                template <typename Receiver>
+                typename connect_result<Sender,
+                    bulk_receiver<executor_type, Shape, F,
+                        typename std::decay<Receiver>::type>>::type
+                connect(Receiver&& r) &&
+                {
+                    typedef bulk_receiver<executor_type, Shape, F,
+                        typename std::decay<Receiver>::type>
+                        receiver_type;
+
+                    executor_type exec = s_.get_executor();
+                    return std::move(s_).connect(receiver_type{std::move(exec),
+                        std::move(shape_), std::move(f_),
+                        std::forward<Receiver>(r)});
+                }
+
+                Sender s_;
+                Shape shape_;
+                F f_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            template <typename Operation, std::size_t I>
+            struct when_all_receiver
+            {
+                template <typename... Ts>
+                void set_value(Ts&&... ts) noexcept
+                {
+                    op_->template set_value<I>(std::forward<Ts>(ts)...);
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    op_->set_error(std::move(e));
+                }
+
+                Operation* op_;
+            };
+
+            template <typename Receiver, typename Indices,
+                typename... Senders>
+            struct when_all_operation;
+
+            template <typename Receiver, std::size_t... Is,
+                typename... Senders>
+            struct when_all_operation<Receiver,
+                hpx::util::pack_c<std::size_t, Is...>, Senders...>
+            {
+                typedef hpx::util::tuple<typename value_or_unused<
+                    typename Senders::result_type>::type...>
+                    values_type;
+
+                when_all_operation(
+                    hpx::util::tuple<Senders...>&& senders, Receiver&& r)
+                  : senders_(std::move(senders))
+                  , r_(std::move(r))
+                  , count_(sizeof...(Senders))
+                  , has_error_(false)
+                {
+                }
+
+                // the operation state can be moved as long as it has not
+                // been started
+                when_all_operation(when_all_operation&& rhs)
+                  : senders_(std::move(rhs.senders_))
+                  , r_(std::move(rhs.r_))
+                  , count_(sizeof...(Senders))
+                  , has_error_(false)
+                {
+                }
+
+                void start() noexcept
+                {
+                    // the predecessors are connected only now, as their
+                    // receivers refer to this (now stable) operation state
+                    try
+                    {
+                        int const sequencer[] = {0,
+                            (hpx::util::get<Is>(ops_).emplace(
+                                 std::move(hpx::util::get<Is>(senders_))
+                                     .connect(when_all_receiver<
+                                         when_all_operation, Is>{this})),
+                                0)...};
+                        (void) sequencer;
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                        return;
+                    }
+
+                    int const sequencer[] = {
+                        0, ((*hpx::util::get<Is>(ops_)).start(), 0)...};
+                    (void) sequencer;
+                }
+
+                template <std::size_t I, typename... Ts>
+                void set_value(Ts&&... ts) noexcept
+                {
+                    try
+                    {
+                        hpx::util::get<I>(values_).emplace(
+                            std::forward<Ts>(ts)...);
+                    }
+                    catch (...)
+                    {
+                        set_error(std::current_exception());
+                        return;
+                    }
+                    finish();
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    // only the first error is reported
+                    if (!has_error_.exchange(true))
+                        error_ = std::move(e);
+                    finish();
+                }
+
+                void finish() noexcept
+                {
+                    if (--count_ != 0)
+                        return;
+
+                    if (has_error_.load(std::memory_order_relaxed))
+                    {
+                        r_.set_error(std::move(error_));
+                        return;
+                    }
+
+                    try
+                    {
+                        r_.set_value(values_type(
+                            std::move(*hpx::util::get<Is>(values_))...));
+                    }
+                    catch (...)
+                    {
+                        r_.set_error(std::current_exception());
+                    }
+                }
+
+                hpx::util::tuple<Senders...> senders_;
+                Receiver r_;
+
+                hpx::util::tuple<hpx::util::optional<
+                    typename connect_result<Senders,
+                        when_all_receiver<when_all_operation, Is>>::type>...>
+                    ops_;
+                hpx::util::tuple<hpx::util::optional<typename value_or_unused<
+                    typename Senders::result_type>::type>...>
+                    values_;
+
+                std::atomic<std::size_t> count_;
+                std::atomic<bool> has_error_;
+                std::exception_ptr error_;
+            };
+
+            template <typename Sender, typename... Senders>
+            struct when_all_sender
+            {
+                typedef hpx::util::tuple<
+                    typename value_or_unused<
+                        typename Sender::result_type>::type,
+                    typename value_or_unused<
+                        typename Senders::result_type>::type...>
+                    result_type;
+                typedef typename Sender::executor_type executor_type;
+
+                executor_type const& get_executor() const noexcept
+                {
+                    return hpx::util::get<0>(senders_).get_executor();
+                }
+
+                template <typename Receiver>
+                when_all_operation<typename std::decay<Receiver>::type,
+                    typename hpx::util::make_index_pack<1 +
+                        sizeof...(Senders)>::type,
+                    Sender, Senders...>
+                connect(Receiver&& r) &&
+                {
+                    return {std::move(senders_), std::forward<Receiver>(r)};
+                }
+
+                hpx::util::tuple<Sender, Senders...> senders_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            struct sync_wait_state_base
+            {
+                sync_wait_state_base()
+                  : done_(false)
+                {
+                }
+
+                void set_done()
+                {
+                    // the waiting thread may destroy this object as soon as
+                    // the lock has been released
+                    std::lock_guard<mutex_type> l(mtx_);
+                    done_ = true;
+                    cond_.notify_one();
+                }
+
+                void wait()
+                {
+                    std::unique_lock<mutex_type> l(mtx_);
+                    cond_.wait(l, [this]() { return done_; });
+
+                    if (error_)
+                        std::rethrow_exception(error_);
+                }
+
+                typedef hpx::lcos::local::spinlock mutex_type;
+
+                mutex_type mtx_;
+                hpx::lcos::local::condition_variable_any cond_;
+                bool done_;
+                std::exception_ptr error_;
+            };
+
+            template <typename T>
+            struct sync_wait_state : sync_wait_state_base
+            {
+                T get()
+                {
+                    wait();
+                    return std::move(*value_);
+                }
+
+                hpx::util::optional<T> value_;
+            };
+
+            template <>
+            struct sync_wait_state<void> : sync_wait_state_base
+            {
+                void get()
+                {
+                    wait();
+                }
+
+                hpx::util::optional<hpx::util::unused_type> value_;
+            };
+
+            template <typename T>
+            struct sync_wait_receiver
+            {
+                template <typename... Ts>
+                void set_value(Ts&&... ts) noexcept
+                {
+                    try
+                    {
+                        state_->value_.emplace(std::forward<Ts>(ts)...);
+                    }
+                    catch (...)
+                    {
+                        state_->error_ = std::current_exception();
+                    }
+                    state_->set_done();
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    state_->error_ = std::move(e);
+                    state_->set_done();
+                }
+
+                sync_wait_state<T>* state_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            // The receiver keeps the shared state (and with it the operation
+            // state it is part of) alive until the pipeline has finished.
+            template <typename State>
+            struct future_receiver
+            {
+                template <typename... Ts>
+                void set_value(Ts&&... ts) noexcept
+                {
+                    hpx::intrusive_ptr<State> state = std::move(state_);
+                    try
+                    {
+                        state->set_value(std::forward<Ts>(ts)...);
+                    }
+                    catch (...)
+                    {
+                        state->set_exception(std::current_exception());
+                    }
+                }
+
+                void set_error(std::exception_ptr e) noexcept
+                {
+                    hpx::intrusive_ptr<State> state = std::move(state_);
+                    state->set_exception(std::move(e));
+                }
+
+                hpx::intrusive_ptr<State> state_;
+            };
+
+            template <typename Sender>
+            struct future_sender_state
+              : lcos::detail::future_data<typename Sender::result_type>
+            {
+                typedef lcos::detail::future_data<typename Sender::result_type>
+                    base_type;
+                typedef typename base_type::init_no_addref init_no_addref;
+
+                typedef typename connect_result<Sender,
+                    future_receiver<future_sender_state>>::type
+                    operation_type;
+
+                explicit future_sender_state(init_no_addref no_addref)
+                  : base_type(no_addref)
+                {
+                }
+
+                hpx::util::optional<operation_type> op_;
+            };
+        }    // namespace detail
+        /// \endcond
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return a sender which completes on an execution agent created by
+        /// the given executor (e.g. a \a parallel_executor or a
+        /// \a pool_executor).
+        template <typename Executor>
+        detail::schedule_sender<typename std::decay<Executor>::type> schedule(
+            Executor&& exec)
+        {
+            return {std::forward<Executor>(exec)};
+        }
+
+        /// Return a sender which invokes \a f with the value produced by
+        /// \a s (if any) and produces the result of this invocation.
+        template <typename Sender, typename F>
+        detail::then_sender<Sender, typename std::decay<F>::type> then(
+            Sender s, F&& f)
+        {
+            return {std::move(s), std::forward<F>(f)};
+        }
+
+        /// Return a sender which invokes \a f(i, value) for each element
+        /// \a i of \a shape once \a s has produced its value. The invocations
+        /// are distributed using the executor \a s was scheduled on. The
+        /// sender produces the (possibly modified) value of \a s.
+        template <typename Sender, typename Shape, typename F>
+        detail::bulk_sender<Sender, typename std::decay<Shape>::type,
+            typename std::decay<F>::type>
+        bulk(Sender s, Shape&& shape, F&& f)
+        {
+            return {
+                std::move(s), std::forward<Shape>(shape), std::forward<F>(f)};
+        }
+
+        /// Return a sender which completes once all given senders have
+        /// completed. It produces a tuple of their values, where senders
+        /// producing no value are represented by \a hpx::util::unused_type.
+        /// If any of the senders completes with an error, the first error
+        /// is propagated.
+        template <typename Sender, typename... Senders>
+        detail::when_all_sender<Sender, Senders...> when_all(
+            Sender s, Senders... ss)
+        {
+            return {hpx::util::tuple<Sender, Senders...>(
+                std::move(s), std::move(ss)...)};
+        }
+
+        /// Start the work described by \a s and wait for it to complete.
+        /// Returns the value produced by \a s or rethrows the exception it
+        /// completed with. No shared state is allocated as the operation
+        /// state of the pipeline is kept on the stack of the calling thread.
+        template <typename Sender>
+        typename Sender::result_type sync_wait(Sender s)
+        {
+            typedef typename Sender::result_type result_type;
+
+            detail::sync_wait_state<result_type> state;
+            auto op = std::move(s).connect(
+                detail::sync_wait_receiver<result_type>{&state});
+            op.start();
+            return state.get();
+        }
+
+        /// Start the work described by \a s and return a future referring
+        /// to the value it produces. This allocates a single shared state
+        /// holding the operation state of the whole pipeline.
+        template <typename Sender>
+        hpx::future<typename Sender::result_type> make_future(Sender s)
+        {
+            typedef detail::future_sender_state<Sender> shared_state;
+            typedef typename shared_state::init_no_addref init_no_addref;
+            typedef detail::future_receiver<shared_state> receiver_type;
+
+            hpx::intrusive_ptr<shared_state> p(
+                new shared_state(init_no_addref{}), false);
+
+            p->op_.emplace(std::move(s).connect(receiver_type{p}));
+            (*p->op_).start();
+
+            return hpx::traits::future_access<hpx::future<
+                typename Sender::result_type>>::create(std::move(p));
+        }
+    }    // namespace experimental
+}}}    // namespace hpx::parallel::execution
+
+#endif
@@ -27,7 +27,11 @@ int hpx_main()
             using var_type = typename hpx::util::decay<comp_type>::type;
 
             var_type mass_density = 0.0;
+#if defined(HPX_HAVE_DATAPAR_VC)
             mass_density(mass_density > 0.0) = 7.0;
+#else
+            where(mass_density > 0.0, mass_density) = 7.0;
+#endif
 
             HPX_TEST(all_of(mass_density == 0.0));
         });
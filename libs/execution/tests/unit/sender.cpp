@@ -0,0 +1,163 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = hpx::parallel::execution::experimental;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Executor>
+void test_then(Executor& exec)
+{
+    hpx::thread::id tid = hpx::this_thread::get_id();
+
+    auto s = ex::then(ex::then(ex::schedule(exec),
+                          [tid]() {
+                              HPX_TEST(tid != hpx::this_thread::get_id());
+                              return 42;
+                          }),
+        [](int i) { return std::to_string(i); });
+
+    HPX_TEST_EQ(ex::sync_wait(std::move(s)), std::string("42"));
+
+    // a chain of stages producing no value
+    std::atomic<int> count(0);
+    ex::sync_wait(ex::then(ex::then(ex::schedule(exec), [&]() { ++count; }),
+        [&]() { ++count; }));
+    HPX_TEST_EQ(count.load(), 2);
+}
+
+template <typename Executor>
+void test_when_all(Executor& exec)
+{
+    auto s = ex::when_all(ex::then(ex::schedule(exec), []() { return 1; }),
+        ex::then(ex::schedule(exec), []() { return 2.0; }),
+        ex::schedule(exec));
+
+    auto result = ex::sync_wait(ex::then(std::move(s),
+        [](hpx::util::tuple<int, double, hpx::util::unused_type>&& t) {
+            return hpx::util::get<0>(t) + hpx::util::get<1>(t);
+        }));
+    HPX_TEST_EQ(result, 3.0);
+}
+
+template <typename Executor>
+void test_bulk(Executor& exec)
+{
+    std::vector<std::size_t> shape(107);
+    std::iota(shape.begin(), shape.end(), 0);
+
+    auto s = ex::bulk(ex::then(ex::schedule(exec),
+                          []() { return std::vector<std::size_t>(107, 0); }),
+        shape, [](std::size_t i, std::vector<std::size_t>& v) { v[i] = i; });
+
+    std::vector<std::size_t> result = ex::sync_wait(std::move(s));
+    HPX_TEST(result == shape);
+
+    // bulk on a sender producing no value
+    std::atomic<std::size_t> count(0);
+    ex::sync_wait(
+        ex::bulk(ex::schedule(exec), shape, [&](std::size_t) { ++count; }));
+    HPX_TEST_EQ(count.load(), shape.size());
+}
+
+template <typename Executor>
+void test_make_future(Executor& exec)
+{
+    hpx::future<int> f = ex::make_future(
+        ex::then(ex::schedule(exec), []() { return 42; }));
+    HPX_TEST_EQ(f.get(), 42);
+
+    hpx::future<void> fv = ex::make_future(ex::schedule(exec));
+    fv.get();
+}
+
+template <typename Executor>
+void test_exceptions(Executor& exec)
+{
+    bool caught_exception = false;
+    try
+    {
+        ex::sync_wait(ex::then(ex::then(ex::schedule(exec),
+                                   []() -> int {
+                                       throw std::runtime_error("error");
+                                   }),
+            [](int i) { return i; }));
+        HPX_TEST(false);
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        ex::sync_wait(ex::when_all(ex::then(ex::schedule(exec),
+                                       []() { throw std::runtime_error(""); }),
+            ex::schedule(exec)));
+        HPX_TEST(false);
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    hpx::future<void> f = ex::make_future(
+        ex::then(ex::schedule(exec), []() { throw std::runtime_error(""); }));
+    f.wait();
+    HPX_TEST(f.has_exception());
+
+    f = ex::make_future(
+        ex::then(ex::schedule(exec), []() { throw std::runtime_error(""); }));
+    HPX_TEST_THROW(f.get(), std::runtime_error);
+}
+
+template <typename Executor>
+void test_senders(Executor& exec)
+{
+    test_then(exec);
+    test_when_all(exec);
+    test_bulk(exec);
+    test_make_future(exec);
+    test_exceptions(exec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    hpx::parallel::execution::parallel_executor par_exec;
+    test_senders(par_exec);
+
+    hpx::parallel::execution::pool_executor pool_exec("default");
+    test_senders(pool_exec);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv, cfg), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
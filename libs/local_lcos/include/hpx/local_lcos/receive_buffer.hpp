@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
+#include <hpx/datastructures/optional.hpp>
 #include <hpx/errors.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/local_lcos/promise.hpp>
@@ -21,454 +22,397 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <utility>
 
 namespace hpx { namespace lcos { namespace local {
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename T, typename Mutex = lcos::local::spinlock>
-    struct receive_buffer
-    {
-    protected:
-        typedef Mutex mutex_type;
-        typedef hpx::lcos::local::promise<T> buffer_promise_type;
 
-        struct entry_data
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // The entries of a receive buffer are kept in a ring indexed by the
+        // step modulo the window size. An entry whose ring slot is occupied
+        // by a different step (i.e. a step far ahead of the others) is stored
+        // in a map instead. The ring is allocated once, on first use, thus
+        // matching a message with its receiver does not allocate anything
+        // beyond the shared state of the future as long as all steps in
+        // flight fit into the window.
+        template <typename T, typename Mutex>
+        struct receive_buffer_base
         {
-        public:
-            HPX_NON_COPYABLE(entry_data);
+        protected:
+            typedef Mutex mutex_type;
+            typedef hpx::lcos::local::promise<T> buffer_promise_type;
 
-        public:
-            entry_data()
-              : can_be_deleted_(false)
-              , value_set_(false)
+            struct entry_data
             {
-            }
+            public:
+                HPX_NON_COPYABLE(entry_data);
+
+            public:
+                entry_data()
+                  : step_(std::size_t(-1))
+                  , in_use_(false)
+                  , can_be_deleted_(false)
+                  , value_set_(false)
+                {
+                }
 
-            hpx::future<T> get_future()
-            {
-                return promise_.get_future();
-            }
+                void acquire(std::size_t step)
+                {
+                    HPX_ASSERT(!in_use_);
+                    step_ = step;
+                    in_use_ = true;
+                    can_be_deleted_ = false;
+                    value_set_ = false;
+                    promise_.emplace();
+                }
 
-            template <typename Val>
-            void set_value(Val&& val)
-            {
-                value_set_ = true;
-                promise_.set_value(std::forward<Val>(val));
-            }
+                void release()
+                {
+                    in_use_ = false;
+                    promise_.reset();
+                }
 
-            bool cancel(std::exception_ptr const& e)
-            {
-                HPX_ASSERT(can_be_deleted_);
-                if (!value_set_)
+                hpx::future<T> get_future()
                 {
-                    promise_.set_exception(e);
-                    return true;
+                    return promise_->get_future();
                 }
-                return false;
-            }
 
-            buffer_promise_type promise_;
-            bool can_be_deleted_;
-            bool value_set_;
-        };
+                template <typename... Ts>
+                void set_value(Ts&&... ts)
+                {
+                    value_set_ = true;
+                    promise_->set_value(std::forward<Ts>(ts)...);
+                }
 
-        typedef std::map<std::size_t, std::shared_ptr<entry_data>>
-            buffer_map_type;
-        typedef typename buffer_map_type::iterator iterator;
+                bool cancel(std::exception_ptr const& e)
+                {
+                    HPX_ASSERT(can_be_deleted_);
+                    if (!value_set_)
+                    {
+                        promise_->set_exception(e);
+                        return true;
+                    }
+                    return false;
+                }
 
-        struct erase_on_exit
-        {
-            erase_on_exit(buffer_map_type& buffer_map, iterator it)
-              : buffer_map_(buffer_map)
-              , it_(it)
-            {
-            }
+                hpx::util::optional<buffer_promise_type> promise_;
+                std::size_t step_;
+                bool in_use_;
+                bool can_be_deleted_;
+                bool value_set_;
+            };
+
+            typedef std::map<std::size_t, entry_data> buffer_map_type;
+            typedef typename buffer_map_type::iterator iterator;
 
-            ~erase_on_exit()
+            static std::size_t round_up_window_size(std::size_t size)
             {
-                buffer_map_.erase(it_);
+                std::size_t result = 1;
+                while (result < size)
+                {
+                    result <<= 1;
+                }
+                return result;
             }
 
-            buffer_map_type& buffer_map_;
-            iterator it_;
-        };
-
-    public:
-        receive_buffer() = default;
-
-        receive_buffer(receive_buffer&& other) noexcept
-          : mtx_()
-          , buffer_map_(std::move(other.buffer_map_))
-        {
-        }
-
-        ~receive_buffer()
-        {
-            HPX_ASSERT(buffer_map_.empty());
-        }
+        public:
+            static constexpr std::size_t default_window_size = 16;
 
-        receive_buffer& operator=(receive_buffer&& other) noexcept
-        {
-            if (this != &other)
+            explicit receive_buffer_base(
+                std::size_t window_size = default_window_size)
+              : window_mask_(round_up_window_size(window_size) - 1)
+              , size_(0)
             {
-                mtx_ = mutex_type();
-                buffer_map_ = std::move(other.buffer_map_);
             }
-            return *this;
-        }
-
-        hpx::future<T> receive(std::size_t step)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
-
-            iterator it = get_buffer_entry(step);
-            HPX_ASSERT(it != buffer_map_.end());
 
-            // if the value was already set we delete the entry after
-            // retrieving the future
-            if (it->second->can_be_deleted_)
+            receive_buffer_base(receive_buffer_base&& other) noexcept
+              : mtx_()
+              , ring_(std::move(other.ring_))
+              , window_mask_(other.window_mask_)
+              , buffer_map_(std::move(other.buffer_map_))
+              , size_(other.size_)
             {
-                erase_on_exit t(buffer_map_, it);
-                return it->second->get_future();
+                other.size_ = 0;
             }
 
-            // otherwise mark the entry as to be deleted once the value was set
-            it->second->can_be_deleted_ = true;
-            return it->second->get_future();
-        }
-
-        bool try_receive(std::size_t step, hpx::future<T>* f = nullptr)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
-
-            iterator it = buffer_map_.find(step);
-            if (it == buffer_map_.end())
-                return false;
+            ~receive_buffer_base()
+            {
+                HPX_ASSERT(size_ == 0);
+            }
 
-            // if the value was already set we delete the entry after
-            // retrieving the future
-            if (it->second->can_be_deleted_)
+            receive_buffer_base& operator=(receive_buffer_base&& other) noexcept
             {
-                if (f != nullptr)
+                if (this != &other)
                 {
-                    erase_on_exit t(buffer_map_, it);
-                    *f = it->second->get_future();
+                    mtx_ = mutex_type();
+                    ring_ = std::move(other.ring_);
+                    window_mask_ = other.window_mask_;
+                    buffer_map_ = std::move(other.buffer_map_);
+                    size_ = other.size_;
+                    other.size_ = 0;
                 }
-                return true;
+                return *this;
             }
 
-            // otherwise mark the entry as to be deleted once the value was set
-            if (f != nullptr)
-            {
-                it->second->can_be_deleted_ = true;
-                *f = it->second->get_future();
-            }
-            return true;
-        }
-
-        template <typename Lock = hpx::lcos::local::no_mutex>
-        void store_received(std::size_t step, T&& val, Lock* lock = nullptr)
-        {
-            std::shared_ptr<entry_data> entry;
-
+            hpx::future<T> receive(std::size_t step)
             {
                 std::lock_guard<mutex_type> l(mtx_);
 
-                iterator it = get_buffer_entry(step);
-                HPX_ASSERT(it != buffer_map_.end());
-
-                entry = it->second;
+                entry_data* entry = get_buffer_entry(step);
 
-                if (!entry->can_be_deleted_)
+                // if the value was already set we delete the entry after
+                // retrieving the future
+                if (entry->can_be_deleted_)
                 {
-                    // if the future was not retrieved yet mark the entry as
-                    // to be deleted after it was be retrieved
-                    entry->can_be_deleted_ = true;
+                    hpx::future<T> f = entry->get_future();
+                    erase_buffer_entry(entry);
+                    return f;
                 }
-                else
-                {
-                    // if the future was already retrieved we can delete the
-                    // entry now
-                    buffer_map_.erase(it);
-                }
-            }
 
-            if (lock)
-                lock->unlock();
-
-            // set value in promise, but only after the lock went out of scope
-            entry->set_value(std::move(val));
-        }
+                // otherwise mark the entry as to be deleted once the value
+                // was set
+                entry->can_be_deleted_ = true;
+                return entry->get_future();
+            }
 
-        bool empty() const
-        {
-            return buffer_map_.empty();
-        }
+            bool try_receive(std::size_t step, hpx::future<T>* f = nullptr)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
 
-        // return the number of deleted buffer entries
-        std::size_t cancel_waiting(
-            std::exception_ptr const& e, bool force_delete_entries = false)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
+                entry_data* entry = find_buffer_entry(step);
+                if (entry == nullptr)
+                    return false;
 
-            std::size_t count = 0;
-            iterator end = buffer_map_.end();
-            for (iterator it = buffer_map_.begin(); it != end; /**/)
-            {
-                iterator to_delete = it++;
-                if (to_delete->second->cancel(e) || force_delete_entries)
+                // if the value was already set we delete the entry after
+                // retrieving the future
+                if (entry->can_be_deleted_)
                 {
-                    buffer_map_.erase(to_delete);
-                    ++count;
+                    if (f != nullptr)
+                    {
+                        *f = entry->get_future();
+                        erase_buffer_entry(entry);
+                    }
+                    return true;
                 }
-            }
-            return count;
-        }
 
-    protected:
-        iterator get_buffer_entry(std::size_t step)
-        {
-            iterator it = buffer_map_.find(step);
-            if (it == buffer_map_.end())
-            {
-                std::pair<iterator, bool> res = buffer_map_.insert(
-                    std::make_pair(step, std::make_shared<entry_data>()));
-                if (!res.second)
+                // otherwise mark the entry as to be deleted once the value
+                // was set
+                if (f != nullptr)
                 {
-                    HPX_THROW_EXCEPTION(invalid_status,
-                        "base_receive_buffer::get_buffer_entry",
-                        "couldn't insert a new entry into the receive buffer");
+                    entry->can_be_deleted_ = true;
+                    *f = entry->get_future();
                 }
-                return res.first;
-            }
-            return it;
-        }
-
-    private:
-        mutable mutex_type mtx_;
-        buffer_map_type buffer_map_;
-    };
-
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename Mutex>
-    struct receive_buffer<void, Mutex>
-    {
-    protected:
-        typedef Mutex mutex_type;
-        typedef hpx::lcos::local::promise<void> buffer_promise_type;
-
-        struct entry_data
-        {
-        public:
-            HPX_NON_COPYABLE(entry_data);
-
-        public:
-            entry_data()
-              : can_be_deleted_(false)
-              , value_set_(false)
-            {
+                return true;
             }
 
-            hpx::future<void> get_future()
+            bool empty() const
             {
-                return promise_.get_future();
+                return size_ == 0;
             }
 
-            void set_value()
+            // return the number of deleted buffer entries
+            std::size_t cancel_waiting(
+                std::exception_ptr const& e, bool force_delete_entries = false)
             {
-                value_set_ = true;
-                promise_.set_value();
-            }
+                std::lock_guard<mutex_type> l(mtx_);
 
-            bool cancel(std::exception_ptr const& e)
-            {
-                HPX_ASSERT(can_be_deleted_);
-                if (!value_set_)
+                std::size_t count = 0;
+                if (ring_)
                 {
-                    promise_.set_exception(e);
-                    return true;
+                    for (std::size_t i = 0; i <= window_mask_; ++i)
+                    {
+                        entry_data& entry = ring_[i];
+                        if (entry.in_use_ &&
+                            (entry.cancel(e) || force_delete_entries))
+                        {
+                            entry.release();
+                            --size_;
+                            ++count;
+                        }
+                    }
                 }
-                return false;
-            }
-
-            buffer_promise_type promise_;
-            bool can_be_deleted_;
-            bool value_set_;
-        };
 
-        typedef std::map<std::size_t, std::shared_ptr<entry_data>>
-            buffer_map_type;
-        typedef typename buffer_map_type::iterator iterator;
-
-        struct erase_on_exit
-        {
-            erase_on_exit(buffer_map_type& buffer_map, iterator it)
-              : buffer_map_(buffer_map)
-              , it_(it)
-            {
+                iterator end = buffer_map_.end();
+                for (iterator it = buffer_map_.begin(); it != end; /**/)
+                {
+                    iterator to_delete = it++;
+                    if (to_delete->second.cancel(e) || force_delete_entries)
+                    {
+                        buffer_map_.erase(to_delete);
+                        --size_;
+                        ++count;
+                    }
+                }
+                return count;
             }
 
-            ~erase_on_exit()
+        protected:
+            template <typename Lock, typename... Ts>
+            void store_received_impl(std::size_t step, Lock* lock, Ts&&... ts)
             {
-                buffer_map_.erase(it_);
-            }
-
-            buffer_map_type& buffer_map_;
-            iterator it_;
-        };
+                hpx::util::optional<buffer_promise_type> promise;
 
-    public:
-        receive_buffer() {}
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    entry_data* entry = get_buffer_entry(step);
+
+                    if (!entry->can_be_deleted_)
+                    {
+                        // if the future was not retrieved yet nobody can
+                        // be waiting for the value, store it right away and
+                        // mark the entry as to be deleted after the future
+                        // was retrieved
+                        entry->can_be_deleted_ = true;
+                        entry->set_value(std::forward<Ts>(ts)...);
+                    }
+                    else
+                    {
+                        // if the future was already retrieved we can delete
+                        // the entry now, the promise is kept alive until
+                        // the value is set
+                        promise.emplace(std::move(*entry->promise_));
+                        erase_buffer_entry(entry);
+                    }
+                }
 
-        receive_buffer(receive_buffer&& other)
-          : buffer_map_(std::move(other.buffer_map_))
-        {
-        }
+                if (lock)
+                    lock->unlock();
 
-        ~receive_buffer()
-        {
-            HPX_ASSERT(buffer_map_.empty());
-        }
+                // set value in promise, but only after the lock went out of
+                // scope as setting the value might run continuations
+                if (promise)
+                    promise->set_value(std::forward<Ts>(ts)...);
+            }
 
-        receive_buffer& operator=(receive_buffer&& other)
-        {
-            if (this != &other)
+            entry_data* find_buffer_entry(std::size_t step)
             {
-                buffer_map_ = std::move(other.buffer_map_);
-            }
-            return *this;
-        }
+                if (ring_)
+                {
+                    entry_data& entry = ring_[step & window_mask_];
+                    if (entry.in_use_ && entry.step_ == step)
+                        return &entry;
+                }
 
-        hpx::future<void> receive(std::size_t step)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
+                if (buffer_map_.empty())
+                    return nullptr;
 
-            iterator it = get_buffer_entry(step);
-            HPX_ASSERT(it != buffer_map_.end());
+                iterator it = buffer_map_.find(step);
+                if (it == buffer_map_.end())
+                    return nullptr;
 
-            // if the value was already set we delete the entry after
-            // retrieving the future
-            if (it->second->can_be_deleted_)
-            {
-                erase_on_exit t(buffer_map_, it);
-                return it->second->get_future();
+                return &it->second;
             }
 
-            // otherwise mark the entry as to be deleted once the value was set
-            it->second->can_be_deleted_ = true;
-            return it->second->get_future();
-        }
-
-        bool try_receive(std::size_t step, hpx::future<void>* f = nullptr)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
+            entry_data* get_buffer_entry(std::size_t step)
+            {
+                entry_data* entry = find_buffer_entry(step);
+                if (entry != nullptr)
+                    return entry;
 
-            iterator it = buffer_map_.find(step);
-            if (it == buffer_map_.end())
-                return false;
+                if (!ring_)
+                    ring_.reset(new entry_data[window_mask_ + 1]);
 
-            // if the value was already set we delete the entry after
-            // retrieving the future
-            if (it->second->can_be_deleted_)
-            {
-                if (f != nullptr)
+                entry = &ring_[step & window_mask_];
+                if (entry->in_use_)
                 {
-                    erase_on_exit t(buffer_map_, it);
-                    *f = it->second->get_future();
+                    // the slot is taken by a different step, fall back to
+                    // the overflow map
+                    std::pair<iterator, bool> res = buffer_map_.emplace(
+                        std::piecewise_construct, std::forward_as_tuple(step),
+                        std::forward_as_tuple());
+                    if (!res.second)
+                    {
+                        HPX_THROW_EXCEPTION(invalid_status,
+                            "base_receive_buffer::get_buffer_entry",
+                            "couldn't insert a new entry into the receive "
+                            "buffer");
+                    }
+                    entry = &res.first->second;
                 }
-                return true;
-            }
 
-            // otherwise mark the entry as to be deleted once the value was set
-            if (f != nullptr)
-            {
-                it->second->can_be_deleted_ = true;
-                *f = it->second->get_future();
+                entry->acquire(step);
+                ++size_;
+                return entry;
             }
-            return true;
-        }
-
-        template <typename Lock = hpx::lcos::local::no_mutex>
-        void store_received(std::size_t step, Lock* lock = nullptr)
-        {
-            std::shared_ptr<entry_data> entry;
 
+            void erase_buffer_entry(entry_data* entry)
             {
-                std::lock_guard<mutex_type> l(mtx_);
-
-                iterator it = get_buffer_entry(step);
-                HPX_ASSERT(it != buffer_map_.end());
+                HPX_ASSERT(entry->in_use_);
+                --size_;
 
-                entry = it->second;
-
-                if (!entry->can_be_deleted_)
+                if (ring_ && entry >= &ring_[0] &&
+                    entry <= &ring_[window_mask_])
                 {
-                    // if the future was not retrieved yet mark the entry as
-                    // to be deleted after it was be retrieved
-                    entry->can_be_deleted_ = true;
-                }
-                else
-                {
-                    // if the future was already retrieved we can delete the
-                    // entry now
-                    buffer_map_.erase(it);
+                    entry->release();
+                    return;
                 }
+
+                buffer_map_.erase(entry->step_);
             }
 
-            if (lock)
-                lock->unlock();
+        private:
+            mutable mutex_type mtx_;
+            std::unique_ptr<entry_data[]> ring_;
+            std::size_t window_mask_;
+            buffer_map_type buffer_map_;
+            std::size_t size_;
+        };
 
-            // set value in promise, but only after the lock went out of scope
-            entry->set_value();
-        }
+        template <typename T, typename Mutex>
+        constexpr std::size_t
+            receive_buffer_base<T, Mutex>::default_window_size;
+    }    // namespace detail
 
-        bool empty() const
+    ///////////////////////////////////////////////////////////////////////////
+    // The window size is the number of consecutive steps which can be in
+    // flight at the same time without requiring any additional allocation.
+    template <typename T, typename Mutex = lcos::local::spinlock>
+    struct receive_buffer : detail::receive_buffer_base<T, Mutex>
+    {
+        typedef detail::receive_buffer_base<T, Mutex> base_type;
+
+    public:
+        explicit receive_buffer(
+            std::size_t window_size = base_type::default_window_size)
+          : base_type(window_size)
         {
-            return buffer_map_.empty();
         }
 
-        // return the number of deleted buffer entries
-        std::size_t cancel_waiting(
-            std::exception_ptr const& e, bool force_delete_entries = false)
-        {
-            std::lock_guard<mutex_type> l(mtx_);
+        receive_buffer(receive_buffer&& other) = default;
+        receive_buffer& operator=(receive_buffer&& other) = default;
 
-            std::size_t count = 0;
-            iterator end = buffer_map_.end();
-            for (iterator it = buffer_map_.begin(); it != end; /**/)
-            {
-                iterator to_delete = it++;
-                if (to_delete->second->cancel(e) || force_delete_entries)
-                {
-                    buffer_map_.erase(to_delete);
-                    ++count;
-                }
-            }
-            return count;
+        template <typename Lock = hpx::lcos::local::no_mutex>
+        void store_received(std::size_t step, T&& val, Lock* lock = nullptr)
+        {
+            this->store_received_impl(step, lock, std::move(val));
         }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Mutex>
+    struct receive_buffer<void, Mutex>
+      : detail::receive_buffer_base<void, Mutex>
+    {
+        typedef detail::receive_buffer_base<void, Mutex> base_type;
 
-    protected:
-        iterator get_buffer_entry(std::size_t step)
+    public:
+        explicit receive_buffer(
+            std::size_t window_size = base_type::default_window_size)
+          : base_type(window_size)
         {
-            iterator it = buffer_map_.find(step);
-            if (it == buffer_map_.end())
-            {
-                std::pair<iterator, bool> res = buffer_map_.insert(
-                    std::make_pair(step, std::make_shared<entry_data>()));
-                if (!res.second)
-                {
-                    HPX_THROW_EXCEPTION(invalid_status,
-                        "base_receive_buffer::get_buffer_entry",
-                        "couldn't insert a new entry into the receive buffer");
-                }
-                return res.first;
-            }
-            return it;
         }
 
-    private:
-        mutable mutex_type mtx_;
-        buffer_map_type buffer_map_;
+        receive_buffer(receive_buffer&& other) = default;
+        receive_buffer& operator=(receive_buffer&& other) = default;
+
+        template <typename Lock = hpx::lcos::local::no_mutex>
+        void store_received(std::size_t step, Lock* lock = nullptr)
+        {
+            this->store_received_impl(step, lock);
+        }
     };
 }}}    // namespace hpx::lcos::local
 
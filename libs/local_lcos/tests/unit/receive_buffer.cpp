@@ -0,0 +1,133 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/local_lcos/receive_buffer.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_in_order(std::size_t window_size)
+{
+    hpx::lcos::local::receive_buffer<std::string> buffer(window_size);
+
+    // values received before they are requested
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        buffer.store_received(i, std::to_string(i));
+    }
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        HPX_TEST_EQ(buffer.receive(i).get(), std::to_string(i));
+    }
+    HPX_TEST(buffer.empty());
+
+    // values requested before they are received
+    std::vector<hpx::future<std::string>> values;
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        values.push_back(buffer.receive(i));
+    }
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        buffer.store_received(i, std::to_string(i));
+    }
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        HPX_TEST_EQ(values[i].get(), std::to_string(i));
+    }
+    HPX_TEST(buffer.empty());
+}
+
+void test_out_of_window()
+{
+    // steps which map to the same slot of the ring
+    hpx::lcos::local::receive_buffer<int> buffer(4);
+
+    hpx::future<int> f1 = buffer.receive(1);
+    hpx::future<int> f5 = buffer.receive(5);
+    buffer.store_received(9, 9);
+
+    hpx::future<int> f;
+    HPX_TEST(!buffer.try_receive(13));
+    HPX_TEST(buffer.try_receive(9));
+    HPX_TEST(buffer.try_receive(9, &f));
+    HPX_TEST_EQ(f.get(), 9);
+
+    buffer.store_received(5, 5);
+    buffer.store_received(1, 1);
+
+    HPX_TEST_EQ(f1.get(), 1);
+    HPX_TEST_EQ(f5.get(), 5);
+    HPX_TEST(buffer.empty());
+}
+
+void test_concurrent()
+{
+    hpx::lcos::local::receive_buffer<std::size_t> buffer;
+
+    std::vector<hpx::future<void>> senders;
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        senders.push_back(hpx::async(
+            [&buffer, i]() { buffer.store_received(i, std::size_t(i)); }));
+    }
+
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        HPX_TEST_EQ(buffer.receive(i).get(), i);
+    }
+
+    hpx::wait_all(senders);
+    HPX_TEST(buffer.empty());
+}
+
+void test_cancel()
+{
+    hpx::lcos::local::receive_buffer<void> buffer(2);
+
+    hpx::future<void> f0 = buffer.receive(0);
+    hpx::future<void> f2 = buffer.receive(2);
+    buffer.store_received(1);
+
+    std::exception_ptr e;
+    try
+    {
+        HPX_THROW_EXCEPTION(hpx::future_cancelled, "test_cancel", "canceled");
+    }
+    catch (...)
+    {
+        e = std::current_exception();
+    }
+
+    HPX_TEST_EQ(buffer.cancel_waiting(e), std::size_t(2));
+    HPX_TEST(f0.has_exception());
+    HPX_TEST(f2.has_exception());
+
+    HPX_TEST(!buffer.empty());
+    buffer.receive(1).get();
+    HPX_TEST(buffer.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_in_order(1);
+    test_in_order(16);
+    test_in_order(128);
+    test_out_of_window();
+    test_concurrent();
+    test_cancel();
+
+    return hpx::util::report_errors();
+}
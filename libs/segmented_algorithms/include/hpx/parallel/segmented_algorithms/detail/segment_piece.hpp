@@ -0,0 +1,100 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_SEGMENT_PIECE_JAN_2020)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_SEGMENT_PIECE_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail {
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A contiguous piece of a segment: the id of the segment, the local
+    // iterator referring to its first element and the number of elements.
+    // Other than a local iterator passed to a remote algorithm directly, a
+    // piece is not resolved on the locality the algorithm is executed on,
+    // which allows to refer to elements stored on a different locality.
+    template <typename LocalIter>
+    struct segment_piece
+    {
+        segment_piece()
+          : count_(0)
+        {
+        }
+
+        segment_piece(
+            id_type const& id, LocalIter const& begin, std::size_t count)
+          : id_(id)
+          , begin_(begin)
+          , count_(count)
+        {
+        }
+
+        id_type id_;
+        LocalIter begin_;
+        std::size_t count_;
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            // clang-format off
+            ar & id_ & begin_ & count_;
+            // clang-format on
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // copy the given number of elements out of a segment
+    template <typename LocalIter>
+    struct seg_extract
+      : public detail::algorithm<seg_extract<LocalIter>,
+            std::vector<typename std::iterator_traits<LocalIter>::value_type>>
+    {
+        typedef std::vector<
+            typename std::iterator_traits<LocalIter>::value_type>
+            values_type;
+
+        seg_extract()
+          : seg_extract::algorithm("extract")
+        {
+        }
+
+        template <typename ExPolicy, typename FwdIter>
+        static values_type sequential(
+            ExPolicy, FwdIter first, std::size_t count)
+        {
+            return values_type(first, std::next(first, count));
+        }
+
+        template <typename ExPolicy, typename FwdIter>
+        static typename util::detail::algorithm_result<ExPolicy,
+            values_type>::type
+        parallel(ExPolicy&& policy, FwdIter first, std::size_t count)
+        {
+            return util::detail::algorithm_result<ExPolicy, values_type>::get(
+                sequential(policy, first, count));
+        }
+    };
+
+    /// \endcond
+}}}}    // namespace hpx::parallel::v1::detail
+
+#endif
@@ -10,15 +10,18 @@
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
 #include <hpx/lcos/dataflow.hpp>
+#include <hpx/runtime/naming/name.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/segment_piece.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <iterator>
 #include <list>
@@ -33,13 +36,90 @@ namespace hpx { namespace parallel { inline namespace v1 {
         ///////////////////////////////////////////////////////////////////////
         /// \cond NOINTERNAL
 
-        // sequential remote implementation
-        template <typename Algo, typename ExPolicy, typename SegIter,
-            typename SegOutIter>
-        static typename util::detail::algorithm_result<ExPolicy,
-            std::pair<SegIter, SegOutIter>>::type
-        segmented_transfer(Algo&& algo, ExPolicy const& policy, std::true_type,
-            SegIter first, SegIter last, SegOutIter dest)
+        // Transfer the elements of a segment to a destination segment located
+        // on a different locality. This is executed where the destination is
+        // stored, the elements are fetched from the source segment.
+        template <typename LocalIter, typename LocalOutIter>
+        struct seg_transfer_remote
+          : public detail::algorithm<
+                seg_transfer_remote<LocalIter, LocalOutIter>, LocalOutIter>
+        {
+            seg_transfer_remote()
+              : seg_transfer_remote::algorithm("transfer")
+            {
+            }
+
+            template <typename ExPolicy, typename OutIter>
+            static OutIter sequential(ExPolicy policy,
+                segment_piece<LocalIter> const& src, OutIter dest)
+            {
+                std::vector<typename std::iterator_traits<
+                    LocalIter>::value_type>
+                    values = dispatch(src.id_, seg_extract<LocalIter>(), policy,
+                        std::true_type(), src.begin_, src.count_);
+
+                return std::move(values.begin(), values.end(), dest);
+            }
+
+            template <typename ExPolicy, typename OutIter>
+            static typename util::detail::algorithm_result<ExPolicy,
+                OutIter>::type
+            parallel(ExPolicy&& policy, segment_piece<LocalIter> const& src,
+                OutIter dest)
+            {
+                return util::detail::algorithm_result<ExPolicy, OutIter>::get(
+                    sequential(policy, src, dest));
+            }
+        };
+
+        // The part of the source range which is transferred to one
+        // destination segment by a single remote operation.
+        template <typename LocalIter, typename LocalOutIter>
+        struct transfer_piece
+        {
+            transfer_piece(id_type const& id, LocalIter const& first,
+                LocalIter const& last, id_type const& dest_id,
+                LocalOutIter const& dest)
+              : id_(id)
+              , first_(first)
+              , last_(last)
+              , dest_id_(dest_id)
+              , dest_(dest)
+            {
+            }
+
+            // elements can be transferred directly if both segments are
+            // located on the same locality
+            bool is_local() const
+            {
+                return naming::get_locality_id_from_id(id_) ==
+                    naming::get_locality_id_from_id(dest_id_);
+            }
+
+            segment_piece<LocalIter> source() const
+            {
+                return segment_piece<LocalIter>(
+                    id_, first_, std::distance(first_, last_));
+            }
+
+            id_type id_;
+            LocalIter first_;
+            LocalIter last_;
+            id_type dest_id_;
+            LocalOutIter dest_;
+        };
+
+        // Split the source range into pieces such that no piece crosses a
+        // segment boundary of either the source or the destination range.
+        // This allows for the source and destination to be distributed
+        // differently. Returns the end of the destination range.
+        template <typename SegIter, typename SegOutIter>
+        SegOutIter segmented_transfer_pieces(SegIter first, SegIter last,
+            SegOutIter dest,
+            std::vector<transfer_piece<typename hpx::traits::
+                    segmented_iterator_traits<SegIter>::local_iterator,
+                typename hpx::traits::segmented_iterator_traits<
+                    SegOutIter>::local_iterator>>& pieces)
         {
             typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
             typedef typename traits::segment_iterator segment_iterator;
@@ -52,70 +132,85 @@ namespace hpx { namespace parallel { inline namespace v1 {
             typedef typename output_traits::local_iterator
                 local_output_iterator_type;
 
-            typedef std::pair<local_iterator_type, local_output_iterator_type>
-                local_iterator_pair;
-
             segment_iterator sit = traits::segment(first);
             segment_iterator send = traits::segment(last);
 
-            segment_output_iterator sdest = traits::segment(dest);
+            segment_output_iterator sdest = output_traits::segment(dest);
+            local_output_iterator_type out = output_traits::local(dest);
 
-            if (sit == send)
+            while (true)
             {
-                // all elements are on the same partition
-                local_iterator_type beg = traits::local(first);
-                local_iterator_type end = traits::local(last);
-
-                if (beg != end)
+                local_iterator_type beg = (sit == traits::segment(first)) ?
+                    traits::local(first) :
+                    traits::begin(sit);
+                local_iterator_type end =
+                    (sit == send) ? traits::local(last) : traits::end(sit);
+
+                std::size_t count = std::distance(beg, end);
+                while (count != 0)
                 {
-                    local_iterator_pair p =
-                        dispatch(traits::get_id(sit), algo, policy,
-                            std::true_type(), beg, end, traits::local(dest));
+                    std::size_t room =
+                        std::distance(out, output_traits::end(sdest));
+                    if (room == 0)
+                    {
+                        ++sdest;
+                        out = output_traits::begin(sdest);
+                        continue;
+                    }
+
+                    std::size_t n = (std::min)(count, room);
+                    local_iterator_type next = std::next(beg, n);
+
+                    pieces.emplace_back(traits::get_id(sit), beg, next,
+                        output_traits::get_id(sdest), out);
 
-                    dest = output_traits::compose(sdest, p.second);
+                    beg = next;
+                    out = std::next(out, n);
+                    count -= n;
                 }
+
+                if (sit == send)
+                    break;
+                ++sit;
             }
-            else
-            {
-                // handle the remaining part of the first partition
-                local_iterator_type beg = traits::local(first);
-                local_iterator_type end = traits::end(sit);
-                local_output_iterator_type out = traits::local(dest);
 
-                if (beg != end)
-                {
-                    local_iterator_pair p = dispatch(traits::get_id(sit), algo,
-                        policy, std::true_type(), beg, end, out);
-                    out = p.second;
-                }
+            return output_traits::compose(sdest, out);
+        }
 
-                // handle all of the full partitions
-                for ((void) ++sit, ++sdest; sit != send; (void) ++sit, ++sdest)
-                {
-                    beg = traits::begin(sit);
-                    end = traits::end(sit);
-                    out = traits::begin(sdest);
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename SegOutIter>
+        static typename util::detail::algorithm_result<ExPolicy,
+            std::pair<SegIter, SegOutIter>>::type
+        segmented_transfer(Algo&& algo, ExPolicy const& policy, std::true_type,
+            SegIter first, SegIter last, SegOutIter dest)
+        {
+            typedef typename hpx::traits::segmented_iterator_traits<
+                SegIter>::local_iterator local_iterator_type;
+            typedef typename hpx::traits::segmented_iterator_traits<
+                SegOutIter>::local_iterator local_output_iterator_type;
 
-                    if (beg != end)
-                    {
-                        local_iterator_pair p = dispatch(traits::get_id(sit),
-                            algo, policy, std::true_type(), beg, end, out);
-                        out = p.second;
-                    }
-                }
+            typedef transfer_piece<local_iterator_type,
+                local_output_iterator_type>
+                piece_type;
 
-                // handle the beginning of the last partition
-                beg = traits::begin(sit);
-                end = traits::local(last);
-                if (beg != end)
+            std::vector<piece_type> pieces;
+            dest = segmented_transfer_pieces(first, last, dest, pieces);
+
+            for (piece_type const& p : pieces)
+            {
+                if (p.is_local())
                 {
-                    local_iterator_pair p =
-                        dispatch(traits::get_id(sit), algo, policy,
-                            std::true_type(), beg, end, traits::begin(sdest));
-                    out = p.second;
+                    dispatch(p.id_, algo, policy, std::true_type(), p.first_,
+                        p.last_, p.dest_);
+                }
+                else
+                {
+                    dispatch(p.dest_id_,
+                        seg_transfer_remote<local_iterator_type,
+                            local_output_iterator_type>(),
+                        policy, std::true_type(), p.source(), p.dest_);
                 }
-
-                dest = output_traits::compose(sdest, out);
             }
 
             return util::detail::algorithm_result<ExPolicy,
@@ -131,100 +226,62 @@ namespace hpx { namespace parallel { inline namespace v1 {
         segmented_transfer(Algo&& algo, ExPolicy const& policy, std::false_type,
             SegIter first, SegIter last, SegOutIter dest)
         {
-            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
-            typedef typename traits::segment_iterator segment_iterator;
-            typedef typename traits::local_iterator local_iterator_type;
-
-            typedef hpx::traits::segmented_iterator_traits<SegOutIter>
-                output_traits;
-            typedef typename output_traits::segment_iterator
-                segment_output_iterator;
-            typedef typename output_traits::local_iterator
-                local_output_iterator_type;
+            typedef typename hpx::traits::segmented_iterator_traits<
+                SegIter>::local_iterator local_iterator_type;
+            typedef typename hpx::traits::segmented_iterator_traits<
+                SegOutIter>::local_iterator local_output_iterator_type;
 
             typedef std::pair<local_iterator_type, local_output_iterator_type>
                 local_iterator_pair;
 
+            typedef transfer_piece<local_iterator_type,
+                local_output_iterator_type>
+                piece_type;
+
             typedef std::integral_constant<bool,
                 !hpx::traits::is_forward_iterator<SegIter>::value>
                 forced_seq;
 
-            segment_iterator sit = traits::segment(first);
-            segment_iterator send = traits::segment(last);
-
-            segment_output_iterator sdest = traits::segment(dest);
+            std::vector<piece_type> pieces;
+            dest = segmented_transfer_pieces(first, last, dest, pieces);
 
-            std::vector<shared_future<local_iterator_pair>> segments;
-            segments.reserve(std::distance(sit, send));
+            std::vector<future<local_iterator_pair>> segments;
+            std::vector<future<local_output_iterator_type>> remote_segments;
+            segments.reserve(pieces.size());
 
-            if (sit == send)
+            for (piece_type const& p : pieces)
             {
-                // all elements are on the same partition
-                local_iterator_type beg = traits::local(first);
-                local_iterator_type end = traits::local(last);
-
-                if (beg != end)
+                if (p.is_local())
                 {
-                    segments.push_back(dispatch_async(traits::get_id(sit), algo,
-                        policy, forced_seq(), beg, end, traits::local(dest)));
+                    segments.push_back(dispatch_async(p.id_, algo, policy,
+                        forced_seq(), p.first_, p.last_, p.dest_));
                 }
-            }
-            else
-            {
-                // handle the remaining part of the first partition
-                local_iterator_type beg = traits::local(first);
-                local_iterator_type end = traits::end(sit);
-                local_output_iterator_type out = traits::local(dest);
-
-                if (beg != end)
+                else
                 {
-                    segments.push_back(dispatch_async(traits::get_id(sit), algo,
-                        policy, forced_seq(), beg, end, out));
-                }
-
-                // handle all of the full partitions
-                for ((void) ++sit, ++sdest; sit != send; (void) ++sit, ++sdest)
-                {
-                    beg = traits::begin(sit);
-                    end = traits::end(sit);
-                    out = traits::begin(sdest);
-
-                    if (beg != end)
-                    {
-                        segments.push_back(dispatch_async(traits::get_id(sit),
-                            algo, policy, forced_seq(), beg, end, out));
-                    }
-                }
-
-                // handle the beginning of the last partition
-                beg = traits::begin(sit);
-                end = traits::local(last);
-
-                if (beg != end)
-                {
-                    segments.push_back(dispatch_async(traits::get_id(sit), algo,
-                        policy, forced_seq(), beg, end, traits::begin(sdest)));
+                    remote_segments.push_back(dispatch_async(p.dest_id_,
+                        seg_transfer_remote<local_iterator_type,
+                            local_output_iterator_type>(),
+                        policy, forced_seq(), p.source(), p.dest_));
                 }
             }
-            // NOLINTNEXTLINE(bugprone-use-after-move)
-            HPX_ASSERT(!segments.empty());
+            HPX_ASSERT(!segments.empty() || !remote_segments.empty());
 
             return util::detail::
                 algorithm_result<ExPolicy, std::pair<SegIter, SegOutIter>>::get(
                     hpx::dataflow(
-                        [=](std::vector<shared_future<local_iterator_pair>>&& r)
-                            -> std::pair<SegIter, SegOutIter> {
+                        [=](std::vector<future<local_iterator_pair>>&& r,
+                            std::vector<future<local_output_iterator_type>>&&
+                                rr) -> std::pair<SegIter, SegOutIter> {
                             // handle any remote exceptions, will throw on error
                             std::list<std::exception_ptr> errors;
                             parallel::util::detail::handle_remote_exceptions<
                                 ExPolicy>::call(r, errors);
+                            parallel::util::detail::handle_remote_exceptions<
+                                ExPolicy>::call(rr, errors);
 
-                            local_iterator_pair p = r.back().get();
-                            return std::make_pair(
-                                output_traits::compose(sdest, p.first),
-                                output_traits::compose(sdest, p.second));
+                            return std::make_pair(last, dest);
                         },
-                        std::move(segments)));
+                        std::move(segments), std::move(remote_segments)));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,606 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_JAN_2020)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_JAN_2020
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/collectives/latch.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/segment_piece.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 {
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // number of samples drawn from every segment to select the splitters
+        static std::size_t const segmented_sort_samples = 64;
+
+        template <typename T>
+        T segmented_sort_get(T&& t)
+        {
+            return std::forward<T>(t);
+        }
+
+        template <typename T>
+        T segmented_sort_get(hpx::future<T>&& f)
+        {
+            return f.get();
+        }
+
+        template <typename RandomIt>
+        std::vector<typename std::iterator_traits<RandomIt>::value_type>
+        segmented_sort_draw_samples(
+            RandomIt first, RandomIt last, std::size_t num_samples)
+        {
+            std::vector<typename std::iterator_traits<RandomIt>::value_type>
+                samples;
+
+            std::size_t count = std::distance(first, last);
+            num_samples = (std::min)(num_samples, count);
+            samples.reserve(num_samples);
+
+            // the range is sorted, evenly spaced elements are its quantiles
+            for (std::size_t i = 0; i != num_samples; ++i)
+            {
+                samples.push_back(
+                    *std::next(first, (2 * i + 1) * count / (2 * num_samples)));
+            }
+            return samples;
+        }
+
+        // merge two sorted runs, the elements are compared in place and
+        // moved only when being written to the result
+        template <typename T, typename Pred>
+        std::vector<T> segmented_sort_merge(
+            std::vector<T>& lhs, std::vector<T>& rhs, Pred& pred)
+        {
+            std::vector<T> result;
+            result.reserve(lhs.size() + rhs.size());
+
+            auto first1 = lhs.begin();
+            auto first2 = rhs.begin();
+            while (first1 != lhs.end() && first2 != rhs.end())
+            {
+                // take from the first run on ties, the merge is stable
+                if (pred(*first2, *first1))
+                    result.push_back(std::move(*first2++));
+                else
+                    result.push_back(std::move(*first1++));
+            }
+
+            result.insert(result.end(), std::make_move_iterator(first1),
+                std::make_move_iterator(lhs.end()));
+            result.insert(result.end(), std::make_move_iterator(first2),
+                std::make_move_iterator(rhs.end()));
+            return result;
+        }
+
+        // sort the local part of a segment and return samples of it
+        template <typename LocalIter>
+        struct seg_sort_local
+          : public detail::algorithm<seg_sort_local<LocalIter>,
+                std::vector<typename std::iterator_traits<
+                    LocalIter>::value_type>>
+        {
+            typedef std::vector<
+                typename std::iterator_traits<LocalIter>::value_type>
+                samples_type;
+
+            seg_sort_local()
+              : seg_sort_local::algorithm("sort")
+            {
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static samples_type sequential(ExPolicy, RandomIt first,
+                RandomIt last, std::size_t num_samples, Compare&& comp,
+                Proj&& proj)
+            {
+                std::sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+
+                return segmented_sort_draw_samples(first, last, num_samples);
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                samples_type>::type
+            parallel(ExPolicy&& policy, RandomIt first, RandomIt last,
+                std::size_t num_samples, Compare&& comp, Proj&& proj)
+            {
+                return util::detail::algorithm_result<ExPolicy,
+                    samples_type>::get(execution::async_execute(policy
+                                                                    .executor(),
+                    [=]() mutable -> samples_type {
+                        segmented_sort_get(sort<RandomIt>().call(policy,
+                            std::false_type(), first, last, comp, proj));
+
+                        return segmented_sort_draw_samples(
+                            first, last, num_samples);
+                    }));
+            }
+        };
+
+        // return the positions at which the (sorted) local part of a segment
+        // has to be split to separate the elements belonging to the buckets
+        // delimited by the given splitters
+        template <typename LocalIter>
+        struct seg_sort_bounds
+          : public detail::algorithm<seg_sort_bounds<LocalIter>,
+                std::vector<std::size_t>>
+        {
+            seg_sort_bounds()
+              : seg_sort_bounds::algorithm("sort")
+            {
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename T,
+                typename Compare, typename Proj>
+            static std::vector<std::size_t> sequential(ExPolicy,
+                RandomIt first, RandomIt last, std::vector<T> const& splitters,
+                Compare&& comp, Proj&& proj)
+            {
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(splitters.size() + 2);
+                bounds.push_back(0);
+
+                RandomIt it = first;
+                for (T const& splitter : splitters)
+                {
+                    it = std::upper_bound(it, last, splitter, pred);
+                    bounds.push_back(std::distance(first, it));
+                }
+
+                bounds.push_back(std::distance(first, last));
+                return bounds;
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename T,
+                typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                std::vector<std::size_t>>::type
+            parallel(ExPolicy&& policy, RandomIt first, RandomIt last,
+                std::vector<T> const& splitters, Compare&& comp, Proj&& proj)
+            {
+                return util::detail::algorithm_result<ExPolicy,
+                    std::vector<std::size_t>>::get(sequential(policy, first,
+                    last, splitters, std::forward<Compare>(comp),
+                    std::forward<Proj>(proj)));
+            }
+        };
+
+        // move the given elements into a segment
+        template <typename LocalIter>
+        struct seg_sort_store
+          : public detail::algorithm<seg_sort_store<LocalIter>, std::size_t>
+        {
+            seg_sort_store()
+              : seg_sort_store::algorithm("sort")
+            {
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename T>
+            static std::size_t sequential(
+                ExPolicy, FwdIter dest, std::vector<T> values)
+            {
+                std::move(values.begin(), values.end(), dest);
+                return values.size();
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename T>
+            static typename util::detail::algorithm_result<ExPolicy,
+                std::size_t>::type
+            parallel(ExPolicy&& policy, FwdIter dest, std::vector<T> values)
+            {
+                return util::detail::algorithm_result<ExPolicy,
+                    std::size_t>::get(sequential(policy, dest, std::move(values)));
+            }
+        };
+
+        // Collect all elements of one bucket from the segments they are
+        // stored in, merge them and write them to their final place. The
+        // bucket tasks of one sort operation synchronize on the given latch
+        // before writing, no segment is overwritten before all elements
+        // stored in it have been fetched.
+        template <typename LocalIter>
+        struct seg_sort_bucket
+          : public detail::algorithm<seg_sort_bucket<LocalIter>, std::size_t>
+        {
+            typedef typename std::iterator_traits<LocalIter>::value_type
+                value_type;
+            typedef segment_piece<LocalIter> piece_type;
+
+            seg_sort_bucket()
+              : seg_sort_bucket::algorithm("sort")
+            {
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static std::vector<value_type> fetch(ExPolicy const& policy,
+                std::vector<piece_type> const& sources, Compare&& comp,
+                Proj&& proj)
+            {
+                std::vector<hpx::future<std::vector<value_type>>> parts;
+                parts.reserve(sources.size());
+
+                for (piece_type const& src : sources)
+                {
+                    parts.push_back(dispatch_async(src.id_,
+                        seg_extract<LocalIter>(), policy, std::true_type(),
+                        src.begin_, src.count_));
+                }
+                hpx::wait_all(parts);
+
+                // handle any remote exceptions, will throw on error
+                std::list<std::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy>::call(parts, errors);
+
+                std::vector<std::vector<value_type>> runs;
+                runs.reserve(parts.size());
+                for (hpx::future<std::vector<value_type>>& f : parts)
+                    runs.push_back(f.get());
+
+                if (runs.empty())
+                    return std::vector<value_type>();
+
+                // every part is sorted, merge neighboring runs pairwise until
+                // only one is left, every element is moved log(parts) times
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                while (runs.size() > 1)
+                {
+                    std::size_t const num_runs = runs.size();
+                    for (std::size_t i = 0; i + 1 < num_runs; i += 2)
+                    {
+                        runs[i / 2] =
+                            segmented_sort_merge(runs[i], runs[i + 1], pred);
+                    }
+                    if (num_runs % 2 != 0)
+                        runs[num_runs / 2] = std::move(runs[num_runs - 1]);
+
+                    runs.resize((num_runs + 1) / 2);
+                }
+                return std::move(runs.front());
+            }
+
+            template <typename ExPolicy>
+            static void store(ExPolicy const& policy,
+                std::vector<piece_type> const& dests,
+                std::vector<value_type>& values)
+            {
+                std::vector<hpx::future<std::size_t>> parts;
+                parts.reserve(dests.size());
+
+                auto it = values.begin();
+                for (piece_type const& dest : dests)
+                {
+                    auto end = std::next(it, dest.count_);
+                    parts.push_back(dispatch_async(dest.id_,
+                        seg_sort_store<LocalIter>(), policy, std::true_type(),
+                        dest.begin_,
+                        std::vector<value_type>(std::make_move_iterator(it),
+                            std::make_move_iterator(end))));
+                    it = end;
+                }
+                HPX_ASSERT(it == values.end());
+
+                hpx::wait_all(parts);
+
+                // handle any remote exceptions, will throw on error
+                std::list<std::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy>::call(parts, errors);
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static std::size_t sequential(ExPolicy policy,
+                std::vector<piece_type> const& sources,
+                std::vector<piece_type> const& dests, hpx::lcos::latch l,
+                Compare&& comp, Proj&& proj)
+            {
+                std::vector<value_type> values;
+                try
+                {
+                    values = fetch(policy, sources, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj));
+                }
+                catch (...)
+                {
+                    // release the other bucket tasks
+                    l.set_exception(std::current_exception());
+                    throw;
+                }
+
+                // rethrows the exception of any failed bucket task
+                l.count_down_and_wait();
+
+                store(policy, dests, values);
+                return values.size();
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<ExPolicy,
+                std::size_t>::type
+            parallel(ExPolicy&& policy, std::vector<piece_type> const& sources,
+                std::vector<piece_type> const& dests, hpx::lcos::latch l,
+                Compare&& comp, Proj&& proj)
+            {
+                return util::detail::algorithm_result<ExPolicy,
+                    std::size_t>::get(sequential(policy, sources, dests, l,
+                    std::forward<Compare>(comp), std::forward<Proj>(proj)));
+            }
+        };
+
+        // Distributed sample sort: every segment is sorted locally, the
+        // splitters are selected from samples of all segments, the elements
+        // are exchanged between the segments such that every bucket ends up
+        // in its final place and the pieces of each bucket are merged.
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        SegIter segmented_sort(ExPolicy const& policy, SegIter first,
+            SegIter last, Compare const& comp, Proj const& proj)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+            typedef segment_piece<local_iterator_type> piece_type;
+
+            typedef typename parallel::execution::
+                is_sequenced_execution_policy<ExPolicy>::type is_seq;
+
+            // collect the (parts of the) segments covered by the range
+            std::vector<piece_type> segments;
+            std::vector<std::size_t> offsets;
+            std::size_t count = 0;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            if (sit == send)
+            {
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                segments.emplace_back(
+                    traits::get_id(sit), beg, std::distance(beg, end));
+            }
+            else
+            {
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                segments.emplace_back(
+                    traits::get_id(sit), beg, std::distance(beg, end));
+
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    segments.emplace_back(
+                        traits::get_id(sit), beg, std::distance(beg, end));
+                }
+
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                segments.emplace_back(
+                    traits::get_id(sit), beg, std::distance(beg, end));
+            }
+
+            segments.erase(std::remove_if(segments.begin(), segments.end(),
+                               [](piece_type const& p) {
+                                   return p.count_ == 0;
+                               }),
+                segments.end());
+
+            offsets.reserve(segments.size());
+            for (piece_type const& p : segments)
+            {
+                offsets.push_back(count);
+                count += p.count_;
+            }
+
+            std::size_t const num_segments = segments.size();
+            std::list<std::exception_ptr> errors;
+
+            // sort all segments and draw samples from them
+            std::vector<hpx::future<std::vector<value_type>>> samples;
+            samples.reserve(num_segments);
+            for (piece_type const& p : segments)
+            {
+                samples.push_back(dispatch_async(p.id_,
+                    seg_sort_local<local_iterator_type>(), policy, is_seq(),
+                    p.begin_, std::next(p.begin_, p.count_),
+                    num_segments == 1 ? 0 : segmented_sort_samples, comp,
+                    proj));
+            }
+            hpx::wait_all(samples);
+            parallel::util::detail::handle_remote_exceptions<ExPolicy>::call(
+                samples, errors);
+
+            if (num_segments <= 1)
+                return last;
+
+            // select the splitters delimiting one bucket per segment
+            util::compare_projected<Compare const&, Proj const&> pred(
+                comp, proj);
+
+            std::vector<value_type> all_samples;
+            for (hpx::future<std::vector<value_type>>& f : samples)
+            {
+                std::vector<value_type> s = f.get();
+                all_samples.insert(all_samples.end(),
+                    std::make_move_iterator(s.begin()),
+                    std::make_move_iterator(s.end()));
+            }
+            std::sort(all_samples.begin(), all_samples.end(), pred);
+
+            std::vector<value_type> splitters;
+            splitters.reserve(num_segments - 1);
+            for (std::size_t i = 1; i != num_segments; ++i)
+            {
+                splitters.push_back(
+                    all_samples[i * all_samples.size() / num_segments]);
+            }
+
+            // determine the part of each segment belonging to each bucket
+            std::vector<hpx::future<std::vector<std::size_t>>> bounds;
+            bounds.reserve(num_segments);
+            for (piece_type const& p : segments)
+            {
+                bounds.push_back(dispatch_async(p.id_,
+                    seg_sort_bounds<local_iterator_type>(), policy, is_seq(),
+                    p.begin_, std::next(p.begin_, p.count_), splitters, comp,
+                    proj));
+            }
+            hpx::wait_all(bounds);
+            parallel::util::detail::handle_remote_exceptions<ExPolicy>::call(
+                bounds, errors);
+
+            std::vector<std::vector<std::size_t>> segment_bounds;
+            segment_bounds.reserve(num_segments);
+            for (hpx::future<std::vector<std::size_t>>& f : bounds)
+            {
+                segment_bounds.push_back(f.get());
+            }
+
+            // every bucket task fetches the pieces of its bucket from all
+            // segments and writes them to the positions [start, start + size)
+            std::vector<std::vector<piece_type>> sources(num_segments);
+            std::vector<std::vector<piece_type>> dests(num_segments);
+
+            std::size_t start = 0;
+            std::size_t num_buckets = 0;
+            for (std::size_t b = 0; b != num_segments; ++b)
+            {
+                std::size_t size = 0;
+                for (std::size_t s = 0; s != num_segments; ++s)
+                {
+                    std::size_t lo = segment_bounds[s][b];
+                    std::size_t hi = segment_bounds[s][b + 1];
+                    if (lo != hi)
+                    {
+                        sources[b].emplace_back(segments[s].id_,
+                            std::next(segments[s].begin_, lo), hi - lo);
+                        size += hi - lo;
+                    }
+                }
+
+                for (std::size_t s = 0; s != num_segments; ++s)
+                {
+                    std::size_t lo = (std::max)(start, offsets[s]);
+                    std::size_t hi = (std::min)(
+                        start + size, offsets[s] + segments[s].count_);
+                    if (lo < hi)
+                    {
+                        dests[b].emplace_back(segments[s].id_,
+                            std::next(segments[s].begin_, lo - offsets[s]),
+                            hi - lo);
+                    }
+                }
+
+                if (size != 0)
+                    ++num_buckets;
+                start += size;
+            }
+            HPX_ASSERT(start == count);
+
+            hpx::lcos::latch l(static_cast<std::ptrdiff_t>(num_buckets));
+
+            std::vector<hpx::future<std::size_t>> buckets;
+            buckets.reserve(num_buckets);
+            for (std::size_t b = 0; b != num_segments; ++b)
+            {
+                if (dests[b].empty())
+                    continue;
+
+                // run the bucket task where its first element will be stored
+                buckets.push_back(dispatch_async(dests[b].front().id_,
+                    seg_sort_bucket<local_iterator_type>(), policy, is_seq(),
+                    sources[b], dests[b], l, comp, proj));
+            }
+            hpx::wait_all(buckets);
+            parallel::util::detail::handle_remote_exceptions<ExPolicy>::call(
+                buckets, errors);
+
+            return last;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        inline typename std::enable_if<
+            execution::is_execution_policy<ExPolicy>::value,
+            typename util::detail::algorithm_result<ExPolicy,
+                SegIter>::type>::type
+        sort_(ExPolicy&& policy, SegIter first, SegIter last, Compare&& comp,
+            Proj&& proj, std::true_type)
+        {
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            if (first == last)
+                return result::get(std::move(last));
+
+            policy_type p = policy;
+            compare_type c = std::forward<Compare>(comp);
+            proj_type pr = std::forward<Proj>(proj);
+
+            return result::get(execution::async_execute(policy.executor(),
+                [=]() -> SegIter {
+                    return segmented_sort(p, first, last, c, pr);
+                }));
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename std::enable_if<
+            execution::is_execution_policy<ExPolicy>::value,
+            typename util::detail::algorithm_result<ExPolicy,
+                RandomIt>::type>::type
+        sort_(ExPolicy&& policy, RandomIt first, RandomIt last, Compare&& comp,
+            Proj&& proj, std::false_type);
+
+        /// \endcond
+    }    // namespace detail
+}}}      // namespace hpx::parallel::v1
+
+#endif
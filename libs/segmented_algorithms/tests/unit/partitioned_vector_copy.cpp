@@ -128,6 +128,64 @@ void copy_tests_with_policy(
     copy_algo_tests_with_policy_async<T>(size, localities, policy, par);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void iota_vector(hpx::partitioned_vector<T>& v, T val)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (/**/; it != end; ++it)
+        *it = val++;
+}
+
+// source and destination are distributed differently
+template <typename T, typename DistPolicy1, typename DistPolicy2,
+    typename ExPolicy>
+void copy_misaligned_tests_with_policy(std::size_t size,
+    DistPolicy1 const& policy1, DistPolicy2 const& policy2,
+    ExPolicy const& copy_policy)
+{
+    hpx::partitioned_vector<T> v1(size, policy1);
+    iota_vector(v1, T(1));
+
+    hpx::partitioned_vector<T> v2(size, T(0), policy2);
+    auto p = hpx::parallel::copy(copy_policy, v1.begin(), v1.end(), v2.begin());
+    HPX_TEST(p.in() == v1.end());
+    HPX_TEST(p.out() == v2.end());
+    compare_vectors(v1, v2);
+
+    // copy a sub-range to a different offset in the destination
+    hpx::partitioned_vector<T> v3(size, T(0), policy2);
+    auto q = hpx::parallel::copy(
+        copy_policy, v1.begin() + 1, v1.end() - 2, v3.begin() + 2);
+    HPX_TEST(q.out() == v3.end() - 1);
+
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        T expected = (i < 2 || i == size - 1) ?
+            T(0) :
+            v1.get_value(hpx::launch::sync, i - 1);
+        HPX_TEST_EQ(v3.get_value(hpx::launch::sync, i), expected);
+    }
+}
+
+template <typename T, typename DistPolicy1, typename DistPolicy2>
+void copy_misaligned_tests(std::size_t size, DistPolicy1 const& policy1,
+    DistPolicy2 const& policy2)
+{
+    using namespace hpx::parallel::execution;
+
+    copy_misaligned_tests_with_policy<T>(size, policy1, policy2, seq);
+    copy_misaligned_tests_with_policy<T>(size, policy1, policy2, par);
+
+    hpx::partitioned_vector<T> v1(size, policy1);
+    iota_vector(v1, T(1));
+
+    hpx::partitioned_vector<T> v2(size, T(0), policy2);
+    auto f = hpx::parallel::copy(par(task), v1.begin(), v1.end(), v2.begin());
+    HPX_TEST(f.get().out() == v2.end());
+    compare_vectors(v1, v2);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename T>
 void copy_tests()
@@ -155,6 +213,13 @@ void copy_tests()
     copy_tests_with_policy<T>(length, 3, hpx::container_layout(3, localities));
     copy_tests_with_policy<T>(
         length, localities.size(), hpx::container_layout(localities));
+
+    copy_misaligned_tests<T>(length, hpx::container_layout(3, localities),
+        hpx::container_layout(localities));
+    copy_misaligned_tests<T>(length, hpx::container_layout(localities),
+        hpx::container_layout(5, localities));
+    copy_misaligned_tests<T>(
+        length, hpx::container_layout(2), hpx::container_layout(3));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
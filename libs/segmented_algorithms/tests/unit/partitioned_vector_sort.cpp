@@ -0,0 +1,142 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/partitioned_vector_predef.hpp>
+
+#include <hpx/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The vector types to be used are defined in partitioned_vector module.
+// HPX_REGISTER_PARTITIONED_VECTOR(double);
+// HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_vector(
+    hpx::partitioned_vector<T>& v, unsigned int seed, int range)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(0, range);
+
+    std::vector<T> values;
+    values.reserve(v.size());
+
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (/**/; it != end; ++it)
+    {
+        T val = T(dis(gen));
+        *it = val;
+        values.push_back(val);
+    }
+    return values;
+}
+
+template <typename T>
+std::vector<T> get_values(hpx::partitioned_vector<T> const& v)
+{
+    std::vector<T> values;
+    values.reserve(v.size());
+
+    typename hpx::partitioned_vector<T>::const_iterator it = v.begin(),
+                                                        end = v.end();
+    for (/**/; it != end; ++it)
+        values.push_back(*it);
+    return values;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T, typename Compare>
+void test_sort(ExPolicy&& policy, hpx::partitioned_vector<T>& v,
+    std::size_t offset_begin, std::size_t offset_end, int range,
+    Compare comp)
+{
+    std::vector<T> expected = fill_vector(v, 42u, range);
+
+    auto first = v.begin() + offset_begin;
+    auto last = v.end() - offset_end;
+
+    auto result = hpx::parallel::sort(policy, first, last, comp);
+    HPX_TEST(result == last);
+
+    std::sort(expected.begin() + offset_begin, expected.end() - offset_end,
+        comp);
+    HPX_TEST(get_values(v) == expected);
+}
+
+template <typename ExPolicy, typename T, typename Compare>
+void test_sort_async(ExPolicy&& policy, hpx::partitioned_vector<T>& v,
+    std::size_t offset_begin, std::size_t offset_end, int range,
+    Compare comp)
+{
+    std::vector<T> expected = fill_vector(v, 43u, range);
+
+    auto first = v.begin() + offset_begin;
+    auto last = v.end() - offset_end;
+
+    auto f = hpx::parallel::sort(policy, first, last, comp);
+    HPX_TEST(f.get() == last);
+
+    std::sort(expected.begin() + offset_begin, expected.end() - offset_end,
+        comp);
+    HPX_TEST(get_values(v) == expected);
+}
+
+template <typename T, typename Compare>
+void sort_tests(hpx::partitioned_vector<T>& v, std::size_t offset_begin,
+    std::size_t offset_end, int range, Compare comp)
+{
+    using namespace hpx::parallel::execution;
+
+    test_sort(seq, v, offset_begin, offset_end, range, comp);
+    test_sort(par, v, offset_begin, offset_end, range, comp);
+
+    test_sort_async(seq(task), v, offset_begin, offset_end, range, comp);
+    test_sort_async(par(task), v, offset_begin, offset_end, range, comp);
+}
+
+template <typename T, typename DistPolicy>
+void sort_tests(std::size_t size, DistPolicy const& policy)
+{
+    hpx::partitioned_vector<T> v(size, policy);
+
+    // the whole vector, many distinct values
+    sort_tests(v, 0, 0, 100000, std::less<T>());
+
+    // a range starting and ending in the middle of a partition
+    sort_tests(v, 3, 5, 100000, std::less<T>());
+
+    // many equal values, reversed order
+    sort_tests(v, 0, 0, 7, std::greater<T>());
+    sort_tests(v, 1, 1, 0, std::less<T>());
+}
+
+template <typename T>
+void sort_tests(std::vector<hpx::id_type> const& localities)
+{
+    std::size_t const num = 10007;
+
+    sort_tests<T>(num, hpx::container_layout);
+    sort_tests<T>(num, hpx::container_layout(3));
+    sort_tests<T>(num, hpx::container_layout(localities));
+    sort_tests<T>(num, hpx::container_layout(5, localities));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    sort_tests<int>(localities);
+    sort_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -31,9 +31,10 @@ namespace hpx { namespace serialization {
     public:
         using value_type = T;
 
-        array(value_type* t, std::size_t s)
+        array(value_type* t, std::size_t s, bool force_chunking = false)
           : m_t(t)
           , m_element_count(s)
+          , m_force_chunking(force_chunking)
         {
         }
 
@@ -59,7 +60,8 @@ namespace hpx { namespace serialization {
             output_archive& ar, unsigned int, std::true_type)
         {
             // try using chunking
-            ar.save_binary_chunk(m_t, m_element_count * sizeof(T));
+            ar.save_binary_chunk(
+                m_t, m_element_count * sizeof(T), m_force_chunking);
         }
 
         void serialize_optimized(
@@ -91,6 +93,7 @@ namespace hpx { namespace serialization {
     private:
         value_type* m_t;
         std::size_t m_element_count;
+        bool m_force_chunking;
     };
 
     // make_array function
@@ -100,6 +103,15 @@ namespace hpx { namespace serialization {
         return array<T>(begin, size);
     }
 
+    // make_array function, the data is stored as a separate zero-copy chunk
+    // regardless of its size if force_chunking is true
+    template <class T>
+    HPX_FORCEINLINE array<T> make_array(
+        T* begin, std::size_t size, bool force_chunking)
+    {
+        return array<T>(begin, size, force_chunking);
+    }
+
 #if defined(HPX_SERIALIZATION_HAVE_BOOST_TYPES)
     // implement serialization for boost::array
     template <typename Archive, typename T, std::size_t N>
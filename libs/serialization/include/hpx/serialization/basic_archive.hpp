@@ -41,7 +41,8 @@ namespace hpx { namespace serialization {
         endian_little = 0x00008000,
         disable_array_optimization = 0x00010000,
         disable_data_chunking = 0x00020000,
-        all_archive_flags = 0x0003e000    // all of the above
+        enable_integer_compression = 0x00040000,
+        all_archive_flags = 0x0007e000    // all of the above
     };
 
     void HPX_FORCEINLINE reverse_bytes(std::size_t size, char* address)
@@ -106,6 +107,13 @@ namespace hpx { namespace serialization {
                                                                           false;
         }
 
+        bool enable_integer_compression() const
+        {
+            return (flags_ & hpx::serialization::enable_integer_compression) ?
+                true :
+                false;
+        }
+
         std::uint32_t flags() const
         {
             return flags_;
@@ -9,10 +9,13 @@
 #define HPX_SERIALIZATION_CONTAINER_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/errors.hpp>
 #include <hpx/serialization/basic_archive.hpp>
 #include <hpx/serialization/binary_filter.hpp>
+#include <hpx/serialization/detail/varint.hpp>
 
 #include <cstddef>
+#include <cstdint>
 
 namespace hpx { namespace serialization {
 
@@ -26,8 +29,10 @@ namespace hpx { namespace serialization {
         }
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void save_binary(void const* address, std::size_t count) = 0;
+        // store the data as a separate (zero-copy) chunk if it is larger
+        // than the zero-copy threshold or if force_chunking is true
         virtual std::size_t save_binary_chunk(
-            void const* address, std::size_t count) = 0;
+            void const* address, std::size_t count, bool force_chunking) = 0;
         virtual void reset() = 0;
         virtual std::size_t get_num_chunks() const = 0;
         virtual void flush() = 0;
@@ -44,6 +49,29 @@ namespace hpx { namespace serialization {
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void* address, std::size_t count) = 0;
         virtual void load_binary_chunk(void* address, std::size_t count) = 0;
+
+        // load a variable length integer, returns the number of bytes read
+        virtual std::size_t load_varint(std::uint64_t& value)
+        {
+            std::uint64_t result = 0;
+            for (std::size_t i = 0; i != detail::max_varint_size; ++i)
+            {
+                std::uint8_t byte = 0;
+                load_binary(&byte, 1);
+
+                result |= static_cast<std::uint64_t>(byte & 0x7f) << (7 * i);
+                if ((byte & 0x80) == 0)
+                {
+                    value = result;
+                    return i + 1;
+                }
+            }
+
+            HPX_THROW_EXCEPTION(serialization_error,
+                "erased_input_container::load_varint",
+                "archive data bstream holds a malformed integer");
+            return 0;
+        }
     };
 }}    // namespace hpx::serialization
 
@@ -0,0 +1,111 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_DETAIL_VARINT_HPP
+#define HPX_SERIALIZATION_DETAIL_VARINT_HPP
+
+#include <hpx/config.hpp>
+
+#include <boost/predef/other/endian.h>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hpx { namespace serialization { namespace detail {
+
+    // Integers are encoded as LEB128 variable length integers: 7 bits per
+    // byte, least significant group first, the most significant bit of each
+    // byte is set if more bytes follow. Signed values are zigzag encoded
+    // first to keep small negative numbers short.
+    constexpr std::size_t max_varint_size = 10;
+
+    constexpr std::uint64_t zigzag_encode(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^
+            static_cast<std::uint64_t>(value >> 63);
+    }
+
+    constexpr std::int64_t zigzag_decode(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^
+            -static_cast<std::int64_t>(value & 1);
+    }
+
+    // Encode the given value into buffer (which has to be able to hold at
+    // least max_varint_size bytes), returns the number of bytes used.
+    inline std::size_t encode_varint(std::uint64_t value, std::uint8_t* buffer)
+    {
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            buffer[size++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[size++] = static_cast<std::uint8_t>(value);
+        return size;
+    }
+
+    // Decode a value from the given buffer holding size bytes, returns the
+    // number of bytes consumed or zero if the buffer does not hold a
+    // complete (or holds a malformed) varint.
+    inline std::size_t decode_varint_slow(
+        std::uint8_t const* buffer, std::size_t size, std::uint64_t& value)
+    {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i != size && i != max_varint_size; ++i)
+        {
+            result |= static_cast<std::uint64_t>(buffer[i] & 0x7f) << (7 * i);
+            if ((buffer[i] & 0x80) == 0)
+            {
+                value = result;
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    inline std::size_t decode_varint(
+        std::uint8_t const* buffer, std::size_t size, std::uint64_t& value)
+    {
+#if BOOST_ENDIAN_LITTLE_BYTE && (defined(__GNUC__) || defined(__clang__))
+        // Fast path for values of up to 8 bytes (56 bits): load 8 bytes at
+        // once, find the terminating byte from the continuation bits and
+        // gather the 7 bit groups without looping over the bytes.
+        if (size >= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, buffer, sizeof(word));
+
+            std::uint64_t const stop = ~word & 0x8080808080808080ull;
+            if (stop != 0)
+            {
+                std::size_t const bits = __builtin_ctzll(stop) + 1;
+                if (bits != 64)
+                    word &= (std::uint64_t(1) << bits) - 1;
+#if defined(__BMI2__)
+                value = _pext_u64(word, 0x7f7f7f7f7f7f7f7full);
+#else
+                word = (word & 0x007f007f007f007full) |
+                    ((word & 0x7f007f007f007f00ull) >> 1);
+                word = (word & 0x00003fff00003fffull) |
+                    ((word & 0x3fff00003fff0000ull) >> 2);
+                value = (word & 0x000000000fffffffull) |
+                    ((word & 0x0fffffff00000000ull) >> 4);
+#endif
+                return bits / 8;
+            }
+        }
+#endif
+        return decode_varint_slow(buffer, size, value);
+    }
+}}}    // namespace hpx::serialization::detail
+
+#endif
@@ -15,6 +15,7 @@
 #include <hpx/serialization/basic_archive.hpp>
 #include <hpx/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/serialization/detail/raw_ptr.hpp>
+#include <hpx/serialization/detail/varint.hpp>
 #include <hpx/serialization/input_container.hpp>
 #include <hpx/serialization/traits/is_bitwise_serializable.hpp>
 
@@ -48,15 +49,15 @@ namespace hpx { namespace serialization {
 
             // FIXME: make bool once integer compression is implemented
             std::uint64_t endianess = 0ul;
-            load(endianess);
+            load_integral_impl(endianess);
             if (endianess)
                 this->base_type::flags_ = hpx::serialization::endian_big;
 
             // load flags sent by the other end to make sure both ends have
             // the same assumptions about the archive format
-            std::uint32_t flags = 0;
-            load(flags);
-            this->base_type::flags_ = flags;
+            std::uint64_t flags = 0;
+            load_integral_impl(flags);
+            this->base_type::flags_ = static_cast<std::uint32_t>(flags);
 
             bool has_filter = false;
             load(has_filter);
@@ -169,7 +170,10 @@ namespace hpx { namespace serialization {
         void load_integral(T& val, std::false_type)
         {
             std::int64_t l;
-            load_integral_impl(l);
+            if (enable_integer_compression())
+                l = detail::zigzag_decode(load_varint());
+            else
+                load_integral_impl(l);
             val = static_cast<T>(l);
         }
 
@@ -177,10 +181,20 @@ namespace hpx { namespace serialization {
         void load_integral(T& val, std::true_type)
         {
             std::uint64_t ul;
-            load_integral_impl(ul);
+            if (enable_integer_compression())
+                ul = load_varint();
+            else
+                load_integral_impl(ul);
             val = static_cast<T>(ul);
         }
 
+        std::uint64_t load_varint()
+        {
+            std::uint64_t value = 0;
+            size_ += buffer_->load_varint(value);
+            return value;
+        }
+
 #if defined(BOOST_HAS_INT128) && !defined(__NVCC__) && !defined(__CUDACC__)
         void load_integral(boost::int128_type& t, std::false_type)
         {
@@ -13,9 +13,11 @@
 #include <hpx/errors.hpp>
 #include <hpx/serialization/binary_filter.hpp>
 #include <hpx/serialization/container.hpp>
+#include <hpx/serialization/detail/varint.hpp>
 #include <hpx/serialization/serialization_chunk.hpp>
 #include <hpx/serialization/traits/serialization_access_data.hpp>
 
+#include <algorithm>
 #include <cstddef>    // for size_t
 #include <cstdint>
 #include <cstring>    // for memcpy
@@ -117,50 +119,60 @@ namespace hpx { namespace serialization {
 
                 access_traits::read(cont_, count, current_, address);
 
-                current_ = new_current;
+                advance(count);
+            }
+        }
 
-                if (chunks_)
-                {
-                    current_chunk_size_ += count;
-
-                    // make sure we switch to the next serialization_chunk if
-                    // necessary
-                    std::size_t current_chunk_size =
-                        get_chunk_size(current_chunk_);
-                    if (current_chunk_size != 0 &&
-                        current_chunk_size_ >= current_chunk_size)
-                    {
-                        // raise an error if we read past the serialization_chunk
-                        if (current_chunk_size_ > current_chunk_size)
-                        {
-                            HPX_THROW_EXCEPTION(serialization_error,
-                                "input_container::load_binary",
-                                "archive data bstream structure mismatch");
-                            return;
-                        }
-                        ++current_chunk_;
-                        current_chunk_size_ = 0;
-                    }
-                }
+        std::size_t load_varint(std::uint64_t& value)    // override
+        {
+            if (filter_)
+                return erased_input_container::load_varint(value);
+
+            // read ahead as many bytes as the longest possible integer may
+            // need, this allows to decode it without looking at the bytes
+            // one by one
+            std::size_t const size = access_traits::size(cont_);
+            std::size_t const count = current_ < size ?
+                (std::min)(size - current_, detail::max_varint_size) :
+                0;
+
+            std::uint8_t buffer[detail::max_varint_size];
+            std::size_t consumed = 0;
+            if (count != 0)
+            {
+                access_traits::read(cont_, count, current_, buffer);
+                consumed = detail::decode_varint(buffer, count, value);
+            }
+
+            if (consumed == 0)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "input_container::load_varint",
+                    "archive data bstream is too short");
+                return 0;
             }
+
+            advance(consumed);
+            return consumed;
         }
 
         void load_binary_chunk(void* address, std::size_t count)    // override
         {
             HPX_ASSERT((std::int64_t) count >= 0);
 
-            if (chunks_ == nullptr ||
-                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD || filter_)
+            // the sending end decides whether the data is stored as a separate
+            // chunk (depending on its zero-copy threshold and on whether the
+            // chunking was forced), which is why we look at the type of the
+            // current chunk instead of comparing the size with a threshold
+            if (chunks_ == nullptr || filter_ ||
+                current_chunk_ >= get_num_chunks() ||
+                get_chunk_type(current_chunk_) != chunk_type_pointer)
             {
                 // fall back to serialization_chunk-less archive
                 this->input_container::load_binary(address, count);
             }
             else
             {
-                HPX_ASSERT(current_chunk_ != std::size_t(-1));
-                HPX_ASSERT(
-                    get_chunk_type(current_chunk_) == chunk_type_pointer);
-
                 if (get_chunk_size(current_chunk_) != count)
                 {
                     HPX_THROW_EXCEPTION(serialization_error,
@@ -178,6 +190,37 @@ namespace hpx { namespace serialization {
             }
         }
 
+    private:
+        void advance(std::size_t count)
+        {
+            current_ += count;
+
+            if (chunks_)
+            {
+                current_chunk_size_ += count;
+
+                // make sure we switch to the next serialization_chunk if
+                // necessary
+                std::size_t current_chunk_size =
+                    get_chunk_size(current_chunk_);
+                if (current_chunk_size != 0 &&
+                    current_chunk_size_ >= current_chunk_size)
+                {
+                    // raise an error if we read past the serialization_chunk
+                    if (current_chunk_size_ > current_chunk_size)
+                    {
+                        HPX_THROW_EXCEPTION(serialization_error,
+                            "input_container::load_binary",
+                            "archive data bstream structure mismatch");
+                        return;
+                    }
+                    ++current_chunk_;
+                    current_chunk_size_ = 0;
+                }
+            }
+        }
+
+    public:
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
@@ -15,6 +15,7 @@
 #include <hpx/serialization/basic_archive.hpp>
 #include <hpx/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/serialization/detail/raw_ptr.hpp>
+#include <hpx/serialization/detail/varint.hpp>
 #include <hpx/serialization/output_container.hpp>
 #include <hpx/serialization/traits/is_bitwise_serializable.hpp>
 
@@ -40,7 +41,8 @@ namespace hpx { namespace serialization {
         template <typename Container>
         inline std::unique_ptr<erased_output_container> create_output_container(
             Container& buffer, std::vector<serialization_chunk>* chunks,
-            binary_filter* filter, std::false_type)
+            binary_filter* filter, std::size_t zero_copy_threshold,
+            std::false_type)
         {
             std::unique_ptr<erased_output_container> res;
             if (filter == nullptr)
@@ -53,7 +55,7 @@ namespace hpx { namespace serialization {
                 else
                 {
                     res.reset(new output_container<Container, vector_chunker>(
-                        buffer, chunks));
+                        buffer, chunks, zero_copy_threshold));
                 }
             }
             else
@@ -67,7 +69,7 @@ namespace hpx { namespace serialization {
                 else
                 {
                     res.reset(new filtered_output_container<Container,
-                        vector_chunker>(buffer, chunks));
+                        vector_chunker>(buffer, chunks, zero_copy_threshold));
                 }
             }
             return res;
@@ -76,19 +78,20 @@ namespace hpx { namespace serialization {
         template <typename Container>
         inline std::unique_ptr<erased_output_container> create_output_container(
             Container& buffer, std::vector<serialization_chunk>* chunks,
-            binary_filter* filter, std::true_type)
+            binary_filter* filter, std::size_t zero_copy_threshold,
+            std::true_type)
         {
             std::unique_ptr<erased_output_container> res;
             if (filter == nullptr)
             {
                 res.reset(new output_container<Container, counting_chunker>(
-                    buffer, chunks));
+                    buffer, chunks, zero_copy_threshold));
             }
             else
             {
                 res.reset(
                     new filtered_output_container<Container, counting_chunker>(
-                        buffer, chunks));
+                        buffer, chunks, zero_copy_threshold));
             }
             return res;
         }
@@ -109,12 +112,17 @@ namespace hpx { namespace serialization {
     public:
         using base_type = basic_archive<output_archive>;
 
+        // Data passed to save_binary_chunk is stored as a separate
+        // (zero-copy) chunk if it is at least zero_copy_threshold bytes large
         template <typename Container>
         output_archive(Container& buffer, std::uint32_t flags = 0U,
             std::vector<serialization_chunk>* chunks = nullptr,
-            binary_filter* filter = nullptr)
+            binary_filter* filter = nullptr,
+            std::size_t zero_copy_threshold =
+                HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
           : base_type(make_flags(flags, chunks))
           , buffer_(detail::create_output_container(buffer, chunks, filter,
+                zero_copy_threshold,
                 typename traits::serialization_access_data<
                     Container>::preprocessing_only()))
         {
@@ -124,11 +132,13 @@ namespace hpx { namespace serialization {
             // FIXME: make bool once integer compression is implemented
             std::uint64_t endianess =
                 this->base_type::endian_big() ? ~0ul : 0ul;
-            save(endianess);
+            save_integral_impl(endianess);
 
             // send flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            save(this->flags_);
+            // the same assumptions about the archive format, those are
+            // always stored uncompressed as the receiving end does not know
+            // yet whether integer compression is enabled
+            save_integral_impl(static_cast<std::uint64_t>(this->flags_));
 
             bool has_filter = filter != nullptr;
             save(has_filter);
@@ -262,13 +272,30 @@ namespace hpx { namespace serialization {
         template <typename T>
         void save_integral(T val, std::false_type)
         {
-            save_integral_impl(static_cast<std::int64_t>(val));
+            if (enable_integer_compression())
+            {
+                save_varint(
+                    detail::zigzag_encode(static_cast<std::int64_t>(val)));
+            }
+            else
+            {
+                save_integral_impl(static_cast<std::int64_t>(val));
+            }
         }
 
         template <typename T>
         void save_integral(T val, std::true_type)
         {
-            save_integral_impl(static_cast<std::uint64_t>(val));
+            if (enable_integer_compression())
+                save_varint(static_cast<std::uint64_t>(val));
+            else
+                save_integral_impl(static_cast<std::uint64_t>(val));
+        }
+
+        void save_varint(std::uint64_t val)
+        {
+            std::uint8_t buffer[detail::max_varint_size];
+            save_binary(buffer, detail::encode_varint(val, buffer));
         }
 
 #if defined(BOOST_HAS_INT128) && !defined(__NVCC__) && !defined(__CUDACC__)
@@ -330,7 +357,8 @@ namespace hpx { namespace serialization {
             buffer_->save_binary(address, count);
         }
 
-        void save_binary_chunk(void const* address, std::size_t count)
+        void save_binary_chunk(void const* address, std::size_t count,
+            bool force_chunking = false)
         {
             if (count == 0)
                 return;
@@ -342,7 +370,8 @@ namespace hpx { namespace serialization {
             else
             {
                 // the size might grow if optimizations are not used
-                size_ += buffer_->save_binary_chunk(address, count);
+                size_ += buffer_->save_binary_chunk(
+                    address, count, force_chunking);
             }
         }
 
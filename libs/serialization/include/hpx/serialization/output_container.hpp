@@ -162,11 +162,14 @@ namespace hpx { namespace serialization {
     {
         using access_traits = traits::serialization_access_data<Container>;
 
-        output_container(
-            Container& cont, std::vector<serialization_chunk>* chunks = nullptr)
+        output_container(Container& cont,
+            std::vector<serialization_chunk>* chunks = nullptr,
+            std::size_t zero_copy_threshold =
+                HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
           : cont_(cont)
           , current_(0)
           , chunker_(chunks)
+          , zero_copy_threshold_(zero_copy_threshold)
         {
             chunker_.reset();
         }
@@ -229,10 +232,10 @@ namespace hpx { namespace serialization {
             current_ = new_current;
         }
 
-        std::size_t save_binary_chunk(
-            void const* address, std::size_t count) override
+        std::size_t save_binary_chunk(void const* address, std::size_t count,
+            bool force_chunking) override
         {
-            if (count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+            if (!force_chunking && count < zero_copy_threshold_)
             {
                 // fall back to serialization_chunk-less archive
                 this->output_container::save_binary(address, count);
@@ -271,6 +274,7 @@ namespace hpx { namespace serialization {
         Container& cont_;
         std::size_t current_;
         Chunker chunker_;
+        std::size_t zero_copy_threshold_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -280,9 +284,11 @@ namespace hpx { namespace serialization {
         using access_traits = traits::serialization_access_data<Container>;
         using base_type = output_container<Container, Chunker>;
 
-        filtered_output_container(
-            Container& cont, std::vector<serialization_chunk>* chunks = nullptr)
-          : base_type(cont, chunks)
+        filtered_output_container(Container& cont,
+            std::vector<serialization_chunk>* chunks = nullptr,
+            std::size_t zero_copy_threshold =
+                HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+          : base_type(cont, chunks, zero_copy_threshold)
           , start_compressing_at_(0)
           , filter_(nullptr)
         {
@@ -338,10 +344,10 @@ namespace hpx { namespace serialization {
             this->current_ += count;
         }
 
-        std::size_t save_binary_chunk(
-            void const* address, std::size_t count)    // override
+        std::size_t save_binary_chunk(void const* address, std::size_t count,
+            bool force_chunking)    // override
         {
-            if (count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+            if (!force_chunking && count < this->zero_copy_threshold_)
             {
                 // fall back to serialization_chunk-less archive
                 HPX_ASSERT(count != 0);
@@ -351,7 +357,8 @@ namespace hpx { namespace serialization {
             }
             else
             {
-                return this->base_type::save_binary_chunk(address, count);
+                return this->base_type::save_binary_chunk(
+                    address, count, force_chunking);
             }
         }
 
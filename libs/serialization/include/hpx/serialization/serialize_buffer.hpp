@@ -15,6 +15,7 @@
 #include <hpx/serialization/array.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
 #include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/traits/force_zero_copy_serialization.hpp>
 
 #include <boost/shared_array.hpp>
 
@@ -281,7 +282,9 @@ namespace hpx { namespace serialization {
 
             if (size_ != 0)
             {
-                ar << hpx::serialization::make_array(data_.get(), size_);
+                ar << hpx::serialization::make_array(data_.get(), size_,
+                    hpx::traits::force_zero_copy_serialization<
+                        serialize_buffer>::value);
             }
         }
 
@@ -0,0 +1,36 @@
+//  Copyright (c) 2019 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_TRAITS_FORCE_ZERO_COPY_SERIALIZATION_HPP
+#define HPX_TRAITS_FORCE_ZERO_COPY_SERIALIZATION_HPP
+
+#include <hpx/config.hpp>
+
+#include <type_traits>
+
+namespace hpx { namespace traits {
+
+    // This trait is used to decide whether the (bitwise serializable) data
+    // held by a container type (like std::vector<T> or serialize_buffer<T>)
+    // is always stored as a separate zero-copy chunk, independently of the
+    // zero-copy threshold of the archive.
+    template <typename T, typename Enable = void>
+    struct force_zero_copy_serialization : std::false_type
+    {
+    };
+}}    // namespace hpx::traits
+
+#define HPX_FORCE_ZERO_COPY_SERIALIZATION(T)                                   \
+    namespace hpx { namespace traits {                                         \
+            template <>                                                        \
+            struct force_zero_copy_serialization<T> : std::true_type           \
+            {                                                                  \
+            };                                                                 \
+        }                                                                      \
+    }                                                                          \
+    /**/
+
+#endif /*HPX_TRAITS_FORCE_ZERO_COPY_SERIALIZATION_HPP*/
@@ -12,6 +12,7 @@
 #include <hpx/serialization/detail/serialize_collection.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
 #include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/traits/force_zero_copy_serialization.hpp>
 #include <hpx/serialization/traits/is_bitwise_serializable.hpp>
 
 #include <cstddef>
@@ -112,7 +113,9 @@ namespace hpx { namespace serialization {
             }
 
             // bitwise (zero-copy) save ...
-            ar << hpx::serialization::make_array(v.data(), v.size());
+            ar << hpx::serialization::make_array(v.data(), v.size(),
+                hpx::traits::force_zero_copy_serialization<
+                    std::vector<T, Allocator>>::value);
         }
     }    // namespace detail
 
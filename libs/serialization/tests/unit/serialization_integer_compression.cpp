@@ -0,0 +1,168 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/serialization/detail/varint.hpp>
+#include <hpx/serialization/input_archive.hpp>
+#include <hpx/serialization/output_archive.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/string.hpp>
+#include <hpx/serialization/vector.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+enum class color : std::uint8_t
+{
+    red = 1,
+    green = 2,
+    blue = 200
+};
+
+struct metadata
+{
+    std::int32_t id_;
+    std::uint64_t count_;
+    std::int16_t delta_;
+    color color_;
+    std::string name_;
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        ar& id_& count_& delta_& color_& name_;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_varint()
+{
+    using namespace hpx::serialization::detail;
+
+    std::uint64_t const values[] = {0, 1, 127, 128, 300, 16383, 16384,
+        (std::uint64_t(1) << 35) - 1, (std::uint64_t(1) << 56) - 1,
+        std::uint64_t(1) << 56, (std::numeric_limits<std::uint64_t>::max)()};
+
+    for (std::uint64_t v : values)
+    {
+        // pad the buffer to exercise the fast decoding path as well
+        std::uint8_t buffer[max_varint_size + 8] = {0};
+        std::size_t size = encode_varint(v, buffer);
+        HPX_TEST(size >= 1 && size <= max_varint_size);
+
+        std::uint64_t decoded = 0;
+        HPX_TEST_EQ(decode_varint(buffer, sizeof(buffer), decoded), size);
+        HPX_TEST_EQ(decoded, v);
+
+        decoded = 0;
+        HPX_TEST_EQ(decode_varint_slow(buffer, size, decoded), size);
+        HPX_TEST_EQ(decoded, v);
+
+        // truncated input is detected
+        HPX_TEST_EQ(decode_varint(buffer, size - 1, decoded), std::size_t(0));
+    }
+
+    std::int64_t const signed_values[] = {0, -1, 1, -64, 64,
+        (std::numeric_limits<std::int64_t>::min)(),
+        (std::numeric_limits<std::int64_t>::max)()};
+
+    for (std::int64_t v : signed_values)
+    {
+        HPX_TEST_EQ(zigzag_decode(zigzag_encode(v)), v);
+    }
+    HPX_TEST_EQ(zigzag_encode(-1), std::uint64_t(1));
+    HPX_TEST_EQ(zigzag_encode(1), std::uint64_t(2));
+}
+
+template <typename T>
+void test_roundtrip(std::uint32_t flags, T const& value)
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer, flags);
+    oarchive << value;
+
+    hpx::serialization::input_archive iarchive(buffer);
+    T result;
+    iarchive >> result;
+    HPX_TEST(result == value);
+}
+
+void test_integers(std::uint32_t flags)
+{
+    test_roundtrip(flags, std::int8_t(-5));
+    test_roundtrip(flags, std::int32_t(-1));
+    test_roundtrip(flags, (std::numeric_limits<std::int32_t>::min)());
+    test_roundtrip(flags, (std::numeric_limits<std::int64_t>::min)());
+    test_roundtrip(flags, (std::numeric_limits<std::int64_t>::max)());
+    test_roundtrip(flags, std::uint16_t(65535));
+    test_roundtrip(flags, (std::numeric_limits<std::uint64_t>::max)());
+    test_roundtrip(flags, color::blue);
+}
+
+void test_metadata(std::uint32_t flags)
+{
+    std::vector<metadata> data;
+    for (std::int32_t i = 0; i != 100; ++i)
+    {
+        data.push_back(metadata{i - 50, std::uint64_t(i) * 1000,
+            std::int16_t(-i), i % 2 ? color::red : color::blue, "name"});
+    }
+
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer, flags);
+    oarchive << data;
+
+    hpx::serialization::input_archive iarchive(buffer);
+    std::vector<metadata> result;
+    iarchive >> result;
+
+    HPX_TEST_EQ(iarchive.bytes_read(), oarchive.bytes_written());
+    HPX_TEST_EQ(result.size(), data.size());
+    for (std::size_t i = 0; i != data.size(); ++i)
+    {
+        HPX_TEST_EQ(result[i].id_, data[i].id_);
+        HPX_TEST_EQ(result[i].count_, data[i].count_);
+        HPX_TEST_EQ(result[i].delta_, data[i].delta_);
+        HPX_TEST(result[i].color_ == data[i].color_);
+        HPX_TEST_EQ(result[i].name_, data[i].name_);
+    }
+}
+
+std::size_t archive_size(std::uint32_t flags)
+{
+    std::vector<std::size_t> sizes(100, 42);
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(
+        buffer, flags | hpx::serialization::disable_array_optimization);
+    oarchive << sizes;
+    return oarchive.bytes_written();
+}
+
+int main()
+{
+    test_varint();
+
+    for (std::uint32_t flags :
+        {std::uint32_t(hpx::serialization::enable_integer_compression),
+            std::uint32_t(hpx::serialization::enable_integer_compression |
+                hpx::serialization::endian_big),
+            std::uint32_t(hpx::serialization::enable_integer_compression |
+                hpx::serialization::disable_array_optimization)})
+    {
+        test_integers(flags);
+        test_metadata(flags);
+    }
+
+    // small integers occupy a single byte instead of eight
+    HPX_TEST(archive_size(hpx::serialization::enable_integer_compression) +
+            100 * 7 <=
+        archive_size(0));
+
+    return hpx::util::report_errors();
+}
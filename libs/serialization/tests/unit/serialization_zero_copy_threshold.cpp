@@ -0,0 +1,82 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/serialization/input_archive.hpp>
+#include <hpx/serialization/output_archive.hpp>
+#include <hpx/serialization/serialization_chunk.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/traits/force_zero_copy_serialization.hpp>
+#include <hpx/serialization/vector.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// chunking of std::vector<float> is forced regardless of its size
+HPX_FORCE_ZERO_COPY_SERIALIZATION(std::vector<float>)
+
+std::size_t count_pointer_chunks(
+    std::vector<hpx::serialization::serialization_chunk> const& chunks)
+{
+    std::size_t count = 0;
+    for (auto const& c : chunks)
+    {
+        if (c.type_ == hpx::serialization::chunk_type_pointer)
+            ++count;
+    }
+    return count;
+}
+
+template <typename T>
+void test_roundtrip(std::vector<T> const& data, std::size_t threshold,
+    std::size_t expected_pointer_chunks)
+{
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+
+    hpx::serialization::output_archive oarchive(
+        buffer, 0U, &chunks, nullptr, threshold);
+    std::int32_t const before = 42, after = -42;
+    oarchive << before << data << data << after;
+    oarchive.flush();
+
+    HPX_TEST_EQ(count_pointer_chunks(chunks), expected_pointer_chunks);
+
+    // the receiving end does not need to know the threshold used
+    hpx::serialization::input_archive iarchive(
+        buffer, oarchive.bytes_written(), &chunks);
+
+    std::int32_t before_result = 0, after_result = 0;
+    std::vector<T> result1, result2;
+    iarchive >> before_result >> result1 >> result2 >> after_result;
+
+    HPX_TEST_EQ(before_result, before);
+    HPX_TEST_EQ(after_result, after);
+    HPX_TEST(result1 == data);
+    HPX_TEST(result2 == data);
+}
+
+int main()
+{
+    std::vector<double> small(16, 1.0);
+    std::vector<double> large(1024, 2.0);
+
+    // 128 bytes are inlined with a larger threshold ...
+    test_roundtrip(small, 256, 0);
+
+    // ... but are sent as separate chunks if the threshold is lowered
+    test_roundtrip(small, 64, 2);
+
+    // 8 KiB are inlined if the threshold is raised
+    test_roundtrip(large, 1024 * 1024, 0);
+    test_roundtrip(large, 1024, 2);
+
+    // the trait forces chunking of even the smallest vector
+    test_roundtrip(std::vector<float>(4, 3.0f), 1024 * 1024, 2);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,264 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//  The algorithm used here is Dmitry Vyukov's bounded MPMC queue, see
+//  http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+
+#if !defined(HPX_LCOS_LOCAL_CHANNEL_MPMC_LOCKFREE_HPP)
+#define HPX_LCOS_LOCAL_CHANNEL_MPMC_LOCKFREE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concurrency.hpp>
+#include <hpx/errors.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // A bounded channel supporting multiple producers and multiple consumers
+    // which does not use any locks. The data is stored in a ring-buffer, each
+    // element of which carries a sequence number telling whether it is ready
+    // to be written or to be read in the current round. Producers (and
+    // consumers) synchronize with each other only by incrementing the tail
+    // (head) position. The capacity given at construction time is rounded up
+    // to the next power of two (at least two). A full channel refuses new
+    // items (set() returns false), which allows for the producers to be
+    // throttled by the consumers.
+    template <typename T>
+    class channel_mpmc_lockfree
+    {
+    private:
+        struct cell
+        {
+            std::atomic<std::size_t> sequence_;
+            T data_;
+        };
+
+        static std::size_t round_up_size(std::size_t size) noexcept
+        {
+            std::size_t result = 2;
+            while (result < size)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        explicit channel_mpmc_lockfree(std::size_t size)
+          : size_(round_up_size(size))
+          , buffer_(new cell[round_up_size(size)])
+          , closed_(false)
+        {
+            HPX_ASSERT(size != 0);
+
+            for (std::size_t i = 0; i != size_; ++i)
+            {
+                buffer_[i].sequence_.store(i, std::memory_order_relaxed);
+            }
+
+            head_.data_.store(0, std::memory_order_relaxed);
+            tail_.data_.store(0, std::memory_order_release);
+        }
+
+        channel_mpmc_lockfree(channel_mpmc_lockfree&& rhs) noexcept
+          : size_(rhs.size_)
+          , buffer_(std::move(rhs.buffer_))
+        {
+            head_.data_.store(rhs.head_.data_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+            tail_.data_.store(rhs.tail_.data_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+
+            closed_.store(rhs.closed_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+            rhs.size_ = 0;
+            rhs.closed_.store(true, std::memory_order_release);
+        }
+
+        channel_mpmc_lockfree& operator=(channel_mpmc_lockfree&& rhs) noexcept
+        {
+            head_.data_.store(rhs.head_.data_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+            tail_.data_.store(rhs.tail_.data_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+
+            size_ = rhs.size_;
+            buffer_ = std::move(rhs.buffer_);
+
+            closed_.store(rhs.closed_.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+            rhs.size_ = 0;
+            rhs.closed_.store(true, std::memory_order_release);
+
+            return *this;
+        }
+
+        ~channel_mpmc_lockfree()
+        {
+            if (!closed_.load(std::memory_order_relaxed))
+            {
+                close();
+            }
+        }
+
+        bool get(T* val = nullptr) const noexcept
+        {
+            return get_batch(val, 1) != 0;
+        }
+
+        // Retrieve up to n consecutive items at once, returns the number of
+        // items stored to vals. The items are claimed with a single update
+        // of the head position. If vals is the nullptr this only checks
+        // whether at least one item is available.
+        std::size_t get_batch(T* vals, std::size_t n) const noexcept
+        {
+            if (closed_.load(std::memory_order_relaxed) || n == 0)
+            {
+                return 0;
+            }
+
+            std::size_t const mask = size_ - 1;
+            std::size_t head = head_.data_.load(std::memory_order_relaxed);
+
+            std::size_t count = 0;
+            while (true)
+            {
+                // count the number of consecutive items ready to be read
+                count = 0;
+                while (count != n && count != size_)
+                {
+                    cell& c = buffer_[(head + count) & mask];
+                    std::size_t const seq =
+                        c.sequence_.load(std::memory_order_acquire);
+                    if (seq != head + count + 1)
+                    {
+                        break;
+                    }
+                    ++count;
+                }
+
+                if (count == 0)
+                {
+                    std::size_t const seq = buffer_[head & mask]
+                                                .sequence_.load(
+                                                    std::memory_order_acquire);
+                    if (static_cast<std::ptrdiff_t>(seq - (head + 1)) < 0)
+                    {
+                        return 0;    // the channel is empty
+                    }
+
+                    // another consumer got ahead of us, try again
+                    head = head_.data_.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (vals == nullptr)
+                {
+                    return 1;
+                }
+
+                if (head_.data_.compare_exchange_weak(
+                        head, head + count, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+
+            // the items [head, head + count) belong to this consumer now
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                cell& c = buffer_[(head + i) & mask];
+                vals[i] = std::move(c.data_);
+                c.sequence_.store(
+                    head + i + size_, std::memory_order_release);
+            }
+            return count;
+        }
+
+        bool set(T&& t) noexcept
+        {
+            if (closed_.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            std::size_t const mask = size_ - 1;
+            std::size_t tail = tail_.data_.load(std::memory_order_relaxed);
+
+            cell* c = nullptr;
+            while (true)
+            {
+                c = &buffer_[tail & mask];
+                std::size_t const seq =
+                    c->sequence_.load(std::memory_order_acquire);
+
+                std::ptrdiff_t const diff =
+                    static_cast<std::ptrdiff_t>(seq - tail);
+                if (diff == 0)
+                {
+                    if (tail_.data_.compare_exchange_weak(
+                            tail, tail + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;    // the channel is full
+                }
+                else
+                {
+                    // another producer got ahead of us, try again
+                    tail = tail_.data_.load(std::memory_order_relaxed);
+                }
+            }
+
+            c->data_ = std::move(t);
+            c->sequence_.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        std::size_t close()
+        {
+            bool expected = false;
+            if (!closed_.compare_exchange_strong(expected, true))
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "hpx::lcos::local::channel_mpmc_lockfree::close",
+                    "attempting to close an already closed channel");
+            }
+            return 0;
+        }
+
+        std::size_t capacity() const
+        {
+            return size_;
+        }
+
+    private:
+        // keep the head and the tail position in separate cache lines
+        mutable hpx::util::cache_aligned_data<std::atomic<std::size_t>> head_;
+        hpx::util::cache_aligned_data<std::atomic<std::size_t>> tail_;
+
+        // the number of elements in the buffer (always a power of two)
+        std::size_t size_;
+
+        // channel buffer
+        std::unique_ptr<cell[]> buffer_;
+
+        // this channel was closed, i.e. no further operations are possible
+        std::atomic<bool> closed_;
+    };
+}}}    // namespace hpx::lcos::local
+
+#endif
@@ -0,0 +1,146 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_main.hpp>
+#include <hpx/synchronization/channel_mpmc_lockfree.hpp>
+
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+constexpr int NUM_WORKERS = 1000;
+constexpr int NUM_PRODUCERS = 8;
+constexpr int NUM_ITEMS = 10000;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline T channel_get(hpx::lcos::local::channel_mpmc_lockfree<T> const& c)
+{
+    T result;
+    while (!c.get(&result))
+    {
+        hpx::this_thread::yield();
+    }
+    return result;
+}
+
+template <typename T>
+inline void channel_set(hpx::lcos::local::channel_mpmc_lockfree<T>& c, T val)
+{
+    while (!c.set(std::move(val)))    // NOLINT
+    {
+        hpx::this_thread::yield();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int thread_func(int i, hpx::lcos::local::channel_mpmc_lockfree<int>& channel,
+    hpx::lcos::local::channel_mpmc_lockfree<int>& next)
+{
+    channel_set(channel, i);
+    return channel_get(next);
+}
+
+void test_shift()
+{
+    std::vector<hpx::lcos::local::channel_mpmc_lockfree<int>> channels;
+    channels.reserve(NUM_WORKERS);
+
+    std::vector<hpx::future<int>> workers;
+    workers.reserve(NUM_WORKERS);
+
+    for (int i = 0; i != NUM_WORKERS; ++i)
+    {
+        channels.emplace_back(std::size_t(1));
+    }
+
+    for (int i = 0; i != NUM_WORKERS; ++i)
+    {
+        workers.push_back(hpx::async(&thread_func, i, std::ref(channels[i]),
+            std::ref(channels[(i + 1) % NUM_WORKERS])));
+    }
+
+    hpx::wait_all(workers);
+
+    for (int i = 0; i != NUM_WORKERS; ++i)
+    {
+        HPX_TEST_EQ((i + 1) % NUM_WORKERS, workers[i].get());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void produce(hpx::lcos::local::channel_mpmc_lockfree<int>& c, int base)
+{
+    for (int i = 0; i != NUM_ITEMS; ++i)
+    {
+        channel_set(c, base + i);
+    }
+}
+
+void test_batch()
+{
+    // a small channel forces the producers to wait for the consumer
+    hpx::lcos::local::channel_mpmc_lockfree<int> c(std::size_t(16));
+    HPX_TEST_EQ(c.capacity(), std::size_t(16));
+
+    std::vector<hpx::future<void>> producers;
+    producers.reserve(NUM_PRODUCERS);
+    for (int i = 0; i != NUM_PRODUCERS; ++i)
+    {
+        producers.push_back(
+            hpx::async(&produce, std::ref(c), i * NUM_ITEMS));
+    }
+
+    std::vector<int> received(std::size_t(NUM_PRODUCERS) * NUM_ITEMS, 0);
+    std::vector<int> last(NUM_PRODUCERS, -1);
+
+    int batch[8];
+    std::size_t count = 0;
+    while (count != received.size())
+    {
+        std::size_t n = c.get_batch(batch, 8);
+        if (n == 0)
+        {
+            hpx::this_thread::yield();
+            continue;
+        }
+
+        HPX_TEST(n <= 8);
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            // the items of each producer arrive in order
+            int producer = batch[i] / NUM_ITEMS;
+            HPX_TEST(last[producer] < batch[i]);
+            last[producer] = batch[i];
+
+            ++received[batch[i]];
+        }
+        count += n;
+    }
+
+    hpx::wait_all(producers);
+
+    HPX_TEST(!c.get());
+    HPX_TEST_EQ(std::accumulate(received.begin(), received.end(), 0),
+        NUM_PRODUCERS * NUM_ITEMS);
+    for (int r : received)
+    {
+        HPX_TEST_EQ(r, 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    test_shift();
+    test_batch();
+
+    return hpx::util::report_errors();
+}
@@ -295,6 +295,10 @@ namespace hpx { namespace threads {
         double const max_idle_backoff_time = hpx::util::from_string<double>(
             hpx::get_config_entry("hpx.max_idle_backoff_time",
                 std::to_string(HPX_IDLE_BACKOFF_TIME_MAX)));
+        std::int64_t const max_idle_yield_count =
+            hpx::util::from_string<std::int64_t>(
+                hpx::get_config_entry("hpx.max_idle_yield_count",
+                    std::to_string(HPX_IDLE_YIELD_COUNT_MAX)));
 
         std::ptrdiff_t small_stacksize = get_stack_size(thread_stacksize_small);
         std::ptrdiff_t medium_stacksize =
@@ -306,8 +310,8 @@ namespace hpx { namespace threads {
             max_thread_count, min_tasks_to_steal_pending,
             min_tasks_to_steal_staged, min_add_new_count, max_add_new_count,
             min_delete_count, max_delete_count, max_terminated_threads,
-            max_idle_backoff_time, small_stacksize, medium_stacksize,
-            large_stacksize, huge_stacksize);
+            max_idle_backoff_time, max_idle_yield_count, small_stacksize,
+            medium_stacksize, large_stacksize, huge_stacksize);
 
         if (!hpx::is_networking_enabled())
         {
@@ -682,6 +686,45 @@ namespace hpx { namespace threads {
 #endif
                 break;
             }
+
+            case resource::local_workstealing:
+            {
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                hpx::detail::ensure_high_priority_compatibility(cfg_.vm_);
+
+                // instantiate the scheduler
+                using local_sched_type =
+                    hpx::threads::policies::local_workstealing_scheduler<>;
+
+                local_sched_type::init_parameter_type init(
+                    thread_pool_init.num_threads_,
+                    thread_pool_init.affinity_data_, thread_queue_init,
+                    "core-local_workstealing_scheduler");
+
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // set the default scheduler flags
+                sched->add_scheduler_mode(thread_pool_init.mode_);
+                // conditionally set/unset this flag
+                sched->update_scheduler_mode(
+                    policies::enable_stealing_numa, !numa_sensitive);
+
+                // instantiate the pool
+                std::unique_ptr<thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                        local_sched_type>(std::move(sched), thread_pool_init));
+                pools_.push_back(std::move(pool));
+#else
+                throw hpx::detail::command_line_error(
+                    "Command line option --hpx:queuing=local-workstealing "
+                    "is not configured in this build. Please rebuild with "
+                    "'cmake -DHPX_WITH_THREAD_SCHEDULERS=local'.");
+#endif
+                break;
+            }
             }
 
             // update the thread_offset for the next pool
@@ -25,9 +25,11 @@
 
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -43,6 +45,8 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      allow_background_flush = 1
+    //      adaptive = 0
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -51,7 +55,8 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0";
         }
     };
 }}
@@ -87,6 +92,70 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        // weight of new samples for the moving averages
+        constexpr double sample_weight = 0.125;
+
+        void update_average(double& average, double sample)
+        {
+            if (average == 0)
+                average = sample;
+            else
+                average += sample_weight * (sample - average);
+        }
+
+        // The round trip time is kept outside of the message handler. The
+        // write handlers of outgoing parcels refer to it weakly only, as
+        // they may complete after the message handler has been destroyed
+        // (during parcelport shutdown).
+        struct round_trip_time
+        {
+            void record(std::int64_t started_at)
+            {
+                std::int64_t now = util::high_resolution_clock::now();
+
+                std::lock_guard<lcos::local::spinlock> l(mtx_);
+                update_average(average_, double(now - started_at));
+            }
+
+            double get() const
+            {
+                std::lock_guard<lcos::local::spinlock> l(mtx_);
+                return average_;
+            }
+
+            mutable lcos::local::spinlock mtx_;
+            double average_ = 0;                // [ns]
+        };
+
+        // Write handler wrapper measuring the time it takes for a message to
+        // be sent. For connection oriented parcelports (like TCP) this
+        // includes receiving the acknowledgement from the destination.
+        struct round_trip_handler
+        {
+            void operator()(boost::system::error_code const& ec,
+                parcelset::parcel const& p)
+            {
+                if (!ec)
+                {
+                    if (std::shared_ptr<round_trip_time> rtt = rtt_.lock())
+                        rtt->record(started_at_);
+                }
+                if (f_)
+                    f_(ec, p);
+            }
+
+            std::weak_ptr<round_trip_time> rtt_;
+            std::int64_t started_at_;
+            parcelset::write_handler_type f_;
+        };
     }
 
     void coalescing_message_handler::update_num_messages()
@@ -102,6 +171,52 @@ namespace hpx { namespace plugins { namespace parcel
         interval_ = detail::get_interval(interval_);
     }
 
+    void coalescing_message_handler::update_adaptive()
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        adaptive_ = detail::get_adaptive();
+        adapt_parameters();
+    }
+
+    void coalescing_message_handler::adapt_parameters()
+    {
+        adaptive_num_coalesced_parcels_ = num_coalesced_parcels_;
+        adaptive_interval_ = std::int64_t(interval_) * 1000;
+
+        if (!adaptive_)
+            return;
+
+        // use the configured values until a round trip was measured
+        double const average_round_trip_time = round_trip_time_->get();
+        if (average_round_trip_time == 0)
+            return;
+
+        // don't hold back parcels for longer than half a round trip, this
+        // keeps the added latency below the cost of the message itself
+        double interval = (std::min)(
+            average_round_trip_time / 2, double(adaptive_interval_));
+        adaptive_interval_ = (std::max)(std::int64_t(interval), std::int64_t(1));
+
+        // expected number of parcels arriving during that time
+        double num = 1.0;
+        if (average_arrival_time_ != 0)
+            num += interval / average_arrival_time_;
+
+        adaptive_num_coalesced_parcels_ = (std::max)(std::size_t(1),
+            (std::min)(std::size_t(num), num_coalesced_parcels_));
+    }
+
+    std::size_t coalescing_message_handler::get_num_coalesced_parcels() const
+    {
+        return adaptive_ ? adaptive_num_coalesced_parcels_ :
+            num_coalesced_parcels_;
+    }
+
+    std::int64_t coalescing_message_handler::get_interval() const
+    {
+        return adaptive_ ? adaptive_interval_ : std::int64_t(interval_) * 1000;
+    }
+
     coalescing_message_handler::coalescing_message_handler(
             char const* action_name, parcelset::parcelport* pp, std::size_t num,
             std::size_t interval)
@@ -116,6 +231,12 @@ namespace hpx { namespace plugins { namespace parcel
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
         action_name_(action_name),
+        adaptive_(detail::get_adaptive()),
+        adaptive_num_coalesced_parcels_(num_coalesced_parcels_),
+        adaptive_interval_(std::int64_t(interval_) * 1000),
+        average_arrival_time_(0),
+        round_trip_time_(std::make_shared<detail::round_trip_time>()),
+        buffer_started_at_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
@@ -145,6 +266,9 @@ namespace hpx { namespace plugins { namespace parcel
         set_config_entry_callback(
             "hpx.plugins.coalescing_message_handler.interval",
             util::bind(&coalescing_message_handler::update_interval, this));
+        set_config_entry_callback(
+            "hpx.plugins.coalescing_message_handler.adaptive",
+            util::bind(&coalescing_message_handler::update_adaptive, this));
     }
 
     void coalescing_message_handler::put_parcel(
@@ -163,16 +287,31 @@ namespace hpx { namespace plugins { namespace parcel
         if (time_between_parcels_)
             (*time_between_parcels_)(time_since_last_parcel);
 
-        std::chrono::microseconds interval(interval_);
+        if (adaptive_)
+        {
+            detail::update_average(
+                average_arrival_time_, double(time_since_last_parcel));
+            adapt_parameters();
+        }
+
+        std::chrono::nanoseconds interval(get_interval());
 
         // just send parcel if the coalescing was stopped or the buffer is
         // empty and time since last parcel is larger than coalescing interval.
+        // In adaptive mode, parcels are sent right away as well if not more
+        // than one parcel is expected to arrive during the interval.
         if (stopped_ ||
             (buffer_.empty() &&
-                std::chrono::nanoseconds(time_since_last_parcel) > interval
-           ))
+                (std::chrono::nanoseconds(time_since_last_parcel) > interval ||
+                    get_num_coalesced_parcels() == 1)))
         {
             ++num_messages_;
+
+            if (adaptive_)
+            {
+                f = detail::round_trip_handler{
+                    round_trip_time_, parcel_time, std::move(f)};
+            }
             l.unlock();
 
             // this instance should not buffer parcels anymore
@@ -180,12 +319,22 @@ namespace hpx { namespace plugins { namespace parcel
             return;
         }
 
+        // In adaptive mode the buffer is flushed early if no parcel arrives
+        // for twice the average time between parcels.
+        if (adaptive_)
+        {
+            interval = (std::min)(interval,
+                std::chrono::nanoseconds(
+                    std::int64_t(2 * average_arrival_time_) + 1));
+        }
+
         detail::message_buffer::message_buffer_append_state s =
             buffer_.append(dest, std::move(p), std::move(f));
 
         switch(s) {
         case detail::message_buffer::first_message:
             // start deadline timer to flush buffer
+            buffer_started_at_ = parcel_time;
             l.unlock();
             timer_.start(interval);
             break;
@@ -215,6 +364,23 @@ namespace hpx { namespace plugins { namespace parcel
     {
         // adjust timer if needed
         std::unique_lock<mutex_type> l(mtx_);
+        if (!buffer_.empty() && adaptive_ && !stopped_)
+        {
+            // keep buffering as long as parcels are still arriving at the
+            // expected rate and the buffer has not reached its deadline
+            std::int64_t now = util::high_resolution_clock::now();
+            std::int64_t deadline = buffer_started_at_ + get_interval();
+            std::int64_t idle = std::int64_t(2 * average_arrival_time_) + 1;
+
+            if (now - last_parcel_time_ < idle && now < deadline)
+            {
+                l.unlock();
+                timer_.start(std::chrono::nanoseconds(
+                    (std::min)(idle, deadline - now)));
+                return false;
+            }
+        }
+
         if (!buffer_.empty())
         {
             flush_locked(l,
@@ -272,10 +438,17 @@ namespace hpx { namespace plugins { namespace parcel
         if (buffer_.empty())
             return false;
 
-        detail::message_buffer buff (num_coalesced_parcels_);
+        detail::message_buffer buff (get_num_coalesced_parcels());
         std::swap(buff, buffer_);
 
         ++num_messages_;
+
+        if (adaptive_)
+        {
+            parcelset::write_handler_type& f = buff.back_handler();
+            f = detail::round_trip_handler{round_trip_time_,
+                util::high_resolution_clock::now(), std::move(f)};
+        }
         l.unlock();
 
         HPX_ASSERT(nullptr != pp_);
@@ -0,0 +1,237 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHM)
+#include <hpx/assertion.hpp>
+#include <hpx/errors.hpp>
+#include <hpx/plugins/parcelport/shm/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shm/locality.hpp>
+#include <hpx/plugins/parcelport/shm/receiver.hpp>
+#include <hpx/plugins/parcelport/shm/segment.hpp>
+#include <hpx/plugins/parcelport/shm/sender.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/util/get_entry_as.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shm
+{
+    namespace
+    {
+        parcelset::locality parcelport_address()
+        {
+            return parcelset::locality(locality(boost::asio::ip::host_name(),
+                static_cast<std::uint32_t>(::getpid())));
+        }
+    }
+
+    connection_handler::connection_handler(
+        util::runtime_configuration const& ini,
+        threads::policies::callback_notifier const& notifier)
+      : base_type(ini, parcelport_address(), notifier)
+      , num_channels_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.shm.channels", 64))
+      , channel_size_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.shm.channel_size", 1024 * 1024))
+      , receiver_(*this)
+      , stopped_(false)
+    {
+        if (here_.type() != std::string("shm")) {
+            HPX_THROW_EXCEPTION(network_error, "shm::parcelport::parcelport",
+                "this parcelport was instantiated to represent an unexpected "
+                "locality type: " + std::string(here_.type()));
+        }
+    }
+
+    connection_handler::~connection_handler()
+    {
+        receiver_.close();
+    }
+
+    bool connection_handler::do_run()
+    {
+        receiver_.open(here_.get<locality>().segment_name(), num_channels_,
+            channel_size_);
+        return true;
+    }
+
+    void connection_handler::do_stop()
+    {
+        receiver_.close();
+
+        // fail the writes which are still waiting for room
+        std::vector<std::shared_ptr<sender> > parked;
+        {
+            std::lock_guard<lcos::local::spinlock> l(parked_mtx_);
+            stopped_ = true;
+            parked.swap(parked_);
+        }
+        for (std::shared_ptr<sender> const& s : parked)
+            s->resume(true);
+
+        std::lock_guard<lcos::local::spinlock> l(segments_mtx_);
+        segments_.clear();
+    }
+
+    bool connection_handler::can_connect(
+        parcelset::locality const& l, bool use_alternative_parcelport)
+    {
+        return use_alternative_parcelport &&
+            l.get<locality>().host() == here_.get<locality>().host();
+    }
+
+    std::shared_ptr<segment> connection_handler::get_segment(
+        locality const& l, error_code& ec)
+    {
+        std::lock_guard<lcos::local::spinlock> lk(segments_mtx_);
+
+        auto it = segments_.find(l);
+        if (it != segments_.end())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return it->second;
+        }
+
+        std::shared_ptr<segment> seg = std::make_shared<segment>();
+        seg->open(l.segment_name(), ec);
+        if (ec)
+            return std::shared_ptr<segment>();
+
+        segments_.emplace(l, seg);
+        return seg;
+    }
+
+    std::shared_ptr<sender> connection_handler::create_connection(
+        parcelset::locality const& l, error_code& ec)
+    {
+        std::shared_ptr<segment> seg = get_segment(l.get<locality>(), ec);
+        if (!seg)
+            return std::shared_ptr<sender>();
+
+        // claim a channel, retry if all of them are in use
+        std::uint32_t owner = here_.get<locality>().pid();
+        for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+        {
+            if (seg->is_closed())
+                break;
+
+            std::size_t channel = seg->claim_channel(owner);
+            if (channel != std::size_t(-1))
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+
+                return std::make_shared<sender>(
+                    io_service_pool_.get_io_service(), l, seg, channel, this);
+            }
+
+            // wait for a really short amount of time
+            if (hpx::threads::get_self_ptr()) {
+                this_thread::suspend(hpx::threads::pending,
+                    "connection_handler(shm)::create_connection");
+            }
+            else {
+                std::this_thread::sleep_for(
+                    std::chrono::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+            }
+        }
+
+        if (tolerate_node_faults())
+            return std::shared_ptr<sender>();
+
+        std::ostringstream strm;
+        strm << "no shared memory channel available (while trying to "
+                "connect to: " << l << ")";
+        HPX_THROWS_IF(ec, network_error,
+            "shm::connection_handler::create_connection", strm.str());
+        return std::shared_ptr<sender>();
+    }
+
+    parcelset::locality connection_handler::agas_locality(
+        util::runtime_configuration const&) const
+    {
+        // the shared memory parcelport is never used for bootstrapping
+        return parcelset::locality(locality());
+    }
+
+    parcelset::locality connection_handler::create_locality() const
+    {
+        return parcelset::locality(locality());
+    }
+
+    bool connection_handler::background_work(
+        std::size_t, parcelport_background_mode mode)
+    {
+        bool did_some_work = false;
+        if (mode & parcelport_background_mode_send)
+            did_some_work = resume_parked_connections();
+        if (mode & parcelport_background_mode_receive)
+            did_some_work = receiver_.background_work() || did_some_work;
+        return did_some_work;
+    }
+
+    void connection_handler::park_connection(std::shared_ptr<sender> const& s)
+    {
+        {
+            std::lock_guard<lcos::local::spinlock> l(parked_mtx_);
+            if (!stopped_)
+            {
+                parked_.push_back(s);
+                return;
+            }
+        }
+        s->resume(true);
+    }
+
+    bool connection_handler::resume_parked_connections()
+    {
+        std::vector<std::shared_ptr<sender> > resumed;
+        {
+            std::unique_lock<lcos::local::spinlock> l(
+                parked_mtx_, std::try_to_lock);
+            if (!l.owns_lock() || parked_.empty())
+                return false;
+
+            // the receivers advance the tails of the rings as they consume
+            // messages, every connection which has enough room again is
+            // handed back to the io_service
+            auto it = std::partition(parked_.begin(), parked_.end(),
+                [](std::shared_ptr<sender> const& s) {
+                    return !s->can_resume();
+                });
+            resumed.assign(std::make_move_iterator(it),
+                std::make_move_iterator(parked_.end()));
+            parked_.erase(it, parked_.end());
+        }
+
+        for (std::shared_ptr<sender> const& s : resumed)
+            s->resume(false);
+
+        return !resumed.empty();
+    }
+}}}}
+
+#endif
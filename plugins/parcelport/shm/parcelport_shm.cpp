@@ -0,0 +1,54 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHM)
+#include <hpx/plugin/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport/shm/connection_handler.hpp>
+#include <hpx/plugins/parcelport/shm/sender.hpp>
+#include <hpx/plugins/parcelport_factory.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shm]
+    //      ...
+    //      priority = 1000
+    //
+    // The shared memory parcelport has the highest priority, parcels to
+    // localities on other nodes are sent through the next parcelport in line.
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shm::connection_handler>
+    {
+        static char const* priority()
+        {
+            return "1000";
+        }
+
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "channels = ${HPX_PARCEL_SHM_CHANNELS:64}\n"
+                "channel_size = ${HPX_PARCEL_SHM_CHANNEL_SIZE:1048576}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::shm::connection_handler,
+    shm);
+
+#endif
@@ -0,0 +1,245 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHM)
+#include <hpx/assertion.hpp>
+#include <hpx/errors.hpp>
+#include <hpx/plugins/parcelport/shm/segment.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shm
+{
+    namespace
+    {
+        constexpr std::uint64_t segment_magic = 0x6870782e73686d31ull;
+
+        std::size_t controls_offset()
+        {
+            return align_frame(sizeof(segment_header));
+        }
+
+        std::size_t rings_offset(std::size_t num_channels)
+        {
+            return controls_offset() + num_channels * sizeof(channel_control);
+        }
+    }
+
+    segment::segment()
+      : owner_(false)
+      , base_(nullptr)
+      , size_(0)
+      , header_(nullptr)
+      , controls_(nullptr)
+      , rings_(nullptr)
+    {
+    }
+
+    segment::~segment()
+    {
+        close();
+    }
+
+    void segment::create(std::string const& name, std::size_t num_channels,
+        std::size_t channel_size, error_code& ec)
+    {
+        HPX_ASSERT(!is_open());
+
+        if (num_channels == 0 || channel_size < 4 * frame_alignment)
+        {
+            HPX_THROWS_IF(ec, bad_parameter, "shm::segment::create",
+                "invalid number of channels or channel size");
+            return;
+        }
+        channel_size = align_frame(channel_size);
+
+        // remove stale segments left behind by a process which used the same
+        // pid before
+        ::shm_unlink(name.c_str());
+
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd == -1)
+        {
+            HPX_THROWS_IF(ec, network_error, "shm::segment::create",
+                "shm_open failed for " + name + ": " + std::strerror(errno));
+            return;
+        }
+
+        std::size_t size = rings_offset(num_channels) +
+            num_channels * channel_size;
+        if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+        {
+            int err = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            HPX_THROWS_IF(ec, network_error, "shm::segment::create",
+                "ftruncate failed for " + name + ": " + std::strerror(err));
+            return;
+        }
+
+        map(fd, size, ec);
+        if (ec)
+        {
+            ::shm_unlink(name.c_str());
+            return;
+        }
+
+        name_ = name;
+        owner_ = true;
+
+        // the memory is zero initialized, which leaves all channels free
+        new (header_) segment_header;
+        header_->num_channels = static_cast<std::uint32_t>(num_channels);
+        header_->channel_size = channel_size;
+        header_->closed.store(0, std::memory_order_relaxed);
+        header_->active_channels.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i != num_channels; ++i)
+            new (&controls_[i]) channel_control;
+        rings_ = static_cast<char*>(base_) + rings_offset(num_channels);
+
+        header_->magic.store(segment_magic, std::memory_order_release);
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void segment::open(std::string const& name, error_code& ec)
+    {
+        HPX_ASSERT(!is_open());
+
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd == -1)
+        {
+            HPX_THROWS_IF(ec, network_error, "shm::segment::open",
+                "shm_open failed for " + name + ": " + std::strerror(errno));
+            return;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1 ||
+            static_cast<std::size_t>(st.st_size) < rings_offset(0))
+        {
+            ::close(fd);
+            HPX_THROWS_IF(ec, network_error, "shm::segment::open",
+                "shared memory segment " + name + " is not initialized");
+            return;
+        }
+
+        map(fd, static_cast<std::size_t>(st.st_size), ec);
+        if (ec)
+            return;
+
+        if (header_->magic.load(std::memory_order_acquire) != segment_magic ||
+            rings_offset(header_->num_channels) +
+                    header_->num_channels * header_->channel_size >
+                size_)
+        {
+            close();
+            HPX_THROWS_IF(ec, network_error, "shm::segment::open",
+                "shared memory segment " + name + " is not initialized");
+            return;
+        }
+
+        name_ = name;
+        rings_ = static_cast<char*>(base_) + rings_offset(num_channels());
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void segment::map(int fd, std::size_t size, error_code& ec)
+    {
+        void* base = ::mmap(
+            nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            HPX_THROWS_IF(ec, network_error, "shm::segment::map",
+                std::string("mmap failed: ") + std::strerror(err));
+            return;
+        }
+
+        base_ = base;
+        size_ = size;
+        header_ = static_cast<segment_header*>(base);
+        controls_ = reinterpret_cast<channel_control*>(
+            static_cast<char*>(base) + controls_offset());
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void segment::close()
+    {
+        if (base_ == nullptr)
+            return;
+
+        ::munmap(base_, size_);
+        if (owner_)
+            ::shm_unlink(name_.c_str());
+
+        owner_ = false;
+        base_ = nullptr;
+        size_ = 0;
+        header_ = nullptr;
+        controls_ = nullptr;
+        rings_ = nullptr;
+    }
+
+    void segment::mark_closed()
+    {
+        if (header_ != nullptr)
+            header_->closed.store(1, std::memory_order_release);
+    }
+
+    std::size_t segment::claim_channel(std::uint32_t owner)
+    {
+        HPX_ASSERT(owner != 0);
+        for (std::size_t i = 0; i != num_channels(); ++i)
+        {
+            std::uint32_t expected = 0;
+            if (controls_[i].owner.load(std::memory_order_relaxed) == 0 &&
+                controls_[i].owner.compare_exchange_strong(expected, owner,
+                    std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                std::uint32_t active =
+                    header_->active_channels.load(std::memory_order_relaxed);
+                while (active <= i &&
+                    !header_->active_channels.compare_exchange_weak(active,
+                        static_cast<std::uint32_t>(i + 1),
+                        std::memory_order_release, std::memory_order_relaxed))
+                {
+                }
+                return i;
+            }
+        }
+        return std::size_t(-1);
+    }
+
+    void segment::release_channel(std::size_t channel)
+    {
+        // head and tail stay untouched, the next owner continues where this
+        // one stopped
+        control(channel).owner.store(0, std::memory_order_release);
+    }
+}}}}
+
+#endif
@@ -66,6 +66,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         util::runtime_configuration const& ini,
         threads::policies::callback_notifier const& notifier)
       : base_type(ini, parcelport_address(ini), notifier)
+      , receive_buffer_pool_(std::make_shared<detail::receive_buffer_pool>())
       , acceptor_(nullptr)
     {
         if (here_.type() != std::string("tcp")) {
@@ -97,7 +98,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         {
             try {
                 std::shared_ptr<receiver> receiver_conn(
-                    new receiver(io_service, get_max_inbound_message_size(), *this));
+                    new receiver(io_service, get_max_inbound_message_size(),
+                        receive_buffer_pool_, *this));
 
                 tcp::endpoint ep = *it;
                 acceptor_->open(ep.protocol());
@@ -278,6 +280,26 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         return parcelset::locality(locality());
     }
 
+    std::int64_t connection_handler::get_receive_buffer_pool_statistics(
+        receive_buffer_pool_statistics_type t, bool reset)
+    {
+        switch (t) {
+            case receive_buffer_pool_hits:
+                return receive_buffer_pool_->get_hits(reset);
+
+            case receive_buffer_pool_misses:
+                return receive_buffer_pool_->get_misses(reset);
+
+            default:
+                break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "tcp::connection_handler::get_receive_buffer_pool_statistics",
+            "invalid receive buffer pool statistics type");
+        return 0;
+    }
+
     // accepted new incoming connection
     void connection_handler::handle_accept(boost::system::error_code const & e,
         std::shared_ptr<receiver> receiver_conn)
@@ -289,7 +311,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
             boost::asio::io_service& io_service = io_service_pool_.get_io_service();
             receiver_conn.reset(new receiver(io_service, get_max_inbound_message_size(),
-                *this));
+                receive_buffer_pool_, *this));
             acceptor_->async_accept(receiver_conn->socket(),
                 util::bind(&connection_handler::handle_accept,
                     this,
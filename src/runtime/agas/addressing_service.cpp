@@ -66,77 +66,12 @@
 
 namespace hpx { namespace agas
 {
-    struct addressing_service::gva_cache_key
-    {    // {{{ gva_cache_key implementation
-    private:
-        typedef std::pair<naming::gid_type, naming::gid_type> key_type;
-
-        key_type key_;
-
-    public:
-        gva_cache_key()
-          : key_()
-        {
-        }
-
-        explicit gva_cache_key(
-                naming::gid_type const& id, std::uint64_t count = 1)
-          : key_(naming::detail::get_stripped_gid(id),
-                naming::detail::get_stripped_gid(id) + (count - 1))
-        {
-            HPX_ASSERT(count);
-        }
-
-        naming::gid_type get_gid() const
-        {
-            return key_.first;
-        }
-
-        std::uint64_t get_count() const
-        {
-            naming::gid_type const size = key_.second - key_.first;
-            HPX_ASSERT(size.get_msb() == 0);
-            return size.get_lsb();
-        }
-
-        friend bool operator<(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            return lhs.key_.second < rhs.key_.first;
-        }
-
-        friend bool operator==(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            // Direct hit
-            if (lhs.key_ == rhs.key_)
-            {
-                return true;
-            }
-
-            // Is lhs in rhs?
-            if (1 == lhs.get_count() && 1 != rhs.get_count())
-            {
-                return rhs.key_.first <= lhs.key_.first &&
-                    lhs.key_.second <= rhs.key_.second;
-            }
-
-            // Is rhs in lhs?
-            else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            {
-                return lhs.key_.first <= rhs.key_.first &&
-                    rhs.key_.second <= lhs.key_.second;
-            }
-
-            return false;
-        }
-    }; // }}}
 
 addressing_service::addressing_service(
     util::runtime_configuration const& ini_
   , runtime_mode runtime_type_
     )
-  : gva_cache_(new gva_cache_type)
+  : gva_cache_(new gva_cache_type(ini_.get_os_thread_count()))
   , console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
   , refcnt_requests_count_(0)
@@ -377,8 +312,8 @@ void addressing_service::adjust_local_cache_size(std::size_t cache_size)
     // create the hierarchy based on the topology
     if (caching_)
     {
-        std::size_t previous = gva_cache_->size();
-            gva_cache_->reserve(cache_size);
+        std::size_t previous = gva_cache_->capacity();
+        gva_cache_->reserve(cache_size);
 
         LAGAS_(info) << hpx::util::format(
             "addressing_service::adjust_local_cache_size, previous size: {1}, "
@@ -1951,32 +1886,16 @@ void addressing_service::update_cache_entry(
 
         const gva_cache_key key(gid, count);
 
+        gva_cache_key idbase;
+        if (!gva_cache_->update_if(key, g, check_for_collisions, idbase))
         {
-            std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
+            if (LAGAS_ENABLED(warning))
             {
-                if (LAGAS_ENABLED(warning))
-                {
-                    // Figure out who we collided with.
-                    addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
-
-                    if (!gva_cache_->get_entry(key, idbase, e))
-                    {
-                        // This is impossible under sane conditions.
-                        lock.unlock();
-                        HPX_THROWS_IF(ec, invalid_data
-                          , "addressing_service::update_cache_entry"
-                          , "data corruption or lock error occurred in cache");
-                        return;
-                    }
-
-                    LAGAS_(warning) << hpx::util::format(
-                        "addressing_service::update_cache_entry, "
-                        "aborting update due to key collision in cache, "
-                        "new_gid({1}), new_count({2}), old_gid({3}), old_count({4})",
-                        gid, count, idbase.get_gid(), idbase.get_count());
-                }
+                LAGAS_(warning) << hpx::util::format(
+                    "addressing_service::update_cache_entry, "
+                    "aborting update due to key collision in cache, "
+                    "new_gid({1}), new_count({2}), old_gid({3}), old_count({4})",
+                    gid, count, idbase.get_gid(), idbase.get_count());
             }
         }
 
@@ -2003,7 +1922,6 @@ bool addressing_service::get_cache_entry(
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
     if(gva_cache_->get_entry(k, idbase_key, gva))
     {
         const std::uint64_t id_msb =
@@ -2011,7 +1929,6 @@ bool addressing_service::get_cache_entry(
 
         if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
@@ -2040,8 +1957,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -2087,10 +2002,8 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->erase(
-            [&gid](std::pair<gva_cache_key, gva> const& p)
+            [&gid](gva_cache_type::entry_pair const& p)
             {
                 return gid == p.first.get_gid();
             });
@@ -2238,80 +2151,67 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->size();
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().hits(reset);
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().misses(reset);
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().evictions(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_get_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_insert_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_update_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_erase_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_get_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_insert_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_update_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->get_statistics().get_erase_entry_time(reset);
 }
 
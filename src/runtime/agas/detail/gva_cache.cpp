@@ -0,0 +1,765 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/assertion.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/synchronization/detail/yield_k.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Minimal readers/writer spinlock protecting a single shard. Shards
+        // are only ever locked for very short periods of time, which makes
+        // spinning preferable over suspending the calling thread. A waiting
+        // writer keeps new readers from entering, a constant stream of
+        // lookups can't starve the writers.
+        class rw_spinlock
+        {
+            static constexpr std::uint32_t writer = 0x80000000u;
+            static constexpr std::uint32_t writer_pending = 0x40000000u;
+
+        public:
+            rw_spinlock()
+              : state_(0)
+            {}
+
+            void lock_shared()
+            {
+                for (std::size_t k = 0; /**/; ++k)
+                {
+                    std::uint32_t s = state_.load(std::memory_order_relaxed);
+                    if ((s & (writer | writer_pending)) == 0 &&
+                        state_.compare_exchange_weak(s, s + 1,
+                            std::memory_order_acquire,
+                            std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    util::detail::yield_k(
+                        k, "hpx::agas::detail::rw_spinlock::lock_shared");
+                }
+            }
+
+            void unlock_shared()
+            {
+                state_.fetch_sub(1, std::memory_order_release);
+            }
+
+            void lock()
+            {
+                for (std::size_t k = 0; /**/; ++k)
+                {
+                    std::uint32_t s = state_.load(std::memory_order_relaxed);
+                    if ((s & ~writer_pending) == 0)
+                    {
+                        if (state_.compare_exchange_weak(s, writer,
+                                std::memory_order_acquire,
+                                std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                    }
+                    else if ((s & writer_pending) == 0)
+                    {
+                        // announce the writer, new readers will wait
+                        state_.fetch_or(
+                            writer_pending, std::memory_order_relaxed);
+                    }
+                    util::detail::yield_k(
+                        k, "hpx::agas::detail::rw_spinlock::lock");
+                }
+            }
+
+            void unlock()
+            {
+                // other writers might have announced themselves meanwhile
+                state_.fetch_and(~writer, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<std::uint32_t> state_;
+        };
+
+        struct shared_lock
+        {
+            explicit shared_lock(rw_spinlock& mtx)
+              : mtx_(mtx)
+            {
+                mtx_.lock_shared();
+            }
+            ~shared_lock()
+            {
+                mtx_.unlock_shared();
+            }
+
+            rw_spinlock& mtx_;
+        };
+
+        std::uint64_t now()
+        {
+            std::chrono::nanoseconds ns =
+                std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(ns.count());
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::statistics::update_on_exit::update_on_exit(
+            statistics& stat, method m)
+      : started_at_(now())
+      , stat_(stat)
+      , m_(m)
+    {
+    }
+
+    gva_cache::statistics::update_on_exit::~update_on_exit()
+    {
+        stat_.times_[m_] += static_cast<std::int64_t>(now() - started_at_);
+        ++stat_.counts_[m_];
+    }
+
+    gva_cache::statistics::statistics()
+      : hits_(0)
+      , misses_(0)
+      , insertions_(0)
+      , evictions_(0)
+    {
+        for (std::size_t i = 0; i != num_methods; ++i)
+        {
+            counts_[i] = 0;
+            times_[i] = 0;
+        }
+    }
+
+    std::size_t gva_cache::statistics::hits(bool reset)
+    {
+        return util::get_and_reset_value(hits_, reset);
+    }
+
+    std::size_t gva_cache::statistics::misses(bool reset)
+    {
+        return util::get_and_reset_value(misses_, reset);
+    }
+
+    std::size_t gva_cache::statistics::insertions(bool reset)
+    {
+        return util::get_and_reset_value(insertions_, reset);
+    }
+
+    std::size_t gva_cache::statistics::evictions(bool reset)
+    {
+        return util::get_and_reset_value(evictions_, reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_get_entry_count(bool reset)
+    {
+        return util::get_and_reset_value(counts_[method_get_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_insert_entry_count(bool reset)
+    {
+        return util::get_and_reset_value(counts_[method_insert_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_update_entry_count(bool reset)
+    {
+        return util::get_and_reset_value(counts_[method_update_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_erase_entry_count(bool reset)
+    {
+        return util::get_and_reset_value(counts_[method_erase_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_get_entry_time(bool reset)
+    {
+        return util::get_and_reset_value(times_[method_get_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_insert_entry_time(bool reset)
+    {
+        return util::get_and_reset_value(times_[method_insert_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_update_entry_time(bool reset)
+    {
+        return util::get_and_reset_value(times_[method_update_entry], reset);
+    }
+
+    std::int64_t gva_cache::statistics::get_erase_entry_time(bool reset)
+    {
+        return util::get_and_reset_value(times_[method_erase_entry], reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A shard holds up to capacity_ entries in a fixed array of slots. The
+    // index maps keys to slots, the hand points to the next slot to be
+    // considered for eviction.
+    struct gva_cache::shard
+    {
+        shard()
+          : capacity_(0)
+          , hand_(0)
+          , count_(0)
+        {}
+
+        // may be called without holding the lock
+        bool empty() const
+        {
+            return count_.load(std::memory_order_relaxed) == 0;
+        }
+
+        // all functions below require the lock to be held, lookup() may be
+        // called with a shared lock, all others require exclusive access
+
+        bool lookup(key_type const& key, key_type& realkey, entry_type& entry)
+            const
+        {
+            auto it = index_.find(key);
+            if (it == index_.end())
+                return false;
+
+            // avoid writing to the cache line if the bit is already set
+            std::atomic<bool>& ref = referenced_[it->second];
+            if (!ref.load(std::memory_order_relaxed))
+                ref.store(true, std::memory_order_relaxed);
+
+            realkey = it->first;
+            entry = slots_[it->second].second;
+            return true;
+        }
+
+        // returns true if an entry was evicted to make room for the new one
+        bool insert_nonexist(key_type const& key, entry_type const& entry)
+        {
+            if (capacity_ == 0)
+                return false;
+
+            bool evicted = false;
+            std::size_t slot = 0;
+            if (!free_.empty())
+            {
+                slot = free_.back();
+                free_.pop_back();
+            }
+            else if (slots_.size() < capacity_)
+            {
+                slot = slots_.size();
+                slots_.emplace_back();
+                used_.push_back(false);
+            }
+            else
+            {
+                slot = evict();
+                evicted = true;
+            }
+
+            slots_[slot] = entry_pair(key, entry);
+            used_[slot] = true;
+            referenced_[slot].store(false, std::memory_order_relaxed);
+            index_.emplace(key, slot);
+            count_.store(index_.size(), std::memory_order_relaxed);
+            return evicted;
+        }
+
+        // CLOCK eviction: sweep the slots starting at the hand, clearing the
+        // reference bits on the way, and free the first unreferenced entry
+        std::size_t evict()
+        {
+            HPX_ASSERT(!slots_.empty());
+            for (;;)
+            {
+                std::size_t slot = hand_;
+                hand_ = (hand_ + 1) % slots_.size();
+
+                if (!used_[slot])
+                    continue;
+
+                if (referenced_[slot].load(std::memory_order_relaxed))
+                {
+                    referenced_[slot].store(false, std::memory_order_relaxed);
+                    continue;
+                }
+
+                index_.erase(slots_[slot].first);
+                used_[slot] = false;
+                return slot;
+            }
+        }
+
+        void remove(std::map<key_type, std::size_t>::iterator it)
+        {
+            used_[it->second] = false;
+            slots_[it->second] = entry_pair();
+            free_.push_back(it->second);
+            index_.erase(it);
+            count_.store(index_.size(), std::memory_order_relaxed);
+        }
+
+        std::size_t size() const
+        {
+            return index_.size();
+        }
+
+        std::size_t clear()
+        {
+            std::size_t erased = index_.size();
+            index_.clear();
+            slots_.clear();
+            used_.clear();
+            free_.clear();
+            hand_ = 0;
+            count_.store(0, std::memory_order_relaxed);
+            return erased;
+        }
+
+        // change the capacity, keeps as many of the existing entries as
+        // possible, returns the number of evicted entries
+        std::size_t reserve(std::size_t capacity)
+        {
+            std::vector<entry_pair> entries;
+            entries.reserve(index_.size());
+            for (auto const& p : index_)
+                entries.push_back(std::move(slots_[p.second]));
+
+            clear();
+
+            capacity_ = capacity;
+            referenced_.reset(new std::atomic<bool>[capacity_]);
+            for (std::size_t i = 0; i != capacity_; ++i)
+                referenced_[i].store(false, std::memory_order_relaxed);
+
+            slots_.reserve(capacity_);
+            used_.reserve(capacity_);
+
+            std::size_t count = (std::min)(capacity_, entries.size());
+            for (std::size_t i = 0; i != count; ++i)
+                insert_nonexist(entries[i].first, entries[i].second);
+
+            return entries.size() - count;
+        }
+
+        mutable rw_spinlock mtx_;
+
+        std::size_t capacity_;
+        std::size_t hand_;
+
+        std::map<key_type, std::size_t> index_;
+        std::vector<entry_pair> slots_;
+        std::vector<bool> used_;
+        std::vector<std::size_t> free_;
+        std::unique_ptr<std::atomic<bool>[]> referenced_;
+
+        // number of entries, allows lookups to skip empty shards
+        std::atomic<std::size_t> count_;
+
+        // keep the locks of neighboring shards on different cache lines
+        char cacheline_pad_[threads::get_cache_line_size()];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache(std::size_t num_shards)
+      : num_shards_(1)
+      , num_shards_log2_(0)
+    {
+        if (num_shards == 0)
+            num_shards = std::thread::hardware_concurrency();
+
+        num_shards = (std::min)(num_shards, max_num_shards);
+        while (num_shards_ < num_shards)
+        {
+            num_shards_ <<= 1;
+            ++num_shards_log2_;
+        }
+
+        // the regular shards are followed by the range shards and the
+        // spanning shard
+        shards_.reset(new shard[total_shards()]);
+    }
+
+    gva_cache::~gva_cache() = default;
+
+    void gva_cache::reserve(std::size_t max_size)
+    {
+        std::size_t const num_shards = total_shards();
+        std::size_t capacity = (std::max)(
+            (max_size + num_shards - 1) / num_shards, std::size_t(1));
+
+        for (std::size_t i = 0; i != num_shards; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<rw_spinlock> l(s.mtx_);
+
+            std::size_t evicted = s.reserve(capacity);
+            for (std::size_t j = 0; j != evicted; ++j)
+                statistics_.got_eviction();
+        }
+    }
+
+    std::size_t gva_cache::capacity() const
+    {
+        std::size_t capacity = 0;
+        for (std::size_t i = 0; i != total_shards(); ++i)
+        {
+            shared_lock l(shards_[i].mtx_);
+            capacity += shards_[i].capacity_;
+        }
+        return capacity;
+    }
+
+    std::size_t gva_cache::size() const
+    {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i != total_shards(); ++i)
+        {
+            shared_lock l(shards_[i].mtx_);
+            size += shards_[i].size();
+        }
+        return size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // Fibonacci hashing of the block number, the msb is mixed in to
+        // spread ids of different localities over different shards
+        std::size_t hash_block(std::uint64_t msb, std::uint64_t block,
+            std::size_t num_shards_log2)
+        {
+            if (num_shards_log2 == 0)
+                return 0;
+
+            block ^= msb * 0x9e3779b97f4a7c15ull;
+            return static_cast<std::size_t>(
+                (block * 0x9e3779b97f4a7c15ull) >> (64 - num_shards_log2));
+        }
+
+        // mark the shards the given blocks map to, returns false if all
+        // shards have to be considered
+        bool mark_blocks(naming::gid_type const& first,
+            naming::gid_type const& last, std::size_t block_bits,
+            std::size_t num_shards, std::size_t num_shards_log2,
+            bool* visited)
+        {
+            std::uint64_t const first_block = first.get_lsb() >> block_bits;
+            std::uint64_t const last_block = last.get_lsb() >> block_bits;
+
+            if (first.get_msb() != last.get_msb() ||
+                last_block - first_block >= num_shards)
+            {
+                return false;
+            }
+
+            for (std::uint64_t block = first_block; block <= last_block;
+                 ++block)
+            {
+                visited[hash_block(
+                    first.get_msb(), block, num_shards_log2)] = true;
+            }
+            return true;
+        }
+    }
+
+    std::size_t gva_cache::get_shard(naming::gid_type const& id) const
+    {
+        return hash_block(id.get_msb(), id.get_lsb() >> shard_block_bits,
+            num_shards_log2_);
+    }
+
+    std::size_t gva_cache::get_range_shard(naming::gid_type const& id) const
+    {
+        return num_shards_ +
+            hash_block(id.get_msb(), id.get_lsb() >> range_block_bits,
+                num_shards_log2_);
+    }
+
+    std::size_t gva_cache::get_shards(key_type const& key,
+        std::size_t* shards, std::size_t& target) const
+    {
+        naming::gid_type const first = key.get_gid();
+        naming::gid_type const& last = key.get_last_gid();
+
+        bool const same_msb = first.get_msb() == last.get_msb();
+        bool const single_block = same_msb &&
+            (first.get_lsb() >> shard_block_bits) ==
+                (last.get_lsb() >> shard_block_bits);
+        bool const single_range_block = same_msb &&
+            (first.get_lsb() >> range_block_bits) ==
+                (last.get_lsb() >> range_block_bits);
+
+        std::size_t const spanning = 2 * num_shards_;
+        std::size_t count = 0;
+
+        // fast path, the key lives in a single block
+        if (single_block)
+        {
+            target = get_shard(first);
+            shards[count++] = target;
+            shards[count++] = get_range_shard(first);
+            shards[count++] = spanning;
+            return count;
+        }
+
+        // the regular shards and the range shards the ids of the key map to,
+        // keys covering more blocks than there are shards may overlap with
+        // entries of any of them
+        for (std::size_t base : {std::size_t(0), num_shards_})
+        {
+            bool visited[max_num_shards] = {false};
+            bool const partial = mark_blocks(first, last,
+                base == 0 ? shard_block_bits : range_block_bits, num_shards_,
+                num_shards_log2_, visited);
+
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                if (!partial || visited[i])
+                    shards[count++] = base + i;
+            }
+        }
+        shards[count++] = spanning;
+
+        target = single_range_block ? get_range_shard(first) : spanning;
+        return count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::get_entry(
+        key_type const& key, key_type& realkey, entry_type& entry)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_get_entry);
+
+        bool found = false;
+        {
+            shard& s = shards_[get_shard(key.get_gid())];
+            shared_lock l(s.mtx_);
+            found = s.lookup(key, realkey, entry);
+        }
+
+        // the id might be covered by a range key, only shards holding any
+        // entries are locked
+        if (!found)
+        {
+            shard& r = shards_[get_range_shard(key.get_gid())];
+            if (!r.empty())
+            {
+                shared_lock l(r.mtx_);
+                found = r.lookup(key, realkey, entry);
+            }
+        }
+
+        if (!found)
+        {
+            shard& r = shards_[2 * num_shards_];
+            if (!r.empty())
+            {
+                shared_lock l(r.mtx_);
+                found = r.lookup(key, realkey, entry);
+            }
+        }
+
+        if (found)
+            statistics_.got_hit();
+        else
+            statistics_.got_miss();
+
+        return found;
+    }
+
+    bool gva_cache::insert(key_type const& key, entry_type const& entry)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_insert_entry);
+
+        std::size_t shards[2 * max_num_shards + 1];
+        std::size_t target = 0;
+        std::size_t const count = get_shards(key, shards, target);
+
+        // lock all affected shards in ascending order to make the operation
+        // atomic, only the shard receiving the entry is modified. Any
+        // concurrent operation on an overlapping key locks that shard as
+        // well.
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (shards[i] == target)
+                shards_[shards[i]].mtx_.lock();
+            else
+                shards_[shards[i]].mtx_.lock_shared();
+        }
+
+        bool exists = false;
+        for (std::size_t i = 0; i != count && !exists; ++i)
+        {
+            shard const& s = shards_[shards[i]];
+            exists = s.index_.find(key) != s.index_.end();
+        }
+
+        if (!exists)
+        {
+            statistics_.got_insertion();
+            if (shards_[target].insert_nonexist(key, entry))
+                statistics_.got_eviction();
+        }
+
+        for (std::size_t i = count; i != 0; --i)
+        {
+            if (shards[i - 1] == target)
+                shards_[shards[i - 1]].mtx_.unlock();
+            else
+                shards_[shards[i - 1]].mtx_.unlock_shared();
+        }
+
+        return !exists;
+    }
+
+    bool gva_cache::update_if(key_type const& key, entry_type const& entry,
+        collision_function_type const& f, key_type& collision)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_update_entry);
+
+        std::size_t shards[2 * max_num_shards + 1];
+        std::size_t target = 0;
+        std::size_t const count = get_shards(key, shards, target);
+
+        // Lock all affected shards in ascending order to make the operation
+        // atomic. The shard receiving a new entry is locked exclusively, as
+        // is the shard holding an existing entry which is to be updated in
+        // place. The latter is known only after looking for it, the shards
+        // are locked again if it turns out to be a different one.
+        std::size_t updated = target;
+        auto exclusive = [&](std::size_t i) {
+            return shards[i] == target || shards[i] == updated;
+        };
+
+        for (;;)
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                if (exclusive(i))
+                    shards_[shards[i]].mtx_.lock();
+                else
+                    shards_[shards[i]].mtx_.lock_shared();
+            }
+
+            // check for collisions in all shards before modifying the cache,
+            // an existing (overlapping) entry is updated in place if there
+            // is none
+            std::size_t found = count;
+            std::size_t slot = 0;
+            bool collided = false;
+            for (std::size_t i = 0; i != count && !collided; ++i)
+            {
+                shard& s = shards_[shards[i]];
+                auto it = s.index_.find(key);
+                if (it != s.index_.end())
+                {
+                    if (f(key, it->first))
+                    {
+                        collision = it->first;
+                        collided = true;
+                    }
+                    else
+                    {
+                        found = i;
+                        slot = it->second;
+                    }
+                }
+            }
+
+            bool const retry = !collided && found != count && !exclusive(found);
+            if (!collided && !retry)
+            {
+                if (found != count)
+                {
+                    statistics_.got_hit();
+
+                    shard& s = shards_[shards[found]];
+                    s.slots_[slot].second = entry;
+                    s.referenced_[slot].store(true, std::memory_order_relaxed);
+                }
+                else
+                {
+                    statistics_.got_miss();
+                    statistics_.got_insertion();
+
+                    if (shards_[target].insert_nonexist(key, entry))
+                        statistics_.got_eviction();
+                }
+            }
+
+            for (std::size_t i = count; i != 0; --i)
+            {
+                if (exclusive(i - 1))
+                    shards_[shards[i - 1]].mtx_.unlock();
+                else
+                    shards_[shards[i - 1]].mtx_.unlock_shared();
+            }
+
+            if (!retry)
+                return !collided;
+
+            updated = shards[found];
+        }
+    }
+
+    std::size_t gva_cache::erase(erase_function_type const& f)
+    {
+        statistics::update_on_exit update(
+            statistics_, statistics::method_erase_entry);
+
+        std::size_t erased = 0;
+        for (std::size_t i = 0; i != total_shards(); ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<rw_spinlock> l(s.mtx_);
+
+            for (auto it = s.index_.begin(); it != s.index_.end(); /**/)
+            {
+                if (f(s.slots_[it->second]))
+                {
+                    s.remove(it++);
+                    statistics_.got_eviction();
+                    ++erased;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        return erased;
+    }
+
+    std::size_t gva_cache::clear()
+    {
+        std::size_t erased = 0;
+        for (std::size_t i = 0; i != total_shards(); ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<rw_spinlock> l(s.mtx_);
+            erased += s.clear();
+        }
+        return erased;
+    }
+}}}
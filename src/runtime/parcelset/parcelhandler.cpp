@@ -986,6 +986,28 @@ namespace hpx { namespace parcelset
         return pp ? pp->get_connection_cache_statistics(stat_type, reset) : 0;
     }
 
+    // receive buffer pool statistics
+    std::int64_t parcelhandler::get_receive_buffer_pool_statistics(
+        std::string const& pp_type,
+        parcelport::receive_buffer_pool_statistics_type stat_type,
+        bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_receive_buffer_pool_statistics(stat_type, reset) : 0;
+    }
+
+    // send buffer pool statistics
+    std::int64_t parcelhandler::get_send_buffer_pool_statistics(
+        std::string const& pp_type,
+        parcelport::send_buffer_pool_statistics_type stat_type,
+        bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_send_buffer_pool_statistics(stat_type, reset) : 0;
+    }
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     // same as above, just separated data for each action
     // number of parcels sent
@@ -1053,6 +1075,8 @@ namespace hpx { namespace parcelset
         {
             register_counter_types(pp.second->type());
             register_connection_cache_counter_types(pp.second->type());
+            register_receive_buffer_pool_counter_types(pp.second->type());
+            register_send_buffer_pool_counter_types(pp.second->type());
         }
 
         using util::placeholders::_1;
@@ -1526,6 +1550,132 @@ namespace hpx { namespace parcelset
 #endif
     }
 
+    // register connection specific performance counters related to the pool
+    // of receive buffers
+    void parcelhandler::register_receive_buffer_pool_counter_types(
+        std::string const& pp_type)
+    {
+#if defined(HPX_HAVE_NETWORKING)
+        if (!is_networking_enabled_)
+            return;
+
+        using hpx::util::placeholders::_1;
+        using hpx::util::placeholders::_2;
+
+        util::function_nonser<std::int64_t(bool)> pool_hits(
+            util::bind_front(&parcelhandler::get_receive_buffer_pool_statistics,
+                this, pp_type, parcelport::receive_buffer_pool_hits));
+        util::function_nonser<std::int64_t(bool)> pool_misses(
+            util::bind_front(&parcelhandler::get_receive_buffer_pool_statistics,
+                this, pp_type, parcelport::receive_buffer_pool_misses));
+
+        performance_counters::generic_counter_type_data const
+            receive_buffer_pool_types[] =
+        {
+            { hpx::util::format(
+                  "/parcelport/count/{}/receive-buffer-pool-hits", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of receive buffers which were reused "
+                  "from the receive buffer pool for the {} connection type on "
+                  "the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_hits), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/{}/receive-buffer-pool-misses", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of receive buffers which had to be "
+                  "newly allocated by the receive buffer pool for the {} "
+                  "connection type on the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_misses), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(receive_buffer_pool_types,
+            sizeof(receive_buffer_pool_types) /
+                sizeof(receive_buffer_pool_types[0]));
+#endif
+    }
+
+    // register connection specific performance counters related to the pool
+    // of send buffers
+    void parcelhandler::register_send_buffer_pool_counter_types(
+        std::string const& pp_type)
+    {
+#if defined(HPX_HAVE_NETWORKING)
+        if (!is_networking_enabled_)
+            return;
+
+        using hpx::util::placeholders::_1;
+        using hpx::util::placeholders::_2;
+
+        util::function_nonser<std::int64_t(bool)> pool_hits(
+            util::bind_front(&parcelhandler::get_send_buffer_pool_statistics,
+                this, pp_type, parcelport::send_buffer_pool_hits));
+        util::function_nonser<std::int64_t(bool)> pool_misses(
+            util::bind_front(&parcelhandler::get_send_buffer_pool_statistics,
+                this, pp_type, parcelport::send_buffer_pool_misses));
+        util::function_nonser<std::int64_t(bool)> pool_occupancy(
+            util::bind_front(&parcelhandler::get_send_buffer_pool_statistics,
+                this, pp_type, parcelport::send_buffer_pool_occupancy));
+
+        performance_counters::generic_counter_type_data const
+            send_buffer_pool_types[] =
+        {
+            { hpx::util::format(
+                  "/parcelport/count/{}/send-buffer-pool-hits", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of send buffers which were reused "
+                  "from the send buffer pool for the {} connection type on "
+                  "the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_hits), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/{}/send-buffer-pool-misses", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of send buffers which had to be "
+                  "newly allocated by the send buffer pool for the {} "
+                  "connection type on the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_misses), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/{}/send-buffer-pool-occupancy", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of bytes currently held by the send "
+                  "buffer pool for the {} connection type on the referenced "
+                  "locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_occupancy), _2),
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
+            }
+        };
+        performance_counters::install_counter_types(send_buffer_pool_types,
+            sizeof(send_buffer_pool_types) /
+                sizeof(send_buffer_pool_types[0]));
+#endif
+    }
+
     std::vector<plugins::parcelport_factory_base *> &
     parcelhandler::get_parcelport_factories()
     {
@@ -1600,7 +1750,12 @@ namespace hpx { namespace parcelset
             "array_optimization = ${HPX_PARCEL_ARRAY_OPTIMIZATION:1}",
             "zero_copy_optimization = ${HPX_PARCEL_ZERO_COPY_OPTIMIZATION:"
                 "$[hpx.parcel.array_optimization]}",
+            "integer_compression = ${HPX_PARCEL_INTEGER_COMPRESSION:0}",
+            "zero_copy_serialization_threshold = "
+                "${HPX_PARCEL_ZERO_COPY_SERIALIZATION_THRESHOLD:"
+                HPX_PP_STRINGIZE(HPX_ZERO_COPY_SERIALIZATION_THRESHOLD) "}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "priority_message_size = ${HPX_PARCEL_PRIORITY_MESSAGE_SIZE:1024}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
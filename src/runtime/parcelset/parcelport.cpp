@@ -12,6 +12,7 @@
 #include <hpx/state.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/runtime/applier/applier.hpp>
+#include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/util/get_entry_as.hpp>
@@ -39,8 +40,13 @@ namespace hpx { namespace parcelset
         here_(here),
         max_inbound_message_size_(ini.get_max_inbound_message_size()),
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
+        priority_message_size_(hpx::util::get_entry_as<std::size_t>(ini,
+            "hpx.parcel.priority_message_size", 1024)),
         allow_array_optimizations_(true),
         allow_zero_copy_optimizations_(true),
+        allow_integer_compression_(false),
+        zero_copy_serialization_threshold_(
+            HPX_ZERO_COPY_SERIALIZATION_THRESHOLD),
         async_serialization_(false),
         priority_(hpx::util::get_entry_as<int>(ini,
             "hpx.parcel." + type + ".priority", 0)),
@@ -64,6 +70,17 @@ namespace hpx { namespace parcelset
             }
         }
 
+        if (hpx::util::get_entry_as<int>(
+                ini, key + ".integer_compression", 0) != 0)
+        {
+            allow_integer_compression_ = true;
+        }
+
+        zero_copy_serialization_threshold_ =
+            hpx::util::get_entry_as<std::size_t>(ini,
+                key + ".zero_copy_serialization_threshold",
+                HPX_ZERO_COPY_SERIALIZATION_THRESHOLD);
+
         if (hpx::util::get_entry_as<int>(
                 ini, key + ".async_serialization", 0) != 0)
         {
@@ -71,6 +88,30 @@ namespace hpx { namespace parcelset
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t parcelport::get_send_buffer_pool_statistics(
+        send_buffer_pool_statistics_type t, bool reset)
+    {
+        switch (t) {
+            case send_buffer_pool_hits:
+                return send_buffer_pool_.get_hits(reset);
+
+            case send_buffer_pool_misses:
+                return send_buffer_pool_.get_misses(reset);
+
+            case send_buffer_pool_occupancy:
+                return send_buffer_pool_.get_occupancy();
+
+            default:
+                break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "parcelport::get_send_buffer_pool_statistics",
+            "invalid send buffer pool statistics type");
+        return 0;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Update performance counter data
     void parcelport::add_received_data(
@@ -192,14 +233,58 @@ namespace hpx { namespace parcelset
         std::int64_t count = 0;
         for (auto && p : pending_parcels_)
         {
-            count += hpx::util::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second).size() ==
-                hpx::util::get<1>(p.second).size());
+            for (pending_parcels_lane const& lane : p.second)
+            {
+                count += hpx::util::get<0>(lane).size();
+                HPX_ASSERT(hpx::util::get<0>(lane).size() ==
+                    hpx::util::get<1>(lane).size());
+            }
         }
         return count;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Parcels invoking high priority actions, parcels targeting AGAS or
+    // barriers, and small (control) messages are sent through the high
+    // priority lane. This way they don't get stuck behind large messages
+    // which are already queued for the same destination.
+    parcelport::parcel_lane parcelport::get_parcel_lane(parcel const& p) const
+    {
+        if (p.size() <= priority_message_size_)
+            return parcel_lane_high_priority;
+
+        switch (p.get_thread_priority())
+        {
+        case threads::thread_priority_high_recursive:
+        case threads::thread_priority_boost:
+        case threads::thread_priority_high:
+            return parcel_lane_high_priority;
+
+        default:
+            break;
+        }
+
+        switch (components::get_base_type(p.addr().type_))
+        {
+        case components::component_agas_locality_namespace:
+        case components::component_agas_primary_namespace:
+        case components::component_agas_component_namespace:
+        case components::component_agas_symbol_namespace:
+            return parcel_lane_high_priority;
+
+        default:
+            break;
+        }
+
+        if (p.addr().type_ == components::component_barrier ||
+            p.addr().type_ == components::component_flex_barrier)
+        {
+            return parcel_lane_high_priority;
+        }
+
+        return parcel_lane_normal_priority;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     // same as above, just separated data for each action
@@ -52,6 +52,12 @@ namespace hpx { namespace threads { namespace detail
     {
     }
 
+    void io_service_thread_pool::create_threads(thread_init_data* data,
+        std::size_t count, thread_state_enum initial_state, bool run_now,
+        error_code& ec)
+    {
+    }
+
     threads::thread_state io_service_thread_pool::set_state(
         thread_id_type const& id, thread_state_enum new_state,
         thread_state_ex_enum new_state_ex, thread_priority priority,
@@ -14,6 +14,11 @@
 template class HPX_EXPORT hpx::threads::policies::local_queue_scheduler<>;
 template class HPX_EXPORT hpx::threads::detail::scheduled_thread_pool<
     hpx::threads::policies::local_queue_scheduler<>>;
+
+#include <hpx/runtime/threads/policies/local_workstealing_scheduler.hpp>
+template class HPX_EXPORT hpx::threads::policies::local_workstealing_scheduler<>;
+template class HPX_EXPORT hpx::threads::detail::scheduled_thread_pool<
+    hpx::threads::policies::local_workstealing_scheduler<>>;
 #endif
 
 #if defined(HPX_HAVE_STATIC_SCHEDULER)
@@ -6,7 +6,9 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assertion.hpp>
+#include <hpx/errors.hpp>
 #include <hpx/resource_partitioner/detail/partitioner.hpp>
+#include <hpx/runtime/threads/detail/thread_num_tss.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -31,12 +33,51 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF) && defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF) && defined(__linux__)
+    namespace detail
+    {
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(int),
+            "futex words have to be 32 bit wide");
+
+        // block the calling OS thread as long as the given word holds the
+        // expected value, at most for the given time
+        void futex_wait(std::atomic<std::uint32_t>& word,
+            std::uint32_t expected, std::chrono::milliseconds period)
+        {
+            timespec timeout;
+            timeout.tv_sec = static_cast<std::time_t>(period.count() / 1000);
+            timeout.tv_nsec = static_cast<long>(period.count() % 1000) *
+                1000000L;
+
+            ::syscall(SYS_futex, reinterpret_cast<int*>(&word),
+                FUTEX_WAIT_PRIVATE, static_cast<int>(expected), &timeout,
+                nullptr, 0);
+        }
+
+        // wake up the OS thread waiting on the given word, if any
+        void futex_wake(std::atomic<std::uint32_t>& word)
+        {
+            ::syscall(SYS_futex, reinterpret_cast<int*>(&word),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+#endif
+
     scheduler_base::scheduler_base(std::size_t num_threads,
         char const* description, thread_queue_init_parameters thread_queue_init,
         scheduler_mode mode)
@@ -53,13 +94,18 @@ namespace hpx { namespace threads { namespace policies
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         double max_time = thread_queue_init.max_idle_backoff_time_;
+        std::int64_t max_yield_count = thread_queue_init.max_idle_yield_count_;
 
-        wait_counts_.resize(num_threads);
+        wait_counts_ =
+            std::vector<util::cache_line_data<idle_backoff_data>>(num_threads);
         for (auto && data : wait_counts_)
         {
             data.data_.wait_count_ = 0;
             data.data_.max_idle_backoff_time_ = max_time;
+            data.data_.max_idle_yield_count_ = max_yield_count;
         }
+        num_parked_.data_.store(0);
+        next_parked_.data_.store(0);
 #endif
 
         for (std::size_t i = 0; i != num_threads; ++i)
@@ -72,26 +118,67 @@ namespace hpx { namespace threads { namespace policies
         if (mode_.data_.load(std::memory_order_relaxed) &
                 policies::enable_idle_backoff)
         {
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
+            // The scheduling loop has been spinning without finding work for
+            // max_idle_loop_count iterations. Yield to other OS threads for
+            // a while before putting this thread to sleep.
 
             idle_backoff_data& data = wait_counts_[num_thread].data_;
 
-            // Exponential back-off with a maximum sleep time.
+            for (std::int64_t i = 0; i != data.max_idle_yield_count_; ++i)
+            {
+                std::this_thread::yield();
+                if (get_queue_length(num_thread) != 0)
+                {
+                    data.wait_count_ = 0;
+                    return;
+                }
+            }
+
+            if (data.domain_.load(std::memory_order_relaxed) ==
+                std::size_t(-1))
+            {
+                data.domain_.store(domain_from_local_thread_index(num_thread),
+                    std::memory_order_relaxed);
+            }
+
+            // Put this thread to sleep for some time, additionally it gets
+            // woken up on new work. Exponential back-off with a maximum
+            // sleep time.
             double exponent = (std::min)(double(data.wait_count_),
                 double(std::numeric_limits<double>::max_exponent - 1));
 
             std::chrono::milliseconds period(std::lround((std::min)(
                 data.max_idle_backoff_time_, std::pow(2.0, exponent))));
 
-            ++data.wait_count_;
+            // Announce that this thread is about to be parked before checking
+            // the queue for the last time, any work scheduled after this
+            // point will wake us up.
+            data.parked_.store(1);
+            ++num_parked_.data_;
 
-            std::unique_lock<pu_mutex_type> l(mtx_);
-            if (cond_.wait_for(l, period) == std::cv_status::no_timeout)
+            if (get_queue_length(num_thread) == 0)
+            {
+#if defined(__linux__)
+                detail::futex_wait(data.parked_, 1, period);
+#else
+                std::unique_lock<pu_mutex_type> l(mtx_);
+                cond_.wait_for(
+                    l, period, [&]() { return data.parked_.load() == 0; });
+#endif
+            }
+
+            bool woken_up = data.parked_.exchange(0) == 0;
+            --num_parked_.data_;
+
+            if (woken_up)
             {
                 // reset counter if thread was woken up
                 data.wait_count_ = 0;
             }
+            else
+            {
+                ++data.wait_count_;
+            }
         }
 #else
         (void)num_thread;
@@ -101,12 +188,134 @@ namespace hpx { namespace threads { namespace policies
     /// This function gets called by the thread-manager whenever new work
     /// has been added, allowing the scheduler to reactivate one or more of
     /// possibly idling OS threads
-    void scheduler_base::do_some_work(std::size_t)
+    void scheduler_base::do_some_work(std::size_t num_thread)
     {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        // make sure the new work is visible to any thread which announces
+        // to be parked after this point
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (num_parked_.data_.load(std::memory_order_relaxed) == 0)
+            return;
+
+        std::size_t const num_threads = wait_counts_.size();
+
+        // without a hint wake up exactly one parked thread, it will steal
+        // the work if necessary. A thread in the NUMA domain of the
+        // producing worker (if any) is preferred.
+        if (num_thread == std::size_t(-1))
+        {
+            std::size_t domain = std::size_t(-1);
+            std::size_t self = threads::detail::get_thread_num_tss();
+            if (self != std::size_t(-1) && parent_pool_ != nullptr)
+            {
+                self = global_to_local_thread_index(self);
+                if (self < num_threads)
+                {
+                    domain = wait_counts_[self].data_.domain_.load(
+                        std::memory_order_relaxed);
+                }
+            }
+
+            if (domain == std::size_t(-1) ||
+                !wake_parked_in_domain(domain, std::size_t(-1)))
+            {
+                wake_up_parked(1);
+            }
+            return;
+        }
+
+        // wake up the thread the work was scheduled on, or one parked
+        // thread in the same NUMA domain which can steal the work
+        num_thread %= num_threads;
+        if (wake_parked(num_thread))
+            return;
+
+        std::size_t domain = wait_counts_[num_thread].data_.domain_.load(
+            std::memory_order_relaxed);
+        if (domain != std::size_t(-1))
+            wake_parked_in_domain(domain, num_thread);
+#else
+        (void)num_thread;
+#endif
+    }
+
+    /// Wake up at most the given number of parked OS threads, all of them
+    /// if count is std::size_t(-1).
+    void scheduler_base::wake_up_parked(std::size_t count)
+    {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::size_t const num_threads = wait_counts_.size();
+        std::size_t const first = next_parked_index();
+        for (std::size_t i = 0; i != num_threads && count != 0; ++i)
+        {
+            if (num_parked_.data_.load(std::memory_order_relaxed) == 0)
+                return;
+
+            if (wake_parked((first + i) % num_threads))
+                --count;
+        }
+#else
+        (void)count;
+#endif
+    }
+
+    std::size_t scheduler_base::get_num_parked() const
+    {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        return num_parked_.data_.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    std::size_t scheduler_base::next_parked_index()
+    {
+        return next_parked_.data_.fetch_add(1, std::memory_order_relaxed) %
+            wait_counts_.size();
+    }
+
+    bool scheduler_base::wake_parked(std::size_t num_thread)
+    {
+        idle_backoff_data& data = wait_counts_[num_thread].data_;
+        if (data.parked_.load(std::memory_order_relaxed) == 0 ||
+            data.parked_.exchange(0) == 0)
+        {
+            return false;
+        }
+
+#if defined(__linux__)
+        detail::futex_wake(data.parked_);
+#else
+        std::lock_guard<pu_mutex_type> l(mtx_);
         cond_.notify_all();
 #endif
+        return true;
+    }
+
+    /// Wake up one parked OS thread (other than skip) in the given NUMA
+    /// domain, returns whether one was found.
+    bool scheduler_base::wake_parked_in_domain(
+        std::size_t domain, std::size_t skip)
+    {
+        std::size_t const num_threads = wait_counts_.size();
+        std::size_t const first = next_parked_index();
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            std::size_t const num_thread = (first + i) % num_threads;
+            if (num_thread != skip &&
+                wait_counts_[num_thread].data_.domain_.load(
+                    std::memory_order_relaxed) == domain &&
+                wake_parked(num_thread))
+            {
+                return true;
+            }
+        }
+        return false;
     }
+#endif
 
     void scheduler_base::suspend(std::size_t num_thread)
     {
@@ -307,12 +516,25 @@ namespace hpx { namespace threads { namespace policies
         return result;
     }
 
+    ///////////////////////////////////////////////////////////////////////
+    void scheduler_base::create_threads(thread_init_data* data,
+        std::size_t count, thread_state_enum initial_state, bool run_now,
+        error_code& ec)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            create_thread(data[i], nullptr, initial_state, run_now, ec);
+            if (ec)
+                return;
+        }
+    }
+
     // get/set scheduler mode
     void scheduler_base::set_scheduler_mode(scheduler_mode mode)
     {
         // distribute the same value across all cores
         mode_.data_.store(mode, std::memory_order_release);
-        do_some_work(std::size_t(-1));
+        wake_up_parked(std::size_t(-1));
     }
 
     void scheduler_base::add_scheduler_mode(scheduler_mode mode)
@@ -5,14 +5,14 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_slab_allocator.hpp>
 #include <hpx/logging.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads {
 
-    util::internal_allocator<thread_data_stackless>
+    util::thread_local_slab_allocator<thread_data_stackless>
         thread_data_stackless::thread_alloc_;
 
     thread_data_stackless::~thread_data_stackless()
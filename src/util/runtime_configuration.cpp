@@ -80,6 +80,14 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         // this global (urghhh) variable is used to control whether guard pages
         // will be used or not
         HPX_EXPORT bool use_guard_pages = true;
+
+        // this global variable controls whether thread stacks are allocated
+        // from per-OS-thread stack pools
+        HPX_EXPORT bool use_stack_pool = true;
+
+        // this global variable controls whether coroutines hand back their
+        // stack to the executing OS thread once they have run to completion
+        HPX_EXPORT bool use_adaptive_stacks = false;
     }
 }}}}
 #endif
@@ -206,6 +214,9 @@ namespace hpx { namespace util
             "max_idle_backoff_time = "
             "${HPX_MAX_IDLE_BACKOFF_TIME:" HPX_PP_STRINGIZE(
                 HPX_PP_EXPAND(HPX_IDLE_BACKOFF_TIME_MAX)) "}",
+            "max_idle_yield_count = "
+            "${HPX_MAX_IDLE_YIELD_COUNT:" HPX_PP_STRINGIZE(
+                HPX_PP_EXPAND(HPX_IDLE_YIELD_COUNT_MAX)) "}",
 #endif
             "default_scheduler_mode = ${HPX_DEFAULT_SCHEDULER_MODE}",
 
@@ -221,6 +232,11 @@ namespace hpx { namespace util
             "[hpx.lcos.collectives]",
             "arity = ${HPX_LCOS_COLLECTIVES_ARITY:32}",
             "cut_off = ${HPX_LCOS_COLLECTIVES_CUT_OFF:-1}",
+            // number of sites from which on the data collectives use tree
+            // based algorithms, values of trivially copyable types of up to
+            // small_data_size bytes are exchanged using recursive doubling
+            "data_cut_off = ${HPX_LCOS_COLLECTIVES_DATA_CUT_OFF:16}",
+            "small_data_size = ${HPX_LCOS_COLLECTIVES_SMALL_DATA_SIZE:256}",
 
             // connect back to the given latch if specified
             "[hpx.on_startup]",
@@ -243,6 +259,8 @@ namespace hpx { namespace util
                 HPX_PP_EXPAND(HPX_HUGE_STACK_SIZE)) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "use_stack_pool = ${HPX_USE_STACK_POOL:1}",
+            "adaptive = ${HPX_ADAPTIVE_STACKS:0}",
 #endif
 
             "[hpx.threadpools]",
@@ -597,6 +615,10 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::use_adaptive_stacks =
+            init_use_adaptive_stacks();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -658,6 +680,10 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::use_stack_pool =
+            init_use_stack_pool();
+        threads::coroutines::detail::posix::use_adaptive_stacks =
+            init_use_adaptive_stacks();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -1078,6 +1104,30 @@ namespace hpx { namespace util
         }
         return true;    // default is true
     }
+
+    bool runtime_configuration::init_use_stack_pool() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "use_stack_pool", 1) != 0;
+            }
+        }
+        return true;    // default is true
+    }
+
+    bool runtime_configuration::init_use_adaptive_stacks() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "adaptive", 0) != 0;
+            }
+        }
+        return false;    // default is false
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
@@ -14,7 +14,9 @@
 
 #include <hpx/cache/entries/lfu_entry.hpp>
 #include <hpx/cache/local_cache.hpp>
+#include <hpx/cache/lru_cache.hpp>
 #include <hpx/cache/statistics/local_full_statistics.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/preprocessor/stringize.hpp>
 #include <hpx/statistics/histogram.hpp>
 #include <hpx/testing.hpp>
@@ -27,6 +29,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -228,6 +231,101 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Concurrent lookups, comparing the global mutex protecting an lru_cache (as
+// used by AGAS before) with the sharded GVA cache used by AGAS now
+typedef hpx::util::cache::lru_cache<gva_cache_key, hpx::agas::gva,
+    hpx::util::cache::statistics::local_full_statistics>
+    locked_gva_cache_type;
+
+struct locked_gva_cache
+{
+    explicit locked_gva_cache(std::size_t cache_size)
+    {
+        cache_.reserve(cache_size);
+    }
+
+    void insert(hpx::naming::gid_type const& id, hpx::agas::gva const& g)
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        cache_.insert(gva_cache_key(id, 1), g);
+    }
+
+    bool get_entry(hpx::naming::gid_type const& id, hpx::agas::gva& g)
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        return cache_.get_entry(gva_cache_key(id, 1), g);
+    }
+
+    hpx::lcos::local::spinlock mtx_;
+    locked_gva_cache_type cache_;
+};
+
+struct sharded_gva_cache
+{
+    explicit sharded_gva_cache(std::size_t cache_size)
+    {
+        cache_.reserve(cache_size);
+    }
+
+    void insert(hpx::naming::gid_type const& id, hpx::agas::gva const& g)
+    {
+        cache_.insert(hpx::agas::detail::gva_cache_key(id, 1), g);
+    }
+
+    bool get_entry(hpx::naming::gid_type const& id, hpx::agas::gva& g)
+    {
+        return cache_.get_entry(hpx::agas::detail::gva_cache_key(id, 1), g);
+    }
+
+    hpx::agas::detail::gva_cache cache_;
+};
+
+template <typename Cache>
+double test_concurrent_get(char const* name, std::size_t cache_size,
+    std::size_t num_entries, std::size_t num_lookups)
+{
+    Cache cache(cache_size);
+
+    hpx::naming::gid_type locality = hpx::get_locality();
+    std::uint32_t ct = hpx::components::component_invalid;
+
+    std::vector<hpx::naming::gid_type> ids;
+    ids.reserve(num_entries);
+    for (std::size_t i = 0; i != num_entries; ++i)
+    {
+        ids.push_back(hpx::detail::get_next_id());
+        cache.insert(ids.back(), hpx::agas::gva(locality, ct, 1, std::uint64_t(i), 0));
+    }
+
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void>> threads;
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        threads.push_back(hpx::async([&, i]() {
+            hpx::agas::gva g;
+            std::size_t index = i * (num_entries / num_threads);
+            for (std::size_t j = 0; j != num_lookups; ++j)
+            {
+                cache.get_entry(ids[index], g);
+                if (++index == num_entries)
+                    index = 0;
+            }
+        }));
+    }
+    hpx::wait_all(threads);
+
+    double elapsed = t.elapsed();
+    std::cout << name << " (" << num_threads << " threads): "
+              << (elapsed * 1e9) / double(num_lookups) << " [ns/lookup]"
+              << std::endl;
+    return elapsed;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(hpx::program_options::variables_map& vm)
 {
@@ -253,6 +351,20 @@ int hpx_main(hpx::program_options::variables_map& vm)
     double elapsed = t1.elapsed();
     hpx::util::print_cdash_timing("AGASCache", elapsed);
 
+    std::size_t num_lookups = 100000;
+    if (vm.count("num_lookups"))
+        num_lookups = vm["num_lookups"].as<std::size_t>();
+
+    num_entries = (std::min)(num_entries, cache_size);
+
+    double locked = test_concurrent_get<locked_gva_cache>(
+        "  locked get", cache_size, num_entries, num_lookups);
+    double sharded = test_concurrent_get<sharded_gva_cache>(
+        " sharded get", cache_size, num_entries, num_lookups);
+
+    hpx::util::print_cdash_timing("AGASCacheLockedGet", locked);
+    hpx::util::print_cdash_timing("AGASCacheShardedGet", sharded);
+
     return hpx::finalize();
 }
 
@@ -268,6 +380,8 @@ int main(int argc, char* argv[])
          HPX_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("num_lookups", value<std::size_t>(),
+         "number of concurrent lookups per worker thread (default: 100000)")
         ;
 
     // Initialize and run HPX
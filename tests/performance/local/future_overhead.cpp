@@ -6,6 +6,7 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/format.hpp>
 #include <hpx/hpx_init.hpp>
 #include <hpx/include/apply.hpp>
@@ -205,6 +206,37 @@ void measure_function_futures_wait_all(
     print_stats("async", "WaitAll", ExecName(exec), count, duration, csv);
 }
 
+// Attach a chain of continuations to a future, each of which is run
+// synchronously. The number of shared states which could not be served from
+// the thread local cache is reported along with the timing.
+void measure_function_futures_then_chain(std::uint64_t count, bool csv)
+{
+    typedef hpx::util::thread_local_caching_allocator<> allocator_type;
+
+    // start the clock
+    std::int64_t const allocations = allocator_type::get_upstream_allocations();
+    high_resolution_timer walltime;
+
+    future<double> f = hpx::make_ready_future(0.0);
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        f = f.then(hpx::launch::sync,
+            [](future<double>&& f) { return f.get() + 1.0; });
+    }
+    HPX_TEST_EQ(f.get(), double(count));
+
+    const double duration = walltime.elapsed();
+    print_stats("then", "Chain", "none", count, duration, csv);
+
+    std::int64_t const upstream =
+        allocator_type::get_upstream_allocations() - allocations;
+    if (!csv)
+    {
+        std::cout << "upstream allocations " << upstream << " : "
+                  << double(upstream) / count << " per future" << std::endl;
+    }
+}
+
 template <typename Executor>
 void measure_function_futures_thread_count(
     std::uint64_t count, bool csv, Executor& exec)
@@ -558,6 +590,7 @@ int hpx_main(variables_map& vm)
                 measure_function_futures_wait_each(count, csv, par);
                 measure_function_futures_wait_all(count, csv, def);
                 measure_function_futures_wait_all(count, csv, par);
+                measure_function_futures_then_chain(count, csv);
                 measure_function_futures_thread_count(count, csv, def);
                 measure_function_futures_thread_count(count, csv, par);
                 measure_function_futures_sliding_semaphore(count, csv, def);
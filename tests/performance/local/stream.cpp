@@ -28,11 +28,11 @@
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/threads.hpp>
 #include <hpx/include/compute.hpp>
-#include <hpx/type_support/unused.hpp>
 
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -273,14 +273,11 @@ struct triad_step
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-template <typename Allocator, typename Executor, typename Target, typename... Targets>
+template <typename Allocator, typename Policy>
 std::vector<std::vector<double> >
-run_benchmark(
-    std::size_t iterations, std::size_t size, Target target, Targets... targets)
+run_benchmark(std::size_t iterations, std::size_t size, Allocator const& alloc,
+    Policy policy)
 {
-    // Creating our allocator ...
-    Allocator alloc(target);
-
     // Allocate our data
     typedef hpx::compute::vector<STREAM_TYPE, Allocator> vector_type;
 
@@ -288,12 +285,6 @@ run_benchmark(
     vector_type b(size, alloc);
     vector_type c(size, alloc);
 
-    // Creating our executor ....
-    Executor exec(target, targets...);
-
-    // Creating the policy used in the parallel algorithms
-    auto policy = hpx::parallel::execution::par.on(exec);
-
     // Initialize arrays
     hpx::parallel::fill(policy, a.begin(), a.end(), 1.0);
     hpx::parallel::fill(policy, b.begin(), b.end(), 2.0);
@@ -386,6 +377,59 @@ run_benchmark(
     return timing;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void print_results(std::vector<std::vector<double> > const& timing,
+    std::size_t vector_size, std::size_t iterations, double time_total)
+{
+    /* --- SUMMARY --- */
+    const char *label[4] = {
+        "Copy:      ",
+        "Scale:     ",
+        "Add:       ",
+        "Triad:     "
+    };
+
+    const double bytes[4] = {
+        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size)
+    };
+
+    // Note: skip first iteration
+    std::vector<double> avgtime(4, 0.0);
+    std::vector<double> mintime(4, (std::numeric_limits<double>::max)());
+    std::vector<double> maxtime(4, 0.0);
+    for(std::size_t iteration = 1; iteration != iterations; ++iteration)
+    {
+        for (std::size_t j=0; j<4; j++)
+        {
+            avgtime[j] = avgtime[j] + timing[j][iteration];
+            mintime[j] = (std::min)(mintime[j], timing[j][iteration]);
+            maxtime[j] = (std::max)(maxtime[j], timing[j][iteration]);
+        }
+    }
+
+    printf("Function    Best Rate MB/s  Avg time     Min time     Max time\n");
+    for (std::size_t j=0; j<4; j++) {
+        avgtime[j] = avgtime[j]/(double)(iterations-1);
+
+        printf("%s%12.1f  %11.6f  %11.6f  %11.6f\n", label[j],
+           1.0E-06 * bytes[j]/mintime[j],
+           avgtime[j],
+           mintime[j],
+           maxtime[j]);
+    }
+
+    std::cout
+        << "\nTotal time: " << time_total
+        << " (per iteration: " << time_total/iterations << ")\n";
+
+    std::cout
+        << "-------------------------------------------------------------\n"
+        ;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(hpx::program_options::variables_map& vm)
 {
@@ -394,8 +438,6 @@ int hpx_main(hpx::program_options::variables_map& vm)
     std::size_t iterations = vm["iterations"].as<std::size_t>();
     std::size_t chunk_size = vm["chunk_size"].as<std::size_t>();
 
-    HPX_UNUSED(chunk_size);
-
     std::string chunker = vm["chunker"].as<std::string>();
 
     std::cout
@@ -423,9 +465,6 @@ int hpx_main(hpx::program_options::variables_map& vm)
         << "-------------------------------------------------------------\n"
         ;
 
-    double time_total = mysecond();
-    std::vector<std::vector<double> > timing;
-
 #if defined(HPX_HAVE_COMPUTE)
     bool use_accel = false;
     if(vm.count("use-accelerator"))
@@ -446,11 +485,17 @@ int hpx_main(hpx::program_options::variables_map& vm)
 #else
 #error "The STREAM benchmark currently requires CUDA to run on an accelerator"
 #endif
+        allocator_type alloc(target);
+        executor_type exec(target, std::move(host_targets));
+
         // perform benchmark
-        timing =
-            run_benchmark<allocator_type, executor_type>(
-                iterations, vector_size, std::move(target), std::move(host_targets));
-                //iterations, vector_size, std::move(target));
+        double time_total = mysecond();
+        std::vector<std::vector<double> > timing =
+            run_benchmark(iterations, vector_size, alloc,
+                hpx::parallel::execution::par.on(exec));
+        time_total = mysecond() - time_total;
+
+        print_results(timing, vector_size, iterations, time_total);
     }
     else
 #endif
@@ -461,60 +506,42 @@ int hpx_main(hpx::program_options::variables_map& vm)
         // Get the numa targets we want to run on
         auto numa_nodes = hpx::compute::host::numa_domains();
 
-        // perform benchmark
-        timing =
-            run_benchmark<allocator_type, executor_type>(
-                iterations, vector_size, numa_nodes);
-    }
-    time_total = mysecond() - time_total;
-
-    /* --- SUMMARY --- */
-    const char *label[4] = {
-        "Copy:      ",
-        "Scale:     ",
-        "Add:       ",
-        "Triad:     "
-    };
+        // The block_allocator places the memory of the arrays onto the NUMA
+        // domains (first touch).
+        allocator_type alloc(numa_nodes);
+        executor_type exec(numa_nodes);
 
-    const double bytes[4] = {
-        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size)
-    };
+        // Run the benchmark twice, first with chunks which are processed on
+        // the NUMA domain which holds their memory, then with chunks which
+        // are distributed over all cores by the default executor.
+        std::cout
+            << "Placement aware chunking (block_executor, block_chunk_size) "
+               "on " << numa_nodes.size() << " NUMA domain(s)\n"
+            << "-------------------------------------------------------------\n"
+            ;
 
-    // Note: skip first iteration
-    std::vector<double> avgtime(4, 0.0);
-    std::vector<double> mintime(4, (std::numeric_limits<double>::max)());
-    std::vector<double> maxtime(4, 0.0);
-    for(std::size_t iteration = 1; iteration != iterations; ++iteration)
-    {
-        for (std::size_t j=0; j<4; j++)
-        {
-            avgtime[j] = avgtime[j] + timing[j][iteration];
-            mintime[j] = (std::min)(mintime[j], timing[j][iteration]);
-            maxtime[j] = (std::max)(maxtime[j], timing[j][iteration]);
-        }
-    }
+        double time_total = mysecond();
+        std::vector<std::vector<double> > timing =
+            run_benchmark(iterations, vector_size, alloc,
+                hpx::parallel::execution::par.on(exec).with(
+                    hpx::compute::host::block_chunk_size()));
+        time_total = mysecond() - time_total;
 
-    printf("Function    Best Rate MB/s  Avg time     Min time     Max time\n");
-    for (std::size_t j=0; j<4; j++) {
-        avgtime[j] = avgtime[j]/(double)(iterations-1);
+        print_results(timing, vector_size, iterations, time_total);
 
-        printf("%s%12.1f  %11.6f  %11.6f  %11.6f\n", label[j],
-           1.0E-06 * bytes[j]/mintime[j],
-           avgtime[j],
-           mintime[j],
-           maxtime[j]);
-    }
+        std::cout
+            << "Default chunking (parallel_executor, static_chunk_size)\n"
+            << "-------------------------------------------------------------\n"
+            ;
 
-    std::cout
-        << "\nTotal time: " << time_total
-        << " (per iteration: " << time_total/iterations << ")\n";
+        time_total = mysecond();
+        timing = run_benchmark(iterations, vector_size, alloc,
+            hpx::parallel::execution::par.with(
+                hpx::parallel::execution::static_chunk_size(chunk_size)));
+        time_total = mysecond() - time_total;
 
-    std::cout
-        << "-------------------------------------------------------------\n"
-        ;
+        print_results(timing, vector_size, iterations, time_total);
+    }
 
     return hpx::finalize();
 }
@@ -541,7 +568,8 @@ int main(int argc, char* argv[])
             "possible values: dynamic, auto, guided. (default: default)")
         (   "chunk_size",
              hpx::program_options::value<std::size_t>()->default_value(0),
-            "size of vector (default: 1024)")
+            "chunk size used for the default chunking "
+            "(default: 0, determined from the number of cores)")
 
 #if defined(HPX_HAVE_COMPUTE)
         (   "use-accelerator",
@@ -4,6 +4,7 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/format.hpp>
 #include <hpx/hpx_init.hpp>
 #include <hpx/include/iostreams.hpp>
@@ -39,9 +40,18 @@ create_tasks(std::size_t num_tasks, std::size_t delay)
     return tasks;
 }
 
+// number of shared states allocated from the system so far
+std::int64_t get_allocations()
+{
+    return hpx::util::thread_local_caching_allocator<>::
+        get_upstream_allocations();
+}
+
 double wait_tasks(std::size_t num_samples, std::size_t num_tasks,
-    std::size_t num_chunks, std::size_t delay)
+    std::size_t num_chunks, std::size_t delay, double& allocations)
 {
+    std::int64_t const allocations_start = get_allocations();
+
     std::size_t num_chunk_tasks = ((num_tasks + num_chunks) / num_chunks) - 1;
     std::size_t last_num_chunk_tasks = num_tasks - (num_chunks - 1) * num_chunk_tasks;
 
@@ -79,6 +89,8 @@ double wait_tasks(std::size_t num_samples, std::size_t num_tasks,
         result += t.elapsed();
     }
 
+    allocations =
+        double(get_allocations() - allocations_start) / num_samples;
     return result / num_samples;
 }
 
@@ -106,36 +118,45 @@ int hpx_main(hpx::program_options::variables_map& vm)
         num_chunks = 1;
 
     // wait for all of the tasks sequentially
-    double elapsed_seq = wait_tasks(num_samples, num_tasks, 1, delay);
+    double allocations_seq = 0;
+    double elapsed_seq =
+        wait_tasks(num_samples, num_tasks, 1, delay, allocations_seq);
 
     // wait of tasks in chunks
     double elapsed_chunks = 0;
+    double allocations_chunks = 0;
     if (num_chunks != 1)
-        elapsed_chunks = wait_tasks(num_samples, num_tasks, num_chunks, delay);
+    {
+        elapsed_chunks = wait_tasks(
+            num_samples, num_tasks, num_chunks, delay, allocations_chunks);
+    }
 
     if (header)
     {
         hpx::cout
-            << "Tasks,Chunks,Delay[s],Total Walltime[s],Walltime per Task[s]"
-             << hpx::endl;
+            << "Tasks,Chunks,Delay[s],Total Walltime[s],Walltime per Task[s],"
+               "Allocations per Task"
+            << hpx::endl;
     }
 
     std::string const tasks_str = hpx::util::format("{}", num_tasks);
     std::string const chunks_str = hpx::util::format("{}", num_chunks);
     std::string const delay_str = hpx::util::format("{}", delay);
 
-    hpx::util::format_to(hpx::cout, "{:10},{:10},{:10},{:10},{:10.12}\n",
-        tasks_str, std::string("1"), delay_str, elapsed_seq,
-        elapsed_seq / num_tasks)
+    hpx::util::format_to(hpx::cout,
+        "{:10},{:10},{:10},{:10},{:10.12},{:10.4}\n", tasks_str,
+        std::string("1"), delay_str, elapsed_seq, elapsed_seq / num_tasks,
+        allocations_seq / num_tasks)
         << hpx::endl;
     hpx::util::print_cdash_timing("WaitAll", elapsed_seq / num_tasks);
 
     if (num_chunks != 1)
     {
         hpx::util::format_to(hpx::cout,
-            "{:10},{:10},{:10},{:10},{:10.12},{:10.12}\n",
+            "{:10},{:10},{:10},{:10},{:10.12},{:10.4}\n",
             tasks_str, chunks_str, delay_str,
-            elapsed_chunks, elapsed_chunks / num_tasks) << hpx::endl;
+            elapsed_chunks, elapsed_chunks / num_tasks,
+            allocations_chunks / num_tasks) << hpx::endl;
         hpx::util::print_cdash_timing("WaitAllChunks", elapsed_chunks / num_tasks);
     }
     return hpx::finalize();
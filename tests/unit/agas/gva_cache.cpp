@@ -0,0 +1,251 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using hpx::agas::gva;
+using hpx::agas::detail::gva_cache;
+using hpx::naming::gid_type;
+
+typedef gva_cache::key_type key_type;
+
+// number of regular shards used by all tests below, ranges covering more
+// than that many blocks may overlap with entries of any of the shards
+std::size_t const num_shards = 4;
+std::uint64_t const block_size = std::uint64_t(1)
+    << gva_cache::shard_block_bits;
+std::uint64_t const range_block_size = std::uint64_t(1)
+    << gva_cache::range_block_bits;
+
+gva make_gva(std::uint64_t lva)
+{
+    return gva(gid_type(0, 1), 1, 1, lva);
+}
+
+bool check_for_collisions(key_type const& new_key, key_type const& old_key)
+{
+    return new_key.get_gid() != old_key.get_gid() ||
+        new_key.get_count() != old_key.get_count();
+}
+
+bool never_collides(key_type const&, key_type const&)
+{
+    return false;
+}
+
+// all ids of the given range resolve to the range key and its entry
+void test_range_found(gva_cache& cache, std::uint64_t first,
+    std::uint64_t count, std::uint64_t lva)
+{
+    for (std::uint64_t id = first; id != first + count; ++id)
+    {
+        key_type realkey;
+        gva entry;
+        HPX_TEST(cache.get_entry(key_type(gid_type(0, id)), realkey, entry));
+        HPX_TEST(realkey.get_gid() == gid_type(0, first));
+        HPX_TEST(realkey.get_last_gid() == gid_type(0, first + count - 1));
+        HPX_TEST_EQ(entry.lva(), lva);
+    }
+}
+
+void test_range_missing(
+    gva_cache& cache, std::uint64_t first, std::uint64_t count)
+{
+    for (std::uint64_t id = first; id != first + count; ++id)
+    {
+        gva entry;
+        HPX_TEST(!cache.get_entry(key_type(gid_type(0, id)), entry));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_range_keys()
+{
+    gva_cache cache(num_shards);
+    cache.reserve(1024);
+
+    // a range within a single block, one covering a few blocks, one
+    // covering more blocks than there are shards, and one crossing the
+    // boundary between two range blocks
+    std::uint64_t const small = 2 * block_size + 3;
+    std::uint64_t const medium = 8 * block_size + 5;
+    std::uint64_t const large = 32 * block_size + 7;
+    std::uint64_t const spanning = 3 * range_block_size - 5;
+
+    HPX_TEST(cache.insert(key_type(gid_type(0, small), 4), make_gva(1)));
+    HPX_TEST(cache.insert(
+        key_type(gid_type(0, medium), 3 * block_size), make_gva(2)));
+    HPX_TEST(cache.insert(
+        key_type(gid_type(0, large), 2 * num_shards * block_size),
+        make_gva(3)));
+    HPX_TEST(
+        cache.insert(key_type(gid_type(0, spanning), 10), make_gva(5)));
+
+    // every range is stored (and counted) once
+    HPX_TEST_EQ(cache.size(), std::size_t(4));
+
+    test_range_found(cache, small, 4, 1);
+    test_range_found(cache, medium, 3 * block_size, 2);
+    test_range_found(cache, large, 2 * num_shards * block_size, 3);
+    test_range_found(cache, spanning, 10, 5);
+
+    // overlapping keys can't be inserted
+    HPX_TEST(!cache.insert(key_type(gid_type(0, small + 1)), make_gva(4)));
+    HPX_TEST(!cache.insert(
+        key_type(gid_type(0, medium + block_size)), make_gva(4)));
+    HPX_TEST(!cache.insert(key_type(gid_type(0, large + 5 * block_size)),
+        make_gva(4)));
+    HPX_TEST(!cache.insert(
+        key_type(gid_type(0, 3 * range_block_size + 2)), make_gva(4)));
+    HPX_TEST(!cache.insert(
+        key_type(gid_type(0, spanning + 2), 20), make_gva(4)));
+    HPX_TEST_EQ(cache.size(), std::size_t(4));
+
+    // ranges are removed as a whole
+    std::size_t erased = cache.erase([](gva_cache::entry_pair const& p) {
+        return p.second.lva() == 3;
+    });
+    HPX_TEST_EQ(erased, std::size_t(1));
+    HPX_TEST_EQ(cache.size(), std::size_t(3));
+    test_range_missing(cache, large, 2 * num_shards * block_size);
+
+    erased = cache.erase([](gva_cache::entry_pair const& p) {
+        return p.second.lva() == 2;
+    });
+    HPX_TEST_EQ(erased, std::size_t(1));
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+    test_range_missing(cache, medium, 3 * block_size);
+
+    HPX_TEST_EQ(cache.clear(), std::size_t(2));
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+    test_range_missing(cache, small, 4);
+    test_range_missing(cache, spanning, 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_eviction()
+{
+    gva_cache cache(num_shards);
+
+    // one entry for each of the shards (including the range shards and the
+    // spanning shard)
+    cache.reserve(2 * num_shards + 1);
+    HPX_TEST_EQ(cache.capacity(), 2 * num_shards + 1);
+
+    // inserting ranges covering all shards (but a single range block)
+    // evicts the previous range from the cache as a whole
+    std::uint64_t const count = num_shards * block_size + 1;
+    for (std::uint64_t i = 0; i != 10; ++i)
+    {
+        std::uint64_t const first = (i + 1) * 100 * block_size;
+        HPX_TEST(cache.insert(key_type(gid_type(0, first), count),
+            make_gva(first)));
+
+        test_range_found(cache, first, count, first);
+        if (i != 0)
+        {
+            test_range_missing(cache, first - 100 * block_size, count);
+        }
+        HPX_TEST(cache.size() <= cache.capacity());
+    }
+    HPX_TEST_EQ(cache.get_statistics().evictions(true), std::size_t(9));
+
+    // single ids never exceed the capacity of the cache and all of the
+    // remaining entries can still be found
+    for (std::uint64_t id = 1; id != 1000; ++id)
+    {
+        HPX_TEST(cache.insert(key_type(gid_type(0, id)), make_gva(id)));
+        HPX_TEST(cache.size() <= cache.capacity());
+    }
+    HPX_TEST(cache.get_statistics().evictions(true) != 0);
+
+    std::size_t found = 0;
+    for (std::uint64_t id = 1; id != 1000; ++id)
+    {
+        gva entry;
+        if (cache.get_entry(key_type(gid_type(0, id)), entry))
+        {
+            HPX_TEST_EQ(entry.lva(), id);
+            ++found;
+        }
+    }
+    test_range_found(cache, 1000 * block_size, count, 1000 * block_size);
+    HPX_TEST_EQ(found + 1, cache.size());
+
+    // erasing all entries reports each of them once
+    HPX_TEST_EQ(
+        cache.erase([](gva_cache::entry_pair const&) { return true; }),
+        found + 1);
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_update_if()
+{
+    gva_cache cache(num_shards);
+    cache.reserve(1024);
+
+    std::uint64_t const first = 10 * block_size + 1;
+    std::uint64_t const count = 3 * block_size;
+    key_type const range(gid_type(0, first), count);
+
+    // inserts the entry if it's not cached yet, updates it otherwise
+    key_type collision;
+    HPX_TEST(cache.update_if(range, make_gva(1), check_for_collisions,
+        collision));
+    test_range_found(cache, first, count, 1);
+
+    HPX_TEST(cache.update_if(range, make_gva(2), check_for_collisions,
+        collision));
+    test_range_found(cache, first, count, 2);
+    HPX_TEST_EQ(cache.size(), std::size_t(1));
+
+    // a single id inside of the range collides with the range
+    HPX_TEST(!cache.update_if(key_type(gid_type(0, first + block_size)),
+        make_gva(3), check_for_collisions, collision));
+    HPX_TEST(collision.get_gid() == range.get_gid());
+    HPX_TEST(collision.get_last_gid() == range.get_last_gid());
+    test_range_found(cache, first, count, 2);
+
+    // so does a different range overlapping the range
+    key_type const overlapping(gid_type(0, first + count - 1), count);
+    HPX_TEST(!cache.update_if(overlapping, make_gva(3), check_for_collisions,
+        collision));
+    HPX_TEST(collision.get_gid() == range.get_gid());
+    test_range_found(cache, first, count, 2);
+    test_range_missing(cache, first + count, count - 1);
+    HPX_TEST_EQ(cache.size(), std::size_t(1));
+
+    // a single id colliding with another single id
+    key_type const single(gid_type(0, 1));
+    HPX_TEST(cache.update_if(single, make_gva(4), check_for_collisions,
+        collision));
+    HPX_TEST(!cache.update_if(key_type(gid_type(0, 1), 2), make_gva(5),
+        check_for_collisions, collision));
+    HPX_TEST(collision.get_gid() == single.get_gid());
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+
+    // without a collision the existing entry is updated in place
+    HPX_TEST(cache.update_if(key_type(gid_type(0, first + block_size)),
+        make_gva(6), never_collides, collision));
+    test_range_found(cache, first, count, 6);
+    HPX_TEST_EQ(cache.size(), std::size_t(2));
+}
+
+int main()
+{
+    test_range_keys();
+    test_eviction();
+    test_update_if();
+
+    return hpx::util::report_errors();
+}
@@ -24,18 +24,19 @@ std::size_t const numparcels_default = 10;
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Action, typename T>
 hpx::parcelset::parcel
-generate_parcel(hpx::id_type const& dest_id, hpx::id_type const& cont, T && data)
+generate_parcel(hpx::id_type const& dest_id, hpx::id_type const& cont, T && data,
+    hpx::threads::thread_priority priority = hpx::threads::thread_priority_normal,
+    std::size_t size = 4096)
 {
     hpx::naming::address addr;
     hpx::naming::gid_type dest = dest_id.get_gid();
     hpx::parcelset::parcel p(hpx::parcelset::detail::create_parcel::call(
         std::move(dest), std::move(addr),
         hpx::actions::typed_continuation<hpx::id_type>(cont),
-        Action(), hpx::threads::thread_priority_normal,
-        std::forward<T>(data)));
+        Action(), priority, std::forward<T>(data)));
 
     p.set_source_id(hpx::find_here());
-    p.size() = 4096;
+    p.size() = size;
     return p;
 }
 
@@ -185,6 +186,61 @@ void test_mixed_arguments(hpx::id_type const& id)
     }
 }
 
+// parcels of one batch which end up in different priority lanes of the
+// same destination
+void test_mixed_lanes(hpx::id_type const& id)
+{
+    std::vector<double> data(vsize_default);
+    std::generate(data.begin(), data.end(), std::rand);
+
+    for (int batch = 0; batch != 10; ++batch)
+    {
+        std::vector<hpx::future<hpx::id_type> > results;
+        results.reserve(numparcels_default);
+
+        // create parcels, small ones and ones with a high priority go to the
+        // high priority lane, the others to the normal lane
+        std::vector<hpx::parcelset::parcel> parcels;
+        for (std::size_t i = 0; i != numparcels_default; ++i)
+        {
+            hpx::lcos::promise<hpx::id_type> p;
+            auto f = p.get_future();
+
+            switch (std::rand() % 3)
+            {
+            case 0:
+                parcels.push_back(generate_parcel<test1_action>(id,
+                    p.get_id(), data, hpx::threads::thread_priority_normal,
+                    64));
+                break;
+
+            case 1:
+                parcels.push_back(generate_parcel<test1_action>(id,
+                    p.get_id(), data, hpx::threads::thread_priority_high));
+                break;
+
+            default:
+                parcels.push_back(generate_parcel<test1_action>(id,
+                    p.get_id(), data, hpx::threads::thread_priority_normal,
+                    1024 * 1024));
+                break;
+            }
+            results.push_back(std::move(f));
+        }
+
+        // send parcels
+        hpx::get_runtime().get_parcel_handler().put_parcels(std::move(parcels));
+
+        // verify all messages got actually sent to the correct locality
+        hpx::wait_all(results);
+
+        for (hpx::future<hpx::id_type>& f : results)
+        {
+            HPX_TEST(f.get() == id);
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void print_counters(char const* name)
 {
@@ -217,6 +273,7 @@ int hpx_main(hpx::program_options::variables_map& vm)
         test_plain_argument(id);
         test_future_argument(id);
         test_mixed_arguments(id);
+        test_mixed_lanes(id);
     }
 
 #if defined(HPX_HAVE_NETWORKING)
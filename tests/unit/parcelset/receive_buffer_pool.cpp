@@ -0,0 +1,168 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/runtime/parcelset/detail/receive_buffer_pool.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using hpx::parcelset::detail::receive_buffer_allocator;
+using hpx::parcelset::detail::receive_buffer_cache;
+using hpx::parcelset::detail::receive_buffer_pool;
+
+typedef std::vector<char, receive_buffer_allocator<char>> buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_pool()
+{
+    receive_buffer_pool pool;
+
+    void* p1 = pool.allocate(100);
+    HPX_TEST_EQ(reinterpret_cast<std::uintptr_t>(p1) %
+            receive_buffer_pool::page_size, std::uintptr_t(0));
+    HPX_TEST_EQ(pool.get_misses(false), 1);
+    HPX_TEST_EQ(pool.get_hits(false), 0);
+
+    // a block of the same size class is reused
+    pool.deallocate(p1, 100);
+    void* p2 = pool.allocate(4000);
+    HPX_TEST_EQ(p1, p2);
+    HPX_TEST_EQ(pool.get_hits(false), 1);
+
+    // a block of a different size class is not
+    pool.deallocate(p2, 4000);
+    void* p3 = pool.allocate(10000);
+    HPX_TEST_EQ(pool.get_misses(true), 2);
+    HPX_TEST_EQ(pool.get_misses(false), 0);
+    pool.deallocate(p3, 10000);
+}
+
+void test_cache()
+{
+    std::shared_ptr<receive_buffer_pool> pool =
+        std::make_shared<receive_buffer_pool>();
+
+    {
+        receive_buffer_allocator<char> alloc(
+            std::make_shared<receive_buffer_cache>(pool));
+
+        char const* data = nullptr;
+        {
+            buffer_type buffer(alloc);
+            buffer.resize(1024 * 1024);
+            data = buffer.data();
+        }
+        HPX_TEST_EQ(pool->get_misses(false), 1);
+
+        for (int i = 0; i != 10; ++i)
+        {
+            buffer_type buffer(alloc);
+            buffer.resize(1000 * 1000);
+            HPX_TEST(buffer.data() == data);
+        }
+        HPX_TEST_EQ(pool->get_hits(false), 10);
+        HPX_TEST_EQ(pool->get_misses(false), 1);
+    }
+
+    // the blocks held by the cache were given back to the pool
+    buffer_type buffer(receive_buffer_allocator<char>(
+        std::make_shared<receive_buffer_cache>(pool)));
+    buffer.resize(1024 * 1024);
+    HPX_TEST_EQ(pool->get_hits(false), 11);
+    HPX_TEST_EQ(pool->get_misses(false), 1);
+}
+
+void test_limits()
+{
+    std::size_t const mb = 1024 * 1024;
+
+    {
+        // large blocks are not cached
+        receive_buffer_pool pool;
+
+        void* p = pool.allocate(32 * mb);
+        pool.deallocate(p, 32 * mb);
+        HPX_TEST_EQ(pool.get_occupancy(), 0);
+
+        p = pool.allocate(32 * mb);
+        HPX_TEST_EQ(pool.get_misses(false), 2);
+        pool.deallocate(p, 32 * mb);
+    }
+
+    {
+        // the number of bytes held by the pool is bounded
+        receive_buffer_pool pool;
+
+        std::vector<void*> blocks;
+        for (std::size_t i = 0; i != receive_buffer_pool::max_free_blocks; ++i)
+        {
+            blocks.push_back(pool.allocate(8 * mb));
+            blocks.push_back(pool.allocate(16 * mb));
+        }
+
+        for (std::size_t i = 0; i != blocks.size(); i += 2)
+            pool.deallocate(blocks[i], 8 * mb);
+        for (std::size_t i = 1; i < blocks.size(); i += 2)
+            pool.deallocate(blocks[i], 16 * mb);
+
+        HPX_TEST_EQ(pool.get_occupancy(),
+            std::int64_t(receive_buffer_pool::max_cached_bytes));
+    }
+
+    {
+        // the per-connection caches keep small blocks only, the blocks they
+        // keep are accounted for by the pool
+        std::shared_ptr<receive_buffer_pool> pool =
+            std::make_shared<receive_buffer_pool>();
+        std::shared_ptr<receive_buffer_cache> cache =
+            std::make_shared<receive_buffer_cache>(pool);
+
+        void* p = cache->allocate(mb);
+        cache->deallocate(p, mb);
+        HPX_TEST_EQ(pool->get_occupancy(), std::int64_t(mb));
+
+        p = cache->allocate(mb);
+        HPX_TEST_EQ(pool->get_occupancy(), 0);
+        cache->deallocate(p, mb);
+
+        void* q = cache->allocate(2 * mb);
+        cache->deallocate(q, 2 * mb);
+        HPX_TEST_EQ(pool->get_occupancy(), std::int64_t(3 * mb));
+
+        // the block was given to the pool, not the cache
+        q = pool->allocate(2 * mb);
+        HPX_TEST_EQ(pool->get_occupancy(), std::int64_t(mb));
+        pool->deallocate(q, 2 * mb);
+
+        cache.reset();
+        HPX_TEST_EQ(pool->get_occupancy(), std::int64_t(3 * mb));
+    }
+}
+
+void test_default_allocator()
+{
+    buffer_type buffer;
+    buffer.resize(100, 'a');
+    HPX_TEST_EQ(buffer.size(), std::size_t(100));
+    HPX_TEST_EQ(buffer[99], 'a');
+
+    buffer_type other(std::move(buffer));
+    HPX_TEST_EQ(other.size(), std::size_t(100));
+}
+
+int main()
+{
+    test_pool();
+    test_cache();
+    test_limits();
+    test_default_allocator();
+
+    return hpx::util::report_errors();
+}
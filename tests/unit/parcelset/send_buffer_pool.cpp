@@ -0,0 +1,125 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/runtime/parcelset/detail/send_buffer_pool.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using hpx::parcelset::detail::send_buffer_pool;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    send_buffer_pool pool;
+
+    std::vector<char> buffer;
+    pool.acquire(buffer, 100);
+    HPX_TEST(buffer.capacity() >= std::size_t(4096));
+    HPX_TEST_EQ(pool.get_misses(false), 1);
+    HPX_TEST_EQ(pool.get_hits(false), 0);
+
+    char const* data = buffer.data();
+    buffer.resize(100);
+
+    // the memory is given back and reused by the next message of the same
+    // size class
+    pool.release(buffer);
+    HPX_TEST_EQ(buffer.capacity(), std::size_t(0));
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(4096));
+
+    std::vector<char> other;
+    pool.acquire(other, 4000);
+    HPX_TEST(other.data() == data);
+    HPX_TEST(other.empty());
+    HPX_TEST_EQ(pool.get_hits(false), 1);
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(0));
+
+    // a buffer which is large enough is kept as it is
+    pool.acquire(other, 1000);
+    HPX_TEST(other.data() == data);
+    HPX_TEST_EQ(pool.get_hits(false), 2);
+
+    // a buffer which is too small is exchanged for a larger one
+    pool.acquire(other, 10000);
+    HPX_TEST(other.capacity() >= std::size_t(10000));
+    HPX_TEST_EQ(pool.get_misses(true), 2);
+    HPX_TEST_EQ(pool.get_misses(false), 0);
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(4096));
+
+    pool.release(other);
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(4096 + 16384));
+}
+
+void test_grown_buffer()
+{
+    send_buffer_pool pool;
+
+    // buffers which grew during serialization are put into the largest size
+    // class they can satisfy
+    std::vector<char> buffer;
+    buffer.reserve(6000);
+    pool.release(buffer);
+
+    std::vector<char> other;
+    pool.acquire(other, 5000);
+    HPX_TEST_EQ(pool.get_misses(false), 1);
+
+    pool.acquire(buffer, 3000);
+    HPX_TEST(buffer.capacity() >= std::size_t(6000));
+    HPX_TEST_EQ(pool.get_hits(false), 1);
+
+    // small buffers are not cached
+    std::vector<char> small(100);
+    pool.release(small);
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(0));
+}
+
+void test_concurrent_release()
+{
+    send_buffer_pool pool;
+
+    // buffers released concurrently never exceed the overall limit of the
+    // pool, even if each of them alone would fit
+    std::size_t const size = send_buffer_pool::max_cached_bytes / 4;
+    std::size_t const num_threads = 16;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        threads.emplace_back([&pool, size]() {
+            std::vector<char> buffer;
+            buffer.reserve(size);
+            pool.release(buffer);
+        });
+    }
+    for (std::thread& t : threads)
+        t.join();
+
+    HPX_TEST_EQ(pool.get_occupancy(),
+        static_cast<std::int64_t>(send_buffer_pool::max_cached_bytes));
+
+    // all cached buffers can be handed out again
+    std::vector<std::vector<char>> buffers(4);
+    for (std::vector<char>& buffer : buffers)
+        pool.acquire(buffer, size);
+
+    HPX_TEST_EQ(pool.get_hits(false), 4);
+    HPX_TEST_EQ(pool.get_occupancy(), std::int64_t(0));
+}
+
+int main()
+{
+    test_reuse();
+    test_grown_buffer();
+    test_concurrent_release();
+
+    return hpx::util::report_errors();
+}
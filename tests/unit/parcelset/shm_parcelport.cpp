@@ -0,0 +1,100 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test sends parcels of various sizes between localities running on the
+// same node through the shared memory parcelport. The channel size is chosen
+// small enough for the larger messages to be streamed in fragments and for
+// the rings to fill up.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/serialization/string.hpp>
+#include <hpx/serialization/vector.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<double> echo_data(std::vector<double> const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo_data);
+
+std::string echo_string(std::string const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo_string);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_echo(hpx::id_type const& id, std::size_t size)
+{
+    std::vector<hpx::future<std::vector<double>>> data_futures;
+    std::vector<hpx::future<std::string>> string_futures;
+
+    for (std::size_t i = 0; i != 16; ++i)
+    {
+        std::vector<double> data(size);
+        for (std::size_t j = 0; j != size; ++j)
+            data[j] = double(i + j);
+        data_futures.push_back(hpx::async<echo_data_action>(id, data));
+
+        std::string str(size, char('a' + i));
+        string_futures.push_back(hpx::async<echo_string_action>(id, str));
+    }
+
+    for (std::size_t i = 0; i != 16; ++i)
+    {
+        std::vector<double> data = data_futures[i].get();
+        HPX_TEST_EQ(data.size(), size);
+        for (std::size_t j = 0; j != data.size(); ++j)
+            HPX_TEST_EQ(data[j], double(i + j));
+
+        HPX_TEST(string_futures[i].get() == std::string(size, char('a' + i)));
+    }
+}
+
+int hpx_main()
+{
+    hpx::parcelset::parcelhandler& ph =
+        hpx::get_runtime().get_parcel_handler();
+
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    std::int64_t const sent = ph.get_parcel_send_count("shm", false);
+    std::int64_t const received = ph.get_parcel_receive_count("shm", false);
+
+    for (hpx::id_type const& id : localities)
+    {
+        for (std::size_t size : {0, 1, 100, 10000, 100000})
+        {
+            test_echo(id, size);
+        }
+    }
+
+    // all requests and their responses went through the shared memory
+    // parcelport
+    std::int64_t const num_parcels = std::int64_t(localities.size() * 5 * 32);
+    HPX_TEST(ph.get_parcel_send_count("shm", false) - sent >= num_parcels);
+    HPX_TEST(ph.get_parcel_receive_count("shm", false) - received >=
+        num_parcels);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.shm.enable=1", "hpx.parcel.shm.channel_size=65536"};
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
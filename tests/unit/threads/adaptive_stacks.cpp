@@ -0,0 +1,72 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that threads keep their stack while being suspended if
+// stacks are handed back to the worker threads on completion
+// (hpx.stacks.adaptive=1).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_TASKS 10000
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t no_suspension(std::size_t i)
+{
+    return i;
+}
+
+std::size_t with_suspension(std::size_t i)
+{
+    // keep some data on the stack which has to survive the suspension
+    volatile std::size_t data[64];
+    for (std::size_t j = 0; j != 64; ++j)
+        data[j] = i + j;
+
+    hpx::this_thread::yield();
+    hpx::async(&no_suspension, i).get();
+
+    std::size_t result = 0;
+    for (std::size_t j = 0; j != 64; ++j)
+        result += data[j] - j;
+    return result / 64;
+}
+
+int hpx_main()
+{
+    std::vector<hpx::future<std::size_t>> futures;
+    futures.reserve(2 * NUM_TASKS);
+
+    for (std::size_t i = 0; i != NUM_TASKS; ++i)
+    {
+        futures.push_back(hpx::async(&no_suspension, i));
+        futures.push_back(hpx::async(&with_suspension, i));
+    }
+
+    for (std::size_t i = 0; i != NUM_TASKS; ++i)
+    {
+        HPX_TEST_EQ(futures[2 * i].get(), i);
+        HPX_TEST_EQ(futures[2 * i + 1].get(), i);
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all", "hpx.stacks.adaptive=1"};
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,97 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that scheduler threads which went to sleep because they
+// ran out of work are woken up as soon as new work is scheduled, instead of
+// only after their back-off period has expired.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/testing.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::size_t> count(0);
+
+void work()
+{
+    ++count;
+}
+
+int hpx_main()
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::size_t const this_thread = hpx::get_worker_thread_num();
+
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    auto const sched = hpx::threads::get_self_id_data()->get_scheduler_base();
+#endif
+
+    for (int round = 0; round != 5; ++round)
+    {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        // block this worker without yielding to the scheduler until all
+        // other workers ran out of work and went to sleep
+        hpx::util::high_resolution_timer wait;
+        while (sched->get_num_parked() != num_threads - 1 &&
+            wait.elapsed() < 10.0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        HPX_TEST_EQ(sched->get_num_parked(), num_threads - 1);
+#endif
+
+        hpx::util::high_resolution_timer t;
+
+        // place the work on the queues of the sleeping workers only, this
+        // worker does not return to the scheduler until all work is done
+        count = 0;
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            if (i == this_thread)
+                continue;
+
+            hpx::threads::register_work_nullary(&work, "work",
+                hpx::threads::pending, hpx::threads::thread_priority_normal,
+                hpx::threads::thread_schedule_hint(
+                    static_cast<std::int16_t>(i)));
+            ++expected;
+        }
+
+        while (count != expected && t.elapsed() < 10.0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        // the back-off time is set to 60s, waking up the sleeping threads
+        // has to be significantly faster than that
+        HPX_TEST_EQ(count.load(), expected);
+        HPX_TEST_LT(t.elapsed(), 10.0);
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.os_threads=all",
+        "hpx.max_idle_loop_count=0", "hpx.max_idle_yield_count=0",
+        "hpx.max_idle_backoff_time=60000"};
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
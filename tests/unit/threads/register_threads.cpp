@@ -0,0 +1,98 @@
+//  Copyright (c) 2020 The STE||AR-Group
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that all threads registered as a batch are run exactly
+// once, independently of whether they are staged or created right away.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/synchronization/latch.hpp>
+#include <hpx/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_THREADS 10000
+
+///////////////////////////////////////////////////////////////////////////////
+void test_register_threads(bool run_now, hpx::threads::thread_priority priority)
+{
+    std::vector<std::atomic<std::size_t>> counts(NUM_THREADS);
+    for (auto& count : counts)
+        count.store(0);
+
+    hpx::lcos::local::latch l(NUM_THREADS + 1);
+
+    std::vector<hpx::threads::thread_init_data> data;
+    data.reserve(NUM_THREADS);
+
+    auto pool = hpx::threads::detail::get_self_or_default_pool();
+    std::ptrdiff_t stacksize = pool->get_scheduler()->get_stack_size(
+        hpx::threads::thread_stacksize_default);
+
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        auto f = [&counts, &l, i]() {
+            ++counts[i];
+            l.count_down(1);
+        };
+
+        data.emplace_back(
+            hpx::threads::thread_function_type(
+                hpx::threads::detail::thread_function_nullary<decltype(f)>{f}),
+            hpx::util::thread_description("test_register_threads"), priority,
+            hpx::threads::thread_schedule_hint(), stacksize);
+    }
+
+    hpx::threads::register_threads_plain(pool, data.data(), data.size(),
+        hpx::threads::pending, run_now);
+
+    l.count_down_and_wait();
+
+    for (auto& count : counts)
+        HPX_TEST_EQ(count.load(), std::size_t(1));
+}
+
+void test_bulk_async_execute()
+{
+    hpx::parallel::execution::parallel_executor exec;
+
+    std::vector<std::size_t> v(NUM_THREADS);
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+        v[i] = i;
+
+    std::vector<hpx::future<std::size_t>> results =
+        hpx::parallel::execution::bulk_async_execute(
+            exec, [](std::size_t i) { return 2 * i; }, v);
+
+    HPX_TEST_EQ(results.size(), std::size_t(NUM_THREADS));
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+        HPX_TEST_EQ(results[i].get(), 2 * i);
+}
+
+int hpx_main()
+{
+    test_register_threads(false, hpx::threads::thread_priority_default);
+    test_register_threads(true, hpx::threads::thread_priority_default);
+    test_register_threads(false, hpx::threads::thread_priority_high);
+    test_register_threads(true, hpx::threads::thread_priority_low);
+
+    test_bulk_async_execute();
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}